@@ -176,8 +176,46 @@ class Byte32:
         """
 class Client:
     """
-    This class represents a local client and provides access to meta information and connected remote servers
+    This class represents a local client and provides access to meta information and connected remote servers. Instances created in a sub interpreter run their callbacks in that interpreter, a per-interpreter GIL requires a build against pybind11 3 or later
     """
+    def __arrow_c_array__(self, requested_schema: object = None) -> tuple[object, object]:
+        """
+        export all points and their current information as Arrow record batch via the Arrow PyCapsule interface
+
+        Columns: common_address, io_address, type, value, quality, recorded_at, processed_at
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        tuple[object, object]
+            arrow_schema and arrow_array PyCapsules
+
+        Example
+        -------
+        >>> table = pyarrow.record_batch(my_client)
+        """
+    def __arrow_c_stream__(self, requested_schema: object = None) -> object:
+        """
+        export all points and their current information as Arrow stream via the Arrow PyCapsule interface
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        object
+            arrow_array_stream PyCapsule
+
+        Example
+        -------
+        >>> df = polars.DataFrame(my_client)
+        """
     def __init__(self, tick_rate_ms: int = 100, command_timeout_ms: int = 100, transport_security: TransportSecurity | None = None) -> None:
         """
         create a new 104er client
@@ -253,6 +291,47 @@ class Client:
         >>> con = my_client.get_connection(ip="192.168.50.3", port=2406)
         >>> con = my_client.get_connection(common_address=4711)
         """
+    def on_fleet_state(self, callable: collections.abc.Callable[[Client, dict[ConnectionState, int]], None]) -> None:
+        """
+        set python callback that will be executed with the number of connections per state after connection states changed
+
+        All state changes of all connections within the window of state_change_window_ms are reported by a single call. No call is made if the counts did not change compared to the last call.
+
+        Parameters
+        ----------
+        callable: collections.abc.Callable[[c104.Client, dict[c104.ConnectionState, int]], None]
+            callback function reference
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            callable signature does not match exactly
+
+        **Callable signature**
+
+        Callable Parameters
+        -------------------
+        client: c104.Client
+            client instance
+        states: dict[c104.ConnectionState, int]
+            number of connections per state
+
+        Callable Returns
+        ----------------
+        None
+
+        Example
+        -------
+        >>> def cl_on_fleet_state(client: c104.Client, states: dict[c104.ConnectionState, int]) -> None:
+        >>>     print("FLEET {0} open, {1} closed".format(states[c104.ConnectionState.OPEN], states[c104.ConnectionState.CLOSED]))
+        >>>
+        >>> my_client.state_change_window_ms = 1000
+        >>> my_client.on_fleet_state(callable=cl_on_fleet_state)
+        """
     def on_new_point(self, callable: collections.abc.Callable[[Client, Station, int, Type], None]) -> None:
         """
         set python callback that will be executed on incoming message from unknown point
@@ -372,6 +451,11 @@ class Client:
         list of all remote terminal unit (server) Connection objects
         """
     @property
+    def fleet_state(self) -> dict[ConnectionState, int]:
+        """
+        number of connections per state (read-only)
+        """
+    @property
     def has_active_connections(self) -> bool:
         """
         test if client has active (open and not muted) connections to servers
@@ -421,6 +505,25 @@ class Client:
             not a valid originator address
         """
     @property
+    def state_change_window_ms(self) -> int:
+        """
+        window in milliseconds to coalesce connection state changes in, Connection.on_state_change is called once per window with the latest state, 0 = report every change
+        """
+    @state_change_window_ms.setter
+    def state_change_window_ms(self, value: int) -> None:
+        """
+        set window in milliseconds to coalesce connection state changes in, 0 = report every change
+
+        Parameters
+        ----------
+        value: int
+            window in milliseconds
+
+        Returns
+        -------
+        None
+        """
+    @property
     def tick_rate_ms(self) -> int:
         """
         the clients tick rate in milliseconds
@@ -454,7 +557,7 @@ class CommandMode:
         ...
 class Connection:
     """
-    This class represents connections from a client to a remote server and provides access to meta information and containing stations
+    This class represents connections from a client to a remote server and provides access to meta information and containing stations. Instances created in a sub interpreter run their callbacks in that interpreter, a per-interpreter GIL requires a build against pybind11 3 or later
     """
     def add_station(self, common_address: int) -> Station | None:
         """
@@ -534,6 +637,22 @@ class Connection:
         >>> if not my_connection.counter_interrogation(common_address=47, cause=c104.Cot.ACTIVATION, qualifier=c104.Qoi.STATION):
         >>>     raise ValueError("Cannot send counter interrogation command")
         """
+    def disable_lost_update_detection(self) -> None:
+        """
+        stop detecting lost updates, collected statistics are kept
+
+        Example
+        -------
+        >>> my_connection.disable_lost_update_detection()
+        """
+    def disable_rtt_probe(self) -> None:
+        """
+        stop measuring the round trip time, collected statistics are kept
+
+        Example
+        -------
+        >>> my_connection.disable_rtt_probe()
+        """
     def disconnect(self) -> None:
         """
         close connection to remote terminal unit (server)
@@ -542,6 +661,51 @@ class Connection:
         -------
         >>> my_connection.disconnect()
         """
+    def enable_lost_update_detection(self, tolerance: float = 0.0, max_discrepancies: int = 100) -> None:
+        """
+        compare the values of general and group interrogation responses against the last spontaneously received values to detect lost updates
+
+        Every interrogated value that differs from the last spontaneous value of the point counts as a discrepancy, for example after a queue overflow or a reconnect. The interrogated value becomes the new reference, so that a lost update is counted once. Points that were never reported spontaneously are not checked. Enabling the detection again resets the statistics.
+
+        Parameters
+        ----------
+        tolerance: float
+            accepted absolute difference of numeric values
+        max_discrepancies: int
+            number of recent discrepancies to keep for inspection
+
+        Example
+        -------
+        >>> my_connection.enable_lost_update_detection(tolerance=0.01)
+        >>> my_connection.interrogation(common_address=47)
+        >>> print(my_connection.lost_updates["discrepancies"])
+        """
+    def enable_rtt_probe(self, common_address: int, interval_ms: int = 10000, threshold_ms: int = 0) -> None:
+        """
+        periodically measure the round trip time to the remote terminal unit (server) via test commands with timestamp
+
+        Parameters
+        ----------
+        common_address: int
+            station common address used for the test commands
+        interval_ms: int
+            interval between two probes, a probe without response within this interval is counted as lost
+        threshold_ms: int
+            threshold of the averaged round trip time that triggers the on_rtt_threshold callback, 0 = disabled
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            interval_ms is below 100
+
+        Example
+        -------
+        >>> my_connection.enable_rtt_probe(common_address=47, interval_ms=5000, threshold_ms=200)
+        """
     def get_station(self, common_address: int) -> Station | None:
         """
         get a station object via common address
@@ -604,6 +768,100 @@ class Connection:
         >>> if not my_connection.mute():
         >>>     raise ValueError("Cannot mute connection")
         """
+    def on_aggregate(self, callable: collections.abc.Callable[[Connection, datetime.datetime, datetime.datetime, list[dict[str, typing.Any]]], None], interval_ms: int = 60000) -> None:
+        """
+        set python callback that receives min, max, average and last value of every point once per interval instead of every received value
+
+        Received values of single, double, step, measured and integrated totals points are aggregated natively. Intervals are aligned to multiples of interval_ms since the unix epoch, so an interval of one minute starts at every full minute. Measured values are averaged weighted by the time each value was valid, the last value of an interval is carried into the next one. Other values are averaged per received value. Points without a new value in an interval are reported with count 0 and their last value. Setting the callback again restarts the aggregation.
+
+        Parameters
+        ----------
+        callable: collections.abc.Callable[[c104.Connection, datetime.datetime, datetime.datetime, list[dict[str, typing.Any]]], None]
+            callback function reference, None to stop aggregating
+        interval_ms: int
+            length of an aggregation interval in milliseconds
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            callable signature does not match exactly or interval_ms is 0
+
+        **Callable signature**
+
+        Callable Parameters
+        -------------------
+        connection: c104.Connection
+            connection instance
+        start: datetime.datetime
+            begin of the interval
+        end: datetime.datetime
+            end of the interval
+        aggregates: list[dict[str, typing.Any]]
+            one dict per point with common_address, io_address, type, count, min, max, average, last and last_at
+
+        Callable Returns
+        ----------------
+        None
+
+        Example
+        -------
+        >>> def con_on_aggregate(connection: c104.Connection, start: datetime.datetime, end: datetime.datetime, aggregates: list[dict[str, typing.Any]]) -> None:
+        >>>     for aggregate in aggregates:
+        >>>         historian.write(end, aggregate["io_address"], aggregate["average"])
+        >>>
+        >>> my_connection.on_aggregate(callable=con_on_aggregate, interval_ms=60000)
+        """
+    def on_raw_batch(self, callable: collections.abc.Callable[[Connection, RawFrameBatch], None], max_frames: int = 1000, max_delay_ms: int = 100) -> None:
+        """
+        set python callback that receives incoming and outgoing raw messages in batches
+
+        Frames are collected natively and delivered with a single callback per batch, instead of one callback per message like on_receive_raw and on_send_raw. Batches are delivered if they contain max_frames frames or if the oldest frame is older than max_delay_ms, the age is checked on every message and on every tick. An incomplete batch is delivered to the previous callback if the callback is replaced or removed and if the client stops.
+
+        Parameters
+        ----------
+        callable: collections.abc.Callable[[c104.Connection, c104.RawFrameBatch], None]
+            callback function reference, None to remove the callback
+        max_frames: int
+            number of frames per batch
+        max_delay_ms: int
+            maximum age of the oldest frame of a batch in milliseconds
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            callable signature does not match exactly or max_frames is 0
+
+        **Callable signature**
+
+        Callable Parameters
+        -------------------
+        connection: c104.Connection
+            connection instance
+        batch: c104.RawFrameBatch
+            frames received or sent since the last batch
+
+        Callable Returns
+        ----------------
+        None
+
+        Example
+        -------
+        >>> def con_on_raw_batch(connection: c104.Connection, batch: c104.RawFrameBatch) -> None:
+        >>>     data = batch.data
+        >>>     offsets = batch.offsets
+        >>>     for i in range(len(batch)):
+        >>>         frame = data[offsets[i]:offsets[i + 1]]
+        >>>
+        >>> my_connection.on_raw_batch(callable=con_on_raw_batch, max_frames=500, max_delay_ms=200)
+        """
     def on_receive_raw(self, callable: collections.abc.Callable[[Connection, bytes], None]) -> None:
         """
         set python callback that will be executed on incoming message
@@ -642,6 +900,46 @@ class Connection:
         >>>
         >>> my_connection.on_receive_raw(callable=con_on_receive_raw)
         """
+    def on_rtt_threshold(self, callable: collections.abc.Callable[[Connection, float, bool], None]) -> None:
+        """
+        set python callback that will be executed if the averaged round trip time crosses the threshold configured via enable_rtt_probe
+
+        Parameters
+        ----------
+        callable: collections.abc.Callable[[c104.Connection, float, bool], None]
+            callback function reference
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            callable signature does not match exactly
+
+        **Callable signature**
+
+        Callable Parameters
+        -------------------
+        connection: c104.Connection
+            connection instance
+        rtt_ms: float
+            averaged round trip time in milliseconds
+        exceeded: bool
+            True if the threshold is exceeded, False if the round trip time recovered
+
+        Callable Returns
+        ----------------
+        None
+
+        Example
+        -------
+        >>> def con_on_rtt_threshold(connection: c104.Connection, rtt_ms: float, exceeded: bool) -> None:
+        >>>     print("CON {0}:{1} RTT {2:.1f} ms, degraded: {3}".format(connection.ip, connection.port, rtt_ms, exceeded))
+        >>>
+        >>> my_connection.on_rtt_threshold(callable=con_on_rtt_threshold)
+        """
     def on_send_raw(self, callable: collections.abc.Callable[[Connection, bytes], None]) -> None:
         """
         set python callback that will be executed on outgoing message
@@ -757,6 +1055,11 @@ class Connection:
         >>>     raise ValueError("Cannot unmute connection")
         """
     @property
+    def aggregation(self) -> dict[str, typing.Any]:
+        """
+        interval aggregation statistics: enabled, interval_ms, points, samples, intervals, skipped, dropped, pending_bytes and last_batch_size (read-only)
+        """
+    @property
     def connected_at(self) -> datetime.datetime | None:
         """
         datetime of last connection opening, if connection is open
@@ -787,6 +1090,11 @@ class Connection:
         test if connection is muted
         """
     @property
+    def lost_updates(self) -> dict[str, typing.Any]:
+        """
+        lost update statistics: enabled, tolerance, checked, unchecked, discrepancies, stations (per common address: checked, unchecked, discrepancies and last_discrepancy_at) and recent (list of discrepancies with common_address, io_address, type, expected, expected_at, expected_spontaneous, interrogated and interrogated_at)
+        """
+    @property
     def originator_address(self) -> int:
         """
         originator address of this connection (0-255)
@@ -821,6 +1129,21 @@ class Connection:
         read and update protocol parameters
         """
     @property
+    def raw_batch_statistics(self) -> dict[str, int]:
+        """
+        raw batch statistics: frames, batches, pending_batches, pending_bytes and dropped_frames (read-only)
+        """
+    @property
+    def rejected_messages(self) -> dict[Umc, int]:
+        """
+        number of rejected incoming messages per cause
+        """
+    @property
+    def rtt(self) -> dict[str, typing.Any]:
+        """
+        round trip time statistics: count, lost, last_ms, min_ms, max_ms, ema_fast_ms, ema_slow_ms, histogram_bounds_ms and histogram
+        """
+    @property
     def state(self) -> ConnectionState:
         """
         current connection state
@@ -1388,6 +1711,52 @@ class Point:
     """
     This class represents command and measurement data point of a station and provides access to structured properties of points
     """
+    def add_tag(self, tag: str) -> None:
+        """
+        add a tag to this point, the parent station indexes the point by its tags for fast selections
+
+        Parameters
+        ----------
+        tag: str
+            tag name, for example a bay, a signal group or a data source
+
+        Raises
+        ------
+        ValueError
+            tag is empty
+
+        Example
+        -------
+        >>> point.add_tag("bay:E01")
+        >>> point.add_tag("breaker")
+        """
+    def clear_command_policy(self) -> None:
+        """
+        remove the native command policy, received commands are handled by on_receive only
+
+        Example
+        -------
+        >>> setpoint.clear_command_policy()
+        """
+    def has_tag(self, tag: str) -> bool:
+        """
+        test if this point has a tag
+
+        Parameters
+        ----------
+        tag: str
+            tag name
+
+        Returns
+        -------
+        bool
+            True if the point has this tag, else False
+
+        Example
+        -------
+        >>> if point.has_tag("breaker"):
+        >>>     print("breaker position")
+        """
     def on_before_auto_transmit(self, callable: collections.abc.Callable[[Point], None]) -> None:
         """
         set python callback that will be called before server reports a measured value interval-based
@@ -1470,14 +1839,16 @@ class Point:
         >>> step_point = sv_station_2.add_point(io_address=31, type=c104.Type.M_ST_TB_1, report_ms=2000)
         >>> step_point.on_before_read(callable=on_before_read_steppoint)
         """
-    def on_receive(self, callable: collections.abc.Callable[[Point, Information, IncomingMessage], ResponseState]) -> None:
+    def on_receive(self, callable: typing.Union[collections.abc.Callable[[Point, Information, IncomingMessage], ResponseState], collections.abc.Callable[[int, float, int, int], ResponseState]]) -> None:
         """
         set python callback that will be executed on every incoming message
         this can be either a command or an monitoring message
 
+        A callable with the lightweight signature (io_address, value, quality, recorded_at_ms) receives plain scalars instead of point, information and message objects, which is considerably cheaper per call. The dispatch is selected by the signature of the callable.
+
         Parameters
         ----------
-        callable: collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState]
+        callable: typing.Union[collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState], collections.abc.Callable[[int, float, int, int], c104.ResponseState]]
             callback function reference
 
         Returns
@@ -1505,6 +1876,24 @@ class Point:
         c104.ResponseState
             send command SUCCESS or FAILURE response
 
+        **Lightweight callable signature**
+
+        Callable Parameters
+        -------------------
+        io_address: int
+            information object address of the point
+        value: float
+            new value as number, booleans and enums are passed as their integer value, NaN if the value has no numeric representation
+        quality: int
+            quality bitset as integer, 0 if the type has no quality
+        recorded_at_ms: int
+            recorded timestamp in milliseconds since epoch, 0 if the message has no timestamp
+
+        Callable Returns
+        ----------------
+        c104.ResponseState
+            send command SUCCESS or FAILURE response
+
         Example
         -------
         >>> def on_setpoint_command(point: c104.Point, previous_info: c104.Information, message: c104.IncomingMessage) -> c104.ResponseState:
@@ -1523,6 +1912,12 @@ class Point:
         >>> sv_measurement_point.value = 12.34
         >>> sv_command_point = sv_station_2.add_point(io_address=12, type=c104.Type.C_SE_NC_1, report_ms=0, related_io_address=sv_measurement_point.io_address, related_io_autoreturn=True, command_mode=c104.CommandMode.SELECT_AND_EXECUTE)
         >>> sv_command_point.on_receive(callable=on_setpoint_command)
+        >>>
+        >>> def on_measurement(io_address: int, value: float, quality: int, recorded_at_ms: int) -> c104.ResponseState:
+        >>>     print("CL] IOA: {0}, value: {1}, quality: {2}".format(io_address, value, quality))
+        >>>     return c104.ResponseState.NONE
+        >>>
+        >>> cl_measurement_point.on_receive(callable=on_measurement)
         """
     def on_timer(self, callable: collections.abc.Callable[[Point], None], int) -> None:
         """
@@ -1566,9 +1961,27 @@ class Point:
         >>> nv_point = sv_station_2.add_point(io_address=31, type=c104.Type.M_ME_TD_1)
         >>> nv_point.on_timer(callable=on_timer, interval_ms=1000)
         """
-    def read(self) -> bool:
+    def prepare_command(self) -> None:
         """
-        send read command
+        **Client-side point**
+        encode the command frame of this point once, following transmissions only patch value, timestamp and cause of transmission in place
+
+        This reduces the latency of frequently transmitted commands like setpoints. The frame is encoded from scratch again if the point type changes.
+
+        Raises
+        ------
+        ValueError
+            parent station or connection reference is invalid, point is server-sided or not a command
+
+        Example
+        -------
+        >>> cl_setpoint.prepare_command()
+        >>> cl_setpoint.value = 12.5
+        >>> cl_setpoint.transmit(cause=c104.Cot.ACTIVATION)
+        """
+    def read(self) -> bool:
+        """
+        send read command
 
         Returns
         -------
@@ -1585,6 +1998,53 @@ class Point:
         >>> if cl_step_point.read():
         >>>     print("read command successful")
         """
+    def remove_tag(self, tag: str) -> bool:
+        """
+        remove a tag from this point
+
+        Parameters
+        ----------
+        tag: str
+            tag name
+
+        Returns
+        -------
+        bool
+            True if the point had this tag, else False
+
+        Example
+        -------
+        >>> point.remove_tag("breaker")
+        """
+    def set_command_policy(self, mirror: bool = False, min_value: float | None = None, max_value: float | None = None, min_interval_ms: int = 0, reject_invalid_quality: bool = False) -> None:
+        """
+        handle received commands of this server-sided control point natively, without acquiring the GIL for rejected or mirrored commands
+
+        Rules are evaluated in this order: value range, quality of the related monitoring point and minimum interval since the last accepted command. A command that violates a rule is answered with a negative confirmation and on_receive is not called. Accepted commands are passed to on_receive, unless mirror is enabled: then the commanded value is copied into the related monitoring point and the command is confirmed without calling python. Combine mirror with related_io_autoreturn to report the mirrored value. Setting a policy again resets its counters.
+
+        Parameters
+        ----------
+        mirror: bool
+            copy the commanded value into the related monitoring point (related_io_address), which must have the same value type
+        min_value: float, optional
+            lowest accepted value
+        max_value: float, optional
+            highest accepted value
+        min_interval_ms: int
+            minimum time in milliseconds between two accepted commands, 0 = no limit
+        reject_invalid_quality: bool
+            reject commands while the related monitoring point has an invalid quality
+
+        Raises
+        ------
+        ValueError
+            point is not a server-sided control point, mirror is requested for a step command or min_value is greater than max_value
+
+        Example
+        -------
+        >>> setpoint = sv_station_1.add_point(io_address=12, type=c104.Type.C_SE_NC_1, related_io_address=11, related_io_autoreturn=True)
+        >>> setpoint.set_command_policy(mirror=True, min_value=0.0, max_value=100.0, min_interval_ms=1000)
+        """
     def transmit(self, cause: Cot) -> bool:
         """
         **Server-side point**
@@ -1633,6 +2093,11 @@ class Point:
         None
         """
     @property
+    def command_policy(self) -> dict[str, typing.Any]:
+        """
+        native command policy and counters: active, mirror, min_value, max_value, min_interval_ms, reject_invalid_quality, accepted, mirrored, rejected_range, rejected_rate, rejected_quality and rejected_mirror (read-only)
+        """
+    @property
     def info(self) -> Information:
         """
         current information
@@ -1779,6 +2244,11 @@ class Point:
         parent Station object
         """
     @property
+    def tags(self) -> list[str]:
+        """
+        tags of this point
+        """
+    @property
     def timer_ms(self) -> int:
         """
         interval in milliseconds between timer callbacks, 0 = no periodic transmission
@@ -2137,6 +2607,55 @@ class Quality:
         """
         combined bits in integer representation
         """
+class RawFrameBatch:
+    """
+    This class provides read-only access to a batch of raw messages without copying, all columns are memoryviews of native buffers
+    """
+    def __len__(self) -> int:
+        ...
+    def frame(self, index: int) -> bytes:
+        """
+        get a copy of a single frame
+
+        Parameters
+        ----------
+        index: int
+            frame index
+
+        Returns
+        -------
+        bytes
+            raw message bytes
+
+        Raises
+        ------
+        IndexError
+            index is out of range
+
+        Example
+        -------
+        >>> first = batch.frame(0)
+        """
+    @property
+    def data(self) -> memoryview:
+        """
+        all frames concatenated, format B (read-only)
+        """
+    @property
+    def directions(self) -> memoryview:
+        """
+        1 for sent and 0 for received frames, format B (read-only)
+        """
+    @property
+    def offsets(self) -> memoryview:
+        """
+        start offset of every frame in data and the total length as last element, format I (read-only)
+        """
+    @property
+    def timestamps(self) -> memoryview:
+        """
+        time of every frame in nanoseconds since epoch, format q (read-only)
+        """
 class ResponseState:
     """
     This enum contains all command response states, that add the ability to control the servers command response behaviour via python callbacks return value.
@@ -2238,6 +2757,44 @@ class Server:
     """
     This class represents a local server and provides access to meta information and containing stations
     """
+    def __arrow_c_array__(self, requested_schema: object = None) -> tuple[object, object]:
+        """
+        export all points and their current information as Arrow record batch via the Arrow PyCapsule interface
+
+        Columns: common_address, io_address, type, value, quality, recorded_at, processed_at
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        tuple[object, object]
+            arrow_schema and arrow_array PyCapsules
+
+        Example
+        -------
+        >>> table = pyarrow.record_batch(my_server)
+        """
+    def __arrow_c_stream__(self, requested_schema: object = None) -> object:
+        """
+        export all points and their current information as Arrow stream via the Arrow PyCapsule interface
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        object
+            arrow_array_stream PyCapsule
+
+        Example
+        -------
+        >>> df = polars.DataFrame(my_server)
+        """
     def __init__(self, ip: str = "0.0.0.0", port: int = 2404, tick_rate_ms: int = 100, select_timeout_ms = 100, max_connections: int = 0, transport_security: TransportSecurity | None = None) -> None:
         """
         create a new 104er server
@@ -2261,6 +2818,29 @@ class Server:
         -------
         >>> my_server = c104.Server(ip="0.0.0.0", port=2404, tick_rate_ms=100, select_timeout_ms=100, max_connections=0)
         """
+    def add_admission_rule(self, cidr: str, allow: bool = True) -> None:
+        """
+        allow or deny connection requests from an IPv4 network
+
+        Admission rules are evaluated natively for every connection request before the on_connect callback: denied networks, connection cap per ip, accept rate limits and finally allowed networks. Peers in an allowed network are accepted without calling on_connect. If at least one allowed network exists, all other peers are rejected. Otherwise the on_connect callback decides about the remaining requests.
+
+        Parameters
+        ----------
+        cidr: str
+            network in CIDR notation, a plain address matches a single peer
+        allow: bool
+            accept or reject matching peers
+
+        Raises
+        ------
+        ValueError
+            cidr is invalid
+
+        Example
+        -------
+        >>> my_server.add_admission_rule(cidr="192.168.50.0/24")
+        >>> my_server.add_admission_rule(cidr="192.168.50.66", allow=False)
+        """
     def add_station(self, common_address: int) -> Station | None:
         """
         add a new station to this server and return the new station object
@@ -2279,6 +2859,91 @@ class Server:
         -------
         >>> station_1 = my_server.add_station(common_address=15)
         """
+    def clear_admission_rules(self) -> None:
+        """
+        remove all allowed and denied networks, limits are kept
+
+        Example
+        -------
+        >>> my_server.clear_admission_rules()
+        """
+    def disable_background_scan(self) -> None:
+        """
+        stop the background scan, statistics are kept
+
+        Example
+        -------
+        >>> my_server.disable_background_scan()
+        """
+    def disable_command_executor(self) -> None:
+        """
+        execute all pending commands and handle new commands in the thread of the client connection again
+
+        Example
+        -------
+        >>> my_server.disable_command_executor()
+        """
+    def disable_loopback(self) -> None:
+        """
+        serve this endpoint via TCP again after the next start of the server
+
+        Example
+        -------
+        >>> my_server.disable_loopback()
+        """
+    def enable_background_scan(self, points_per_second: int = 0) -> None:
+        """
+        continuously cycle through all monitoring points of all stations and send them with cause of transmission BACKGROUND_SCAN in packed ASDUs
+
+        The scan keeps the database of clients up to date without the burst load of a general interrogation. Enabling the scan again restarts the cycle.
+
+        Parameters
+        ----------
+        points_per_second: int
+            number of points to send per second, 0 = send a batch of points per tick only while the send windows of all active connections are available
+
+        Example
+        -------
+        >>> my_server.enable_background_scan(points_per_second=200)
+        """
+    def enable_command_executor(self, workers: int = 0) -> None:
+        """
+        handle incoming commands in a pool of worker threads instead of the thread of the client connection
+
+        Commands are assigned to workers by common address and information object address. Commands of different points are executed in parallel, so a slow on_receive callback of one point does not delay commands of other stations on the same connection. Commands of the same point are executed in the order of arrival and the activation confirmation is always sent before the activation termination. Enabling the executor again restarts the pool after all pending commands are executed. Pending commands are executed before the server stops and the pool is restarted with the server. Pending commands of a closed connection are dropped.
+
+        Parameters
+        ----------
+        workers: int
+            number of worker threads, 0 = number of hardware threads
+
+        Example
+        -------
+        >>> my_server.enable_command_executor(workers=4)
+        """
+    def enable_loopback(self, latency_ms: int = 0, bandwidth: int = 0) -> None:
+        """
+        serve this endpoint in-process: clients of the same process that connect to the servers ip and port exchange frames via memory instead of the network stack
+
+        The transport replaces the socket layer of lib60870 and is intended for deterministic benchmarks of the protocol stack. It takes effect on the next start of the server, the link parameters apply to new connections.
+
+        Parameters
+        ----------
+        latency_ms: int
+            one way delay per frame in milliseconds, 0 = immediate
+        bandwidth: int
+            bytes per second in each direction, 0 = unlimited
+
+        Raises
+        ------
+        RuntimeError
+            the build does not support the loopback transport (build option C104_LOOPBACK_TRANSPORT, Linux only)
+
+        Example
+        -------
+        >>> my_server.enable_loopback(latency_ms=5, bandwidth=8000)
+        >>> my_server.start()
+        """
     def get_station(self, common_address: int) -> Station | None:
         """
         get a station object via common address
@@ -2381,6 +3046,53 @@ class Server:
         >>>
         >>> my_server.on_connect(callable=sv_on_connect)
         """
+    def on_raw_batch(self, callable: collections.abc.Callable[[Server, RawFrameBatch], None], max_frames: int = 1000, max_delay_ms: int = 100) -> None:
+        """
+        set python callback that receives incoming and outgoing raw messages in batches
+
+        Frames are collected natively and delivered with a single callback per batch, instead of one callback per message like on_receive_raw and on_send_raw. Batches are delivered if they contain max_frames frames or if the oldest frame is older than max_delay_ms, the age is checked on every message and on every tick. An incomplete batch is delivered to the previous callback if the callback is replaced or removed and if the server stops.
+
+        Parameters
+        ----------
+        callable: collections.abc.Callable[[c104.Server, c104.RawFrameBatch], None]
+            callback function reference, None to remove the callback
+        max_frames: int
+            number of frames per batch
+        max_delay_ms: int
+            maximum age of the oldest frame of a batch in milliseconds
+
+        Returns
+        -------
+        None
+
+        Raises
+        ------
+        ValueError
+            callable signature does not match exactly or max_frames is 0
+
+        **Callable signature**
+
+        Callable Parameters
+        -------------------
+        server: c104.Server
+            server instance
+        batch: c104.RawFrameBatch
+            frames received or sent since the last batch
+
+        Callable Returns
+        ----------------
+        None
+
+        Example
+        -------
+        >>> def sv_on_raw_batch(server: c104.Server, batch: c104.RawFrameBatch) -> None:
+        >>>     data = batch.data
+        >>>     offsets = batch.offsets
+        >>>     for i in range(len(batch)):
+        >>>         frame = data[offsets[i]:offsets[i + 1]]
+        >>>
+        >>> my_server.on_raw_batch(callable=sv_on_raw_batch, max_frames=500, max_delay_ms=200)
+        """
     def on_receive_raw(self, callable: collections.abc.Callable[[Server, bytes], None]) -> None:
         """
         set python callback that will be executed on incoming message
@@ -2497,6 +3209,57 @@ class Server:
         >>>
         >>> my_server.on_unexpected_message(callable=sv_on_unexpected_message)
         """
+    def set_admission_limits(self, max_connections_per_ip: int = 0, accept_rate: float = 0.0, accept_rate_per_ip: float = 0.0, burst: int = 5) -> None:
+        """
+        limit open connections per peer ip and the rate of connection requests that pass the native admission rules
+
+        Requests exceeding a limit are rejected without calling on_connect.
+
+        Parameters
+        ----------
+        max_connections_per_ip: int
+            open connections per peer ip, 0 = unlimited
+        accept_rate: float
+            connection requests per second from all peers, 0 = unlimited
+        accept_rate_per_ip: float
+            connection requests per second per peer ip, 0 = unlimited
+        burst: int
+            number of connection requests passed at once before the rate applies
+
+        Raises
+        ------
+        ValueError
+            a rate is negative
+
+        Example
+        -------
+        >>> my_server.set_admission_limits(max_connections_per_ip=2, accept_rate_per_ip=0.5)
+        """
+    def set_bandwidth_limit(self, bytes_per_second: int, burst_bytes: int = 0, ip: str | None = None) -> None:
+        """
+        limit the outgoing bandwidth per client connection via token bucket
+
+        Frames that exceed the limit are held back per connection. Interrogation responses and spontaneous data are released before periodic and background scan data. Confirmations are never held back, but count towards the limit.
+
+        Parameters
+        ----------
+        bytes_per_second: int
+            limit in bytes per second including protocol overhead, 0 = unlimited
+        burst_bytes: int
+            bucket size in bytes, 0 = traffic of two ticks
+        ip: str, optional
+            limit only connections from this ip, None = default limit for all connections without an ip specific limit
+
+        Raises
+        ------
+        ValueError
+            ip is invalid
+
+        Example
+        -------
+        >>> my_server.set_bandwidth_limit(bytes_per_second=1200)
+        >>> my_server.set_bandwidth_limit(bytes_per_second=8000, ip="192.168.50.10")
+        """
     def start(self) -> None:
         """
         open local server socket for incoming connections
@@ -2524,6 +3287,26 @@ class Server:
         get number of active (open and not muted) connections to clients
         """
     @property
+    def admission_statistics(self) -> dict[str, typing.Any]:
+        """
+        admission rules, limits and decision counters: allow, deny, max_connections_per_ip, accept_rate, accept_rate_per_ip, burst, accepted, undecided, rejected_denied, rejected_not_allowed, rejected_cap, rejected_rate, rejected_callback, open and tracked (read-only)
+        """
+    @property
+    def background_scan(self) -> dict[str, typing.Any]:
+        """
+        background scan configuration and cycle statistics: enabled, rate, cycles, points, deferred, cycle_points, last_cycle_ms and current_cycle_ms (read-only)
+        """
+    @property
+    def bandwidth_statistics(self) -> list[dict[str, typing.Any]]:
+        """
+        bandwidth shaping statistics per open connection: ip, rate, burst, bytes, frames, bypassed_bytes, delayed_frames, held_frames, held_bytes, dropped_frames, coalesced_frames, held_ms and max_held_ms (read-only)
+        """
+    @property
+    def command_executor(self) -> dict[str, int]:
+        """
+        command executor statistics: workers, dispatched, executed, pending and max_pending (read-only)
+        """
+    @property
     def has_active_connections(self) -> bool:
         """
         test if server has active (open and not muted) connections to clients
@@ -2544,6 +3327,11 @@ class Server:
         ip address the server will accept connections on, "0.0.0.0" = any
         """
     @property
+    def is_loopback(self) -> bool:
+        """
+        test if this endpoint is served in-process
+        """
+    @property
     def is_running(self) -> bool:
         """
         test if server is running
@@ -2588,6 +3376,16 @@ class Server:
         read and update protocol parameters
         """
     @property
+    def raw_batch_statistics(self) -> dict[str, int]:
+        """
+        raw batch statistics: frames, batches, pending_batches, pending_bytes and dropped_frames (read-only)
+        """
+    @property
+    def rejected_messages(self) -> dict[Umc, int]:
+        """
+        number of rejected incoming messages per cause
+        """
+    @property
     def stations(self) -> list[Station]:
         """
         list of all local Station objects
@@ -2791,6 +3589,44 @@ class Station:
     """
     This class represents local or remote stations and provides access to meta information and containing points
     """
+    def __arrow_c_array__(self, requested_schema: object = None) -> tuple[object, object]:
+        """
+        export all points and their current information as Arrow record batch via the Arrow PyCapsule interface
+
+        Columns: common_address, io_address, type, value, quality, recorded_at, processed_at
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        tuple[object, object]
+            arrow_schema and arrow_array PyCapsules
+
+        Example
+        -------
+        >>> table = pyarrow.record_batch(my_station)
+        """
+    def __arrow_c_stream__(self, requested_schema: object = None) -> object:
+        """
+        export all points and their current information as Arrow stream via the Arrow PyCapsule interface
+
+        Parameters
+        ----------
+        requested_schema: object, optional
+            ignored, the table is always exported with its native schema
+
+        Returns
+        -------
+        object
+            arrow_array_stream PyCapsule
+
+        Example
+        -------
+        >>> df = polars.DataFrame(my_station)
+        """
     def add_point(self, io_address: int, type: Type, report_ms: int = 0, related_io_address: int | None = None, related_io_autoreturn: bool = False, command_mode: CommandMode = ...) -> Point | None:
         """
         add a new point to this station and return the new point object
@@ -2832,6 +3668,64 @@ class Station:
         >>> point_2 = sv_station_1.add_point(io_address=11, type=c104.Type.M_ME_NC_1, report_ms=1000)
         >>> point_3 = sv_station_1.add_point(io_address=12, type=c104.Type.C_SE_NC_1, report_ms=0, related_io_address=point_2.io_address, related_io_autoreturn=True, command_mode=c104.CommandMode.SELECT_AND_EXECUTE)
         """
+    def apply_diff(self, diff: StationDiff) -> None:
+        """
+        apply point additions, removals and configuration changes at once without restarting the server or client
+
+        Concurrent readers such as interrogations see either the complete old or the complete new point list. Points that are not part of the diff keep their values, callbacks and selections.
+
+        Parameters
+        ----------
+        diff: c104.StationDiff
+            changes to apply
+
+        Raises
+        ------
+        ValueError
+            a point to remove or configure does not exist, a point to add already exists or an option is invalid, no change is applied in this case
+
+        Example
+        -------
+        >>> diff = c104.StationDiff()
+        >>> diff.remove_point(io_address=34)
+        >>> diff.add_point(io_address=35, type=c104.Type.M_ME_NC_1, report_ms=1000)
+        >>> diff.configure_point(io_address=11, report_ms=5000)
+        >>> sv_station_1.apply_diff(diff=diff)
+        """
+    def disable_counter_freeze(self) -> None:
+        """
+        stop freezing integrated totals, statistics are kept
+
+        Example
+        -------
+        >>> sv_station_1.disable_counter_freeze()
+        """
+    def enable_counter_freeze(self, interval_ms: int = 900000, reset: bool = False, offset_ms: int = 0) -> None:
+        """
+        freeze all integrated totals (M_IT_NA_1, M_IT_TB_1) of this server station at wall-clock aligned boundaries and send the frozen values with cause of transmission SPONTANEOUS in packed ASDUs
+
+        Boundaries are multiples of the interval since the unix epoch plus the offset, an interval of 15 minutes freezes at :00, :15, :30 and :45. Each freeze advances the sequence number of every counter and uses the boundary as timestamp of the frozen reading. Counters are frozen in a single pass under the station lock.
+
+        Parameters
+        ----------
+        interval_ms: int
+            time between two freezes in milliseconds
+        reset: bool
+            reset the counters to zero after each freeze (counter freeze with reset)
+        offset_ms: int
+            shift of the boundaries in milliseconds, must be less than interval_ms
+
+        Raises
+        ------
+        RuntimeError
+            station is not a server station
+        ValueError
+            interval_ms is zero or offset_ms is not less than interval_ms
+
+        Example
+        -------
+        >>> sv_station_1.enable_counter_freeze(interval_ms=900000, reset=True)
+        """
     def get_point(self, io_address: int) -> Point | None:
         """
         get a point object via information object address
@@ -2850,6 +3744,47 @@ class Station:
         -------
         >>> point_11 = my_station.get_point(io_address=11)
         """
+    def remove_point(self, io_address: int) -> bool:
+        """
+        remove an existing point from this station
+
+        Parameters
+        ----------
+        io_address: int
+            point information object address (value between 0 and 16777215)
+
+        Returns
+        -------
+        bool
+            True if the point was removed, else False
+
+        Example
+        -------
+        >>> sv_station_1.remove_point(io_address=34)
+        """
+    def select_points(self, tags: list[str] = [], first_io_address: int = 0, last_io_address: int = 16777215) -> list[Point]:
+        """
+        select points via tag and information object address indexes without iterating all points
+
+        Parameters
+        ----------
+        tags: list[str]
+            points must have all of these tags, an empty list selects points regardless of tags
+        first_io_address: int
+            lowest information object address to select
+        last_io_address: int
+            highest information object address to select
+
+        Returns
+        -------
+        list[c104.Point]
+            matching points sorted by information object address
+
+        Example
+        -------
+        >>> breakers_of_bay_1 = sv_station_1.select_points(tags=["bay:E01", "breaker"])
+        >>> points_100_199 = sv_station_1.select_points(first_io_address=100, last_io_address=199)
+        """
     @property
     def common_address(self) -> int:
         """
@@ -2861,6 +3796,11 @@ class Station:
         parent Connection of non-local station
         """
     @property
+    def counter_freeze(self) -> dict[str, typing.Any]:
+        """
+        counter freeze schedule and statistics: enabled, interval_ms, offset_ms, reset, freezes, skipped, unsent, points, last_frozen_at, last_snapshot_ms, last_transmission_ms and next_freeze_at (read-only)
+        """
+    @property
     def has_points(self) -> bool:
         """
         test if station has at least one point
@@ -2880,6 +3820,80 @@ class Station:
         """
         parent Server of local station
         """
+class StationDiff:
+    """
+    This class collects point additions, removals and configuration changes that are applied to a station at once
+    """
+    def __init__(self) -> None:
+        """
+        create a new empty station diff
+
+        Example
+        -------
+        >>> diff = c104.StationDiff()
+        """
+    def add_point(self, io_address: int, type: Type, report_ms: int = 0, related_io_address: int | None = None, related_io_autoreturn: bool = False, command_mode: CommandMode = ...) -> None:
+        """
+        add a new point, the arguments are validated when the diff is applied
+
+        Parameters
+        ----------
+        io_address: int
+            point information object address (value between 0 and 16777215)
+        type: c104.Type
+            point information type
+        report_ms: int
+            automatic reporting interval in milliseconds (monitoring points server-sided only), 0 = disabled
+        related_io_address: int, optional
+            related monitoring point identified by information object address (for control points server-sided only)
+        related_io_autoreturn: bool
+            automatically transmit related monitoring point on incoming client command (for control points server-sided only)
+        command_mode: c104.CommandMode
+            command transmission mode (direct or select-and-execute)
+
+        Example
+        -------
+        >>> diff.add_point(io_address=35, type=c104.Type.M_ME_NC_1, report_ms=1000)
+        """
+    def configure_point(self, io_address: int, report_ms: int | None = None, related_io_address: int | None = None, related_io_autoreturn: bool | None = None, command_mode: CommandMode | None = None) -> None:
+        """
+        change options of an existing or added point, options set to None are kept
+
+        Parameters
+        ----------
+        io_address: int
+            point information object address (value between 0 and 16777215)
+        report_ms: int, optional
+            automatic reporting interval in milliseconds, 0 = disabled
+        related_io_address: int, optional
+            related monitoring point identified by information object address
+        related_io_autoreturn: bool, optional
+            automatically transmit related monitoring point on incoming client command
+        command_mode: c104.CommandMode, optional
+            command transmission mode (direct or select-and-execute)
+
+        Example
+        -------
+        >>> diff.configure_point(io_address=11, report_ms=5000)
+        """
+    def remove_point(self, io_address: int) -> None:
+        """
+        remove an existing point
+
+        Parameters
+        ----------
+        io_address: int
+            point information object address (value between 0 and 16777215)
+
+        Example
+        -------
+        >>> diff.remove_point(io_address=34)
+        """
+    @property
+    def size(self) -> int:
+        """
+        number of collected changes
+        """
 class StatusAndChanged(Information):
     """
     This class represents all specific packed status point information with change detection
@@ -3307,6 +4321,7 @@ class Umc:
     This enum contains all unexpected message cause identifier to interpret error context.
     """
     INVALID_COT: typing.ClassVar[Umc]
+    INVALID_STRUCTURE: typing.ClassVar[Umc]
     INVALID_TYPE_ID: typing.ClassVar[Umc]
     MISMATCHED_TYPE_ID: typing.ClassVar[Umc]
     NO_ERROR_CAUSE: typing.ClassVar[Umc]
@@ -3393,6 +4408,22 @@ def explain_bytes_dict(apdu: bytes) -> dict[str, typing.Any]:
     >>> def sv_on_receive_raw(server: c104.Server, data: bytes) -> None:
     >>>    print("SV] -->| {1} [{0}] | SERVER {2}:{3}".format(data.hex(), c104.explain_bytes_dict(apdu=data), server.ip, server.port))
     """
+def get_asdu_buffer_stats() -> dict[str, int]:
+    """
+    get usage counters of the reusable buffers for outgoing ASDUs
+
+    Outgoing reports and inventory responses are encoded in thread-local buffers instead of allocating a new ASDU per frame. In steady-state operation only the acquired counter grows.
+
+    Returns
+    -------
+    dict[str, int]
+        acquired: number of ASDUs encoded in a reused buffer, allocated: number of buffers allocated on the heap
+
+    Example
+    -------
+    >>> stats = c104.get_asdu_buffer_stats()
+    >>> print("{0} frames, {1} buffers".format(stats["acquired"], stats["allocated"]))
+    """
 def get_debug_mode() -> Debug:
     """
     get current debug mode
@@ -3406,6 +4437,20 @@ def get_debug_mode() -> Debug:
     -------
     >>> mode = c104.get_debug_mode()
     """
+def get_memory_stats() -> dict[str, typing.Any]:
+    """
+    get usage and shedding counters of the process wide memory budget
+
+    Returns
+    -------
+    dict[str, typing.Any]
+        limit: budget in bytes (0 = unlimited), usage: accounted bytes, peak: highest accounted bytes, stage: active shedding stage (none, drop_periodic, coalesce or refuse_history), subsystems: accounted bytes per subsystem (held_frames, held_periodic_frames, raw_frames, aggregates), dropped_periodic: dropped periodic frames, coalesced: replaced spontaneous frames, refused_history: refused batches
+
+    Example
+    -------
+    >>> stats = c104.get_memory_stats()
+    >>> print("{0} of {1} bytes, stage: {2}".format(stats["usage"], stats["limit"], stats["stage"]))
+    """
 def set_debug_mode(mode: Debug) -> None:
     """
     set the debug mode
@@ -3419,4 +4464,29 @@ def set_debug_mode(mode: Debug) -> None:
     -------
     >>> c104.set_debug_mode(mode=c104.Debug.Client|c104.Debug.Connection)
     """
+def set_memory_budget(limit_bytes: int) -> None:
+    """
+    set a process wide memory budget for internal queues and buffers of all servers and clients
+
+    Frames held by a bandwidth limit, raw frame batches and aggregate batches that wait for delivery are accounted per subsystem. If the usage approaches the limit, load is shed in this order, each stage includes the previous ones:
+
+    1. at 80 %: held periodic and background frames are dropped, they are sent again in the next cycle
+    2. at 90 %: a held spontaneous frame is replaced by a newer frame of the same point instead of queueing both
+    3. at 100 %: new raw frame batches and aggregate batches are refused
+
+    The budget does not limit allocations of python objects. Every buffer keeps its own size limit and frames that cannot be shed, for example interrogation responses and confirmations, are still accepted.
+
+    Parameters
+    ----------
+    limit_bytes: int
+        limit in bytes, 0 = unlimited
+
+    Returns
+    -------
+    None
+
+    Example
+    -------
+    >>> c104.set_memory_budget(limit_bytes=64 * 1024 * 1024)
+    """
 __version__: str = '2.1.0'
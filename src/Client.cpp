@@ -108,6 +108,9 @@ void Client::stop() {
 
   // stop all connections
   disconnectAll();
+  for (const auto &c : getConnections()) {
+    c->deliverRawBatches(true);
+  }
 
   DEBUG_PRINT(Debug::Client, "stop] Stopped");
 }
@@ -305,6 +308,55 @@ void Client::onNewPoint(std::shared_ptr<Object::Station> station,
   }
 }
 
+void Client::setOnFleetStateCallback(py::object &callable) {
+  py_onFleetState.reset(callable);
+}
+
+void Client::onConnectionStateChange() {
+  if (!py_onFleetState.is_set() || fleetStatePending.exchange(true)) {
+    return;
+  }
+
+  scheduleTask(
+      [this]() {
+        fleetStatePending.store(false);
+        auto states = getFleetState();
+        {
+          std::lock_guard<Module::GilAwareMutex> const lock(fleet_mutex);
+          if (states == lastFleetState) {
+            // all changes within the window were reverted
+            return;
+          }
+          lastFleetState = states;
+        }
+        DEBUG_PRINT(Debug::Client, "CALLBACK on_fleet_state");
+        Module::ScopedGilAcquire const scoped("Client.on_fleet_state");
+        py_onFleetState.call(shared_from_this(), std::move(states));
+      },
+      stateChangeWindow_ms.load());
+}
+
+std::map<ConnectionState, std::uint_fast32_t> Client::getFleetState() const {
+  std::map<ConnectionState, std::uint_fast32_t> states;
+  for (auto const state : {CLOSED, CLOSED_AWAIT_OPEN, CLOSED_AWAIT_RECONNECT,
+                           OPEN_MUTED, OPEN, OPEN_AWAIT_CLOSED}) {
+    states[state] = 0;
+  }
+  std::lock_guard<Module::GilAwareMutex> const lock(connections_mutex);
+  for (auto &c : connections) {
+    states[c->getState()]++;
+  }
+  return states;
+}
+
+void Client::setStateChangeWindow_ms(const std::uint_fast16_t window_ms) {
+  stateChangeWindow_ms.store(window_ms);
+}
+
+std::uint_fast16_t Client::getStateChangeWindow_ms() const {
+  return stateChangeWindow_ms.load();
+}
+
 std::uint_fast16_t Client::getTickRate_ms() const { return tickRate_ms; }
 
 void Client::scheduleDataPointTimer() {
@@ -312,7 +364,10 @@ void Client::scheduleDataPointTimer() {
   auto now = std::chrono::steady_clock::now();
 
   for (const auto &c : getConnections()) {
+    c->deliverRawBatches();
+    c->deliverAggregates();
     if (c->isOpen() && !c->isMuted()) {
+      c->probeRoundTrip(now);
       for (const auto &station : c->getStations()) {
         for (const auto &point : station->getPoints()) {
           auto next = point->nextTimerAt();
@@ -361,6 +416,7 @@ void Client::scheduleTask(const std::function<void()> &task, int delay) {
 
 void Client::thread_run() {
   bool const debug = DEBUG_TEST(Debug::Client);
+  Module::Interpreter_bind(interpreter);
   running.store(true);
   while (enabled.load()) {
     std::function<void()> task;
@@ -187,8 +187,48 @@ public:
   void onNewPoint(std::shared_ptr<Object::Station> station,
                   std::uint_fast32_t io_address, IEC60870_5_TypeID type);
 
+  /**
+   * @brief set python callback that will be executed with the number of
+   * connections per state after connection state changes, changes within the
+   * state change window are reported once
+   * @throws std::invalid_argument if callable signature does not match
+   */
+  void setOnFleetStateCallback(py::object &callable);
+
+  /**
+   * @brief notify about a changed state of a connection, the fleet state
+   * callback is scheduled once per state change window
+   */
+  void onConnectionStateChange();
+
+  /**
+   * @brief Getter for the number of connections per state
+   * @return map with a count for every connection state
+   */
+  std::map<ConnectionState, std::uint_fast32_t> getFleetState() const;
+
+  /**
+   * @brief Setter for the window to coalesce connection state changes in
+   * @param window_ms window in milliseconds, 0 = report every change of a
+   * connection
+   */
+  void setStateChangeWindow_ms(std::uint_fast16_t window_ms);
+
+  /**
+   * @brief Getter for the window to coalesce connection state changes in
+   * @return window in milliseconds, 0 = report every change of a connection
+   */
+  std::uint_fast16_t getStateChangeWindow_ms() const;
+
   std::uint_fast16_t getTickRate_ms() const;
 
+  /**
+   * @brief Getter for the python interpreter that created this client, its
+   * callbacks are executed in this interpreter
+   * @return interpreter or nullptr for the main interpreter
+   */
+  PyInterpreterState *getInterpreter() const { return interpreter; }
+
   void schedulePeriodicTask(const std::function<void()> &task, int interval);
   void scheduleTask(const std::function<void()> &task, int delay = 0);
 
@@ -210,6 +250,9 @@ private:
   /// @brief minimum interval between to periodic broadcasts in milliseconds
   const std::uint_fast16_t tickRate_ms{1000};
 
+  /// @brief python interpreter owning this instance, nullptr for main
+  PyInterpreterState *const interpreter{Module::Interpreter_current()};
+
   /// @brief timeout in milliseconds before an inactive connection gets closed
   const std::uint_fast16_t commandTimeout_ms{100};
 
@@ -253,6 +296,24 @@ private:
       "Client.on_new_point", "(client: c104.Client, station: c104.Station, "
                              "io_address: int, point_type: c104.Type) -> None"};
 
+  /// @brief python callback function pointer
+  Module::Callback<void> py_onFleetState{
+      "Client.on_fleet_state",
+      "(client: c104.Client, states: dict[c104.ConnectionState, int]) -> "
+      "None"};
+
+  /// @brief window in milliseconds to coalesce state changes in
+  std::atomic_uint_fast16_t stateChangeWindow_ms{0};
+
+  /// @brief fleet state callback is scheduled
+  std::atomic_bool fleetStatePending{false};
+
+  /// @brief MUTEX Lock to access lastFleetState
+  mutable Module::GilAwareMutex fleet_mutex{"Client::fleet_mutex"};
+
+  /// @brief last reported number of connections per state
+  std::map<ConnectionState, std::uint_fast32_t> lastFleetState{};
+
   /// @brief client thread function
   void thread_run();
 
@@ -32,9 +32,11 @@
 #include "Server.h"
 #include "module/ScopedGilAcquire.h"
 #include "module/ScopedGilRelease.h"
+#include "remote/Loopback.h"
 #include "remote/TransportSecurity.h"
 #include "remote/message/PointCommand.h"
 #include "remote/message/PointMessage.h"
+#include "remote/message/ScratchAsdu.h"
 #include <pybind11/chrono.h>
 
 using namespace Remote;
@@ -100,6 +102,7 @@ Server::~Server() {
   // stops and destroys the slave
   stop();
   CS104_Slave_destroy(slave);
+  disableLoopback();
 
   {
     std::lock_guard<Module::GilAwareMutex> const st_lock(station_mutex);
@@ -143,6 +146,10 @@ void Server::start() {
 
   DEBUG_PRINT(Debug::Server, "start] Started");
 
+  if (commandExecutorEnabled.load() && !commandExecutor.isRunning()) {
+    commandExecutor.start(commandExecutorWorkers.load(), interpreter);
+  }
+
   if (!runThread) {
     runThread = new std::thread(&Server::thread_run, this);
   }
@@ -156,6 +163,14 @@ void Server::start() {
         scheduleDataPointTimer();
       },
       tickRate_ms);
+  schedulePeriodicTask(
+      [this]() {
+        releaseHeldFrames();
+        sendCounterFreezes();
+        sendBackgroundScan();
+        deliverRawBatches();
+      },
+      tickRate_ms);
 }
 
 void Server::scheduleDataPointTimer() {
@@ -210,6 +225,7 @@ void Server::scheduleTask(const std::function<void()> &task, int delay) {
 
 void Server::thread_run() {
   bool const debug = DEBUG_TEST(Debug::Server);
+  Module::Interpreter_bind(interpreter);
   running.store(true);
   while (enabled.load()) {
     std::function<void()> task;
@@ -277,7 +293,21 @@ void Server::stop() {
     runThread = nullptr;
   }
 
+  // finish dispatched commands while their connections are still open
+  commandExecutor.stop();
+
   CS104_Slave_stop(slave);
+  deliverRawBatches(true);
+
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(connection_mutex);
+    for (auto const &entry : connectionTokens) {
+      std::unique_lock<std::shared_mutex> const token_lock(
+          entry.second->mutex);
+      entry.second->closed = true;
+    }
+    connectionTokens.clear();
+  }
 
   connectionMap.clear();
   activeConnections.store(0);
@@ -364,46 +394,34 @@ Server::addStation(std::uint_fast16_t commonAddress) {
 
 void Server::cleanupSelections() {
   auto now = std::chrono::steady_clock::now();
-  std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
-  selectionVector.erase(
-      std::remove_if(selectionVector.begin(), selectionVector.end(),
-                     [this, now](const Selection &s) {
-                       if ((now - s.created) < selectTimeout_ms) {
-                         return false;
-                       } else {
-                         unselect(s);
-                         return true;
-                       }
-                     }),
-      selectionVector.end());
-}
+  std::vector<Selection> expired;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
+    auto const begin = std::partition(
+        selectionVector.begin(), selectionVector.end(),
+        [this, now](const Selection &s) {
+          return (now - s.created) < selectTimeout_ms;
+        });
+    if (begin == selectionVector.end()) {
+      return;
+    }
+    expired.assign(begin, selectionVector.end());
+    selectionVector.erase(begin, selectionVector.end());
+  }
 
-void Server::cleanupSelections(IMasterConnection connection) {
-  std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
-  selectionVector.erase(std::remove_if(selectionVector.begin(),
-                                       selectionVector.end(),
-                                       [this, connection](const Selection &s) {
-                                         if (s.connection == connection) {
-                                           unselect(s);
-                                           return true;
-                                         } else {
-                                           return false;
-                                         }
-                                       }),
-                        selectionVector.end());
+  // terminate outside the lock, sending locks the connections
+  for (auto const &selection : expired) {
+    unselect(selection);
+  }
 }
 
-void Server::cleanupSelection(uint16_t ca, uint32_t ioa) {
+void Server::cleanupSelections(IMasterConnection connection) {
+  // the connection is closed, no termination is sent
   std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
   selectionVector.erase(std::remove_if(selectionVector.begin(),
                                        selectionVector.end(),
-                                       [this, ca, ioa](const Selection &s) {
-                                         if (s.ca == ca && s.ioa == ioa) {
-                                           unselect(s);
-                                           return true;
-                                         } else {
-                                           return false;
-                                         }
+                                       [connection](const Selection &s) {
+                                         return s.connection == connection;
                                        }),
                         selectionVector.end());
 }
@@ -431,6 +449,13 @@ bool Server::select(IMasterConnection connection,
         "Only control points, except for binary commands can be selected");
   }
 
+  CS101_ASDU const asdu = message->getAsdu();
+  int const payloadSize = CS101_ASDU_getPayloadSize(asdu);
+  if (payloadSize <= 0 ||
+      static_cast<std::size_t>(payloadSize) > SELECTION_MAX_PAYLOAD_SIZE) {
+    return false;
+  }
+
   const uint8_t oa = message->getOriginatorAddress();
   const uint16_t ca = message->getCommonAddress();
   const uint32_t ioa = message->getIOA();
@@ -443,49 +468,65 @@ bool Server::select(IMasterConnection connection,
 
   // selection NOT found
   if (it == selectionVector.end()) {
-    CS101_ASDU cp = CS101_ASDU_clone(message->getAsdu(), nullptr);
-    selectionVector.emplace_back<Selection>({cp, oa, ca, ioa, connection, now});
+    it = selectionVector.emplace(selectionVector.end());
   }
   // selection found
-  else {
-    if ((it->connection != connection) &&
-        (now - it->created) < selectTimeout_ms) {
-      return false;
-    } else {
-      it->created = now;
-    }
+  else if ((it->connection != connection) &&
+           (now - it->created) < selectTimeout_ms) {
+    return false;
   }
 
+  it->type = type;
+  it->oa = oa;
+  it->ca = ca;
+  it->ioa = ioa;
+  it->test = message->isTest();
+  it->connection = connection;
+  it->created = now;
+  it->payloadSize = static_cast<std::uint_fast8_t>(payloadSize);
+  std::memcpy(it->payload.data(), CS101_ASDU_getPayload(asdu), payloadSize);
   return true;
 }
 
 void Server::unselect(const Selection &selection) {
-  scheduleTask([this, selection]() {
-    sendActivationTermination(selection.connection, selection.asdu);
-    CS101_ASDU_destroy(selection.asdu);
-  });
+  Remote::Message::ScratchAsdu const scratch(
+      appLayerParameters, false, CS101_COT_ACTIVATION_TERMINATION,
+      selection.oa, selection.ca, selection.test, false);
+  CS101_ASDU asdu = scratch.get();
+
+  // encode the information object of the select command again
+  CS101_ASDU_setTypeID(asdu, selection.type);
+  auto payload = selection.payload;
+  if (!CS101_ASDU_addPayload(asdu, payload.data(),
+                             static_cast<int>(selection.payloadSize))) {
+    return;
+  }
+  CS101_ASDU_setNumberOfElements(asdu, 1);
+  sendActivationTermination(selection.connection, asdu);
 }
 
 CommandResponseState
 Server::execute(IMasterConnection connection,
                 std::shared_ptr<Remote::Message::IncomingMessage> message,
-                std::shared_ptr<Object::DataPoint> point) {
-  bool selected = false;
+                std::shared_ptr<Object::DataPoint> point,
+                std::optional<Selection> &executed) {
   const uint16_t ca = message->getCommonAddress();
   const uint32_t ioa = message->getIOA();
+  auto const matches = [ca, ioa, connection](const Selection &s) {
+    return s.ca == ca && s.ioa == ioa && s.connection == connection;
+  };
 
-  if (SELECT_AND_EXECUTE_COMMAND == point->getCommandMode()) {
+  bool const sbo = SELECT_AND_EXECUTE_COMMAND == point->getCommandMode();
+  if (sbo) {
     auto now = std::chrono::steady_clock::now();
 
     std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
-    auto it = std::find_if(
-        selectionVector.begin(), selectionVector.end(),
-        [ca, ioa](const Selection &s) { return s.ca == ca && s.ioa == ioa; });
+    auto it =
+        std::find_if(selectionVector.begin(), selectionVector.end(), matches);
 
     // selection NOT found
-    selected = (it != selectionVector.end() && (it->connection == connection) &&
-                (now - it->created) < selectTimeout_ms);
-    if (!selected) {
+    if (it == selectionVector.end() ||
+        (now - it->created) >= selectTimeout_ms) {
       std::cerr << "[c104.Server] Cannot execute command on point in "
                    "SELECT_AND_EXECUTE "
                    "command mode without selection"
@@ -496,13 +537,149 @@ Server::execute(IMasterConnection connection,
 
   auto res = point->onReceive(std::move(message));
 
-  if (selected) {
-    scheduleTask([this, ca, ioa]() { cleanupSelection(ca, ioa); }, 1);
+  if (sbo) {
+    // the selection may have expired meanwhile and is terminated already
+    std::lock_guard<Module::GilAwareMutex> const lock(selection_mutex);
+    auto it =
+        std::find_if(selectionVector.begin(), selectionVector.end(), matches);
+    if (it != selectionVector.end()) {
+      executed = *it;
+      *it = selectionVector.back();
+      selectionVector.pop_back();
+    }
   }
 
   return res;
 }
 
+CommandResponseState Server::executeCommand(
+    IMasterConnection connection,
+    std::shared_ptr<Remote::Message::IncomingMessage> message,
+    const std::shared_ptr<Object::Station> &station,
+    std::shared_ptr<Object::DataPoint> point,
+    std::optional<Selection> &executed) {
+  if (message->isSelectCommand()) {
+    if (SELECT_AND_EXECUTE_COMMAND == point->getCommandMode()) {
+      return select(connection, message) ? RESPONSE_STATE_SUCCESS
+                                         : RESPONSE_STATE_FAILURE;
+    }
+    std::cerr << "[c104.Point] Failed to select point in DIRECT "
+                 "command mode"
+              << std::endl;
+    return RESPONSE_STATE_FAILURE;
+  }
+
+  auto const responseState = execute(connection, message, point, executed);
+
+  if (responseState == RESPONSE_STATE_SUCCESS &&
+      point->getRelatedInformationObjectAutoReturn()) {
+    const auto related_ioa = point->getRelatedInformationObjectAddress();
+    // send related point info in case of auto return
+    if (related_ioa.has_value()) {
+      auto related_point = station->getPoint(related_ioa.value());
+      scheduleTask(
+          [this, related_point]() {
+            try {
+              transmit(related_point, CS101_COT_RETURN_INFO_REMOTE);
+            } catch (const std::exception &e) {
+              std::cerr << "[c104.Server] asdu_handler] Auto transmit "
+                           "related point failed for "
+                        << TypeID_toString(related_point->getType())
+                        << " at IOA "
+                        << related_point->getInformationObjectAddress()
+                        << ": " << e.what() << std::endl;
+            }
+          },
+          2);
+    }
+  }
+
+  return responseState;
+}
+
+bool Server::dispatchCommand(
+    IMasterConnection connection,
+    std::shared_ptr<Remote::Message::IncomingMessage> message,
+    std::shared_ptr<Object::Station> station,
+    std::shared_ptr<Object::DataPoint> point) {
+  if (!commandExecutor.isRunning())
+    return false;
+
+  const uint16_t ca = message->getCommonAddress();
+  const uint32_t ioa = message->getIOA();
+  std::weak_ptr<Server> weak = weak_from_this();
+
+  std::shared_ptr<ConnectionToken> token;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(connection_mutex);
+    auto &entry = connectionTokens[connection];
+    if (!entry) {
+      entry = std::make_shared<ConnectionToken>();
+    }
+    token = entry;
+  }
+
+  auto job = [weak, token, connection, message, station, point]() {
+    auto instance = weak.lock();
+    if (!instance) {
+      return;
+    }
+
+    // the connection may be closed and freed while the job was queued, closing
+    // waits for running jobs of the connection
+    std::shared_lock<std::shared_mutex> const alive(token->mutex);
+    if (token->closed) {
+      DEBUG_PRINT(Debug::Server, "Drop command of closed connection");
+      return;
+    }
+
+    std::optional<Selection> executed;
+    auto const responseState = instance->executeCommand(
+        connection, message, station, point, executed);
+
+    // confirm activation, the received ASDU is copied since the message may
+    // still be referenced by python
+    if ((responseState != RESPONSE_STATE_NONE) &&
+        (message->getCauseOfTransmission() == CS101_COT_ACTIVATION ||
+         message->getCauseOfTransmission() == CS101_COT_DEACTIVATION)) {
+      CS101_ASDU const received = message->getAsdu();
+      Remote::Message::ScratchAsdu const scratch(
+          instance->appLayerParameters, message->isSequence(),
+          message->getCauseOfTransmission(), message->getOriginatorAddress(),
+          message->getCommonAddress(), message->isTest(), false);
+      CS101_ASDU asdu = scratch.get();
+      CS101_ASDU_setTypeID(asdu, message->getType());
+      CS101_ASDU_addPayload(asdu, CS101_ASDU_getPayload(received),
+                            CS101_ASDU_getPayloadSize(received));
+      CS101_ASDU_setNumberOfElements(asdu,
+                                     CS101_ASDU_getNumberOfElements(received));
+      instance->sendActivationConfirmation(
+          connection, asdu, (responseState == RESPONSE_STATE_FAILURE));
+    }
+
+    // terminate the executed selection after the confirmation
+    if (executed.has_value()) {
+      instance->unselect(executed.value());
+    }
+  };
+  return commandExecutor.dispatch(ca, ioa, std::move(job));
+}
+
+void Server::enableCommandExecutor(const std::uint_fast32_t workers) {
+  commandExecutorWorkers.store(workers);
+  commandExecutorEnabled.store(true);
+  commandExecutor.start(workers, interpreter);
+}
+
+void Server::disableCommandExecutor() {
+  commandExecutorEnabled.store(false);
+  commandExecutor.stop();
+}
+
+py::dict Server::getCommandExecutorStatistics() const {
+  return commandExecutor.toDict();
+}
+
 CS104_APCIParameters Server::getParameters() const {
   return CS104_Slave_getConnectionParameters(slave);
 }
@@ -555,6 +732,46 @@ void Server::onSendRaw(unsigned char *msg, unsigned char msgSize) {
   }
 }
 
+void Server::setOnRawBatchCallback(py::object &callable,
+                                   const std::size_t max_frames,
+                                   const std::uint_fast32_t max_delay_ms) {
+  // hand pending frames to the previous callback
+  deliverRawBatches(true);
+  rawTap.configure(max_frames, max_delay_ms);
+  py_onRawBatch.reset(callable);
+}
+
+void Server::onRawFrame(unsigned char *msg, unsigned char msgSize,
+                        const bool sent) {
+  if (py_onRawBatch.is_set() && rawTap.append(msg, msgSize, sent)) {
+    std::weak_ptr<Server> weak = weak_from_this();
+    scheduleTask([weak]() {
+      if (auto instance = weak.lock()) {
+        instance->deliverRawBatches();
+      }
+    });
+  }
+}
+
+void Server::deliverRawBatches(const bool flush) {
+  // no delivery while the server is destroyed
+  auto self = weak_from_this().lock();
+  if (!self || !py_onRawBatch.is_set())
+    return;
+
+  auto const batches = rawTap.collect(flush);
+  if (batches.empty())
+    return;
+
+  DEBUG_PRINT(Debug::Server, "CALLBACK on_raw_batch");
+  Module::ScopedGilAcquire const scoped("Server.on_raw_batch");
+  for (auto const &batch : batches) {
+    py_onRawBatch.call(self, batch);
+  }
+}
+
+py::dict Server::getRawBatchStatistics() const { return rawTap.toDict(); }
+
 void Server::setOnClockSyncCallback(py::object &callable) {
   py_onClockSync.reset(callable);
 }
@@ -611,38 +828,40 @@ void Server::onUnexpectedMessage(
     IMasterConnection connection,
     std::shared_ptr<Remote::Message::IncomingMessage> message,
     UnexpectedMessageCause cause) {
+  rejectedMessages[cause]++;
+
   CS101_ASDU asdu = message->getAsdu();
   switch (cause) {
   case INVALID_TYPE_ID:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Invalid type id");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case MISMATCHED_TYPE_ID:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Mismatching type id");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case UNKNOWN_TYPE_ID:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Unknown type id");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_TYPE_ID);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case INVALID_COT:
   case UNKNOWN_COT:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Invalid COT");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_COT);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case UNKNOWN_CA:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Unknown CA");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_CA);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case UNKNOWN_IOA:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Unknown IOA");
     CS101_ASDU_setCOT(asdu, CS101_COT_UNKNOWN_IOA);
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
     break;
   case UNIMPLEMENTED_GROUP:
     DEBUG_PRINT(Debug::Server, "on_unexpected_message] Unimplemented group");
@@ -660,6 +879,11 @@ void Server::onUnexpectedMessage(
   }
 }
 
+std::map<UnexpectedMessageCause, std::uint_fast32_t>
+Server::getRejectedMessageCounts() const {
+  return RejectionCounters_toMap(rejectedMessages);
+}
+
 void Server::setOnConnectCallback(py::object &callable) {
   py_onConnect.reset(callable);
 }
@@ -667,28 +891,42 @@ void Server::setOnConnectCallback(py::object &callable) {
 std::uint_fast16_t Server::getTickRate_ms() const { return tickRate_ms; }
 
 bool Server::connectionRequestHandler(void *parameter, const char *ipAddress) {
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Reject connection request in shutdown");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
+
+  std::string const ip(ipAddress);
+
+  // native rules first, python is only consulted for undecided requests
+  switch (instance->admission.evaluate(ip)) {
+  case Remote::AdmissionControl::Verdict::Accept:
+    return true;
+  case Remote::AdmissionControl::Verdict::Reject:
+    DEBUG_PRINT(Debug::Server, "Reject connection request from " + ip);
+    return false;
+  case Remote::AdmissionControl::Verdict::Undecided:
+    break;
+  }
 
   if (instance->py_onConnect.is_set()) {
     DEBUG_PRINT(Debug::Server, "CALLBACK on_connect");
     Module::ScopedGilAcquire const scoped("Server.on_connect");
-    std::string const ip(ipAddress);
+    bool accept = false;
     if (instance->py_onConnect.call(instance, ip)) {
       try {
-        return instance->py_onConnect.getResult();
+        accept = instance->py_onConnect.getResult();
       } catch (const std::exception &e) {
         DEBUG_PRINT(Debug::Server, "on_connect] Invalid callback result: " +
                                        std::string(e.what()));
-        return false;
       }
     }
+    if (!accept) {
+      instance->admission.rejectedByCallback();
+    }
+    return accept;
   }
 
   return true;
@@ -703,25 +941,25 @@ void Server::connectionEventHandler(void *parameter,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Ignore connection event " +
                                    PeerConnectionEvent_toString(event) +
                                    " in shutdown");
     return;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   char ipAddrStr[60];
   IMasterConnection_getPeerAddress(connection, ipAddrStr, 60);
 
+  std::shared_ptr<ConnectionToken> closedToken;
   {
     std::lock_guard<Module::GilAwareMutex> const lock(
         instance->connection_mutex);
 
     if (event == CS104_CON_EVENT_CONNECTION_OPENED) {
+      instance->admission.opened(ipAddrStr);
       // set as invalid receiver
       auto it = instance->connectionMap.find(connection);
       if (it == instance->connectionMap.end()) {
@@ -732,6 +970,7 @@ void Server::connectionEventHandler(void *parameter,
       }
 
     } else if (event == CS104_CON_EVENT_CONNECTION_CLOSED) {
+      instance->admission.closed(ipAddrStr);
       // set as invalid receiver
       auto it = instance->connectionMap.find(connection);
       if (it != instance->connectionMap.end()) {
@@ -740,10 +979,12 @@ void Server::connectionEventHandler(void *parameter,
         }
         instance->connectionMap.erase(it);
       }
-      // remove selections
-      instance->scheduleTask([instance, connection]() {
-        instance->cleanupSelections(connection);
-      });
+      // invalidate dispatched commands
+      auto token_it = instance->connectionTokens.find(connection);
+      if (token_it != instance->connectionTokens.end()) {
+        closedToken = std::move(token_it->second);
+        instance->connectionTokens.erase(token_it);
+      }
     } else if (event == CS104_CON_EVENT_ACTIVATED) {
       // set as valid receiver
       auto it = instance->connectionMap.find(connection);
@@ -769,6 +1010,18 @@ void Server::connectionEventHandler(void *parameter,
     }
   }
 
+  if (event == CS104_CON_EVENT_CONNECTION_CLOSED) {
+    if (closedToken) {
+      // wait for running commands, queued commands are dropped
+      std::unique_lock<std::shared_mutex> const lock(closedToken->mutex);
+      closedToken->closed = true;
+    }
+    // remove selections
+    instance->cleanupSelections(connection);
+  }
+
+  instance->updateShaper(connection, event, ipAddrStr);
+
   if (debug) {
     end = std::chrono::steady_clock::now();
     DEBUG_PRINT_CONDITION(true, Debug::Server,
@@ -818,10 +1071,11 @@ bool Server::send(std::shared_ptr<Remote::Message::OutgoingMessage> message,
     message->setOriginatorAddress(param->originatorAddress);
   }
 
-  CS101_ASDU asdu = CS101_ASDU_create(
+  Remote::Message::ScratchAsdu const scratch(
       appLayerParameters, message->isSequence(),
       message->getCauseOfTransmission(), message->getOriginatorAddress(),
       message->getCommonAddress(), message->isTest(), message->isNegative());
+  CS101_ASDU asdu = scratch.get();
 
   // @todo add support for packed messages / multiple IOs in outgoing message
   CS101_ASDU_addInformationObject(asdu, message->getInformationObject());
@@ -830,14 +1084,12 @@ bool Server::send(std::shared_ptr<Remote::Message::OutgoingMessage> message,
   if (!connection || CS101_COT_PERIODIC == message->getCauseOfTransmission() ||
       CS101_COT_SPONTANEOUS == message->getCauseOfTransmission())
     // low priority
-    CS104_Slave_enqueueASDU(slave, asdu);
+    sendShaped(asdu);
   else {
     // high priority
-    IMasterConnection_sendASDU(connection, asdu);
+    sendShaped(asdu, connection);
   }
 
-  CS101_ASDU_destroy(asdu);
-
   if (debug) {
     end = std::chrono::steady_clock::now();
     DEBUG_PRINT_CONDITION(true, Debug::Server,
@@ -865,12 +1117,12 @@ void Server::sendActivationConfirmation(IMasterConnection connection,
     std::lock_guard<Module::GilAwareMutex> const st_lock(station_mutex);
     for (auto &s : stations) {
       CS101_ASDU_setCA(asdu, s->getCommonAddress());
-      IMasterConnection_sendASDU(connection, asdu);
+      sendConfirmation(connection, asdu);
     }
   } else {
     DEBUG_PRINT(Debug::Server,
                 "send_activation_confirmation] to requesting MTU");
-    IMasterConnection_sendASDU(connection, asdu);
+    sendConfirmation(connection, asdu);
   }
 }
 
@@ -886,13 +1138,274 @@ void Server::sendActivationTermination(IMasterConnection connection,
     std::lock_guard<Module::GilAwareMutex> const st_lock(station_mutex);
     for (auto &s : stations) {
       CS101_ASDU_setCA(asdu, s->getCommonAddress());
-      IMasterConnection_sendASDU(connection, asdu);
+      // terminations follow the held interrogation response
+      sendConfirmation(connection, asdu, true);
     }
   } else {
+    sendConfirmation(connection, asdu, true);
+  }
+}
+
+std::size_t Server::getFrameSize(CS101_ASDU asdu) const {
+  // APCI + type id + variable structure qualifier + COT + common address
+  return 6 + 2 + appLayerParameters->sizeOfCOT +
+         appLayerParameters->sizeOfCA + CS101_ASDU_getPayloadSize(asdu);
+}
+
+std::uint_fast64_t Server::getCoalesceKey(CS101_ASDU asdu) const {
+  if (CS101_COT_SPONTANEOUS != CS101_ASDU_getCOT(asdu) ||
+      CS101_ASDU_isSequence(asdu) ||
+      1 != CS101_ASDU_getNumberOfElements(asdu)) {
+    return 0;
+  }
+
+  // the information object address leads the payload, least significant
+  // byte first
+  std::uint_fast64_t ioa = 0;
+  std::uint8_t const *const payload = CS101_ASDU_getPayload(asdu);
+  for (int i = appLayerParameters->sizeOfIOA - 1; i >= 0; i--) {
+    ioa = (ioa << 8) | payload[i];
+  }
+  return (static_cast<std::uint_fast64_t>(CS101_ASDU_getTypeID(asdu)) << 56) |
+         (static_cast<std::uint_fast64_t>(CS101_ASDU_getCA(asdu)) << 24) | ioa;
+}
+
+void Server::sendShaped(CS101_ASDU asdu, IMasterConnection connection) {
+  if (!shaping.load()) {
+    if (connection) {
+      IMasterConnection_sendASDU(connection, asdu);
+    } else {
+      CS104_Slave_enqueueASDU(slave, asdu);
+    }
+    return;
+  }
+
+  auto const cot = CS101_ASDU_getCOT(asdu);
+  bool const low =
+      CS101_COT_PERIODIC == cot || CS101_COT_BACKGROUND_SCAN == cot;
+  std::size_t const size = getFrameSize(asdu);
+  std::uint_fast64_t const key = getCoalesceKey(asdu);
+
+  auto const shape = [asdu, size, low, key](IMasterConnection target,
+                                            const ShaperEntry &entry) {
+    std::lock_guard<std::mutex> const send_lock(entry.gate->mutex);
+    if (entry.gate->closed) {
+      return;
+    }
+    if (IMasterConnection_isReady(target) &&
+        entry.shaper->tryConsume(size, low)) {
+      IMasterConnection_sendASDU(target, asdu);
+    } else {
+      entry.shaper->hold(asdu, size, low, key);
+    }
+  };
+
+  // copy the entries, frames are sent after releasing shaper_mutex
+  std::vector<std::pair<IMasterConnection, ShaperEntry>> targets;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+    if (connection) {
+      auto it = shaperMap.find(connection);
+      if (it != shaperMap.end()) {
+        targets.emplace_back(*it);
+      }
+    } else {
+      // replaces the slave queue: copy to every active connection
+      for (auto const &entry : shaperMap) {
+        if (entry.second.active) {
+          targets.emplace_back(entry);
+        }
+      }
+    }
+  }
+
+  if (connection && targets.empty()) {
     IMasterConnection_sendASDU(connection, asdu);
+    return;
+  }
+  for (auto const &target : targets) {
+    shape(target.first, target.second);
+  }
+}
+
+void Server::sendConfirmation(IMasterConnection connection, CS101_ASDU asdu,
+                              const bool afterHeldFrames) {
+  if (!shaping.load()) {
+    IMasterConnection_sendASDU(connection, asdu);
+    return;
+  }
+
+  std::size_t const size = getFrameSize(asdu);
+
+  std::optional<ShaperEntry> entry;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+    auto it = shaperMap.find(connection);
+    if (it != shaperMap.end()) {
+      entry = it->second;
+    }
+  }
+  if (!entry.has_value()) {
+    IMasterConnection_sendASDU(connection, asdu);
+    return;
   }
+
+  std::lock_guard<std::mutex> const send_lock(entry->gate->mutex);
+  if (entry->gate->closed) {
+    return;
+  }
+  if (afterHeldFrames && entry->shaper->hasHeldFrames()) {
+    entry->shaper->hold(asdu, size, false);
+    return;
+  }
+  entry->shaper->charge(size);
+  IMasterConnection_sendASDU(connection, asdu);
+}
+
+void Server::releaseHeldFrames() {
+  std::vector<std::pair<IMasterConnection, ShaperEntry>> targets;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+    targets.assign(shaperMap.begin(), shaperMap.end());
+  }
+
+  for (auto const &target : targets) {
+    std::lock_guard<std::mutex> const send_lock(target.second.gate->mutex);
+    if (target.second.gate->closed) {
+      continue;
+    }
+    while (IMasterConnection_isReady(target.first)) {
+      CS101_ASDU const asdu = target.second.shaper->releaseNext();
+      if (!asdu) {
+        break;
+      }
+      IMasterConnection_sendASDU(target.first, asdu);
+      CS101_ASDU_destroy(asdu);
+    }
+  }
+}
+
+void Server::updateShaper(IMasterConnection connection,
+                          const CS104_PeerConnectionEvent event,
+                          const std::string &peer_address) {
+  if (event == CS104_CON_EVENT_CONNECTION_CLOSED) {
+    std::shared_ptr<SendGate> gate;
+    {
+      std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+      auto it = shaperMap.find(connection);
+      if (it == shaperMap.end()) {
+        return;
+      }
+      gate = it->second.gate;
+      // drop held frames
+      shaperMap.erase(it);
+    }
+    // wait for a running send, the connection object is released afterwards
+    std::lock_guard<std::mutex> const send_lock(gate->mutex);
+    gate->closed = true;
+    return;
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+
+  auto it = shaperMap.find(connection);
+  if (it == shaperMap.end()) {
+    // strip port from peer address
+    std::string const peer_ip =
+        peer_address.substr(0, peer_address.rfind(':'));
+    auto shaper = std::make_shared<Remote::BandwidthShaper>(peer_ip);
+    auto const limit = getBandwidthLimit(peer_ip);
+    shaper->configure(limit.bytesPerSecond, limit.burstBytes);
+    it = shaperMap
+             .emplace(connection,
+                      ShaperEntry{shaper, std::make_shared<SendGate>(), false})
+             .first;
+  }
+  it->second.active = (event == CS104_CON_EVENT_ACTIVATED);
+}
+
+Server::BandwidthLimit
+Server::getBandwidthLimit(const std::string &peer_ip) const {
+  auto it = bandwidthLimits.find(peer_ip);
+  if (it != bandwidthLimits.end()) {
+    return it->second;
+  }
+  return defaultBandwidthLimit;
+}
+
+void Server::setBandwidthLimit(const std::uint_fast32_t bytes_per_second,
+                               const std::uint_fast32_t burst_bytes,
+                               const std::optional<std::string> &peer_ip) {
+  if (peer_ip.has_value()) {
+    Assert_IPv4(peer_ip.value());
+  }
+
+  // the bucket must hold at least two ticks, since held frames are released
+  // once per tick
+  BandwidthLimit limit{bytes_per_second, burst_bytes};
+  if (0 == limit.burstBytes) {
+    limit.burstBytes = std::max<std::uint_fast32_t>(
+        bytes_per_second * tickRate_ms / 500, Remote::MAX_APDU_SIZE);
+  }
+
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+    if (peer_ip.has_value()) {
+      bandwidthLimits[peer_ip.value()] = limit;
+    } else {
+      defaultBandwidthLimit = limit;
+    }
+
+    for (auto &entry : shaperMap) {
+      auto const effective = getBandwidthLimit(entry.second.shaper->getIP());
+      entry.second.shaper->configure(effective.bytesPerSecond,
+                                     effective.burstBytes);
+    }
+
+    bool limited = defaultBandwidthLimit.bytesPerSecond > 0;
+    for (auto const &entry : bandwidthLimits) {
+      limited = limited || entry.second.bytesPerSecond > 0;
+    }
+    shaping.store(limited);
+  }
+
+  DEBUG_PRINT(Debug::Server,
+              "set_bandwidth_limit] " + std::to_string(bytes_per_second) +
+                  " B/s for " + peer_ip.value_or("all connections"));
 }
 
+py::list Server::getBandwidthStatistics() const {
+  std::vector<std::shared_ptr<Remote::BandwidthShaper>> shapers;
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(shaper_mutex);
+    for (auto const &entry : shaperMap) {
+      shapers.push_back(entry.second.shaper);
+    }
+  }
+
+  py::list result;
+  for (auto const &shaper : shapers) {
+    result.append(shaper->toDict());
+  }
+  return result;
+}
+
+void Server::addAdmissionRule(const std::string &cidr, const bool allow) {
+  admission.addRule(cidr, allow);
+}
+
+void Server::clearAdmissionRules() { admission.clearRules(); }
+
+void Server::setAdmissionLimits(const std::uint_fast32_t max_connections_per_ip,
+                                const double accept_rate,
+                                const double accept_rate_per_ip,
+                                const std::uint_fast32_t burst) {
+  admission.setLimits(max_connections_per_ip, accept_rate, accept_rate_per_ip,
+                      burst);
+}
+
+py::dict Server::getAdmissionStatistics() const { return admission.toDict(); }
+
 void Server::sendInventory(const CS101_CauseOfTransmission cot,
                            const uint_fast16_t commonAddress,
                            IMasterConnection connection) {
@@ -913,10 +1426,7 @@ void Server::sendInventory(const CS101_CauseOfTransmission cot,
         station->getCommonAddress() == commonAddress) {
 
       // group messages per station by type
-      std::map<IEC60870_5_TypeID,
-               std::map<uint_fast16_t,
-                        std::shared_ptr<Remote::Message::OutgoingMessage>>>
-          pointGroup;
+      PointMessageGroups pointGroup;
 
       for (const auto &point : station->getPoints()) {
         type = point->getType();
@@ -964,73 +1474,10 @@ void Server::sendInventory(const CS101_CauseOfTransmission cot,
       }
 
       // send grouped messages of current station
-      for (auto &group : pointGroup) {
+      if (!pointGroup.empty()) {
         empty = false;
-        bool const isSequence = false;
-        bool const isTest = false;
-        bool const isNegative = false;
-
-        /// indicator if an InformationObject was added to ASDU or not
-        bool added = false;
-
-        CS101_ASDU asdu =
-            CS101_ASDU_create(appLayerParameters, isSequence, cot, 0,
-                              station->getCommonAddress(), isTest, isNegative);
-        // std::stringstream c;
-        // c << "GRP-" << TypeID_toString(group.first) << ": ";
-        for (auto &message : group.second) {
-          // c << std::to_string(message.second->getInformationObjectAddress())
-          // << ",";
-          added = CS101_ASDU_addInformationObject(
-              asdu, message.second->getInformationObject());
-
-          // not added => ASDU packet size exceeded => send asdu and create a
-          // new one
-          if (!added) {
-            // send asdu
-            if (connection) {
-              IMasterConnection_sendASDU(connection, asdu);
-            } else {
-              CS104_Slave_enqueueASDU(slave, asdu);
-            }
-
-            // recreate new asdu
-            CS101_ASDU_destroy(asdu);
-            asdu = CS101_ASDU_create(appLayerParameters, isSequence, cot, 0,
-                                     station->getCommonAddress(), isTest,
-                                     isNegative);
-
-            // add message to new asdu
-            added = CS101_ASDU_addInformationObject(
-                asdu, message.second->getInformationObject());
-            if (!added) {
-              DEBUG_PRINT(Debug::Server,
-                          "Dropped message for inventory, "
-                          "cannot be added to new asdu: " +
-                              std::to_string(message.second->getIOA()));
-            }
-          }
-        }
-        // std::cout << c.str() << std::endl;
-
-        // if ASDU is not empty, send ASDU
-        if (added) {
-          if (connection) {
-            IMasterConnection_sendASDU(connection, asdu);
-          } else {
-            CS104_Slave_enqueueASDU(slave, asdu);
-          }
-        }
-
-        // @todo what about ASDU destruction ?!
-        // high priority, ASDU gets destroyed automatically
-        // low priority, destroy ASDU manually
-        CS101_ASDU_destroy(asdu);
-
-        // free messages
-        for (auto &message : group.second) {
-          message.second.reset();
-        }
+        sendPointGroups(cot, station->getCommonAddress(), pointGroup,
+                        connection);
       }
     }
   }
@@ -1052,62 +1499,309 @@ void Server::sendInventory(const CS101_CauseOfTransmission cot,
   }
 }
 
-std::shared_ptr<Remote::Message::IncomingMessage>
-Server::getValidMessage(IMasterConnection connection, CS101_ASDU asdu) {
-  try {
-    auto message =
-        Remote::Message::IncomingMessage::create(asdu, appLayerParameters);
-
-    // @todo enabled advanced COT check
-    /*
-    if (!message->isValidCauseOfTransmission()) {
-        DEBUG_PRINT(Debug::Server, "Server.getValidMessage] Unknown cause of
-    transmission " +
-    std::string(CS101_CauseOfTransmission_toString(message->getCauseOfTransmission())));
-
-        if (message->requireConfirmation()) {
-            sendActivationConfirmation(connection, asdu, true);
+void Server::sendPointGroups(const CS101_CauseOfTransmission cot,
+                             const uint_fast16_t commonAddress,
+                             PointMessageGroups &pointGroup,
+                             IMasterConnection connection) {
+  for (auto &group : pointGroup) {
+    bool const isSequence = false;
+    bool const isTest = false;
+    bool const isNegative = false;
+
+    /// indicator if an InformationObject was added to ASDU or not
+    bool added = false;
+
+    Remote::Message::ScratchAsdu scratch(appLayerParameters, isSequence, cot, 0,
+                                         commonAddress, isTest, isNegative);
+    CS101_ASDU asdu = scratch.get();
+    // std::stringstream c;
+    // c << "GRP-" << TypeID_toString(group.first) << ": ";
+    for (auto &message : group.second) {
+      // c << std::to_string(message.second->getInformationObjectAddress())
+      // << ",";
+      added = CS101_ASDU_addInformationObject(
+          asdu, message.second->getInformationObject());
+
+      // not added => ASDU packet size exceeded => send asdu and create a new
+      // one
+      if (!added) {
+        // send asdu
+        sendShaped(asdu, connection);
+
+        // reuse the buffer for the next asdu
+        scratch.reset();
+        asdu = scratch.get();
+
+        // add message to new asdu
+        added = CS101_ASDU_addInformationObject(
+            asdu, message.second->getInformationObject());
+        if (!added) {
+          DEBUG_PRINT(Debug::Server,
+                      "Dropped message for inventory, "
+                      "cannot be added to new asdu: " +
+                          std::to_string(message.second->getIOA()));
+        }
+      }
+    }
+    // std::cout << c.str() << std::endl;
+
+    // if ASDU is not empty, send ASDU
+    if (added) {
+      sendShaped(asdu, connection);
+    }
+
+    // the asdu was copied by lib60870 while sending, the buffer is
+    // released at the end of this scope
+
+    // free messages
+    for (auto &message : group.second) {
+      message.second.reset();
+    }
+  }
+}
+
+void Server::enableBackgroundScan(const std::uint_fast32_t points_per_second) {
+  backgroundScan.enable(points_per_second);
+  DEBUG_PRINT(Debug::Server, "enable_background_scan] Rate " +
+                                 std::to_string(points_per_second) + "/s");
+}
+
+void Server::disableBackgroundScan() {
+  backgroundScan.disable();
+  DEBUG_PRINT(Debug::Server, "disable_background_scan] Stopped");
+}
+
+void Server::enableLoopback(const std::uint_fast32_t latency_ms,
+                            const std::uint_fast64_t bandwidth) {
+  Remote::Loopback::enable(ip, port, latency_ms, bandwidth);
+  loopback.store(true);
+  DEBUG_PRINT(Debug::Server, "enable_loopback] Latency " +
+                                 std::to_string(latency_ms) + "ms, bandwidth " +
+                                 std::to_string(bandwidth) + "B/s");
+}
+
+void Server::disableLoopback() {
+  if (loopback.exchange(false)) {
+    Remote::Loopback::disable(ip, port);
+    DEBUG_PRINT(Debug::Server, "disable_loopback] Stopped");
+  }
+}
+
+bool Server::isLoopback() const { return loopback.load(); }
+
+py::dict Server::getBackgroundScanStatistics() const {
+  return backgroundScan.toDict();
+}
+
+bool Server::isSendWindowAvailable() {
+  std::lock_guard<Module::GilAwareMutex> const lock(connection_mutex);
+
+  for (const auto &connection : connectionMap) {
+    // only active connections receive spontaneous and background messages
+    if (connection.second && !IMasterConnection_isReady(connection.first)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Server::sendCounterFreezes() {
+  if (!enabled.load())
+    return;
+
+  auto const now = std::chrono::system_clock::now();
+  for (const auto &station : getStations()) {
+    auto &schedule = station->getCounterFreeze();
+    auto const frozen_at = schedule.takeDue(now);
+    if (!frozen_at.has_value())
+      continue;
+
+    auto const begin = std::chrono::steady_clock::now();
+    auto const frozen =
+        station->freezeCounters(schedule.isReset(), frozen_at.value());
+    auto const snapshot = std::chrono::steady_clock::now() - begin;
+
+    // frozen values are lost for the remote side if no connection is active
+    std::optional<std::chrono::steady_clock::duration> transmission{};
+    if (frozen.empty()) {
+      transmission = std::chrono::steady_clock::duration::zero();
+    } else if (hasActiveConnections()) {
+      auto const sendBegin = std::chrono::steady_clock::now();
+      PointMessageGroups pointGroup;
+      for (const auto &counter : frozen) {
+        try {
+          auto message = Remote::Message::PointMessage::create(counter.first,
+                                                               counter.second);
+          message->setCauseOfTransmission(CS101_COT_SPONTANEOUS);
+          pointGroup[counter.first->getType()]
+                    [counter.first->getInformationObjectAddress()] = message;
+        } catch (const std::exception &e) {
+          DEBUG_PRINT(Debug::Server, "Invalid point message for counter "
+                                     "freeze: " +
+                                         std::string(e.what()));
         }
+      }
+      sendPointGroups(CS101_COT_SPONTANEOUS, station->getCommonAddress(),
+                      pointGroup);
+      transmission = std::chrono::steady_clock::now() - sendBegin;
+    }
+    schedule.record(frozen_at.value(), frozen.size(), snapshot, transmission);
+
+    DEBUG_PRINT(Debug::Server,
+                "counter_freeze] CA " +
+                    std::to_string(station->getCommonAddress()) + " froze " +
+                    std::to_string(frozen.size()) + " counters");
+  }
+}
+
+void Server::sendBackgroundScan() {
+  if (!enabled.load() || !backgroundScan.isEnabled() ||
+      !hasActiveConnections())
+    return;
+
+  std::size_t budget = 0;
+  if (0 == backgroundScan.getRate()) {
+    if (!isSendWindowAvailable()) {
+      backgroundScan.recordDeferred();
+      return;
+    }
+    budget = Remote::BACKGROUND_SCAN_IDLE_BATCH;
+  } else {
+    budget = backgroundScan.takeBudget();
+  }
+  if (0 == budget)
+    return;
+
+  bool const debug = DEBUG_TEST(Debug::Server);
+  std::chrono::steady_clock::time_point begin, end;
+  if (debug) {
+    begin = std::chrono::steady_clock::now();
+  }
+
+  auto const stations = getStations();
+  if (stations.empty())
+    return;
+
+  auto cursor = backgroundScan.getCursor();
+  std::size_t sent = 0;
+
+  while (budget > 0) {
+    if (cursor.station >= stations.size()) {
+      // all stations scanned, start the next cycle
+      backgroundScan.advance(cursor, sent);
+      backgroundScan.completeCycle(cursor);
+      // the next cycle starts with the next tick, keep the rest of the budget
+      backgroundScan.refundBudget(budget);
+      cursor = Remote::BackgroundScan::Cursor{0, 0, cursor.generation};
+      sent = 0;
+      break;
+    }
+
+    const auto &station = stations[cursor.station];
+    std::size_t const requested = budget;
+    auto const points =
+        station->scanPoints(cursor.informationObjectAddress, requested);
 
-        onUnexpectedMessage(connection, message.get(), INVALID_COT);
+    PointMessageGroups pointGroup;
+    for (const auto &point : points) {
+      cursor.informationObjectAddress =
+          point->getInformationObjectAddress() + 1;
+
+      // only monitoring points
+      IEC60870_5_TypeID const type = point->getType();
+      if (type > 41)
+        continue;
+
+      point->onBeforeRead();
+      try {
+        auto message = Remote::Message::PointMessage::create(point);
+        message->setCauseOfTransmission(CS101_COT_BACKGROUND_SCAN);
+        pointGroup[type][point->getInformationObjectAddress()] = message;
+        budget--;
+        sent++;
+      } catch (const std::exception &e) {
+        DEBUG_PRINT(Debug::Server,
+                    "Invalid point message for background scan: " +
+                        std::string(e.what()));
+      }
+    }
+
+    if (!pointGroup.empty()) {
+      sendPointGroups(CS101_COT_BACKGROUND_SCAN, station->getCommonAddress(),
+                      pointGroup);
+    }
+
+    // station completed, continue with the next one
+    if (points.size() < requested) {
+      cursor.station++;
+      cursor.informationObjectAddress = 0;
+    }
+  }
+  backgroundScan.advance(cursor, sent);
+
+  if (debug) {
+    end = std::chrono::steady_clock::now();
+    DEBUG_PRINT_CONDITION(true, Debug::Server,
+                          "background_scan] TOTAL " + TICTOC(begin, end));
+  }
+}
 
-        return {nullptr};
-    }*/
+std::shared_ptr<Remote::Message::IncomingMessage>
+Server::getValidMessage(IMasterConnection connection, CS101_ASDU asdu) {
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, appLayerParameters);
 
-    // test & message ip/ca mismatch
-    if (!hasStation(message->getCommonAddress())) {
+  if (!message->isValid()) {
+    rejectedMessages[message->getRejectCause()]++;
+    DEBUG_PRINT(Debug::Server,
+                "get_valid_message] Invalid message format: " +
+                    UnexpectedMessageCause_toString(message->getRejectCause()));
+    return {nullptr};
+  }
 
-      DEBUG_PRINT(Debug::Server,
-                  "get_valid_message] Unknown commonAddress " +
-                      std::to_string(message->getCommonAddress()));
+  // @todo enabled advanced COT check
+  /*
+  if (!message->isValidCauseOfTransmission()) {
+      DEBUG_PRINT(Debug::Server, "Server.getValidMessage] Unknown cause of
+  transmission " +
+  std::string(CS101_CauseOfTransmission_toString(message->getCauseOfTransmission())));
 
       if (message->requireConfirmation()) {
-        sendActivationConfirmation(connection, asdu, true);
+          sendActivationConfirmation(connection, asdu, true);
       }
 
-      onUnexpectedMessage(connection, std::move(message), UNKNOWN_CA);
+      onUnexpectedMessage(connection, message.get(), INVALID_COT);
+
       return {nullptr};
+  }*/
+
+  // test & message ip/ca mismatch
+  if (!hasStation(message->getCommonAddress())) {
+
+    DEBUG_PRINT(Debug::Server, "get_valid_message] Unknown commonAddress " +
+                                   std::to_string(message->getCommonAddress()));
+
+    if (message->requireConfirmation()) {
+      sendActivationConfirmation(connection, asdu, true);
     }
 
-    return std::move(message);
-  } catch (const std::exception &e) {
-    DEBUG_PRINT(Debug::Server, "get_valid_message] Invalid message format: " +
-                                   std::string(e.what()));
+    onUnexpectedMessage(connection, std::move(message), UNKNOWN_CA);
+    return {nullptr};
   }
-  return {nullptr};
+
+  return message;
 }
 
 void Server::rawMessageHandler(void *parameter, IMasterConnection connection,
                                uint_fast8_t *msg, int msgSize, bool sent) {
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Ignore raw message in shutdown");
     return;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
+  instance->onRawFrame(msg, msgSize, sent);
   if (sent) {
     instance->onSendRaw(msg, msgSize);
   } else {
@@ -1161,14 +1855,12 @@ bool Server::interrogationHandler(void *parameter, IMasterConnection connection,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Reject interrogation command in shutdown");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   if (auto message = instance->getValidMessage(connection, asdu)) {
 
@@ -1218,15 +1910,13 @@ bool Server::counterInterrogationHandler(void *parameter,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server,
                 "Reject counter interrogation command in shutdown");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   if (auto message = instance->getValidMessage(connection, asdu)) {
 
@@ -1275,14 +1965,12 @@ bool Server::readHandler(void *parameter, IMasterConnection connection,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Reject read command in shutdown");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   if (auto message = instance->getValidMessage(connection, asdu)) {
 
@@ -1355,20 +2043,19 @@ bool Server::asduHandler(void *parameter, IMasterConnection connection,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Server> instance{};
-
-  try {
-    instance = static_cast<Server *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance = static_cast<Server *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Server, "Reject asdu in shutdown");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   // message with more than one object is not allowed for command type ids
   if (auto message = instance->getValidMessage(connection, asdu)) {
 
     CommandResponseState responseState = RESPONSE_STATE_FAILURE;
     UnexpectedMessageCause cause = NO_ERROR_CAUSE;
+    std::optional<Selection> executed;
 
     // new clockSyncHandler
     if (message->getType() == C_CS_NA_1) {
@@ -1389,48 +2076,14 @@ bool Server::asduHandler(void *parameter, IMasterConnection connection,
         if (auto station = instance->getStation(message->getCommonAddress())) {
           if (auto point = station->getPoint(message->getIOA())) {
             if (point->getType() == message->getType()) {
-
-              if (message->isSelectCommand()) {
-                if (SELECT_AND_EXECUTE_COMMAND == point->getCommandMode()) {
-                  responseState = instance->select(connection, message)
-                                      ? RESPONSE_STATE_SUCCESS
-                                      : RESPONSE_STATE_FAILURE;
-                } else {
-                  std::cerr << "[c104.Point] Failed to select point in DIRECT "
-                               "command mode"
-                            << std::endl;
-                  responseState = RESPONSE_STATE_FAILURE;
-                }
+              if (instance->dispatchCommand(connection, message, station,
+                                            point)) {
+                // confirmed and terminated by the worker of this point
+                responseState = RESPONSE_STATE_NONE;
               } else {
-                responseState = instance->execute(connection, message, point);
-
-                if (responseState == RESPONSE_STATE_SUCCESS &&
-                    point->getRelatedInformationObjectAutoReturn()) {
-                  const auto related_ioa =
-                      point->getRelatedInformationObjectAddress();
-                  // send related point info in case of auto return
-                  if (related_ioa.has_value()) {
-                    auto related_point = station->getPoint(related_ioa.value());
-                    instance->scheduleTask(
-                        [instance, related_point]() {
-                          try {
-                            instance->transmit(related_point,
-                                               CS101_COT_RETURN_INFO_REMOTE);
-                          } catch (const std::exception &e) {
-                            std::cerr
-                                << "[c104.Server] asdu_handler] Auto transmit "
-                                   "related point failed for "
-                                << TypeID_toString(related_point->getType())
-                                << " at IOA "
-                                << related_point->getInformationObjectAddress()
-                                << ": " << e.what() << std::endl;
-                          }
-                        },
-                        2);
-                  }
-                }
-
-              } // else: message->isSelectCommand()
+                responseState = instance->executeCommand(
+                    connection, message, station, point, executed);
+              }
 
             } else {
               cause = MISMATCHED_TYPE_ID;
@@ -1454,6 +2107,11 @@ bool Server::asduHandler(void *parameter, IMasterConnection connection,
           connection, asdu, (responseState == RESPONSE_STATE_FAILURE));
     }
 
+    // terminate the executed selection after the confirmation
+    if (executed.has_value()) {
+      instance->unselect(executed.value());
+    }
+
     // report error cause
     if (cause != NO_ERROR_CAUSE) {
       instance->onUnexpectedMessage(connection, message, cause);
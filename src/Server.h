@@ -32,22 +32,41 @@
 #ifndef C104_SERVER_H
 #define C104_SERVER_H
 
+#include <shared_mutex>
+
 #include "remote/Helper.h"
 #include "types.h"
 
 #include "module/Callback.h"
 #include "module/GilAwareMutex.h"
 #include "object/Station.h"
+#include "remote/BackgroundScan.h"
+#include "remote/AdmissionControl.h"
+#include "remote/BandwidthShaper.h"
+#include "remote/CommandExecutor.h"
+#include "remote/RawFrameTap.h"
 #include "remote/TransportSecurity.h"
 #include "remote/message/IncomingMessage.h"
 
+/// @brief maximum information object size of a selectable command: IOA,
+/// setpoint value, qualifier and CP56Time2a
+constexpr std::size_t SELECTION_MAX_PAYLOAD_SIZE = 16;
+
+/**
+ * @brief selected command point, keeps the header fields and the encoded
+ * information object of the select command to build the activation
+ * termination on demand
+ */
 struct Selection {
-  CS101_ASDU asdu;
+  IEC60870_5_TypeID type;
   uint8_t oa;
   uint16_t ca;
   uint32_t ioa;
+  bool test;
   IMasterConnection connection;
   std::chrono::steady_clock::time_point created;
+  std::uint_fast8_t payloadSize;
+  std::array<std::uint8_t, SELECTION_MAX_PAYLOAD_SIZE> payload;
 };
 
 /**
@@ -195,6 +214,37 @@ public:
 
   void onSendRaw(unsigned char *msg, unsigned char msgSize);
 
+  /**
+   * @brief set python callback that receives raw frames in batches instead of
+   * one call per frame
+   * @param callable python callback or None
+   * @param max_frames deliver a batch after this number of frames
+   * @param max_delay_ms deliver a batch if its oldest frame is older, checked
+   * on every frame and every tick
+   * @throws std::invalid_argument if callable signature does not match or
+   * max_frames is 0
+   */
+  void setOnRawBatchCallback(py::object &callable, std::size_t max_frames,
+                             std::uint_fast32_t max_delay_ms);
+
+  /**
+   * @brief add a frame to the raw batch, schedule delivery if a batch is ready
+   */
+  void onRawFrame(unsigned char *msg, unsigned char msgSize, bool sent);
+
+  /**
+   * @brief deliver complete batches to the raw batch callback
+   * @param flush also deliver an incomplete batch
+   */
+  void deliverRawBatches(bool flush = false);
+
+  /**
+   * @brief Getter for raw batch statistics
+   * @return dict with frames, batches, pending_batches, pending_bytes and
+   * dropped_frames
+   */
+  py::dict getRawBatchStatistics() const;
+
   /**
    * @brief set python callback that will be executed on incoming clock sync
    * command
@@ -217,6 +267,13 @@ public:
                       std::shared_ptr<Remote::Message::IncomingMessage> message,
                       UnexpectedMessageCause cause);
 
+  /**
+   * @brief Getter for the number of rejected incoming messages per cause
+   * @return map of counters since server creation
+   */
+  std::map<UnexpectedMessageCause, std::uint_fast32_t>
+  getRejectedMessageCounts() const;
+
   /**
    * @brief set python callback that will be executed on incoming connection
    * requests
@@ -226,6 +283,13 @@ public:
 
   std::uint_fast16_t getTickRate_ms() const;
 
+  /**
+   * @brief Getter for the python interpreter that created this server, its
+   * callbacks are executed in this interpreter
+   * @return interpreter or nullptr for the main interpreter
+   */
+  PyInterpreterState *getInterpreter() const { return interpreter; }
+
   /**
    * @brief transmit a datapoint related message to a remote client
    * @param point datapoint that should be send via server
@@ -264,6 +328,123 @@ public:
       const CS101_CauseOfTransmission cot,
       const uint_fast16_t commonAddress = IEC60870_GLOBAL_COMMON_ADDRESS,
       IMasterConnection connection = nullptr);
+
+  /**
+   * @brief Start cycling through all monitoring points and send them with
+   * cause of transmission BACKGROUND_SCAN in packed ASDUs
+   * @param points_per_second send rate, 0 = send a batch per tick only while
+   * the send windows of all active connections are available
+   */
+  void enableBackgroundScan(std::uint_fast32_t points_per_second = 0);
+
+  /**
+   * @brief Stop the background scan
+   */
+  void disableBackgroundScan();
+
+  /**
+   * @brief Getter for background scan configuration and cycle statistics
+   * @return dict with enabled, rate, cycles, points, deferred, cycle_points,
+   * last_cycle_ms and current_cycle_ms
+   */
+  py::dict getBackgroundScanStatistics() const;
+
+  /**
+   * @brief Execute commands in a worker pool keyed by common address and
+   * information object address, commands of different points run in parallel
+   * while commands of the same point keep their order
+   * @param workers number of worker threads, 0 = number of hardware threads
+   */
+  void enableCommandExecutor(std::uint_fast32_t workers = 0);
+
+  /**
+   * @brief Execute pending commands and handle new commands in the connection
+   * threads again
+   */
+  void disableCommandExecutor();
+
+  /**
+   * @brief Getter for command executor statistics
+   * @return dict, see Remote::CommandExecutor::toDict
+   */
+  py::dict getCommandExecutorStatistics() const;
+
+  /**
+   * @brief Limit the outgoing bandwidth per client connection via token
+   * bucket, confirmations are never held back
+   * @param bytes_per_second limit in bytes per second, 0 = unlimited
+   * @param burst_bytes bucket size in bytes, 0 = two ticks of traffic
+   * @param peer_ip limit connections from this ip only, nullopt = default for
+   * all connections without own limit
+   * @throws std::invalid_argument if ip is invalid
+   */
+  void setBandwidthLimit(std::uint_fast32_t bytes_per_second,
+                         std::uint_fast32_t burst_bytes = 0,
+                         const std::optional<std::string> &peer_ip =
+                             std::nullopt);
+
+  /**
+   * @brief Getter for shaping statistics of all open connections
+   * @return list of dicts, see Remote::BandwidthShaper::toDict
+   */
+  py::list getBandwidthStatistics() const;
+
+  /**
+   * @brief Allow or deny connection requests from a network, evaluated
+   * natively before the on_connect callback
+   * @param cidr IPv4 address with optional prefix length
+   * @param allow accept or reject matching peers
+   * @throws std::invalid_argument if cidr is invalid
+   */
+  void addAdmissionRule(const std::string &cidr, bool allow = true);
+
+  /**
+   * @brief Remove all allowed and denied networks
+   */
+  void clearAdmissionRules();
+
+  /**
+   * @brief Limit open connections per peer and the rate of accepted
+   * connection requests
+   * @param max_connections_per_ip open connections per peer, 0 = unlimited
+   * @param accept_rate accepted requests per second, 0 = unlimited
+   * @param accept_rate_per_ip accepted requests per second and peer, 0 =
+   * unlimited
+   * @param burst number of requests accepted at once
+   * @throws std::invalid_argument if a rate is negative
+   */
+  void setAdmissionLimits(std::uint_fast32_t max_connections_per_ip = 0,
+                          double accept_rate = 0,
+                          double accept_rate_per_ip = 0,
+                          std::uint_fast32_t burst = 5);
+
+  /**
+   * @brief Getter for admission rules, limits and decision counters
+   * @return dict, see Remote::AdmissionControl::toDict
+   */
+  py::dict getAdmissionStatistics() const;
+
+  /**
+   * @brief Serve this endpoint in-process, clients of the same process that
+   * connect to it exchange frames via memory instead of the network stack
+   * @param latency_ms one way delay per frame, 0 = immediate
+   * @param bandwidth bytes per second in each direction, 0 = unlimited
+   * @throws std::runtime_error if the build does not support loopback
+   * @note takes effect on the next start, the link parameters apply to new
+   * connections
+   */
+  void enableLoopback(std::uint_fast32_t latency_ms = 0,
+                      std::uint_fast64_t bandwidth = 0);
+
+  /**
+   * @brief Serve this endpoint via TCP again after the next start
+   */
+  void disableLoopback();
+
+  /**
+   * @brief test if this endpoint is served in-process
+   */
+  bool isLoopback() const;
   /*
       void sendCounterInterrogationResponse(CS101_CauseOfTransmission cot,
      uint_fast16_t commonAddress = IEC60870_GLOBAL_COMMON_ADDRESS,
@@ -279,6 +460,97 @@ public:
 private:
   void scheduleDataPointTimer();
 
+  /// @brief point messages of a station grouped by type and information
+  /// object address
+  using PointMessageGroups = std::map<
+      IEC60870_5_TypeID,
+      std::map<uint_fast16_t,
+               std::shared_ptr<Remote::Message::OutgoingMessage>>>;
+
+  /**
+   * @brief Send point messages of a station in as few ASDUs as possible
+   * @param cot cause of transmission of all ASDUs
+   * @param commonAddress common address of the station
+   * @param pointGroup messages grouped by type, released after sending
+   * @param connection send to a single client identified via internal
+   * connection object
+   */
+  void sendPointGroups(CS101_CauseOfTransmission cot,
+                       uint_fast16_t commonAddress,
+                       PointMessageGroups &pointGroup,
+                       IMasterConnection connection = nullptr);
+
+  /**
+   * @brief Getter for the length of an ASDU on the wire including APCI
+   */
+  std::size_t getFrameSize(CS101_ASDU asdu) const;
+
+  /**
+   * @brief Getter for a key of the point of a spontaneous single object ASDU,
+   * used to coalesce held frames under memory pressure
+   * @return type, common address and information object address or 0 if the
+   * ASDU cannot be coalesced
+   */
+  std::uint_fast64_t getCoalesceKey(CS101_ASDU asdu) const;
+
+  /**
+   * @brief Send data to one or all active connections, respecting bandwidth
+   * limits
+   * @param asdu frame to send, the caller keeps ownership
+   * @param connection single receiver or nullptr for all active connections
+   */
+  void sendShaped(CS101_ASDU asdu, IMasterConnection connection = nullptr);
+
+  /**
+   * @brief Send a confirmation without delay and charge it to the bandwidth
+   * limit of the connection
+   * @param connection receiver
+   * @param asdu frame to send, the caller keeps ownership
+   * @param afterHeldFrames keep the order behind held normal priority frames,
+   * used for activation terminations
+   */
+  void sendConfirmation(IMasterConnection connection, CS101_ASDU asdu,
+                        bool afterHeldFrames = false);
+
+  /**
+   * @brief Send held frames of all connections, called every tick
+   */
+  void releaseHeldFrames();
+
+  /**
+   * @brief Create, update or remove the shaper of a connection
+   */
+  void updateShaper(IMasterConnection connection,
+                    CS104_PeerConnectionEvent event,
+                    const std::string &peer_address);
+
+  struct BandwidthLimit {
+    std::uint_fast32_t bytesPerSecond{0};
+    std::uint_fast32_t burstBytes{Remote::MAX_APDU_SIZE};
+  };
+
+  /**
+   * @brief Getter for the limit of a peer, the lock must be held
+   */
+  BandwidthLimit getBandwidthLimit(const std::string &peer_ip) const;
+
+  /**
+   * @brief Test if no active connection has a full send window
+   */
+  bool isSendWindowAvailable();
+
+  /**
+   * @brief Send the next slice of the background scan, called every tick
+   */
+  void sendBackgroundScan();
+
+  /**
+   * @brief Freeze the integrated totals of all stations with a due freeze
+   * schedule and send the frozen values as packed spontaneous messages, called
+   * every tick
+   */
+  void sendCounterFreezes();
+
   /**
    * @brief Create a new remote connection handler instance that acts as a
    * server
@@ -295,21 +567,55 @@ private:
          std::uint_fast8_t max_open_connections,
          std::shared_ptr<Remote::TransportSecurity> transport_security);
 
+  /**
+   * @brief remove expired selections and terminate them
+   */
   void cleanupSelections();
 
+  /**
+   * @brief remove all selections of a closed connection
+   */
   void cleanupSelections(IMasterConnection connection);
 
-  void cleanupSelection(uint16_t ca, uint32_t ioa);
-
   bool select(IMasterConnection connection,
               std::shared_ptr<Remote::Message::IncomingMessage> message);
 
+  /**
+   * @brief send the activation termination of a removed selection
+   */
   void unselect(const Selection &selection);
 
+  /**
+   * @brief execute a command, a selection of the point is removed and returned
+   * to be terminated after the activation confirmation
+   */
   CommandResponseState
   execute(IMasterConnection connection,
           std::shared_ptr<Remote::Message::IncomingMessage> message,
-          std::shared_ptr<Object::DataPoint> point);
+          std::shared_ptr<Object::DataPoint> point,
+          std::optional<Selection> &executed);
+
+  /**
+   * @brief select or execute a command of a point and schedule the auto return
+   * of the related point
+   */
+  CommandResponseState
+  executeCommand(IMasterConnection connection,
+                 std::shared_ptr<Remote::Message::IncomingMessage> message,
+                 const std::shared_ptr<Object::Station> &station,
+                 std::shared_ptr<Object::DataPoint> point,
+                 std::optional<Selection> &executed);
+
+  /**
+   * @brief queue a command to the command executor, the worker confirms the
+   * activation and terminates an executed selection
+   * @return false if the command executor is disabled
+   */
+  bool
+  dispatchCommand(IMasterConnection connection,
+                  std::shared_ptr<Remote::Message::IncomingMessage> message,
+                  std::shared_ptr<Object::Station> station,
+                  std::shared_ptr<Object::DataPoint> point);
 
   /// @brief IP address of remote server
   const std::string ip{};
@@ -320,6 +626,9 @@ private:
   /// @brief minimum interval between to periodic broadcasts in milliseconds
   const std::uint_fast16_t tickRate_ms{100};
 
+  /// @brief python interpreter owning this instance, nullptr for main
+  PyInterpreterState *const interpreter{Module::Interpreter_current()};
+
   /// @brief selection init timestamp, to test against timeout
   const std::chrono::milliseconds selectTimeout_ms{100};
 
@@ -350,7 +659,7 @@ private:
   /// @brief map of all connections to store connection state
   std::map<IMasterConnection, bool> connectionMap{};
 
-  /// @brief MUTEX Lock to access selectionVEcotr
+  /// @brief MUTEX Lock to access selectionVector, never held while sending
   mutable Module::GilAwareMutex selection_mutex{"Server::selection_mutex"};
 
   /// @brief vector of all selections
@@ -365,6 +674,77 @@ private:
   /// @brief maximum number of connections (0-255), 0 = no limit
   std::atomic_uint_fast8_t maxOpenConnections{0};
 
+  /// @brief number of rejected incoming messages per cause
+  RejectionCounters rejectedMessages{};
+
+  /// @brief endpoint is registered for the in-process loopback transport
+  std::atomic_bool loopback{false};
+
+  /// @brief pacing and progress of the background scan
+  Remote::BackgroundScan backgroundScan{};
+
+  /// @brief serializes frames sent to a shaped connection
+  struct SendGate {
+    /// @brief held while deciding and sending a frame, may block on socket
+    /// I/O and is therefore no GilAwareMutex
+    std::mutex mutex;
+
+    /// @brief the connection was closed and must not be used anymore
+    bool closed{false};
+  };
+
+  struct ShaperEntry {
+    std::shared_ptr<Remote::BandwidthShaper> shaper;
+
+    std::shared_ptr<SendGate> gate;
+
+    /// @brief connection receives broadcasts (activated and not muted)
+    bool active;
+  };
+
+  /// @brief MUTEX Lock to access shaperMap and bandwidth limits, never held
+  /// while sending
+  mutable Module::GilAwareMutex shaper_mutex{"Server::shaper_mutex"};
+
+  /// @brief bandwidth shaper per open connection
+  std::map<IMasterConnection, ShaperEntry> shaperMap{};
+
+  /// @brief limit for connections without an ip specific limit
+  BandwidthLimit defaultBandwidthLimit{};
+
+  /// @brief limits per peer ip
+  std::map<std::string, BandwidthLimit> bandwidthLimits{};
+
+  /// @brief at least one limit is configured, else frames bypass the shapers
+  std::atomic_bool shaping{false};
+
+  /// @brief native accept or reject decision for connection requests
+  Remote::AdmissionControl admission{};
+
+  /// @brief optional worker pool for command handling
+  Remote::CommandExecutor commandExecutor{};
+
+  /// @brief the command executor is enabled and restarted with the server
+  std::atomic_bool commandExecutorEnabled{false};
+
+  /// @brief configured number of command executor workers
+  std::atomic_uint_fast32_t commandExecutorWorkers{0};
+
+  /// @brief liveness of a connection for queued command jobs
+  struct ConnectionToken {
+    /// @brief shared by running jobs of the connection, taken exclusively to
+    /// close the connection
+    std::shared_mutex mutex;
+
+    /// @brief the connection was closed and must not be used anymore
+    bool closed{false};
+  };
+
+  /// @brief liveness tokens of connections with dispatched commands, guarded
+  /// by connection_mutex
+  std::map<IMasterConnection, std::shared_ptr<ConnectionToken>>
+      connectionTokens{};
+
   std::priority_queue<Task> tasks;
 
   /// @brief server thread to execute periodic transmission
@@ -385,6 +765,14 @@ private:
   Module::Callback<void> py_onSendRaw{
       "Server.on_send_raw", "(server: c104.Server, data: bytes) -> None"};
 
+  /// @brief python callback function pointer
+  Module::Callback<void> py_onRawBatch{
+      "Server.on_raw_batch",
+      "(server: c104.Server, batch: c104.RawFrameBatch) -> None"};
+
+  /// @brief collects raw frames for py_onRawBatch
+  Remote::RawFrameTap rawTap{};
+
   /// @brief python callback function pointer
   Module::Callback<CommandResponseState> py_onClockSync{
       "Server.on_clock_sync", "(server: c104.Server, ip: str, date_time: "
@@ -431,10 +819,11 @@ public:
 
   /**
    * @brief validate incoming ASDU, send negative response if invalid receiver
-   * station or return ASDU wrapped in a IncomingMessage facade otherwise
+   * station or return ASDU wrapped in a IncomingMessage facade otherwise,
+   * malformed packets are counted and dropped without throwing
    * @param connection reference to internal connection object
    * @param asdu incoming ASDU packet
-   * @return
+   * @return message or nullptr if rejected
    */
   std::shared_ptr<Remote::Message::IncomingMessage>
   getValidMessage(IMasterConnection connection, CS101_ASDU asdu);
@@ -372,6 +372,8 @@ UnexpectedMessageCause_toString(const UnexpectedMessageCause &cause) {
     return "MISMATCHED_TYPE_ID";
   case UNIMPLEMENTED_GROUP:
     return "UNIMPLEMENTED_GROUP";
+  case INVALID_STRUCTURE:
+    return "INVALID_STRUCTURE";
   default:
     return "UNKNOWN";
   }
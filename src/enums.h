@@ -32,6 +32,7 @@
 #ifndef C104_ENUMS_H
 #define C104_ENUMS_H
 
+#include <cstddef>
 #include <string>
 #include <type_traits>
 
@@ -228,10 +229,15 @@ enum UnexpectedMessageCause {
   INVALID_COT,
   INVALID_TYPE_ID,
   MISMATCHED_TYPE_ID,
-  UNIMPLEMENTED_GROUP
+  UNIMPLEMENTED_GROUP,
+  INVALID_STRUCTURE
 };
 std::string UnexpectedMessageCause_toString(const UnexpectedMessageCause &mode);
 
+/// @brief number of UnexpectedMessageCause values, used to size per cause
+/// counters
+constexpr std::size_t UNEXPECTED_MESSAGE_CAUSE_COUNT = INVALID_STRUCTURE + 1;
+
 enum class Debug : uint8_t {
   None = 0,
   Server = 0x01,
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file main_analyzer.cpp
+ * @brief offline analyzer for captured IEC 60870-5-104 traffic
+ *
+ * @package iec104-python
+ * @namespace
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "remote/CaptureAnalyzer.h"
+#include <pybind11/embed.h> // everything needed for embedding
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace py = pybind11;
+
+/**
+ * @brief read-only memory mapping of a complete file, the operating system
+ * pages the file in while it is processed
+ */
+class MappedFile {
+public:
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @throws std::runtime_error if the file cannot be mapped
+   */
+  explicit MappedFile(const std::string &path) {
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw std::runtime_error("Cannot open " + path);
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (length > 0) {
+      mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        begin = static_cast<const std::uint8_t *>(
+            MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      }
+      if (!begin) {
+        unmap();
+        throw std::runtime_error("Cannot map " + path);
+      }
+    }
+#else
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat info {};
+    fstat(fd, &info);
+    length = static_cast<std::size_t>(info.st_size);
+    if (length > 0) {
+      void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED) {
+        unmap();
+        throw std::runtime_error("Cannot map " + path);
+      }
+      madvise(address, length, MADV_SEQUENTIAL);
+      begin = static_cast<const std::uint8_t *>(address);
+    }
+#endif
+  }
+
+  ~MappedFile() { unmap(); }
+
+  const std::uint8_t *data() const { return begin; }
+
+  std::size_t size() const { return length; }
+
+private:
+  const std::uint8_t *begin{nullptr};
+  std::size_t length{0};
+#ifdef _WIN32
+  HANDLE file{INVALID_HANDLE_VALUE};
+  HANDLE mapping{nullptr};
+#else
+  int fd{-1};
+#endif
+
+  /**
+   * @brief release the mapping and the file, also used to clean up a
+   * partially constructed mapping
+   */
+  void unmap() {
+#ifdef _WIN32
+    if (begin)
+      UnmapViewOfFile(begin);
+    if (mapping)
+      CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+      CloseHandle(file);
+    begin = nullptr;
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+#else
+    if (begin)
+      munmap(const_cast<std::uint8_t *>(begin), length);
+    if (fd >= 0)
+      close(fd);
+    begin = nullptr;
+    fd = -1;
+#endif
+  }
+};
+
+int main(int argc, char *argv[]) {
+  py::scoped_interpreter guard{};
+
+  std::vector<std::uint16_t> ports;
+  std::vector<std::string> files;
+  std::size_t top = 20;
+
+  for (int i = 1; i < argc; i++) {
+    std::string const arg = argv[i];
+    if ((arg == "--port" || arg == "--top") && i + 1 < argc) {
+      auto const value = std::stoul(argv[++i]);
+      if (arg == "--port") {
+        ports.push_back(static_cast<std::uint16_t>(value));
+      } else {
+        top = value;
+      }
+    } else if (arg == "--help" || arg == "-h" || arg.rfind("--", 0) == 0) {
+      std::cout << "usage: " << argv[0]
+                << " [--port PORT]... [--top N] FILE..." << std::endl
+                << "  --port  server port of IEC 60870-5-104 streams in pcap "
+                   "files, default 2404"
+                << std::endl
+                << "  --top   number of points per connection to print, 0 = "
+                   "all, default 20"
+                << std::endl;
+      return arg == "--help" || arg == "-h" ? 0 : 2;
+    } else {
+      files.push_back(arg);
+    }
+  }
+  if (ports.empty()) {
+    ports.push_back(IEC_60870_5_104_DEFAULT_PORT);
+  }
+  if (files.empty()) {
+    std::cerr << "usage: " << argv[0] << " [--port PORT]... [--top N] FILE..."
+              << std::endl;
+    return 2;
+  }
+
+  Remote::CaptureAnalyzer analyzer(ports);
+  for (const auto &file : files) {
+    try {
+      MappedFile const mapped(file);
+      analyzer.analyze(file, mapped.data(), mapped.size());
+    } catch (const std::exception &e) {
+      std::cerr << "[c104.analyzer] " << e.what() << std::endl;
+      return 1;
+    }
+  }
+  analyzer.print(std::cout, top);
+  return 0;
+}
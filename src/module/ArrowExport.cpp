@@ -0,0 +1,403 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file ArrowExport.cpp
+ * @brief export point tables via the Apache Arrow C data interface
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "ArrowExport.h"
+
+#include "object/Station.h"
+
+using namespace Module;
+
+namespace {
+
+constexpr std::int64_t ARROW_COLUMN_COUNT = 7;
+
+/// @brief non-null placeholder for empty data buffers
+const std::int64_t ARROW_EMPTY_BUFFER = 0;
+
+const char *const ARROW_COLUMN_FORMAT[ARROW_COLUMN_COUNT] = {
+    "S", "I", "u", "g", "S", "tsm:UTC", "tsm:UTC"};
+
+const char *const ARROW_COLUMN_NAME[ARROW_COLUMN_COUNT] = {
+    "common_address", "io_address",  "type",        "value",
+    "quality",        "recorded_at", "processed_at"};
+
+const std::int64_t ARROW_COLUMN_FLAGS[ARROW_COLUMN_COUNT] = {
+    0, 0, 0, ARROW_FLAG_NULLABLE, ARROW_FLAG_NULLABLE, ARROW_FLAG_NULLABLE, 0};
+
+struct InfoValueToDoubleVisitor {
+  std::optional<double> operator()(std::monostate value) const {
+    return std::nullopt;
+  }
+  std::optional<double> operator()(bool value) const { return value; }
+  std::optional<double> operator()(DoublePointValue value) const {
+    return static_cast<double>(value);
+  }
+  std::optional<double> operator()(const LimitedInt7 &obj) const {
+    return obj.get();
+  }
+  std::optional<double> operator()(StepCommandValue value) const {
+    return static_cast<double>(value);
+  }
+  std::optional<double> operator()(const Byte32 &obj) const {
+    return obj.get();
+  }
+  std::optional<double> operator()(const NormalizedFloat &obj) const {
+    return obj.get();
+  }
+  std::optional<double> operator()(const LimitedInt16 &obj) const {
+    return obj.get();
+  }
+  std::optional<double> operator()(float value) const { return value; }
+  std::optional<double> operator()(int32_t value) const { return value; }
+  std::optional<double> operator()(EventState value) const {
+    return static_cast<double>(value);
+  }
+  std::optional<double> operator()(const StartEvents &obj) const {
+    return static_cast<std::underlying_type_t<StartEvents>>(obj);
+  }
+  std::optional<double> operator()(const OutputCircuits &obj) const {
+    return static_cast<std::underlying_type_t<OutputCircuits>>(obj);
+  }
+  std::optional<double> operator()(const FieldSet16 &obj) const {
+    return static_cast<std::underlying_type_t<FieldSet16>>(obj);
+  }
+};
+
+struct InfoQualityToIntVisitor {
+  std::optional<std::uint16_t> operator()(std::monostate value) const {
+    return std::nullopt;
+  }
+  std::optional<std::uint16_t> operator()(const Quality &obj) const {
+    return static_cast<std::uint16_t>(obj);
+  }
+  std::optional<std::uint16_t>
+  operator()(const BinaryCounterQuality &obj) const {
+    return static_cast<std::uint16_t>(obj);
+  }
+};
+
+std::int64_t millisSinceEpoch(std::chrono::system_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+void setValid(std::vector<std::uint8_t> &bitmap, std::size_t index) {
+  bitmap[index / 8] |= static_cast<std::uint8_t>(1 << (index % 8));
+}
+
+template <typename T> const void *bufferOf(const std::vector<T> &buffer) {
+  return buffer.empty() ? static_cast<const void *>(&ARROW_EMPTY_BUFFER)
+                        : static_cast<const void *>(buffer.data());
+}
+
+/**
+ * @brief keeps the table alive as long as one exported array is not released
+ */
+struct ArrowArrayPrivate {
+  std::shared_ptr<ArrowPointTable> table;
+  const void *buffers[3] = {nullptr, nullptr, nullptr};
+  struct ArrowArray childArrays[ARROW_COLUMN_COUNT] = {};
+  struct ArrowArray *children[ARROW_COLUMN_COUNT] = {};
+};
+
+void releaseArray(struct ArrowArray *array) {
+  auto *data = static_cast<ArrowArrayPrivate *>(array->private_data);
+  for (std::int64_t i = 0; i < array->n_children; i++) {
+    struct ArrowArray *child = array->children[i];
+    if (child->release) {
+      child->release(child);
+    }
+  }
+  delete data;
+  array->release = nullptr;
+}
+
+void fillArray(struct ArrowArray *out, std::shared_ptr<ArrowPointTable> table,
+               std::int64_t length, std::int64_t null_count,
+               std::initializer_list<const void *> buffers) {
+  auto *data = new ArrowArrayPrivate{std::move(table)};
+  std::int64_t n = 0;
+  for (const void *buffer : buffers) {
+    data->buffers[n++] = buffer;
+  }
+  out->length = length;
+  out->null_count = null_count;
+  out->offset = 0;
+  out->n_buffers = n;
+  out->n_children = 0;
+  out->buffers = data->buffers;
+  out->children = nullptr;
+  out->dictionary = nullptr;
+  out->release = &releaseArray;
+  out->private_data = data;
+}
+
+struct ArrowSchemaPrivate {
+  struct ArrowSchema childSchemas[ARROW_COLUMN_COUNT] = {};
+  struct ArrowSchema *children[ARROW_COLUMN_COUNT] = {};
+};
+
+void releaseChildSchema(struct ArrowSchema *schema) {
+  schema->release = nullptr;
+}
+
+void releaseSchema(struct ArrowSchema *schema) {
+  auto *data = static_cast<ArrowSchemaPrivate *>(schema->private_data);
+  for (std::int64_t i = 0; i < schema->n_children; i++) {
+    struct ArrowSchema *child = schema->children[i];
+    if (child->release) {
+      child->release(child);
+    }
+  }
+  delete data;
+  schema->release = nullptr;
+}
+
+struct ArrowStreamPrivate {
+  std::shared_ptr<ArrowPointTable> table;
+  bool done = false;
+};
+
+int streamGetSchema(struct ArrowArrayStream *stream, struct ArrowSchema *out) {
+  auto *data = static_cast<ArrowStreamPrivate *>(stream->private_data);
+  data->table->exportSchema(out);
+  return 0;
+}
+
+int streamGetNext(struct ArrowArrayStream *stream, struct ArrowArray *out) {
+  auto *data = static_cast<ArrowStreamPrivate *>(stream->private_data);
+  if (data->done) {
+    // end of stream is signaled via a released array
+    out->release = nullptr;
+    return 0;
+  }
+  data->table->exportArray(out);
+  data->done = true;
+  return 0;
+}
+
+const char *streamGetLastError(struct ArrowArrayStream *stream) {
+  return nullptr;
+}
+
+void releaseStream(struct ArrowArrayStream *stream) {
+  delete static_cast<ArrowStreamPrivate *>(stream->private_data);
+  stream->release = nullptr;
+}
+
+void releaseSchemaCapsule(PyObject *capsule) {
+  auto *schema = static_cast<struct ArrowSchema *>(
+      PyCapsule_GetPointer(capsule, "arrow_schema"));
+  if (schema->release) {
+    schema->release(schema);
+  }
+  delete schema;
+}
+
+void releaseArrayCapsule(PyObject *capsule) {
+  auto *array = static_cast<struct ArrowArray *>(
+      PyCapsule_GetPointer(capsule, "arrow_array"));
+  if (array->release) {
+    array->release(array);
+  }
+  delete array;
+}
+
+void releaseStreamCapsule(PyObject *capsule) {
+  auto *stream = static_cast<struct ArrowArrayStream *>(
+      PyCapsule_GetPointer(capsule, "arrow_array_stream"));
+  if (stream->release) {
+    stream->release(stream);
+  }
+  delete stream;
+}
+
+} // namespace
+
+ArrowPointTable::ArrowPointTable(const Object::DataPointVector &points)
+    : length(static_cast<std::int64_t>(points.size())) {
+  std::size_t const bitmapSize = (points.size() + 7) / 8;
+
+  commonAddress.reserve(points.size());
+  ioAddress.reserve(points.size());
+  typeOffsets.reserve(points.size() + 1);
+  value.reserve(points.size());
+  quality.reserve(points.size());
+  recordedAt.reserve(points.size());
+  processedAt.reserve(points.size());
+  valueValidity.resize(bitmapSize, 0);
+  qualityValidity.resize(bitmapSize, 0);
+  recordedAtValidity.resize(bitmapSize, 0);
+
+  std::size_t index = 0;
+  for (auto &point : points) {
+    auto station = point->getStation();
+    auto info = point->getInfo();
+
+    commonAddress.push_back(station ? station->getCommonAddress() : 0);
+    ioAddress.push_back(point->getInformationObjectAddress());
+    typeData.append(TypeID_toString(point->getType()));
+    typeOffsets.push_back(static_cast<std::int32_t>(typeData.size()));
+
+    std::optional<double> v;
+    std::optional<std::uint16_t> q;
+    bool const native = Object::visitNative(
+        point->getType(), info.get(), [&v, &q](auto *typed) {
+          using INFO = std::remove_pointer_t<decltype(typed)>;
+          v = Object::nativeToDouble(typed->getNativeValue());
+          if constexpr (Object::HasNativeQuality<INFO>::value) {
+            q = static_cast<std::uint16_t>(typed->getNativeQuality());
+          }
+        });
+    if (!native) {
+      // a client point may hold information of another type
+      v = std::visit(InfoValueToDoubleVisitor{}, info->getValue());
+      q = std::visit(InfoQualityToIntVisitor{}, info->getQuality());
+    }
+
+    value.push_back(v.value_or(0));
+    if (v.has_value()) {
+      setValid(valueValidity, index);
+    } else {
+      valueNullCount++;
+    }
+
+    quality.push_back(q.value_or(0));
+    if (q.has_value()) {
+      setValid(qualityValidity, index);
+    } else {
+      qualityNullCount++;
+    }
+
+    auto const &recorded = info->getRecordedAt();
+    recordedAt.push_back(recorded.has_value() ? millisSinceEpoch(*recorded)
+                                              : 0);
+    if (recorded.has_value()) {
+      setValid(recordedAtValidity, index);
+    } else {
+      recordedAtNullCount++;
+    }
+
+    processedAt.push_back(millisSinceEpoch(info->getProcessedAt()));
+    index++;
+  }
+}
+
+void ArrowPointTable::exportSchema(struct ArrowSchema *out) const {
+  auto *data = new ArrowSchemaPrivate();
+  for (std::int64_t i = 0; i < ARROW_COLUMN_COUNT; i++) {
+    struct ArrowSchema *child = &data->childSchemas[i];
+    child->format = ARROW_COLUMN_FORMAT[i];
+    child->name = ARROW_COLUMN_NAME[i];
+    child->metadata = nullptr;
+    child->flags = ARROW_COLUMN_FLAGS[i];
+    child->n_children = 0;
+    child->children = nullptr;
+    child->dictionary = nullptr;
+    child->release = &releaseChildSchema;
+    child->private_data = nullptr;
+    data->children[i] = child;
+  }
+
+  out->format = "+s";
+  out->name = "";
+  out->metadata = nullptr;
+  out->flags = 0;
+  out->n_children = ARROW_COLUMN_COUNT;
+  out->children = data->children;
+  out->dictionary = nullptr;
+  out->release = &releaseSchema;
+  out->private_data = data;
+}
+
+void ArrowPointTable::exportArray(struct ArrowArray *out) {
+  auto self = shared_from_this();
+
+  fillArray(out, self, length, 0, {nullptr});
+  auto *data = static_cast<ArrowArrayPrivate *>(out->private_data);
+
+  auto validity = [](const std::vector<std::uint8_t> &bitmap,
+                     std::int64_t null_count) -> const void * {
+    return null_count > 0 ? bufferOf(bitmap) : nullptr;
+  };
+
+  fillArray(&data->childArrays[0], self, length, 0,
+            {nullptr, bufferOf(commonAddress)});
+  fillArray(&data->childArrays[1], self, length, 0,
+            {nullptr, bufferOf(ioAddress)});
+  fillArray(&data->childArrays[2], self, length, 0,
+            {nullptr, bufferOf(typeOffsets), typeData.data()});
+  fillArray(&data->childArrays[3], self, length, valueNullCount,
+            {validity(valueValidity, valueNullCount), bufferOf(value)});
+  fillArray(&data->childArrays[4], self, length, qualityNullCount,
+            {validity(qualityValidity, qualityNullCount), bufferOf(quality)});
+  fillArray(&data->childArrays[5], self, length, recordedAtNullCount,
+            {validity(recordedAtValidity, recordedAtNullCount),
+             bufferOf(recordedAt)});
+  fillArray(&data->childArrays[6], self, length, 0,
+            {nullptr, bufferOf(processedAt)});
+
+  for (std::int64_t i = 0; i < ARROW_COLUMN_COUNT; i++) {
+    data->children[i] = &data->childArrays[i];
+  }
+  out->n_children = ARROW_COLUMN_COUNT;
+  out->children = data->children;
+}
+
+void ArrowPointTable::exportStream(struct ArrowArrayStream *out) {
+  out->get_schema = &streamGetSchema;
+  out->get_next = &streamGetNext;
+  out->get_last_error = &streamGetLastError;
+  out->release = &releaseStream;
+  out->private_data = new ArrowStreamPrivate{shared_from_this()};
+}
+
+py::tuple ArrowPointTable::toArrayCapsules() {
+  auto *schema = new ArrowSchema();
+  exportSchema(schema);
+  auto *array = new ArrowArray();
+  exportArray(array);
+
+  return py::make_tuple(
+      py::reinterpret_steal<py::object>(
+          PyCapsule_New(schema, "arrow_schema", &releaseSchemaCapsule)),
+      py::reinterpret_steal<py::object>(
+          PyCapsule_New(array, "arrow_array", &releaseArrayCapsule)));
+}
+
+py::object ArrowPointTable::toStreamCapsule() {
+  auto *stream = new ArrowArrayStream();
+  exportStream(stream);
+
+  return py::reinterpret_steal<py::object>(
+      PyCapsule_New(stream, "arrow_array_stream", &releaseStreamCapsule));
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file ArrowExport.h
+ * @brief export point tables via the Apache Arrow C data interface
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_MODULE_ARROWEXPORT_H
+#define C104_MODULE_ARROWEXPORT_H
+
+#include <cstdint>
+
+#include "object/DataPoint.h"
+#include "types.h"
+
+/*
+ * Apache Arrow C data interface ABI, copied verbatim from the specification
+ * https://arrow.apache.org/docs/format/CDataInterface.html
+ * The ABI is stable, no Arrow library is required to produce data.
+ */
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  // Array type description
+  const char *format;
+  const char *name;
+  const char *metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+struct ArrowArray {
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#ifndef ARROW_C_STREAM_INTERFACE
+#define ARROW_C_STREAM_INTERFACE
+
+struct ArrowArrayStream {
+  // Callbacks providing stream functionality
+  int (*get_schema)(struct ArrowArrayStream *, struct ArrowSchema *out);
+  int (*get_next)(struct ArrowArrayStream *, struct ArrowArray *out);
+  const char *(*get_last_error)(struct ArrowArrayStream *);
+
+  // Release callback
+  void (*release)(struct ArrowArrayStream *);
+
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+#endif // ARROW_C_STREAM_INTERFACE
+
+namespace Module {
+
+/**
+ * @brief Columnar snapshot of points and their current information
+ *
+ * The table is filled once and then exported as a single Arrow record batch.
+ * Column buffers are owned by the table and handed to the consumer without
+ * copying, the table lives until the last exported array is released.
+ *
+ * Columns: common_address (uint16), io_address (uint32), type (utf8),
+ * value (float64, nullable), quality (uint16, nullable),
+ * recorded_at (timestamp[ms, UTC], nullable), processed_at (timestamp[ms,
+ * UTC])
+ */
+class ArrowPointTable : public std::enable_shared_from_this<ArrowPointTable> {
+public:
+  /**
+   * @brief Create a table snapshot of all points
+   * @param points points to export, in this order
+   */
+  [[nodiscard]] static std::shared_ptr<ArrowPointTable>
+  create(const Object::DataPointVector &points) {
+    // Not using std::make_shared because the constructor is private.
+    return std::shared_ptr<ArrowPointTable>(new ArrowPointTable(points));
+  }
+
+  /**
+   * @brief Getter for number of rows
+   */
+  std::int64_t getLength() const { return length; }
+
+  /**
+   * @brief Export the table schema
+   * @param out uninitialized schema struct, owned by the consumer
+   */
+  void exportSchema(struct ArrowSchema *out) const;
+
+  /**
+   * @brief Export the table data as struct array (record batch)
+   * @param out uninitialized array struct, owned by the consumer
+   */
+  void exportArray(struct ArrowArray *out);
+
+  /**
+   * @brief Export the table as stream with a single record batch
+   * @param out uninitialized stream struct, owned by the consumer
+   */
+  void exportStream(struct ArrowArrayStream *out);
+
+  /**
+   * @brief Python PyCapsule interface: `__arrow_c_array__`
+   * @return tuple of "arrow_schema" and "arrow_array" capsules
+   */
+  py::tuple toArrayCapsules();
+
+  /**
+   * @brief Python PyCapsule interface: `__arrow_c_stream__`
+   * @return "arrow_array_stream" capsule
+   */
+  py::object toStreamCapsule();
+
+private:
+  explicit ArrowPointTable(const Object::DataPointVector &points);
+
+  /// @brief number of rows
+  std::int64_t length = 0;
+
+  std::vector<std::uint16_t> commonAddress{};
+  std::vector<std::uint32_t> ioAddress{};
+  std::vector<std::int32_t> typeOffsets{0};
+  std::string typeData{};
+  std::vector<double> value{};
+  std::vector<std::uint8_t> valueValidity{};
+  std::int64_t valueNullCount = 0;
+  std::vector<std::uint16_t> quality{};
+  std::vector<std::uint8_t> qualityValidity{};
+  std::int64_t qualityNullCount = 0;
+  std::vector<std::int64_t> recordedAt{};
+  std::vector<std::uint8_t> recordedAtValidity{};
+  std::int64_t recordedAtNullCount = 0;
+  std::vector<std::int64_t> processedAt{};
+};
+
+} // namespace Module
+
+#endif // C104_MODULE_ARROWEXPORT_H
@@ -34,7 +34,7 @@
 
 #include <utility>
 
-#include "module/GilAwareMutex.h"
+#include "module/ScopedGilAcquire.h"
 #include "types.h"
 
 using namespace pybind11::literals;
@@ -48,17 +48,33 @@ namespace Module {
  * A callback function is a function that is passed as an argument to another
  * function. This class provides functionality for setting, resetting, and
  * checking if the callback function is set.
+ *
+ * The callable is published as atomic pointer that owns one reference. It is
+ * only replaced or released while holding the GIL, so a caller holding the GIL
+ * can use it without additional locking.
  */
 class CallbackBase {
 public:
   CallbackBase(std::string cb_name, std::string cb_signature)
-      : callback(py::none()), name(std::move(cb_name)) {
+      : name(std::move(cb_name)) {
     cb_signature.erase(
         remove_if(cb_signature.begin(), cb_signature.end(), isspace),
         cb_signature.end());
     signature = std::move(cb_signature);
   }
 
+  // noncopyable: owns a reference to the callable
+  CallbackBase(const CallbackBase &) = delete;
+  CallbackBase &operator=(const CallbackBase &) = delete;
+
+  ~CallbackBase() {
+    PyObject *const cb = callback.exchange(nullptr);
+    if (cb && Py_IsInitialized()) {
+      Module::ScopedGilAcquire const scoped("Callback.release", interpreter);
+      Py_DECREF(cb);
+    }
+  }
+
   /**
    * @brief Resets the callback function to a new value.
    *
@@ -79,6 +95,47 @@ public:
       return;
     }
 
+    std::string const callable_signature = signatureOf(callable);
+    if (signature != callable_signature) {
+      unset();
+      throw std::invalid_argument("Invalid callback signature, expected: " +
+                                  signature + ", got: " + callable_signature);
+    }
+    interpreter = Interpreter_current();
+    publish(callable.inc_ref().ptr());
+  }
+
+  /**
+   * @brief Test if a callable matches the expected signature without
+   * registering it.
+   *
+   * @param callable The candidate callback function.
+   * @return true if reset would accept the callable, false otherwise.
+   *
+   * @throws py::error_already_set If the `callable` object is not a callable.
+   */
+  bool matches(const py::object &callable) const {
+    return !callable.is_none() && signature == signatureOf(callable);
+  }
+
+  /**
+   * @brief Check if the callback function is set.
+   *
+   * This function checks if a callable is published, it does not require the
+   * GIL.
+   *
+   * @return true if the callback function is set, false otherwise.
+   */
+  bool is_set() const {
+    return callback.load(std::memory_order_acquire) != nullptr;
+  }
+
+protected:
+  /**
+   * @brief Generate the signature of a callable without default parameters
+   * and without whitespace, the GIL must be held
+   */
+  static std::string signatureOf(const py::object &callable) {
     auto inspect = py::module_::import("inspect");
     auto empty = inspect.attr("Parameter").attr("empty");
 
@@ -99,49 +156,105 @@ public:
     callable_signature.erase(remove_if(callable_signature.begin(),
                                        callable_signature.end(), isspace),
                              callable_signature.end());
-
-    if (signature != callable_signature) {
-      unset();
-      throw std::invalid_argument("Invalid callback signature, expected: " +
-                                  signature + ", got: " + callable_signature);
-    }
-    {
-      std::lock_guard<Module::GilAwareMutex> const lock(callback_mutex);
-      callback = callable;
-    }
+    return callable_signature;
   }
 
   /**
-   * @brief Check if the callback function is set.
-   *
-   * This function checks if the callback object is not None.
+   * @brief Unsets the callback function.
    *
-   * @return true if the callback function is set, false otherwise.
+   * This function releases the published callable, the GIL must be held.
    */
-  bool is_set() const {
-    std::lock_guard<Module::GilAwareMutex> const lock(callback_mutex);
+  void unset() {
+    DEBUG_PRINT(Debug::Callback, "CLEAR " + name);
+    publish(nullptr);
+    success = false;
+  }
 
-    return !callback.is_none();
+  /**
+   * @brief Replace the published callable, the GIL must be held
+   * @param cb new reference or nullptr, ownership is transferred
+   */
+  void publish(PyObject *cb) {
+    PyObject *const previous = callback.exchange(cb, std::memory_order_acq_rel);
+    Py_XDECREF(previous);
   }
 
-protected:
   /**
-   * @brief Unsets the callback function.
-   *
-   * This function unsets the callback function by setting it to `py::none()`.
+   * @brief Get a new reference to the published callable, the GIL must be
+   * held
+   * @return callable or an empty object if unset
    */
-  void unset() {
-    DEBUG_PRINT(Debug::Callback, "CLEAR " + name);
-    {
-      std::lock_guard<Module::GilAwareMutex> const lock(callback_mutex);
-      if (!callback.is_none()) {
-        callback = py::none();
-      }
+  py::object acquire() const {
+    return py::reinterpret_borrow<py::object>(
+        callback.load(std::memory_order_acquire));
+  }
+
+  /**
+   * @brief Convert all arguments once and call the callable via vectorcall,
+   * the GIL must be held
+   * @throws py::error_already_set if the callable raised an exception
+   */
+  template <typename... Types>
+  static py::object invoke(const py::object &cb, Types &&...values) {
+    constexpr std::size_t count = sizeof...(Types);
+    std::array<py::object, count> const args{
+        py::cast(std::forward<Types>(values))...};
+
+#if PY_VERSION_HEX >= 0x03080000
+    // slot 0 is reserved, so that bound methods can prepend self in place
+    std::array<PyObject *, count + 1> argv{};
+    for (std::size_t i = 0; i < count; i++) {
+      argv[i + 1] = args[i].ptr();
     }
-    success = false;
+#if PY_VERSION_HEX >= 0x03090000
+    PyObject *const res =
+        PyObject_Vectorcall(cb.ptr(), argv.data() + 1,
+                            count | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+#else
+    PyObject *const res =
+        _PyObject_Vectorcall(cb.ptr(), argv.data() + 1,
+                             count | PY_VECTORCALL_ARGUMENTS_OFFSET, nullptr);
+#endif
+#else
+    py::tuple argt(count);
+    for (std::size_t i = 0; i < count; i++) {
+      PyTuple_SET_ITEM(argt.ptr(), i, args[i].inc_ref().ptr());
+    }
+    PyObject *const res = PyObject_Call(cb.ptr(), argt.ptr(), nullptr);
+#endif
+
+    if (!res) {
+      throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::object>(res);
   }
 
-  py::object callback;
+  /**
+   * @brief print the python exception and remove the callable
+   */
+  void onError(py::error_already_set &e) {
+    this->success = false;
+    std::cerr << '\n'
+              << "------------------------------------------------------------"
+              << '\n'
+              << '\n'
+              << this->name << "] Error:" << std::endl;
+
+    auto traceback = py::module_::import("traceback");
+    traceback.attr("print_exception")(e.type(), e.value(), e.trace());
+
+    std::cerr << "\nRemoved erroneous callback handler!\n\n"
+              << "------------------------------------------------------------"
+              << '\n'
+              << std::endl;
+    this->unset();
+  }
+
+  /// @brief published callable (owning one reference) or nullptr
+  std::atomic<PyObject *> callback{nullptr};
+
+  /// @brief interpreter the callable belongs to, nullptr for main
+  PyInterpreterState *interpreter{nullptr};
 
   std::string name{"Callback"};
   std::string signature{"() -> None"};
@@ -149,8 +262,6 @@ protected:
   std::atomic_bool success{false};
 
   std::chrono::steady_clock::time_point begin, end;
-
-  mutable Module::GilAwareMutex callback_mutex{"Callback::callback_mutex"};
 };
 
 template <typename T> class Callback : public CallbackBase {
@@ -159,18 +270,16 @@ public:
       : CallbackBase(std::move(cb_name), std::move(cb_signature)) {}
 
   /**
-   * @brief Calls the callback function with the given values.
+   * @brief Calls the callback function with the given values, the GIL must be
+   * held.
    *
    * @tparam Types The types of the values to pass to the callback
    * @param values The values to pass to the callback
    * @return bool True if the callback was called successfully, false otherwise
    */
   template <typename... Types> bool call(Types &&...values) {
-    std::unique_lock<Module::GilAwareMutex> lock(this->callback_mutex);
-    auto const cb = this->callback;
-    lock.unlock();
-
-    if (cb.is_none()) {
+    auto const cb = this->acquire();
+    if (!cb) {
       return false;
     }
 
@@ -178,31 +287,19 @@ public:
       this->begin = std::chrono::steady_clock::now();
     }
 
+    py::object res;
     try {
-      py::object res = cb(std::forward<Types>(values)...);
-      result_type = py::cast<std::string>(py::str(py::type::handle_of(res)));
+      res = invoke(cb, std::forward<Types>(values)...);
       result = py::cast<T>(res);
       this->success = true;
     } catch (py::error_already_set &e) {
-      this->success = false;
-      std::cerr
-          << '\n'
-          << "------------------------------------------------------------"
-          << '\n'
-          << '\n'
-          << this->name << "] Error:" << std::endl;
-
-      auto traceback = py::module_::import("traceback");
-      traceback.attr("print_exception")(e.type(), e.value(), e.trace());
-
-      std::cerr
-          << "\nRemoved erroneous callback handler!\n\n"
-          << "------------------------------------------------------------"
-          << '\n'
-          << std::endl;
-      this->unset();
+      this->onError(e);
     } catch (py::builtin_exception &e) {
       this->success = false;
+      // type names are only required for the error message
+      std::string const result_type =
+          res ? py::cast<std::string>(py::str(py::type::handle_of(res)))
+              : "None";
       std::cerr
           << '\n'
           << "------------------------------------------------------------"
@@ -240,15 +337,14 @@ public:
   }
 
   /**
-   * @brief Retrieves the result of a callback.
+   * @brief Retrieves the result of a callback, must be called while still
+   * holding the GIL of the preceding call.
    *
    * @tparam T The type of the result
    * @return T The result of the callback
    * @throws std::invalid_argument if no result is set
    */
   T getResult() {
-    std::lock_guard<Module::GilAwareMutex> lock(this->callback_mutex);
-
     if (!this->success) {
       throw std::invalid_argument("No result set!");
     }
@@ -258,7 +354,6 @@ public:
 
 protected:
   T result;
-  std::string result_type{"None"};
 };
 
 template <> class Callback<void> : public CallbackBase {
@@ -267,7 +362,8 @@ public:
       : CallbackBase(cb_name, cb_signature) {}
 
   /**
-   * @brief Calls the callback function with the given values.
+   * @brief Calls the callback function with the given values, the GIL must be
+   * held.
    *
    * @tparam Types The types of the values.
    * @param values The values to pass to the callback function.
@@ -275,11 +371,8 @@ public:
    * false otherwise.
    */
   template <typename... Types> bool call(Types &&...values) {
-    std::unique_lock<Module::GilAwareMutex> lock(this->callback_mutex);
-    auto const cb = this->callback;
-    lock.unlock();
-
-    if (cb.is_none()) {
+    auto const cb = this->acquire();
+    if (!cb) {
       return false;
     }
 
@@ -288,26 +381,10 @@ public:
     }
 
     try {
-      cb(std::forward<Types>(values)...);
+      invoke(cb, std::forward<Types>(values)...);
       this->success = true;
     } catch (py::error_already_set &e) {
-      this->success = false;
-      std::cerr
-          << '\n'
-          << "------------------------------------------------------------"
-          << '\n'
-          << '\n'
-          << this->name << "] Error:" << std::endl;
-
-      auto traceback = py::module_::import("traceback");
-      traceback.attr("print_exception")(e.type(), e.value(), e.trace());
-
-      std::cerr
-          << "\nRemoved erroneous callback handler!\n\n"
-          << "------------------------------------------------------------"
-          << '\n'
-          << std::endl;
-      this->unset();
+      this->onError(e);
     }
 
     if (DEBUG_TEST(Debug::Callback)) {
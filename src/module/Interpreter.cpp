@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file Interpreter.cpp
+ * @brief bind native threads to the python interpreter owning their objects
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "module/Interpreter.h"
+
+using namespace Module;
+
+namespace {
+
+/// @brief interpreter used by ScopedGilAcquire in this thread
+thread_local PyInterpreterState *boundInterpreter = nullptr;
+
+PyThreadState *currentThreadState() {
+#if PY_VERSION_HEX >= 0x030D0000
+  return PyThreadState_GetUnchecked();
+#else
+  return _PyThreadState_UncheckedGet();
+#endif
+}
+
+} // namespace
+
+PyInterpreterState *Module::Interpreter_current() {
+  PyThreadState *const state = currentThreadState();
+  if (!state) {
+    return nullptr;
+  }
+#if PY_VERSION_HEX >= 0x03090000
+  return PyThreadState_GetInterpreter(state);
+#else
+  return state->interp;
+#endif
+}
+
+bool Module::Interpreter_isMain(PyInterpreterState *interpreter) {
+  return !interpreter || interpreter == PyInterpreterState_Main();
+}
+
+void Module::Interpreter_bind(PyInterpreterState *interpreter) {
+  boundInterpreter = Interpreter_isMain(interpreter) ? nullptr : interpreter;
+}
+
+PyInterpreterState *Module::Interpreter_bound() { return boundInterpreter; }
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file Interpreter.h
+ * @brief bind native threads to the python interpreter owning their objects
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_MODULE_INTERPRETER_H
+#define C104_MODULE_INTERPRETER_H
+
+#include "types.h"
+
+namespace Module {
+
+/**
+ * @brief Getter for the interpreter of the calling thread
+ * @return interpreter of the current thread state or nullptr if the calling
+ * thread does not hold a GIL
+ */
+PyInterpreterState *Interpreter_current();
+
+/**
+ * @brief Test if an interpreter is the main interpreter
+ * @param interpreter interpreter or nullptr, which refers to the main
+ * interpreter
+ */
+bool Interpreter_isMain(PyInterpreterState *interpreter);
+
+/**
+ * @brief Bind the calling native thread to an interpreter
+ *
+ * Threads that are created by this module or by lib60870 run python callbacks
+ * in the interpreter of the Server or Client they belong to. The binding is
+ * used as default by ScopedGilAcquire.
+ *
+ * @param interpreter interpreter or nullptr for the main interpreter
+ */
+void Interpreter_bind(PyInterpreterState *interpreter);
+
+/**
+ * @brief Getter for the interpreter the calling thread is bound to
+ * @return interpreter or nullptr for the main interpreter
+ */
+PyInterpreterState *Interpreter_bound();
+
+} // namespace Module
+
+#endif // C104_MODULE_INTERPRETER_H
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file MemoryBudget.cpp
+ * @brief process wide memory budget of internal buffers
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "module/MemoryBudget.h"
+
+using namespace Module;
+
+namespace {
+
+constexpr std::size_t SUBSYSTEM_COUNT = 4;
+
+constexpr std::array<const char *, SUBSYSTEM_COUNT> SUBSYSTEM_NAMES{
+    "held_frames", "held_periodic_frames", "raw_frames", "aggregates"};
+
+/// @brief usage in percent of the limit that activates DropPeriodic, Coalesce
+/// and RefuseHistory
+constexpr std::array<std::uint_fast64_t, 3> STAGE_PERCENT{80, 90, 100};
+
+constexpr std::array<const char *, 4> STAGE_NAMES{
+    "none", "drop_periodic", "coalesce", "refuse_history"};
+
+std::atomic_uint_fast64_t limit{0};
+std::atomic_uint_fast64_t usage{0};
+std::atomic_uint_fast64_t peak{0};
+std::array<std::atomic_uint_fast64_t, SUBSYSTEM_COUNT> subsystemUsage{};
+
+/// @brief shed items per stage, index 0 is unused
+std::array<std::atomic_uint_fast64_t, 4> shed{};
+
+} // namespace
+
+void MemoryBudget::setLimit(const std::uint_fast64_t bytes) {
+  limit.store(bytes);
+}
+
+std::uint_fast64_t MemoryBudget::getLimit() { return limit.load(); }
+
+void MemoryBudget::add(const Subsystem subsystem, const std::size_t bytes) {
+  subsystemUsage[static_cast<std::size_t>(subsystem)].fetch_add(bytes);
+  auto const current = usage.fetch_add(bytes) + bytes;
+  auto previous = peak.load();
+  while (previous < current && !peak.compare_exchange_weak(previous, current)) {
+  }
+}
+
+void MemoryBudget::remove(const Subsystem subsystem, const std::size_t bytes) {
+  subsystemUsage[static_cast<std::size_t>(subsystem)].fetch_sub(bytes);
+  usage.fetch_sub(bytes);
+}
+
+std::uint_fast64_t MemoryBudget::getUsage() { return usage.load(); }
+
+MemoryBudget::Stage MemoryBudget::getStage() {
+  auto const max = limit.load();
+  if (0 == max) {
+    return Stage::None;
+  }
+  auto const percent = usage.load() * 100;
+  if (percent >= max * STAGE_PERCENT[2]) {
+    return Stage::RefuseHistory;
+  }
+  if (percent >= max * STAGE_PERCENT[1]) {
+    return Stage::Coalesce;
+  }
+  if (percent >= max * STAGE_PERCENT[0]) {
+    return Stage::DropPeriodic;
+  }
+  return Stage::None;
+}
+
+void MemoryBudget::recordShed(const Stage stage, const std::size_t count) {
+  shed[static_cast<std::size_t>(stage)].fetch_add(count);
+}
+
+py::dict MemoryBudget::toDict() {
+  py::dict subsystems;
+  for (std::size_t i = 0; i < SUBSYSTEM_COUNT; i++) {
+    subsystems[SUBSYSTEM_NAMES[i]] = subsystemUsage[i].load();
+  }
+
+  py::dict result;
+  result["limit"] = limit.load();
+  result["usage"] = usage.load();
+  result["peak"] = peak.load();
+  result["stage"] = STAGE_NAMES[static_cast<std::size_t>(getStage())];
+  result["subsystems"] = subsystems;
+  result["dropped_periodic"] =
+      shed[static_cast<std::size_t>(Stage::DropPeriodic)].load();
+  result["coalesced"] = shed[static_cast<std::size_t>(Stage::Coalesce)].load();
+  result["refused_history"] =
+      shed[static_cast<std::size_t>(Stage::RefuseHistory)].load();
+  return result;
+}
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file MemoryBudget.h
+ * @brief process wide memory budget of internal buffers
+ *
+ * @package iec104-python
+ * @namespace module
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_MODULE_MEMORYBUDGET_H
+#define C104_MODULE_MEMORYBUDGET_H
+
+#include "types.h"
+
+namespace Module {
+
+/**
+ * @brief accounts the memory of internal queues and buffers of all servers
+ * and clients in the process against a common limit
+ *
+ * Buffers report their footprint per subsystem. If the usage approaches the
+ * limit, buffers shed load in a fixed order of escalating stages:
+ *
+ * 1. DropPeriodic (80 %): held periodic and background frames are dropped,
+ * they are sent again in the next cycle
+ * 2. Coalesce (90 %): a held spontaneous frame is replaced by a newer frame of
+ * the same point instead of queueing both
+ * 3. RefuseHistory (100 %): new raw frame batches and aggregate batches are
+ * refused instead of waiting for delivery
+ *
+ * Each stage includes the measures of the previous stages. The budget is not
+ * a hard allocation limit: every buffer keeps its own size limit and frames
+ * that cannot be shed are still accepted.
+ */
+class MemoryBudget {
+public:
+  /// @brief accounted buffers
+  enum class Subsystem : std::uint8_t {
+    /// @brief frames of normal priority held by a bandwidth limit
+    HeldFrames,
+    /// @brief periodic and background frames held by a bandwidth limit
+    HeldPeriodicFrames,
+    /// @brief raw frame batches waiting for delivery
+    RawFrames,
+    /// @brief aggregate batches waiting for delivery
+    Aggregates
+  };
+
+  /// @brief shedding stages in escalation order
+  enum class Stage : std::uint8_t {
+    None,
+    DropPeriodic,
+    Coalesce,
+    RefuseHistory
+  };
+
+  /**
+   * @brief Setter for the limit of all accounted buffers
+   * @param bytes limit in bytes, 0 = unlimited
+   */
+  static void setLimit(std::uint_fast64_t bytes);
+
+  /**
+   * @brief Getter for the limit of all accounted buffers
+   * @return limit in bytes, 0 = unlimited
+   */
+  static std::uint_fast64_t getLimit();
+
+  /**
+   * @brief account memory taken by a buffer
+   */
+  static void add(Subsystem subsystem, std::size_t bytes);
+
+  /**
+   * @brief account memory given back by a buffer
+   */
+  static void remove(Subsystem subsystem, std::size_t bytes);
+
+  /**
+   * @brief Getter for the accounted memory of all buffers
+   * @return usage in bytes
+   */
+  static std::uint_fast64_t getUsage();
+
+  /**
+   * @brief Getter for the current shedding stage
+   */
+  static Stage getStage();
+
+  /**
+   * @brief count items shed by a stage
+   * @param stage stage that caused the shedding
+   * @param count number of frames or batches
+   */
+  static void recordShed(Stage stage, std::size_t count = 1);
+
+  /**
+   * @brief Getter for limit, usage and shedding statistics as python
+   * dictionary
+   * @return dict with limit, usage, peak, stage, subsystems, dropped_periodic,
+   * coalesced and refused_history
+   */
+  static py::dict toDict();
+};
+
+} // namespace Module
+
+#endif // C104_MODULE_MEMORYBUDGET_H
@@ -35,6 +35,7 @@
 
 #include <utility>
 
+#include "module/Interpreter.h"
 #include "types.h"
 
 namespace Module {
@@ -47,23 +48,55 @@ namespace Module {
  * The ScopedGilAcquire is used to safely acquire and release the GIL within a
  * specific scope, ensuring that the Python interpreter is protected from
  * concurrent access by multiple threads.
+ *
+ * If the calling thread is bound to a sub interpreter, the GIL of that
+ * interpreter is acquired via a temporary thread state of this thread, since
+ * the PyGILState API only supports the main interpreter. The thread state is
+ * deleted on release, so no state outlives the scope and a sub interpreter can
+ * always be finalized once no callback is running.
  */
 class ScopedGilAcquire {
 public:
-  inline explicit ScopedGilAcquire(std::string callback_name)
+  inline explicit ScopedGilAcquire(
+      std::string callback_name,
+      PyInterpreterState *interpreter = Interpreter_bound())
       : gil(), name(std::move(callback_name)) {
-    if (PyGILState_Check()) {
-      DEBUG_PRINT(Debug::Gil, "--?| (Acquire) GIL | " + name);
-    } else {
-      DEBUG_PRINT(Debug::Gil, "-->| Acquire GIL | " + name);
-      gil = new py::gil_scoped_acquire();
+    if (Interpreter_isMain(interpreter)) {
+      if (PyGILState_Check()) {
+        DEBUG_PRINT(Debug::Gil, "--?| (Acquire) GIL | " + name);
+      } else {
+        DEBUG_PRINT(Debug::Gil, "-->| Acquire GIL | " + name);
+        gil = new py::gil_scoped_acquire();
+      }
+      return;
+    }
+
+    PyInterpreterState *const current = Interpreter_current();
+    if (current == interpreter) {
+      DEBUG_PRINT(Debug::Gil, "--?| (Acquire) sub GIL | " + name);
+      return;
     }
+    DEBUG_PRINT(Debug::Gil, "-->| Acquire sub GIL | " + name);
+    if (current) {
+      // leave the interpreter this thread is currently running in
+      previous = PyEval_SaveThread();
+    }
+    state = PyThreadState_New(interpreter);
+    PyEval_RestoreThread(state);
   }
 
   inline ~ScopedGilAcquire() {
     if (gil) {
       delete gil;
       DEBUG_PRINT(Debug::Gil, "<--| Re-release GIL | " + name);
+    } else if (state) {
+      // releases the GIL of the sub interpreter
+      PyThreadState_Clear(state);
+      PyThreadState_DeleteCurrent();
+      if (previous) {
+        PyEval_RestoreThread(previous);
+      }
+      DEBUG_PRINT(Debug::Gil, "<--| Re-release sub GIL | " + name);
     } else {
       DEBUG_PRINT(Debug::Gil, "?--| (Release) GIL | " + name);
     }
@@ -76,6 +109,12 @@ public:
 private:
   std::string name;
   py::gil_scoped_acquire *gil = nullptr;
+
+  /// @brief temporary thread state of a sub interpreter, owned by this scope
+  PyThreadState *state = nullptr;
+
+  /// @brief thread state that was active before acquiring a sub interpreter
+  PyThreadState *previous = nullptr;
 };
 }; // namespace Module
 
@@ -35,6 +35,7 @@
 
 #include <utility>
 
+#include "module/Interpreter.h"
 #include "types.h"
 
 namespace Module {
@@ -44,12 +45,18 @@ namespace Module {
  *
  * @brief The ScopedGilRelease class is used to release the Global Interpreter
  * Lock (GIL) in Python, and re-acquire it when the scope ends.
+ *
+ * A thread state of a sub interpreter is released directly, since the
+ * PyGILState API only supports the main interpreter.
  */
 class ScopedGilRelease {
 public:
   inline explicit ScopedGilRelease(std::string callback_name)
       : name(std::move(callback_name)) {
-    if (PyGILState_Check()) {
+    if (!Interpreter_isMain(Interpreter_current())) {
+      state = PyEval_SaveThread();
+      DEBUG_PRINT(Debug::Gil, "<--| Release sub GIL | " + name);
+    } else if (PyGILState_Check()) {
       gil = new py::gil_scoped_release(false);
       DEBUG_PRINT(Debug::Gil, "<--| Release GIL | " + name);
     } else {
@@ -61,6 +68,9 @@ public:
     if (gil) {
       delete gil;
       DEBUG_PRINT(Debug::Gil, +"-->| Re-acquire GIL | " + name);
+    } else if (state) {
+      PyEval_RestoreThread(state);
+      DEBUG_PRINT(Debug::Gil, "-->| Re-acquire sub GIL | " + name);
     } else {
       DEBUG_PRINT(Debug::Gil, "--?| (Re-Acquire) GIL | " + name);
     }
@@ -73,6 +83,9 @@ public:
 private:
   std::string name;
   py::gil_scoped_release *gil = nullptr;
+
+  /// @brief released thread state of a sub interpreter
+  PyThreadState *state = nullptr;
 };
 
 } // namespace Module
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandPolicy.cpp
+ * @brief declarative native handling of received commands
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "object/CommandPolicy.h"
+#include "object/InfoTraits.h"
+
+using namespace Object;
+
+void CommandPolicy::configure(const bool mirrorValue,
+                              const std::optional<double> min_value,
+                              const std::optional<double> max_value,
+                              const std::uint_fast32_t min_interval_ms,
+                              const bool reject_invalid_quality) {
+  if (min_value.has_value() && max_value.has_value() &&
+      min_value.value() > max_value.value()) {
+    throw std::invalid_argument("min_value must not be greater than max_value");
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  mirror.store(mirrorValue);
+  minValue = min_value;
+  maxValue = max_value;
+  minInterval_ms = min_interval_ms;
+  rejectInvalidQuality = reject_invalid_quality;
+  acceptedAt.reset();
+  accepted = mirrored = 0;
+  rejectedRange = rejectedRate = rejectedQuality = rejectedMirror = 0;
+  active.store(true);
+}
+
+void CommandPolicy::clear() {
+  active.store(false);
+  mirror.store(false);
+}
+
+bool CommandPolicy::isActive() const { return active.load(); }
+
+bool CommandPolicy::isMirror() const { return mirror.load(); }
+
+CommandPolicy::Verdict
+CommandPolicy::evaluate(const IEC60870_5_TypeID type,
+                        const std::shared_ptr<Information> &command,
+                        const std::shared_ptr<Information> &related,
+                        const std::chrono::steady_clock::time_point now) {
+  std::optional<double> value;
+  if (command) {
+    visitNative(type, command.get(), [&value](auto *typed) {
+      value = nativeToDouble(typed->getNativeValue());
+    });
+  }
+
+  bool invalid = false;
+  if (related) {
+    auto const quality = related->getQuality();
+    if (auto const *q = std::get_if<Quality>(&quality)) {
+      invalid = ::test(*q, Quality::Invalid);
+    } else if (auto const *b = std::get_if<BinaryCounterQuality>(&quality)) {
+      invalid = ::test(*b, BinaryCounterQuality::Invalid);
+    }
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (value.has_value() &&
+      ((minValue.has_value() && value.value() < minValue.value()) ||
+       (maxValue.has_value() && value.value() > maxValue.value()))) {
+    rejectedRange++;
+    return Verdict::RejectRange;
+  }
+  if (rejectInvalidQuality && invalid) {
+    rejectedQuality++;
+    return Verdict::RejectQuality;
+  }
+  if (minInterval_ms > 0 && acceptedAt.has_value() &&
+      now - acceptedAt.value() < std::chrono::milliseconds(minInterval_ms)) {
+    rejectedRate++;
+    return Verdict::RejectRate;
+  }
+  acceptedAt = now;
+  accepted++;
+  return Verdict::Accept;
+}
+
+void CommandPolicy::recordMirror(const bool success) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (success) {
+    mirrored++;
+  } else {
+    rejectedMirror++;
+  }
+}
+
+py::dict CommandPolicy::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::dict result;
+  result["active"] = active.load();
+  result["mirror"] = mirror.load();
+  result["min_value"] =
+      minValue.has_value() ? py::cast(minValue.value()) : py::none();
+  result["max_value"] =
+      maxValue.has_value() ? py::cast(maxValue.value()) : py::none();
+  result["min_interval_ms"] = minInterval_ms;
+  result["reject_invalid_quality"] = rejectInvalidQuality;
+  result["accepted"] = accepted;
+  result["mirrored"] = mirrored;
+  result["rejected_range"] = rejectedRange;
+  result["rejected_rate"] = rejectedRate;
+  result["rejected_quality"] = rejectedQuality;
+  result["rejected_mirror"] = rejectedMirror;
+  return result;
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandPolicy.h
+ * @brief declarative native handling of received commands
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_OBJECT_COMMANDPOLICY_H
+#define C104_OBJECT_COMMANDPOLICY_H
+
+#include <optional>
+
+#include "module/GilAwareMutex.h"
+#include "object/Information.h"
+#include "types.h"
+
+namespace Object {
+
+/**
+ * @brief validation rules and an optional mirror action of a server-sided
+ * command point that are evaluated without acquiring the GIL
+ */
+class CommandPolicy {
+public:
+  /// @brief result of the rule evaluation
+  enum class Verdict {
+    /// @brief all rules passed
+    Accept,
+    /// @brief value is outside of the configured range
+    RejectRange,
+    /// @brief command arrived before the minimum interval elapsed
+    RejectRate,
+    /// @brief related monitoring point has an invalid quality
+    RejectQuality
+  };
+
+  /**
+   * @brief activate the policy, counters are reset
+   * @param mirror copy the commanded value into the related monitoring point
+   * and respond without calling python
+   * @param min_value lowest accepted value, if any
+   * @param max_value highest accepted value, if any
+   * @param min_interval_ms minimum time between two accepted commands
+   * @param reject_invalid_quality reject commands while the related
+   * monitoring point has an invalid quality
+   * @throws std::invalid_argument if min_value is greater than max_value
+   */
+  void configure(bool mirror, std::optional<double> min_value,
+                 std::optional<double> max_value,
+                 std::uint_fast32_t min_interval_ms,
+                 bool reject_invalid_quality);
+
+  /**
+   * @brief deactivate the policy, commands are handled by python only
+   */
+  void clear();
+
+  bool isActive() const;
+
+  bool isMirror() const;
+
+  /**
+   * @brief evaluate all rules, an accepted command starts the minimum interval
+   * @param type type of the command point
+   * @param command received command information
+   * @param related information of the related monitoring point, if any
+   * @param now time of reception
+   * @return verdict of the first rule that failed or Accept
+   */
+  Verdict evaluate(IEC60870_5_TypeID type,
+                   const std::shared_ptr<Information> &command,
+                   const std::shared_ptr<Information> &related,
+                   std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief count the result of a mirror action
+   * @param success if the value was copied into the related point
+   */
+  void recordMirror(bool success);
+
+  /**
+   * @brief Getter for configuration and counters as python dictionary
+   * @return dict with active, mirror, min_value, max_value, min_interval_ms,
+   * reject_invalid_quality, accepted, mirrored, rejected_range,
+   * rejected_rate, rejected_quality and rejected_mirror
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief MUTEX Lock to access configuration and counters
+  mutable Module::GilAwareMutex access_mutex{"CommandPolicy::access_mutex"};
+
+  std::atomic_bool active{false};
+
+  std::atomic_bool mirror{false};
+
+  std::optional<double> minValue{};
+
+  std::optional<double> maxValue{};
+
+  std::uint_fast32_t minInterval_ms{0};
+
+  bool rejectInvalidQuality{false};
+
+  /// @brief reception time of the last accepted command
+  std::optional<std::chrono::steady_clock::time_point> acceptedAt{};
+
+  std::uint_fast64_t accepted{0};
+  std::uint_fast64_t mirrored{0};
+  std::uint_fast64_t rejectedRange{0};
+  std::uint_fast64_t rejectedRate{0};
+  std::uint_fast64_t rejectedQuality{0};
+  std::uint_fast64_t rejectedMirror{0};
+};
+
+} // namespace Object
+
+#endif // C104_OBJECT_COMMANDPOLICY_H
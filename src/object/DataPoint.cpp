@@ -37,6 +37,8 @@
 #include "remote/Connection.h"
 #include "remote/message/IncomingMessage.h"
 
+#include <limits>
+
 using namespace Object;
 
 DataPoint::DataPoint(const std::uint_fast32_t dp_ioa,
@@ -308,6 +310,69 @@ void DataPoint::setRelatedInformationObjectAutoReturn(const bool auto_return) {
   relatedInformationObjectAutoReturn.store(auto_return);
 }
 
+bool DataPoint::insertTagId(const TagId id) {
+  std::lock_guard<std::mutex> const lock(tags_mutex);
+  auto it = std::lower_bound(tags.begin(), tags.end(), id);
+  if (it != tags.end() && *it == id) {
+    return false;
+  }
+  tags.insert(it, id);
+  return true;
+}
+
+bool DataPoint::eraseTagId(const TagId id) {
+  std::lock_guard<std::mutex> const lock(tags_mutex);
+  auto it = std::lower_bound(tags.begin(), tags.end(), id);
+  if (it == tags.end() || *it != id) {
+    return false;
+  }
+  tags.erase(it);
+  return true;
+}
+
+void DataPoint::addTag(const std::string &tag) {
+  auto const id = Tag_intern(tag);
+  if (auto st = getStation()) {
+    st->tagPoint(shared_from_this(), id);
+    return;
+  }
+  insertTagId(id);
+}
+
+bool DataPoint::removeTag(const std::string &tag) {
+  auto const id = Tag_find(tag);
+  if (!id.has_value()) {
+    return false;
+  }
+  if (auto st = getStation()) {
+    return st->untagPoint(shared_from_this(), id.value());
+  }
+  return eraseTagId(id.value());
+}
+
+bool DataPoint::hasTag(const std::string &tag) const {
+  auto const id = Tag_find(tag);
+  return id.has_value() && hasTagId(id.value());
+}
+
+bool DataPoint::hasTagId(const TagId id) const {
+  std::lock_guard<std::mutex> const lock(tags_mutex);
+  return std::binary_search(tags.begin(), tags.end(), id);
+}
+
+std::vector<std::string> DataPoint::getTags() const {
+  std::vector<std::string> result;
+  for (auto const id : getTagIds()) {
+    result.push_back(Tag_toString(id));
+  }
+  return result;
+}
+
+TagIdVector DataPoint::getTagIds() const {
+  std::lock_guard<std::mutex> const lock(tags_mutex);
+  return tags;
+}
+
 CommandTransmissionMode DataPoint::getCommandMode() const {
   return commandMode.load();
 }
@@ -321,6 +386,34 @@ void DataPoint::setCommandMode(const CommandTransmissionMode mode) {
   commandMode.store(mode);
 }
 
+void DataPoint::setCommandPolicy(const bool mirror,
+                                 const std::optional<double> min_value,
+                                 const std::optional<double> max_value,
+                                 const std::uint_fast32_t min_interval_ms,
+                                 const bool reject_invalid_quality) {
+  if (!is_server) {
+    throw std::invalid_argument(
+        "Command policy option is only allowed for server-sided points");
+  }
+  if (type < C_SC_NA_1 || type > C_BO_TA_1) {
+    throw std::invalid_argument("Command policy option is only allowed for "
+                                "control types, but not for " +
+                                std::string(TypeID_toString(type)));
+  }
+  if (mirror && (C_RC_NA_1 == type || C_RC_TA_1 == type)) {
+    throw std::invalid_argument(
+        "Step commands cannot be mirrored into a related point");
+  }
+  commandPolicy.configure(mirror, min_value, max_value, min_interval_ms,
+                          reject_invalid_quality);
+}
+
+void DataPoint::clearCommandPolicy() { commandPolicy.clear(); }
+
+const CommandPolicy &DataPoint::getCommandPolicy() const {
+  return commandPolicy;
+}
+
 std::optional<std::uint_fast8_t> DataPoint::getSelectedByOriginatorAddress() {
   if (auto st = getStation()) {
     if (auto server = st->getServer()) {
@@ -985,39 +1078,17 @@ InfoValue DataPoint::getValue() { return info->getValue(); }
 
 void DataPoint::setValue(const InfoValue new_value) {
   info->setValue(new_value);
-  switch (type) {
-  case M_SP_TB_1:
-  case C_SC_TA_1:
-  case M_DP_TB_1:
-  case C_DC_TA_1:
-  case M_ST_TB_1:
-  case C_RC_TA_1:
-  case M_ME_TD_1:
-  case C_SE_TA_1:
-  case M_ME_TE_1:
-  case C_SE_TB_1:
-  case M_ME_TF_1:
-  case C_SE_TC_1:
-  case M_BO_TB_1:
-  case C_BO_TA_1:
-  case M_IT_TB_1:
-  case M_EP_TD_1:
-  case M_EP_TE_1:
-  case M_EP_TF_1:
-    info->setRecordedAt(std::chrono::system_clock::now());
-    DEBUG_PRINT(
-        Debug::Point,
-        "Injecting current local timestamp into information for [c104.Type." +
-            std::string(TypeID_toString(type)) + "] at IOA " +
-            std::to_string(informationObjectAddress));
-    break;
-  }
+  injectRecordedAt(info.get());
 }
 
 InfoQuality DataPoint::getQuality() { return info->getQuality(); }
 
 void DataPoint::setQuality(const InfoQuality new_Quality) {
   info->setQuality(new_Quality);
+  injectRecordedAt(info.get());
+}
+
+void DataPoint::injectRecordedAt(Information *current) {
   switch (type) {
   case M_SP_TB_1:
   case C_SC_TA_1:
@@ -1037,7 +1108,7 @@ void DataPoint::setQuality(const InfoQuality new_Quality) {
   case M_EP_TD_1:
   case M_EP_TE_1:
   case M_EP_TF_1:
-    info->setRecordedAt(std::chrono::system_clock::now());
+    current->setRecordedAt(std::chrono::system_clock::now());
     DEBUG_PRINT(
         Debug::Point,
         "Injecting current local timestamp into information for [c104.Type." +
@@ -1092,14 +1163,102 @@ std::uint_fast16_t DataPoint::getTimerInterval_ms() const {
 }
 
 void DataPoint::setOnReceiveCallback(py::object &callable) {
-  py_onReceive.reset(callable);
+  py::object none = py::none();
+  if (py_onReceiveValue.matches(callable)) {
+    py_onReceive.reset(none);
+    py_onReceiveValue.reset(callable);
+  } else {
+    py_onReceiveValue.reset(none);
+    py_onReceive.reset(callable);
+  }
 }
 
 CommandResponseState DataPoint::onReceive(
     std::shared_ptr<Remote::Message::IncomingMessage> message) {
+  if (is_server && commandPolicy.isActive()) {
+    std::shared_ptr<DataPoint> related;
+    auto const related_ioa = getRelatedInformationObjectAddress();
+    auto const owner = getStation();
+    if (related_ioa.has_value() && owner) {
+      related = owner->getPoint(related_ioa.value());
+    }
+
+    auto const verdict = commandPolicy.evaluate(
+        type, message->getInfo(), related ? related->getInfo() : nullptr,
+        std::chrono::steady_clock::now());
+    if (verdict != CommandPolicy::Verdict::Accept) {
+      DEBUG_PRINT(Debug::Point, "on_receive] Command rejected by policy at "
+                                "IOA " +
+                                    std::to_string(informationObjectAddress));
+      return RESPONSE_STATE_FAILURE;
+    }
+
+    if (commandPolicy.isMirror()) {
+      bool mirrored = false;
+      if (related) {
+        try {
+          related->setValue(message->getInfo()->getValue());
+          mirrored = true;
+        } catch (const std::exception &e) {
+          DEBUG_PRINT(Debug::Point,
+                      "on_receive] Cannot mirror command: " +
+                          std::string(e.what()));
+        }
+      }
+      commandPolicy.recordMirror(mirrored);
+      if (!mirrored) {
+        return RESPONSE_STATE_FAILURE;
+      }
+      info = message->getInfo();
+      return RESPONSE_STATE_SUCCESS;
+    }
+  }
+
   auto prev = std::move(info);
   info = message->getInfo();
 
+  if (py_onReceiveValue.is_set()) {
+    // convert without the GIL, the callable receives scalars only
+    double value = std::numeric_limits<double>::quiet_NaN();
+    std::uint_fast16_t quality = 0;
+    if (!visitNative(message->getType(), info.get(),
+                     [&value, &quality](auto *typed) {
+                       using INFO = std::remove_pointer_t<decltype(typed)>;
+                       value = nativeToDouble(typed->getNativeValue());
+                       if constexpr (HasNativeQuality<INFO>::value) {
+                         quality = static_cast<std::uint_fast16_t>(
+                             typed->getNativeQuality());
+                       }
+                     })) {
+      DEBUG_PRINT(Debug::Point, "on_receive] No scalar value for type " +
+                                    std::string(TypeID_toString(
+                                        message->getType())));
+    }
+    std::int_fast64_t recorded_at_ms = 0;
+    auto const &recorded = info->getRecordedAt();
+    if (recorded.has_value()) {
+      recorded_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           recorded->time_since_epoch())
+                           .count();
+    }
+
+    DEBUG_PRINT(Debug::Point, "CALLBACK on_receive at IOA " +
+                                  std::to_string(informationObjectAddress));
+    Module::ScopedGilAcquire const scoped("Point.on_receive");
+
+    if (py_onReceiveValue.call(informationObjectAddress, value, quality,
+                               recorded_at_ms)) {
+      try {
+        return py_onReceiveValue.getResult();
+      } catch (const std::exception &e) {
+        DEBUG_PRINT(Debug::Point, "on_receive] Invalid callback result: " +
+                                      std::string(e.what()));
+        return RESPONSE_STATE_FAILURE;
+      }
+    }
+    return RESPONSE_STATE_SUCCESS;
+  }
+
   if (py_onReceive.is_set()) {
     DEBUG_PRINT(Debug::Point, "CALLBACK on_receive at IOA " +
                                   std::to_string(informationObjectAddress));
@@ -1233,3 +1392,19 @@ bool DataPoint::transmit(const CS101_CauseOfTransmission cause) {
   }
   return connection->transmit(shared_from_this(), cause);
 }
+
+void DataPoint::prepareCommand() {
+  auto _station = getStation();
+  if (!_station) {
+    throw std::invalid_argument("Station reference deleted");
+  }
+  if (_station->isLocal()) {
+    throw std::invalid_argument(
+        "Command templates are only available for client-sided points");
+  }
+  auto connection = _station->getConnection();
+  if (!connection) {
+    throw std::invalid_argument("Client connection reference deleted");
+  }
+  connection->prepareCommand(shared_from_this());
+}
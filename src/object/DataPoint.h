@@ -34,7 +34,10 @@
 
 #include "module/Callback.h"
 #include "module/ScopedGilAcquire.h"
+#include "object/CommandPolicy.h"
+#include "object/InfoTraits.h"
 #include "object/Information.h"
+#include "object/Tag.h"
 #include "types.h"
 
 namespace Object {
@@ -136,12 +139,61 @@ private:
 
   std::atomic<std::chrono::steady_clock::time_point> timerNext{};
 
+  /// @brief native command handling rules (only server-sided control points)
+  CommandPolicy commandPolicy{};
+
+  /// @brief sorted interned tags, the station index is updated via Station
+  TagIdVector tags{};
+
+  /// @brief mutex to lock tags access
+  mutable std::mutex tags_mutex{};
+
+  /**
+   * @brief add a tag identifier to the sorted list
+   * @return if the tag was not set before
+   */
+  bool insertTagId(TagId id);
+
+  /**
+   * @brief remove a tag identifier from the sorted list
+   * @return if the tag was set before
+   */
+  bool eraseTagId(TagId id);
+
+  /**
+   * @brief cast the information for typed access
+   * @throws std::invalid_argument if TYPE is not the type of this point
+   */
+  template <IEC60870_5_TypeID TYPE>
+  typename InfoTraits<TYPE>::type *nativeInfo(Information *current) const {
+    if (TYPE != type) {
+      throw std::invalid_argument(
+          "Point is of type [c104.Type." + std::string(TypeID_toString(type)) +
+          "], not [c104.Type." + std::string(TypeID_toString(TYPE)) + "]");
+    }
+    return infoCast<TYPE>(current);
+  }
+
+  /**
+   * @brief set recorded_at to the current time for types with timestamp
+   */
+  void injectRecordedAt(Information *current);
+
+  friend class Station;
+
   /// @brief python callback function pointer
   Module::Callback<CommandResponseState> py_onReceive{
       "Point.on_receive",
       "(point: c104.Point, previous_info: c104.Information, message: "
       "c104.IncomingMessage) -> c104.ResponseState"};
 
+  /// @brief python callback function pointer, lightweight variant of
+  /// on_receive that receives plain scalars instead of wrapped objects
+  Module::Callback<CommandResponseState> py_onReceiveValue{
+      "Point.on_receive",
+      "(io_address: int, value: float, quality: int, recorded_at_ms: int) -> "
+      "c104.ResponseState"};
+
   /// @brief python callback function pointer
   Module::Callback<void> py_onBeforeRead{"Point.on_before_read",
                                          "(point: c104.Point) -> None"};
@@ -207,6 +259,35 @@ public:
    */
   void setCommandMode(CommandTransmissionMode mode);
 
+  /**
+   * @brief Handle received commands natively: validate the value range, the
+   * rate and the quality of the related monitoring point and optionally mirror
+   * the value into the related point without calling python
+   * @param mirror copy the commanded value into the related monitoring point
+   * and respond with success without calling on_receive
+   * @param min_value lowest accepted value, if any
+   * @param max_value highest accepted value, if any
+   * @param min_interval_ms minimum time between two accepted commands
+   * @param reject_invalid_quality reject commands while the related
+   * monitoring point has an invalid quality
+   * @throws std::invalid_argument if not a server-sided control point, mirror
+   * is requested for a step command or the range is invalid
+   */
+  void setCommandPolicy(bool mirror, std::optional<double> min_value,
+                        std::optional<double> max_value,
+                        std::uint_fast32_t min_interval_ms,
+                        bool reject_invalid_quality);
+
+  /**
+   * @brief Remove the command policy, commands are handled by on_receive only
+   */
+  void clearCommandPolicy();
+
+  /**
+   * @brief Getter for the command policy configuration and counters
+   */
+  const CommandPolicy &getCommandPolicy() const;
+
   /**
    * @brief Get select-and-execute lock originator address
    * @return client originator address or zero if no active selection lock
@@ -214,6 +295,44 @@ public:
    */
   std::optional<std::uint_fast8_t> getSelectedByOriginatorAddress();
 
+  /**
+   * @brief Add a tag to this point, the parent station indexes the point by
+   * this tag
+   * @param tag tag name
+   * @throws std::invalid_argument if tag is empty
+   */
+  void addTag(const std::string &tag);
+
+  /**
+   * @brief Remove a tag from this point
+   * @param tag tag name
+   * @return if the tag was set before
+   */
+  bool removeTag(const std::string &tag);
+
+  /**
+   * @brief Test if this point has a tag
+   * @param tag tag name
+   */
+  bool hasTag(const std::string &tag) const;
+
+  /**
+   * @brief Test if this point has a tag
+   * @param id tag identifier
+   */
+  bool hasTagId(TagId id) const;
+
+  /**
+   * @brief Get all tags of this point
+   * @return tag names sorted by first use
+   */
+  std::vector<std::string> getTags() const;
+
+  /**
+   * @brief Get all tag identifiers of this point
+   */
+  TagIdVector getTagIds() const;
+
   IEC60870_5_TypeID getType() const;
 
   /**
@@ -256,6 +375,55 @@ public:
    */
   void setQuality(InfoQuality new_value);
 
+  /**
+   * @brief Get point value without InfoValue conversion
+   * @tparam TYPE type of this point, selects the value_type via InfoTraits
+   * @throws std::invalid_argument if TYPE is not the type of this point
+   */
+  template <IEC60870_5_TypeID TYPE>
+  [[nodiscard]] typename InfoTraits<TYPE>::value_type getNativeValue() const {
+    auto const current = info;
+    return nativeInfo<TYPE>(current.get())->getNativeValue();
+  }
+
+  /**
+   * @brief Set point value without InfoValue conversion
+   * @tparam TYPE type of this point, selects the value_type via InfoTraits
+   * @throws std::invalid_argument if TYPE is not the type of this point
+   * @throws std::out_of_range if the value exceeds the limits of the type
+   */
+  template <IEC60870_5_TypeID TYPE>
+  void setNativeValue(const typename InfoTraits<TYPE>::value_type value) {
+    auto const current = info;
+    nativeInfo<TYPE>(current.get())->setNativeValue(value);
+    injectRecordedAt(current.get());
+  }
+
+  /**
+   * @brief Get point quality without InfoQuality conversion
+   * @tparam TYPE monitoring type of this point
+   * @throws std::invalid_argument if TYPE is not the type of this point
+   */
+  template <IEC60870_5_TypeID TYPE>
+  [[nodiscard]] typename InfoTraits<TYPE>::type::quality_type
+  getNativeQuality() const {
+    auto const current = info;
+    return nativeInfo<TYPE>(current.get())->getNativeQuality();
+  }
+
+  /**
+   * @brief Set point quality without InfoQuality conversion
+   * @tparam TYPE monitoring type of this point
+   * @throws std::invalid_argument if TYPE is not the type of this point
+   */
+  template <IEC60870_5_TypeID TYPE>
+  void setNativeQuality(
+      const typename InfoTraits<TYPE>::type::quality_type value) {
+    auto const current = info;
+    nativeInfo<TYPE>(current.get())->setNativeQuality(value);
+    injectRecordedAt(current.get());
+  }
+
   /**
    * @brief get timestamp bundled with value
    * @return milliseconds since unix-epoch
@@ -295,6 +463,11 @@ public:
 
   /**
    * @brief set python callback that will be executed on every incoming message
+   *
+   * A callable with the lightweight signature (io_address, value, quality,
+   * recorded_at_ms) is dispatched with plain scalars, every other callable
+   * must match the full signature (point, previous_info, message).
+   *
    * @throws std::invalid_argument if callable signature does not match
    */
   void setOnReceiveCallback(py::object &callable);
@@ -356,6 +529,14 @@ public:
    */
   bool transmit(CS101_CauseOfTransmission cause = CS101_COT_UNKNOWN_COT);
 
+  /**
+   * @brief encode the command frame of this client-sided control point once,
+   * later transmissions only patch value and timestamp
+   * @throws std::invalid_argument if parent station or connection reference is
+   * invalid, called from server context or type is not a command
+   */
+  void prepareCommand();
+
   std::string toString() const {
     std::ostringstream oss;
     oss << "<c104.Point io_address=" << std::to_string(informationObjectAddress)
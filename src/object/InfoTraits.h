@@ -0,0 +1,206 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file InfoTraits.h
+ * @brief typed access to point information by IEC60870-5 type id
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_OBJECT_INFOTRAITS_H
+#define C104_OBJECT_INFOTRAITS_H
+
+#include "object/Information.h"
+
+namespace Object {
+
+/**
+ * @brief Information class of a type id
+ *
+ * The information classes provide getNativeValue/setNativeValue (and
+ * getNativeQuality/setNativeQuality for monitoring information) that read and
+ * write the stored value as value_type (bool, float, std::int16_t, ...)
+ * without converting it into the InfoValue variant. The variant is only used
+ * at the python boundary.
+ */
+template <IEC60870_5_TypeID TYPE> struct InfoTraits;
+
+#define C104_INFO_TRAITS(TYPE, INFO)                                           \
+  template <> struct InfoTraits<TYPE> {                                        \
+    using type = INFO;                                                         \
+    using value_type = INFO::value_type;                                       \
+  };
+
+C104_INFO_TRAITS(M_SP_NA_1, SingleInfo)
+C104_INFO_TRAITS(M_SP_TB_1, SingleInfo)
+C104_INFO_TRAITS(M_DP_NA_1, DoubleInfo)
+C104_INFO_TRAITS(M_DP_TB_1, DoubleInfo)
+C104_INFO_TRAITS(M_ST_NA_1, StepInfo)
+C104_INFO_TRAITS(M_ST_TB_1, StepInfo)
+C104_INFO_TRAITS(M_BO_NA_1, BinaryInfo)
+C104_INFO_TRAITS(M_BO_TB_1, BinaryInfo)
+C104_INFO_TRAITS(M_ME_NA_1, NormalizedInfo)
+C104_INFO_TRAITS(M_ME_TD_1, NormalizedInfo)
+C104_INFO_TRAITS(M_ME_ND_1, NormalizedInfo)
+C104_INFO_TRAITS(M_ME_NB_1, ScaledInfo)
+C104_INFO_TRAITS(M_ME_TE_1, ScaledInfo)
+C104_INFO_TRAITS(M_ME_NC_1, ShortInfo)
+C104_INFO_TRAITS(M_ME_TF_1, ShortInfo)
+C104_INFO_TRAITS(M_IT_NA_1, BinaryCounterInfo)
+C104_INFO_TRAITS(M_IT_TB_1, BinaryCounterInfo)
+C104_INFO_TRAITS(M_EP_TD_1, ProtectionEquipmentEventInfo)
+C104_INFO_TRAITS(M_EP_TE_1, ProtectionEquipmentStartEventsInfo)
+C104_INFO_TRAITS(M_EP_TF_1, ProtectionEquipmentOutputCircuitInfo)
+C104_INFO_TRAITS(M_PS_NA_1, StatusWithChangeDetection)
+C104_INFO_TRAITS(C_SC_NA_1, SingleCmd)
+C104_INFO_TRAITS(C_SC_TA_1, SingleCmd)
+C104_INFO_TRAITS(C_DC_NA_1, DoubleCmd)
+C104_INFO_TRAITS(C_DC_TA_1, DoubleCmd)
+C104_INFO_TRAITS(C_RC_NA_1, StepCmd)
+C104_INFO_TRAITS(C_RC_TA_1, StepCmd)
+C104_INFO_TRAITS(C_SE_NA_1, NormalizedCmd)
+C104_INFO_TRAITS(C_SE_TA_1, NormalizedCmd)
+C104_INFO_TRAITS(C_SE_NB_1, ScaledCmd)
+C104_INFO_TRAITS(C_SE_TB_1, ScaledCmd)
+C104_INFO_TRAITS(C_SE_NC_1, ShortCmd)
+C104_INFO_TRAITS(C_SE_TC_1, ShortCmd)
+C104_INFO_TRAITS(C_BO_NA_1, BinaryCmd)
+C104_INFO_TRAITS(C_BO_TA_1, BinaryCmd)
+
+#undef C104_INFO_TRAITS
+
+/// @brief test if an information class provides getNativeQuality
+template <typename INFO, typename = void>
+struct HasNativeQuality : std::false_type {};
+
+template <typename INFO>
+struct HasNativeQuality<INFO, std::void_t<typename INFO::quality_type>>
+    : std::true_type {};
+
+/// @brief convert a native value to double, enums via their underlying value
+template <typename T> double nativeToDouble(const T value) {
+  if constexpr (std::is_enum_v<T>) {
+    return static_cast<std::underlying_type_t<T>>(value);
+  } else {
+    return value;
+  }
+}
+
+/**
+ * @brief cast an information to the class of a type id
+ * @throws std::invalid_argument if the information is of another class
+ */
+template <IEC60870_5_TypeID TYPE>
+typename InfoTraits<TYPE>::type *infoCast(Information *info) {
+  auto *typed = dynamic_cast<typename InfoTraits<TYPE>::type *>(info);
+  if (!typed) {
+    throw std::invalid_argument(
+        "[c104.Type." + std::string(TypeID_toString(TYPE)) +
+        "] requires Information of type " + InfoTraits<TYPE>::type::name());
+  }
+  return typed;
+}
+
+/**
+ * @brief call a generic callable with the information casted to the class of
+ * a type id
+ * @return false if the type id is unsupported or the information is of another
+ * class, the callable is not invoked in that case
+ */
+template <typename F>
+bool visitNative(const IEC60870_5_TypeID type, Information *info, F &&f) {
+  auto const call = [info, &f](auto *typed) {
+    using INFO = std::remove_pointer_t<decltype(typed)>;
+    auto *casted = dynamic_cast<INFO *>(info);
+    if (!casted) {
+      return false;
+    }
+    f(casted);
+    return true;
+  };
+
+  switch (type) {
+  case M_SP_NA_1:
+  case M_SP_TB_1:
+    return call(static_cast<SingleInfo *>(nullptr));
+  case M_DP_NA_1:
+  case M_DP_TB_1:
+    return call(static_cast<DoubleInfo *>(nullptr));
+  case M_ST_NA_1:
+  case M_ST_TB_1:
+    return call(static_cast<StepInfo *>(nullptr));
+  case M_BO_NA_1:
+  case M_BO_TB_1:
+    return call(static_cast<BinaryInfo *>(nullptr));
+  case M_ME_NA_1:
+  case M_ME_TD_1:
+  case M_ME_ND_1:
+    return call(static_cast<NormalizedInfo *>(nullptr));
+  case M_ME_NB_1:
+  case M_ME_TE_1:
+    return call(static_cast<ScaledInfo *>(nullptr));
+  case M_ME_NC_1:
+  case M_ME_TF_1:
+    return call(static_cast<ShortInfo *>(nullptr));
+  case M_IT_NA_1:
+  case M_IT_TB_1:
+    return call(static_cast<BinaryCounterInfo *>(nullptr));
+  case M_EP_TD_1:
+    return call(static_cast<ProtectionEquipmentEventInfo *>(nullptr));
+  case M_EP_TE_1:
+    return call(static_cast<ProtectionEquipmentStartEventsInfo *>(nullptr));
+  case M_EP_TF_1:
+    return call(static_cast<ProtectionEquipmentOutputCircuitInfo *>(nullptr));
+  case M_PS_NA_1:
+    return call(static_cast<StatusWithChangeDetection *>(nullptr));
+  case C_SC_NA_1:
+  case C_SC_TA_1:
+    return call(static_cast<SingleCmd *>(nullptr));
+  case C_DC_NA_1:
+  case C_DC_TA_1:
+    return call(static_cast<DoubleCmd *>(nullptr));
+  case C_RC_NA_1:
+  case C_RC_TA_1:
+    return call(static_cast<StepCmd *>(nullptr));
+  case C_SE_NA_1:
+  case C_SE_TA_1:
+    return call(static_cast<NormalizedCmd *>(nullptr));
+  case C_SE_NB_1:
+  case C_SE_TB_1:
+    return call(static_cast<ScaledCmd *>(nullptr));
+  case C_SE_NC_1:
+  case C_SE_TC_1:
+    return call(static_cast<ShortCmd *>(nullptr));
+  case C_BO_NA_1:
+  case C_BO_TA_1:
+    return call(static_cast<BinaryCmd *>(nullptr));
+  default:
+    return false;
+  }
+}
+
+} // namespace Object
+
+#endif // C104_OBJECT_INFOTRAITS_H
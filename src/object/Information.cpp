@@ -73,6 +73,13 @@ void Information::setValue(const InfoValue val) {
   }
 };
 
+std::unique_lock<std::mutex> Information::lockNativeWrite() {
+  if (readonly) {
+    throw std::logic_error("Information is read-only!");
+  }
+  return std::unique_lock<std::mutex>(mtx);
+}
+
 InfoQuality Information::getQuality() {
   std::lock_guard<std::mutex> lock(mtx);
   return getQualityImpl();
@@ -146,6 +153,26 @@ void SingleInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+SingleInfo::value_type SingleInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return on;
+}
+
+void SingleInfo::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  on = value;
+}
+
+SingleInfo::quality_type SingleInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void SingleInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string SingleInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " on=" << bool_toString(on)
@@ -158,6 +185,16 @@ InfoValue SingleCmd::getValueImpl() const { return on; }
 
 void SingleCmd::setValueImpl(const InfoValue val) { on = std::get<bool>(val); }
 
+SingleCmd::value_type SingleCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return on;
+}
+
+void SingleCmd::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  on = value;
+}
+
 std::string SingleCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " on=" << bool_toString(on)
@@ -178,6 +215,26 @@ void DoubleInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+DoubleInfo::value_type DoubleInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return state;
+}
+
+void DoubleInfo::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  state = value;
+}
+
+DoubleInfo::quality_type DoubleInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void DoubleInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string DoubleInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " state=" << DoublePointValue_toString(state)
@@ -192,6 +249,16 @@ void DoubleCmd::setValueImpl(const InfoValue val) {
   state = std::get<DoublePointValue>(val);
 }
 
+DoubleCmd::value_type DoubleCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return state;
+}
+
+void DoubleCmd::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  state = value;
+}
+
 std::string DoubleCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " state=" << DoublePointValue_toString(state)
@@ -212,6 +279,27 @@ void StepInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+StepInfo::value_type StepInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return position.get();
+}
+
+void StepInfo::setNativeValue(const value_type value) {
+  LimitedInt7 const checked(value);
+  auto const lock = lockNativeWrite();
+  position = checked;
+}
+
+StepInfo::quality_type StepInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void StepInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string StepInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " position=" << std::to_string(position.get())
@@ -227,6 +315,16 @@ void StepCmd::setValueImpl(const InfoValue val) {
   step = std::get<StepCommandValue>(val);
 }
 
+StepCmd::value_type StepCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return step;
+}
+
+void StepCmd::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  step = value;
+}
+
 std::string StepCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " step=" << StepCommandValue_toString(step)
@@ -247,6 +345,27 @@ void BinaryInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+BinaryInfo::value_type BinaryInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return blob.get();
+}
+
+void BinaryInfo::setNativeValue(const value_type value) {
+  Byte32 const checked(value);
+  auto const lock = lockNativeWrite();
+  blob = checked;
+}
+
+BinaryInfo::quality_type BinaryInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void BinaryInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string BinaryInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " blob=" << Byte32_toString(blob)
@@ -261,6 +380,17 @@ void BinaryCmd::setValueImpl(const InfoValue val) {
   blob = std::get<Byte32>(val);
 }
 
+BinaryCmd::value_type BinaryCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return blob.get();
+}
+
+void BinaryCmd::setNativeValue(const value_type value) {
+  Byte32 const checked(value);
+  auto const lock = lockNativeWrite();
+  blob = checked;
+}
+
 std::string BinaryCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " blob=" << Byte32_toString(blob) << ", "
@@ -280,6 +410,27 @@ void NormalizedInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+NormalizedInfo::value_type NormalizedInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return actual.get();
+}
+
+void NormalizedInfo::setNativeValue(const value_type value) {
+  NormalizedFloat const checked(value);
+  auto const lock = lockNativeWrite();
+  actual = checked;
+}
+
+NormalizedInfo::quality_type NormalizedInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void NormalizedInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string NormalizedInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " actual=" << std::to_string(actual.get())
@@ -294,6 +445,17 @@ void NormalizedCmd::setValueImpl(const InfoValue val) {
   target = std::get<NormalizedFloat>(val);
 }
 
+NormalizedCmd::value_type NormalizedCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return target.get();
+}
+
+void NormalizedCmd::setNativeValue(const value_type value) {
+  NormalizedFloat const checked(value);
+  auto const lock = lockNativeWrite();
+  target = checked;
+}
+
 std::string NormalizedCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " target=" << std::to_string(target.get())
@@ -314,6 +476,27 @@ void ScaledInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+ScaledInfo::value_type ScaledInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return actual.get();
+}
+
+void ScaledInfo::setNativeValue(const value_type value) {
+  LimitedInt16 const checked(value);
+  auto const lock = lockNativeWrite();
+  actual = checked;
+}
+
+ScaledInfo::quality_type ScaledInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void ScaledInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string ScaledInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " actual=" << std::to_string(actual.get())
@@ -328,6 +511,17 @@ void ScaledCmd::setValueImpl(const InfoValue val) {
   target = std::get<LimitedInt16>(val);
 }
 
+ScaledCmd::value_type ScaledCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return target.get();
+}
+
+void ScaledCmd::setNativeValue(const value_type value) {
+  LimitedInt16 const checked(value);
+  auto const lock = lockNativeWrite();
+  target = checked;
+}
+
 std::string ScaledCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " target=" << std::to_string(target.get())
@@ -348,6 +542,26 @@ void ShortInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+ShortInfo::value_type ShortInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return actual;
+}
+
+void ShortInfo::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  actual = value;
+}
+
+ShortInfo::quality_type ShortInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void ShortInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string ShortInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " actual=" << std::to_string(actual)
@@ -362,6 +576,16 @@ void ShortCmd::setValueImpl(const InfoValue val) {
   target = std::get<float>(val);
 }
 
+ShortCmd::value_type ShortCmd::getNativeValue() {
+  auto const lock = lockNative();
+  return target;
+}
+
+void ShortCmd::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  target = value;
+}
+
 std::string ShortCmd::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " target=" << std::to_string(target)
@@ -382,6 +606,39 @@ void BinaryCounterInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<BinaryCounterQuality>(val);
 }
 
+BinaryCounterInfo::value_type BinaryCounterInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return counter;
+}
+
+void BinaryCounterInfo::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  counter = value;
+}
+
+BinaryCounterInfo::quality_type BinaryCounterInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void BinaryCounterInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
+std::shared_ptr<BinaryCounterInfo> BinaryCounterInfo::freeze(
+    const bool reset, const std::chrono::system_clock::time_point frozen_at) {
+  auto const lock = lockNativeWrite();
+  // sequence notation is a 5 bit counter of freeze operations
+  sequence = LimitedUInt5(static_cast<int>((sequence.get() + 1) % 32));
+  auto frozen = std::make_shared<BinaryCounterInfo>(counter, sequence, quality,
+                                                    frozen_at, true);
+  if (reset) {
+    counter = 0;
+  }
+  return frozen;
+}
+
 std::string BinaryCounterInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " counter=" << std::to_string(counter)
@@ -405,6 +662,28 @@ void ProtectionEquipmentEventInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+ProtectionEquipmentEventInfo::value_type
+ProtectionEquipmentEventInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return state;
+}
+
+void ProtectionEquipmentEventInfo::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  state = value;
+}
+
+ProtectionEquipmentEventInfo::quality_type
+ProtectionEquipmentEventInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void ProtectionEquipmentEventInfo::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string ProtectionEquipmentEventInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " state=" << EventState_toString(state)
@@ -430,6 +709,30 @@ void ProtectionEquipmentStartEventsInfo::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+ProtectionEquipmentStartEventsInfo::value_type
+ProtectionEquipmentStartEventsInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return events;
+}
+
+void ProtectionEquipmentStartEventsInfo::setNativeValue(
+    const value_type value) {
+  auto const lock = lockNativeWrite();
+  events = value;
+}
+
+ProtectionEquipmentStartEventsInfo::quality_type
+ProtectionEquipmentStartEventsInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void ProtectionEquipmentStartEventsInfo::setNativeQuality(
+    const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string ProtectionEquipmentStartEventsInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " events=" << StartEvents_toString(events)
@@ -456,6 +759,30 @@ void ProtectionEquipmentOutputCircuitInfo::setQualityImpl(
   quality = std::get<Quality>(val);
 }
 
+ProtectionEquipmentOutputCircuitInfo::value_type
+ProtectionEquipmentOutputCircuitInfo::getNativeValue() {
+  auto const lock = lockNative();
+  return circuits;
+}
+
+void ProtectionEquipmentOutputCircuitInfo::setNativeValue(
+    const value_type value) {
+  auto const lock = lockNativeWrite();
+  circuits = value;
+}
+
+ProtectionEquipmentOutputCircuitInfo::quality_type
+ProtectionEquipmentOutputCircuitInfo::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void ProtectionEquipmentOutputCircuitInfo::setNativeQuality(
+    const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string ProtectionEquipmentOutputCircuitInfo::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " circuits=" << OutputCircuits_toString(circuits)
@@ -479,6 +806,28 @@ void StatusWithChangeDetection::setQualityImpl(const InfoQuality val) {
   quality = std::get<Quality>(val);
 }
 
+StatusWithChangeDetection::value_type
+StatusWithChangeDetection::getNativeValue() {
+  auto const lock = lockNative();
+  return status;
+}
+
+void StatusWithChangeDetection::setNativeValue(const value_type value) {
+  auto const lock = lockNativeWrite();
+  status = value;
+}
+
+StatusWithChangeDetection::quality_type
+StatusWithChangeDetection::getNativeQuality() {
+  auto const lock = lockNative();
+  return quality;
+}
+
+void StatusWithChangeDetection::setNativeQuality(const quality_type value) {
+  auto const lock = lockNativeWrite();
+  quality = value;
+}
+
 std::string StatusWithChangeDetection::toString() const {
   std::ostringstream oss;
   oss << "<c104." << name() << " status=" << FieldSet16_toString(status)
@@ -59,6 +59,17 @@ protected:
 
   std::string base_toString() const;
 
+  /// @brief lock for native value access of derived classes
+  [[nodiscard]] std::unique_lock<std::mutex> lockNative() {
+    return std::unique_lock<std::mutex>(mtx);
+  }
+
+  /**
+   * @brief lock for native value changes of derived classes
+   * @throws std::logic_error if read-only
+   */
+  [[nodiscard]] std::unique_lock<std::mutex> lockNativeWrite();
+
 public:
   explicit Information(std::optional<std::chrono::system_clock::time_point>
                            recorded_at = std::nullopt,
@@ -135,6 +146,18 @@ public:
 
   [[nodiscard]] bool isOn() const { return on; }
 
+  using value_type = bool;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "SingleInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -181,6 +204,12 @@ public:
     return qualifier;
   }
 
+  using value_type = bool;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "SingleCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -216,6 +245,18 @@ public:
 
   [[nodiscard]] DoublePointValue getState() const { return state; }
 
+  using value_type = DoublePointValue;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "DoubleInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -262,6 +303,12 @@ public:
     return qualifier;
   }
 
+  using value_type = DoublePointValue;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "DoubleCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -304,6 +351,18 @@ public:
 
   [[nodiscard]] bool isTransient() const { return transient; }
 
+  using value_type = std::int8_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "StepInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -350,6 +409,12 @@ public:
     return qualifier;
   }
 
+  using value_type = StepCommandValue;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "StepCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -385,6 +450,18 @@ public:
 
   [[nodiscard]] const Byte32 &getBlob() const { return blob; }
 
+  using value_type = std::uint32_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "BinaryInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -416,6 +493,12 @@ public:
 
   [[nodiscard]] const Byte32 &getBlob() const { return blob; }
 
+  using value_type = std::uint32_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "BinaryCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -452,6 +535,18 @@ public:
 
   [[nodiscard]] const NormalizedFloat &getActual() const { return actual; }
 
+  using value_type = float;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "NormalizedInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -496,6 +591,12 @@ public:
 
   [[nodiscard]] const LimitedUInt7 &getQualifier() const { return qualifier; }
 
+  using value_type = float;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "NormalizedCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -531,6 +632,18 @@ public:
 
   [[nodiscard]] const LimitedInt16 &getActual() const { return actual; }
 
+  using value_type = std::int16_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "ScaledInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -574,6 +687,12 @@ public:
 
   [[nodiscard]] const LimitedUInt7 &getQualifier() const { return qualifier; }
 
+  using value_type = std::int16_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "ScaledCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -609,6 +728,18 @@ public:
 
   [[nodiscard]] float getActual() const { return actual; }
 
+  using value_type = float;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "ShortInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -651,6 +782,12 @@ public:
 
   [[nodiscard]] const LimitedUInt7 &getQualifier() const { return qualifier; }
 
+  using value_type = float;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
   [[nodiscard]] static std::string name() { return "ShortCmd"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -694,6 +831,28 @@ public:
 
   [[nodiscard]] const LimitedUInt5 &getSequence() const { return sequence; }
 
+  using value_type = std::int32_t;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = BinaryCounterQuality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
+  /**
+   * @brief freeze the counter: advance the sequence number and return a
+   * read-only copy of the frozen reading, optionally resetting the counter
+   * @param reset set the counter to zero after the copy was taken
+   * @param frozen_at timestamp of the frozen reading
+   * @throws std::logic_error if read-only
+   */
+  [[nodiscard]] std::shared_ptr<BinaryCounterInfo>
+  freeze(bool reset, std::chrono::system_clock::time_point frozen_at);
+
   [[nodiscard]] static std::string name() { return "BinaryCounterInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -737,6 +896,18 @@ public:
 
   [[nodiscard]] LimitedUInt16 getElapsed_ms() const { return elapsed_ms; }
 
+  using value_type = EventState;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "ProtectionEventInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -783,6 +954,18 @@ public:
     return relay_duration_ms;
   }
 
+  using value_type = StartEvents;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "ProtectionStartInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -829,6 +1012,18 @@ public:
     return relay_operating_ms;
   }
 
+  using value_type = OutputCircuits;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "ProtectionCircuitInfo"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -871,6 +1066,18 @@ public:
 
   [[nodiscard]] FieldSet16 getChanged() const { return changed; }
 
+  using value_type = FieldSet16;
+
+  [[nodiscard]] value_type getNativeValue();
+
+  void setNativeValue(value_type value);
+
+  using quality_type = Quality;
+
+  [[nodiscard]] quality_type getNativeQuality();
+
+  void setNativeQuality(quality_type value);
+
   [[nodiscard]] static std::string name() { return "StatusAndChanged"; }
 
   [[nodiscard]] std::string toString() const override;
@@ -48,6 +48,9 @@ Station::~Station() {
   {
     std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
     points.clear();
+    pointIndexMap.clear();
+    pointIoaIndex.clear();
+    pointTagIndex.clear();
   }
   DEBUG_PRINT(Debug::Station, "Removed");
 }
@@ -87,12 +90,23 @@ Station::getPoint(const std::uint_fast32_t informationObjectAddress) {
   }
 
   std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
-  for (auto &p : points) {
-    if (p->getInformationObjectAddress() == informationObjectAddress) {
-      return p;
+  auto it = pointIndexMap.find(informationObjectAddress);
+  if (it == pointIndexMap.end()) {
+    return {nullptr};
+  }
+  return points[it->second];
+}
+
+std::uint_fast16_t Station::getTickRate_ms() {
+  if (auto sv = getServer()) {
+    return sv->getTickRate_ms();
+  }
+  if (auto co = getConnection()) {
+    if (auto cl = co->getClient()) {
+      return cl->getTickRate_ms();
     }
   }
-  return {nullptr};
+  return 0;
 }
 
 std::shared_ptr<DataPoint> Station::addPoint(
@@ -110,14 +124,7 @@ std::shared_ptr<DataPoint> Station::addPoint(
                   std::to_string(informationObjectAddress));
 
   // forward tickRate_ms
-  uint_fast16_t tickRate_ms = 0;
-  if (auto sv = getServer()) {
-    tickRate_ms = sv->getTickRate_ms();
-  } else if (auto co = getConnection()) {
-    if (auto cl = co->getClient()) {
-      tickRate_ms = cl->getTickRate_ms();
-    }
-  }
+  uint_fast16_t const tickRate_ms = getTickRate_ms();
 
   std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
   auto point = DataPoint::create(
@@ -125,8 +132,303 @@ std::shared_ptr<DataPoint> Station::addPoint(
       relatedInformationObjectAddress, relatedInformationObjectAutoReturn,
       commandMode, tickRate_ms);
 
-  points.push_back(point);
+  if (pointIndexMap.count(informationObjectAddress)) {
+    // added concurrently
+    return {nullptr};
+  }
+  insertPoint(point);
   return point;
 }
 
+bool Station::isIndexed(const std::shared_ptr<DataPoint> &point) const {
+  auto it = pointIndexMap.find(point->getInformationObjectAddress());
+  return it != pointIndexMap.end() && points[it->second] == point;
+}
+
+void Station::insertPoint(std::shared_ptr<DataPoint> point) {
+  auto const ioa = point->getInformationObjectAddress();
+  pointIndexMap.emplace(ioa, points.size());
+  pointIoaIndex.insert(ioa);
+  for (auto const id : point->getTagIds()) {
+    pointTagIndex[id].insert(ioa);
+  }
+  points.push_back(std::move(point));
+}
+
+bool Station::erasePoint(const std::uint_fast32_t informationObjectAddress) {
+  auto it = pointIndexMap.find(informationObjectAddress);
+  if (it == pointIndexMap.end()) {
+    return false;
+  }
+  std::size_t const index = it->second;
+  pointIndexMap.erase(it);
+  pointIoaIndex.erase(informationObjectAddress);
+  for (auto const id : points[index]->getTagIds()) {
+    auto tagged = pointTagIndex.find(id);
+    if (tagged != pointTagIndex.end()) {
+      tagged->second.erase(informationObjectAddress);
+      if (tagged->second.empty()) {
+        pointTagIndex.erase(tagged);
+      }
+    }
+  }
+  if (index + 1 < points.size()) {
+    points[index] = std::move(points.back());
+    pointIndexMap[points[index]->getInformationObjectAddress()] = index;
+  }
+  points.pop_back();
+  return true;
+}
+
+bool Station::removePoint(const std::uint_fast32_t informationObjectAddress) {
+  DEBUG_PRINT(Debug::Station,
+              "remove_point] IOA " + std::to_string(informationObjectAddress));
+
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+  return erasePoint(informationObjectAddress);
+}
+
+void Station::applyDiff(const StationDiff &diff) {
+  DEBUG_PRINT(Debug::Station, "apply_diff] " + diff.toString());
+
+  uint_fast16_t const tickRate_ms = getTickRate_ms();
+
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+
+  // 1. validate removals
+  std::unordered_set<std::uint_fast32_t> removed;
+  for (auto const ioa : diff.removals) {
+    if (!pointIndexMap.count(ioa)) {
+      throw std::invalid_argument("Cannot remove unknown point with IOA " +
+                                  std::to_string(ioa));
+    }
+    if (!removed.insert(ioa).second) {
+      throw std::invalid_argument("Point with IOA " + std::to_string(ioa) +
+                                  " is removed twice");
+    }
+  }
+
+  // 2. validate and create additions, nothing is visible to readers yet
+  std::unordered_map<std::uint_fast32_t, std::shared_ptr<DataPoint>> added;
+  DataPointVector additions;
+  additions.reserve(diff.additions.size());
+  for (auto const &a : diff.additions) {
+    if ((pointIndexMap.count(a.informationObjectAddress) &&
+         !removed.count(a.informationObjectAddress)) ||
+        added.count(a.informationObjectAddress)) {
+      throw std::invalid_argument("Point with IOA " +
+                                  std::to_string(a.informationObjectAddress) +
+                                  " already exists");
+    }
+    auto point = DataPoint::create(
+        a.informationObjectAddress, a.type, shared_from_this(),
+        a.reportInterval_ms, a.relatedInformationObjectAddress,
+        a.relatedInformationObjectAutoReturn, a.commandMode, tickRate_ms);
+    added.emplace(a.informationObjectAddress, point);
+    additions.push_back(std::move(point));
+  }
+
+  // 3. apply configuration changes, restore previous options on failure
+  struct Previous {
+    std::shared_ptr<DataPoint> point;
+    std::uint_fast16_t reportInterval_ms;
+    std::optional<std::uint_fast32_t> relatedInformationObjectAddress;
+    bool relatedInformationObjectAutoReturn;
+    CommandTransmissionMode commandMode;
+  };
+  std::vector<Previous> previous;
+  previous.reserve(diff.configurations.size());
+  try {
+    for (auto const &c : diff.configurations) {
+      std::shared_ptr<DataPoint> point;
+      auto a = added.find(c.informationObjectAddress);
+      if (a != added.end()) {
+        point = a->second;
+      } else if (!removed.count(c.informationObjectAddress)) {
+        auto it = pointIndexMap.find(c.informationObjectAddress);
+        if (it != pointIndexMap.end()) {
+          point = points[it->second];
+        }
+      }
+      if (!point) {
+        throw std::invalid_argument("Cannot configure unknown point with IOA " +
+                                    std::to_string(c.informationObjectAddress));
+      }
+
+      previous.push_back({point, point->getReportInterval_ms(),
+                          point->getRelatedInformationObjectAddress(),
+                          point->getRelatedInformationObjectAutoReturn(),
+                          point->getCommandMode()});
+      if (c.reportInterval_ms.has_value()) {
+        point->setReportInterval_ms(c.reportInterval_ms.value());
+      }
+      if (c.relatedInformationObjectAddress.has_value()) {
+        point->setRelatedInformationObjectAddress(
+            c.relatedInformationObjectAddress);
+      }
+      if (c.relatedInformationObjectAutoReturn.has_value()) {
+        point->setRelatedInformationObjectAutoReturn(
+            c.relatedInformationObjectAutoReturn.value());
+      }
+      if (c.commandMode.has_value()) {
+        point->setCommandMode(c.commandMode.value());
+      }
+    }
+  } catch (const std::exception &e) {
+    // previous options passed validation before, restore in reverse order
+    for (auto it = previous.rbegin(); it != previous.rend(); ++it) {
+      it->point->setRelatedInformationObjectAutoReturn(false);
+      it->point->setRelatedInformationObjectAddress(
+          it->relatedInformationObjectAddress);
+      it->point->setRelatedInformationObjectAutoReturn(
+          it->relatedInformationObjectAutoReturn);
+      it->point->setReportInterval_ms(it->reportInterval_ms);
+      it->point->setCommandMode(it->commandMode);
+    }
+    DEBUG_PRINT(Debug::Station,
+                "apply_diff] Rejected: " + std::string(e.what()));
+    throw;
+  }
+
+  // 4. commit structural changes, cannot fail
+  for (auto const ioa : diff.removals) {
+    erasePoint(ioa);
+  }
+  for (auto &point : additions) {
+    insertPoint(std::move(point));
+  }
+}
+
+void Station::tagPoint(const std::shared_ptr<DataPoint> &point,
+                       const TagId id) {
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+  if (point->insertTagId(id) && isIndexed(point)) {
+    pointTagIndex[id].insert(point->getInformationObjectAddress());
+  }
+}
+
+bool Station::untagPoint(const std::shared_ptr<DataPoint> &point,
+                         const TagId id) {
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+  if (!point->eraseTagId(id)) {
+    return false;
+  }
+  if (isIndexed(point)) {
+    auto tagged = pointTagIndex.find(id);
+    if (tagged != pointTagIndex.end()) {
+      tagged->second.erase(point->getInformationObjectAddress());
+      if (tagged->second.empty()) {
+        pointTagIndex.erase(tagged);
+      }
+    }
+  }
+  return true;
+}
+
+DataPointVector
+Station::selectPoints(const std::vector<std::string> &tags,
+                      const std::uint_fast32_t firstInformationObjectAddress,
+                      const std::uint_fast32_t lastInformationObjectAddress)
+    const {
+  DataPointVector result;
+  if (firstInformationObjectAddress > lastInformationObjectAddress) {
+    return result;
+  }
+
+  TagIdVector ids;
+  for (auto const &tag : tags) {
+    auto const id = Tag_find(tag);
+    if (!id.has_value()) {
+      // tag was never used, no point can match
+      return result;
+    }
+    ids.push_back(id.value());
+  }
+
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+
+  // iterate the smallest candidate set, test the others per candidate
+  const std::set<std::uint_fast32_t> *candidates = &pointIoaIndex;
+  std::vector<const std::set<std::uint_fast32_t> *> filters;
+  for (auto const id : ids) {
+    auto tagged = pointTagIndex.find(id);
+    if (tagged == pointTagIndex.end()) {
+      return result;
+    }
+    if (candidates == &pointIoaIndex) {
+      candidates = &tagged->second;
+    } else if (tagged->second.size() < candidates->size()) {
+      filters.push_back(candidates);
+      candidates = &tagged->second;
+    } else {
+      filters.push_back(&tagged->second);
+    }
+  }
+
+  auto const end = candidates->upper_bound(lastInformationObjectAddress);
+  for (auto it = candidates->lower_bound(firstInformationObjectAddress);
+       it != end; ++it) {
+    bool const matches =
+        std::all_of(filters.begin(), filters.end(),
+                    [ioa = *it](auto filter) { return filter->count(ioa); });
+    if (matches) {
+      result.push_back(points[pointIndexMap.at(*it)]);
+    }
+  }
+  return result;
+}
+
+DataPointVector
+Station::scanPoints(const std::uint_fast32_t firstInformationObjectAddress,
+                    const std::size_t count) const {
+  DataPointVector result;
+
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+  result.reserve(std::min(count, pointIoaIndex.size()));
+  for (auto it = pointIoaIndex.lower_bound(firstInformationObjectAddress);
+       it != pointIoaIndex.end() && result.size() < count; ++it) {
+    result.push_back(points[pointIndexMap.at(*it)]);
+  }
+  return result;
+}
+
 bool Station::isLocal() { return !server.expired(); }
+
+void Station::enableCounterFreeze(const std::uint_fast32_t interval_ms,
+                                  const bool reset,
+                                  const std::uint_fast32_t offset_ms) {
+  if (!isLocal()) {
+    throw std::logic_error("Counter freeze is only available for stations of "
+                           "a server");
+  }
+  counterFreeze.enable(interval_ms, reset, offset_ms);
+}
+
+void Station::disableCounterFreeze() { counterFreeze.disable(); }
+
+Remote::CounterFreeze &Station::getCounterFreeze() { return counterFreeze; }
+
+std::vector<
+    std::pair<std::shared_ptr<DataPoint>, std::shared_ptr<BinaryCounterInfo>>>
+Station::freezeCounters(const bool reset,
+                        const std::chrono::system_clock::time_point frozen_at) {
+  std::vector<
+      std::pair<std::shared_ptr<DataPoint>, std::shared_ptr<BinaryCounterInfo>>>
+      result;
+
+  // hold the point list while freezing, so that all counters are frozen in a
+  // single pass without points being added or removed in between
+  std::scoped_lock<Module::GilAwareMutex> const lock(points_mutex);
+  for (const auto &point : points) {
+    auto const type = point->getType();
+    if (M_IT_NA_1 != type && M_IT_TB_1 != type)
+      continue;
+
+    auto info = std::dynamic_pointer_cast<BinaryCounterInfo>(point->getInfo());
+    if (!info || info->isReadonly())
+      continue;
+
+    result.emplace_back(point, info->freeze(reset, frozen_at));
+  }
+  return result;
+}
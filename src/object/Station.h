@@ -32,8 +32,14 @@
 #ifndef C104_OBJECT_STATION_H
 #define C104_OBJECT_STATION_H
 
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "DataPoint.h"
+#include "StationDiff.h"
 #include "module/GilAwareMutex.h"
+#include "remote/CounterFreeze.h"
 #include "types.h"
 
 namespace Object {
@@ -80,10 +86,43 @@ private:
   /// @brief mutex to lock member read/write access
   mutable Module::GilAwareMutex points_mutex{"Station::points_mutex"};
 
-  /// @brief conversion hashmap {IOA,not owning pointer to child DataPoints} to
-  /// find a DataPoint via IOA
-  std::unordered_map<std::uint_fast32_t, std::shared_ptr<DataPoint>>
-      pointIoaMap{};
+  /// @brief conversion hashmap {IOA,position in points} to find a DataPoint
+  /// via IOA (must be accessed with points_mutex)
+  std::unordered_map<std::uint_fast32_t, std::size_t> pointIndexMap{};
+
+  /// @brief ordered IOAs of all points for range selections (must be accessed
+  /// with points_mutex)
+  std::set<std::uint_fast32_t> pointIoaIndex{};
+
+  /// @brief ordered IOAs of all points per tag (must be accessed with
+  /// points_mutex)
+  std::unordered_map<TagId, std::set<std::uint_fast32_t>> pointTagIndex{};
+
+  /**
+   * @brief test if a point is a child of this station, requires points_mutex
+   */
+  bool isIndexed(const std::shared_ptr<DataPoint> &point) const;
+
+  /**
+   * @brief add a point to points and all indexes, requires points_mutex
+   */
+  void insertPoint(std::shared_ptr<DataPoint> point);
+
+  /**
+   * @brief remove a point from points and pointIndexMap in constant time by
+   * moving the last point into its position, requires points_mutex
+   * @param informationObjectAddress information object address
+   * @return if the point existed
+   */
+  bool erasePoint(std::uint_fast32_t informationObjectAddress);
+
+  /// @brief freeze schedule of integrated totals (only local station)
+  Remote::CounterFreeze counterFreeze{};
+
+  /**
+   * @brief Getter for the tick rate of the owning server or client
+   */
+  std::uint_fast16_t getTickRate_ms();
 
 public:
   std::uint_fast16_t getCommonAddress() const;
@@ -132,8 +171,97 @@ public:
            bool relatedInformationObjectAutoReturn = false,
            CommandTransmissionMode commandMode = DIRECT_COMMAND);
 
+  /**
+   * @brief Remove a DataPoint from this Station
+   * @param informationObjectAddress information object address
+   * @return if a point was removed
+   */
+  bool removePoint(std::uint_fast32_t informationObjectAddress);
+
+  /**
+   * @brief Apply point additions, removals and configuration changes at once.
+   * Readers see either the previous or the new point list, untouched points
+   * keep their values and callbacks. The time needed grows with the size of
+   * the diff, not with the number of points.
+   * @param diff changes to apply
+   * @throws std::invalid_argument if any change is invalid, no change is
+   * applied in this case
+   */
+  void applyDiff(const StationDiff &diff);
+
+  /**
+   * @brief Add a tag to a point and to the tag index
+   * @param point child point
+   * @param id tag identifier
+   */
+  void tagPoint(const std::shared_ptr<DataPoint> &point, TagId id);
+
+  /**
+   * @brief Remove a tag from a point and from the tag index
+   * @param point child point
+   * @param id tag identifier
+   * @return if the point had this tag
+   */
+  bool untagPoint(const std::shared_ptr<DataPoint> &point, TagId id);
+
+  /**
+   * @brief Select points via tag and information object address indexes, the
+   * effort depends on the size of the result and the smallest tag set
+   * @param tags points must have all of these tags, empty = no tag filter
+   * @param firstInformationObjectAddress lower bound of the IOA range
+   * @param lastInformationObjectAddress upper bound of the IOA range
+   * @return matching points sorted by information object address
+   */
+  DataPointVector
+  selectPoints(const std::vector<std::string> &tags = {},
+               std::uint_fast32_t firstInformationObjectAddress = 0,
+               std::uint_fast32_t lastInformationObjectAddress =
+                   MAX_INFORMATION_OBJECT_ADDRESS) const;
+
+  /**
+   * @brief Get a slice of points in information object address order, used to
+   * cycle through all points in small steps
+   * @param firstInformationObjectAddress lower bound of the IOA range
+   * @param count maximum number of points
+   * @return points sorted by information object address
+   */
+  DataPointVector scanPoints(std::uint_fast32_t firstInformationObjectAddress,
+                             std::size_t count) const;
+
   bool isLocal();
 
+  /**
+   * @brief Freeze all integrated totals of this station at wall-clock aligned
+   * boundaries and report the frozen values spontaneously
+   * @param interval_ms time between two freezes in milliseconds
+   * @param reset reset the counters to zero after each freeze
+   * @param offset_ms shift of the boundaries in milliseconds
+   * @throws std::logic_error if this is not a server station
+   * @throws std::invalid_argument if the interval or offset is invalid
+   */
+  void enableCounterFreeze(std::uint_fast32_t interval_ms, bool reset,
+                           std::uint_fast32_t offset_ms);
+
+  /**
+   * @brief Stop freezing integrated totals, statistics are kept
+   */
+  void disableCounterFreeze();
+
+  /**
+   * @brief Getter for the freeze schedule of integrated totals
+   */
+  Remote::CounterFreeze &getCounterFreeze();
+
+  /**
+   * @brief Freeze all integrated totals of this station at once
+   * @param reset reset the counters to zero after the snapshot
+   * @param frozen_at timestamp of the frozen readings
+   * @return points with a read-only copy of their frozen information
+   */
+  std::vector<std::pair<std::shared_ptr<DataPoint>,
+                        std::shared_ptr<BinaryCounterInfo>>>
+  freezeCounters(bool reset, std::chrono::system_clock::time_point frozen_at);
+
 public:
   std::string toString() const {
     size_t len = 0;
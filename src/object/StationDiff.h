@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file StationDiff.h
+ * @brief collection of point model changes to be applied to a station at once
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_OBJECT_STATIONDIFF_H
+#define C104_OBJECT_STATIONDIFF_H
+
+#include <optional>
+
+#include "types.h"
+
+namespace Object {
+
+/**
+ * @brief list of point additions, removals and configuration changes that are
+ * applied to a station atomically via Station::applyDiff
+ */
+class StationDiff {
+public:
+  struct Addition {
+    std::uint_fast32_t informationObjectAddress;
+    IEC60870_5_TypeID type;
+    std::uint_fast16_t reportInterval_ms;
+    std::optional<std::uint_fast32_t> relatedInformationObjectAddress;
+    bool relatedInformationObjectAutoReturn;
+    CommandTransmissionMode commandMode;
+  };
+
+  /// @brief configuration change, unset options are kept unchanged
+  struct Configuration {
+    std::uint_fast32_t informationObjectAddress;
+    std::optional<std::uint_fast16_t> reportInterval_ms;
+    std::optional<std::uint_fast32_t> relatedInformationObjectAddress;
+    std::optional<bool> relatedInformationObjectAutoReturn;
+    std::optional<CommandTransmissionMode> commandMode;
+  };
+
+  /**
+   * @brief add a new point, the arguments match Station::addPoint
+   */
+  void addPoint(std::uint_fast32_t informationObjectAddress,
+                IEC60870_5_TypeID type,
+                std::uint_fast16_t reportInterval_ms = 0,
+                std::optional<std::uint_fast32_t>
+                    relatedInformationObjectAddress = std::nullopt,
+                bool relatedInformationObjectAutoReturn = false,
+                CommandTransmissionMode commandMode = DIRECT_COMMAND) {
+    additions.push_back({informationObjectAddress, type, reportInterval_ms,
+                         relatedInformationObjectAddress,
+                         relatedInformationObjectAutoReturn, commandMode});
+  }
+
+  /**
+   * @brief remove an existing point
+   */
+  void removePoint(std::uint_fast32_t informationObjectAddress) {
+    removals.push_back(informationObjectAddress);
+  }
+
+  /**
+   * @brief change the configuration of an existing or added point
+   */
+  void configurePoint(
+      std::uint_fast32_t informationObjectAddress,
+      std::optional<std::uint_fast16_t> reportInterval_ms = std::nullopt,
+      std::optional<std::uint_fast32_t> relatedInformationObjectAddress =
+          std::nullopt,
+      std::optional<bool> relatedInformationObjectAutoReturn = std::nullopt,
+      std::optional<CommandTransmissionMode> commandMode = std::nullopt) {
+    configurations.push_back({informationObjectAddress, reportInterval_ms,
+                              relatedInformationObjectAddress,
+                              relatedInformationObjectAutoReturn,
+                              commandMode});
+  }
+
+  /**
+   * @brief Getter for the number of changes
+   */
+  std::size_t size() const {
+    return additions.size() + removals.size() + configurations.size();
+  }
+
+  /// @brief points to add, in order
+  std::vector<Addition> additions{};
+
+  /// @brief information object addresses of points to remove
+  std::vector<std::uint_fast32_t> removals{};
+
+  /// @brief configuration changes, applied after removals and additions
+  std::vector<Configuration> configurations{};
+
+  std::string toString() const {
+    std::ostringstream oss;
+    oss << "<104.StationDiff #add=" << std::to_string(additions.size())
+        << ", #remove=" << std::to_string(removals.size())
+        << ", #configure=" << std::to_string(configurations.size()) << " at "
+        << std::hex << std::showbase << reinterpret_cast<std::uintptr_t>(this)
+        << ">";
+    return oss.str();
+  };
+};
+
+} // namespace Object
+
+#endif // C104_OBJECT_STATIONDIFF_H
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file Tag.cpp
+ * @brief interned point tags
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "object/Tag.h"
+
+#include <deque>
+#include <unordered_map>
+
+using namespace Object;
+
+namespace {
+
+/// @brief tag names are never released, so references stay valid
+struct TagRegistry {
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string, TagId> ids;
+};
+
+TagRegistry &registry() {
+  static TagRegistry instance;
+  return instance;
+}
+
+} // namespace
+
+TagId Object::Tag_intern(const std::string &tag) {
+  if (tag.empty()) {
+    throw std::invalid_argument("Tag must not be empty");
+  }
+
+  auto &r = registry();
+  std::lock_guard<std::mutex> const lock(r.mutex);
+  auto it = r.ids.find(tag);
+  if (it != r.ids.end()) {
+    return it->second;
+  }
+  auto const id = static_cast<TagId>(r.names.size());
+  r.names.push_back(tag);
+  r.ids.emplace(tag, id);
+  return id;
+}
+
+std::optional<TagId> Object::Tag_find(const std::string &tag) {
+  auto &r = registry();
+  std::lock_guard<std::mutex> const lock(r.mutex);
+  auto it = r.ids.find(tag);
+  if (it == r.ids.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+const std::string &Object::Tag_toString(const TagId id) {
+  auto &r = registry();
+  std::lock_guard<std::mutex> const lock(r.mutex);
+  return r.names.at(id);
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file Tag.h
+ * @brief interned point tags
+ *
+ * @package iec104-python
+ * @namespace object
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_OBJECT_TAG_H
+#define C104_OBJECT_TAG_H
+
+#include <optional>
+
+#include "types.h"
+
+namespace Object {
+
+/// @brief process-wide unique identifier of an interned tag string
+typedef std::uint_fast32_t TagId;
+
+/// @brief sorted list of tag identifiers
+typedef std::vector<TagId> TagIdVector;
+
+/**
+ * @brief Get the identifier of a tag, register the tag if unknown
+ * @param tag tag name
+ * @return tag identifier
+ * @throws std::invalid_argument if tag is empty
+ */
+TagId Tag_intern(const std::string &tag);
+
+/**
+ * @brief Get the identifier of a registered tag without registering it
+ * @param tag tag name
+ * @return tag identifier or nullopt if the tag was never used
+ */
+std::optional<TagId> Tag_find(const std::string &tag);
+
+/**
+ * @brief Get the name of a registered tag
+ * @param id tag identifier
+ * @return tag name
+ */
+const std::string &Tag_toString(TagId id);
+
+} // namespace Object
+
+#endif // C104_OBJECT_TAG_H
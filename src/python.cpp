@@ -29,7 +29,10 @@
  *
  */
 
+#include "module/ArrowExport.h"
+#include "module/MemoryBudget.h"
 #include "remote/Helper.h"
+#include "remote/message/ScratchAsdu.h"
 #include "types.h"
 
 #include "Client.h"
@@ -40,7 +43,14 @@
 #include <pybind11/stl.h>
 
 #ifdef VERSION_INFO
+#if PYBIND11_VERSION_MAJOR >= 3
+// multi-phase initialization: every sub interpreter imports its own module
+// instance and may run with its own GIL (PEP 684)
+#define PY_MODULE(name, var)                                                   \
+  PYBIND11_MODULE(name, var, py::multiple_interpreters::per_interpreter_gil())
+#else
 #define PY_MODULE(name, var) PYBIND11_MODULE(name, var)
+#endif
 #else
 #define VERSION_INFO "embedded"
 #include <pybind11/embed.h>
@@ -206,6 +216,86 @@ py::dict explain_bytes_dict(const py::bytes &obj) {
                                                (unsigned char)buffer->len);
 }
 
+py::dict get_asdu_buffer_stats() {
+  py::dict result;
+  result["acquired"] = Remote::Message::ScratchAsdu::getAcquiredCount();
+  result["allocated"] = Remote::Message::ScratchAsdu::getAllocatedCount();
+  return result;
+}
+
+Object::DataPointVector
+StationVector_getPoints(const Object::StationVector &stations) {
+  Object::DataPointVector points;
+  for (auto &station : stations) {
+    auto station_points = station->getPoints();
+    points.insert(points.end(), station_points.begin(), station_points.end());
+  }
+  return points;
+}
+
+Object::DataPointVector Client_getPoints(Client &client) {
+  Object::DataPointVector points;
+  for (auto &connection : client.getConnections()) {
+    auto connection_points = StationVector_getPoints(connection->getStations());
+    points.insert(points.end(), connection_points.begin(),
+                  connection_points.end());
+  }
+  return points;
+}
+
+/// @brief body of the __arrow_c_array__ docstring of all point containers
+constexpr const char *ARROW_C_ARRAY_DOC = R"def( -> tuple[object, object]
+
+export all points and their current information as Arrow record batch via the Arrow PyCapsule interface
+
+Columns: common_address, io_address, type, value, quality, recorded_at, processed_at
+
+Parameters
+----------
+requested_schema: object, optional
+    ignored, the table is always exported with its native schema
+
+Returns
+-------
+tuple[object, object]
+    arrow_schema and arrow_array PyCapsules
+
+Example
+-------
+>>> table = pyarrow.record_batch()def";
+
+/// @brief body of the __arrow_c_stream__ docstring of all point containers
+constexpr const char *ARROW_C_STREAM_DOC = R"def( -> object
+
+export all points and their current information as Arrow stream via the Arrow PyCapsule interface
+
+Parameters
+----------
+requested_schema: object, optional
+    ignored, the table is always exported with its native schema
+
+Returns
+-------
+object
+    arrow_array_stream PyCapsule
+
+Example
+-------
+>>> df = polars.DataFrame()def";
+
+/**
+ * @brief docstring of an Arrow PyCapsule export method
+ * @param method python method name
+ * @param cls python class name
+ * @param body ARROW_C_ARRAY_DOC or ARROW_C_STREAM_DOC
+ * @param example variable name of an instance in the example
+ */
+std::string arrowDoc(const char *method, const char *cls, const char *body,
+                     const char *example) {
+  return std::string(method) + "(self: c104." + cls +
+         ", requested_schema: object = None)" + body + example + ")\n";
+}
+
 PY_MODULE(_c104, m) {
 #ifdef _WIN32
   system("chcp 65001 > nul");
@@ -376,7 +466,8 @@ PY_MODULE(_c104, m) {
       .value("INVALID_COT", INVALID_COT)
       .value("INVALID_TYPE_ID", INVALID_TYPE_ID)
       .value("MISMATCHED_TYPE_ID", MISMATCHED_TYPE_ID)
-      .value("UNIMPLEMENTED_GROUP", UNIMPLEMENTED_GROUP);
+      .value("UNIMPLEMENTED_GROUP", UNIMPLEMENTED_GROUP)
+      .value("INVALID_STRUCTURE", INVALID_STRUCTURE);
 
   py::enum_<ConnectionInit>(
       m, "Init",
@@ -898,6 +989,65 @@ Example
 >>> c104.set_debug_mode(mode=c104.Debug.Client|c104.Debug.Connection)
 )def",
         "mode"_a);
+  m.def("get_asdu_buffer_stats", &get_asdu_buffer_stats,
+        R"def(get_asdu_buffer_stats() -> dict[str, int]
+
+get usage counters of the reusable buffers for outgoing ASDUs
+
+Outgoing reports and inventory responses are encoded in thread-local buffers instead of allocating a new ASDU per frame. In steady-state operation only the acquired counter grows.
+
+Returns
+-------
+dict[str, int]
+    acquired: number of ASDUs encoded in a reused buffer, allocated: number of buffers allocated on the heap
+
+Example
+-------
+>>> stats = c104.get_asdu_buffer_stats()
+>>> print("{0} frames, {1} buffers".format(stats["acquired"], stats["allocated"]))
+)def");
+  m.def("set_memory_budget", &Module::MemoryBudget::setLimit,
+        R"def(set_memory_budget(limit_bytes: int) -> None
+
+set a process wide memory budget for internal queues and buffers of all servers and clients
+
+Frames held by a bandwidth limit, raw frame batches and aggregate batches that wait for delivery are accounted per subsystem. If the usage approaches the limit, load is shed in this order, each stage includes the previous ones:
+
+1. at 80 %: held periodic and background frames are dropped, they are sent again in the next cycle
+2. at 90 %: a held spontaneous frame is replaced by a newer frame of the same point instead of queueing both
+3. at 100 %: new raw frame batches and aggregate batches are refused
+
+The budget does not limit allocations of python objects. Every buffer keeps its own size limit and frames that cannot be shed, for example interrogation responses and confirmations, are still accepted.
+
+Parameters
+----------
+limit_bytes: int
+    limit in bytes, 0 = unlimited
+
+Returns
+-------
+None
+
+Example
+-------
+>>> c104.set_memory_budget(limit_bytes=64 * 1024 * 1024)
+)def",
+        "limit_bytes"_a);
+  m.def("get_memory_stats", &Module::MemoryBudget::toDict,
+        R"def(get_memory_stats() -> dict[str, typing.Any]
+
+get usage and shedding counters of the process wide memory budget
+
+Returns
+-------
+dict[str, typing.Any]
+    limit: budget in bytes (0 = unlimited), usage: accounted bytes, peak: highest accounted bytes, stage: active shedding stage (none, drop_periodic, coalesce or refuse_history), subsystems: accounted bytes per subsystem (held_frames, held_periodic_frames, raw_frames, aggregates), dropped_periodic: dropped periodic frames, coalesced: replaced spontaneous frames, refused_history: refused batches
+
+Example
+-------
+>>> stats = c104.get_memory_stats()
+>>> print("{0} of {1} bytes, stage: {2}".format(stats["usage"], stats["limit"], stats["stage"]))
+)def");
   m.def("get_debug_mode", &getDebug, R"def(get_debug_mode() -> c104.Debug
 
 get current debug mode
@@ -950,7 +1100,9 @@ Example
   py::class_<Client, std::shared_ptr<Client>>(
       m, "Client",
       "This class represents a local client and provides access to meta "
-      "information and connected remote servers")
+      "information and connected remote servers. Instances created in a sub "
+      "interpreter run their callbacks in that interpreter, a per-interpreter "
+      "GIL requires a build against pybind11 3 or later")
       .def(
           py::init(&Client::create),
           R"def(__init__(self: c104.Client, tick_rate_ms: int = 100, command_timeout_ms: int = 100, transport_security: c104.TransportSecurity = None) -> None
@@ -1002,6 +1154,17 @@ Example
                     &Client::setOriginatorAddress,
                     "int: primary originator address of this client (0-255)",
                     py::return_value_policy::copy)
+      .def_property(
+          "state_change_window_ms", &Client::getStateChangeWindow_ms,
+          &Client::setStateChangeWindow_ms,
+          "int: window in milliseconds to coalesce connection state changes "
+          "in, Connection.on_state_change is called once per window with the "
+          "latest state, 0 = report every change",
+          py::return_value_policy::copy)
+      .def_property_readonly(
+          "fleet_state", &Client::getFleetState,
+          "dict[c104.ConnectionState, int]: number of connections per state "
+          "(read-only)")
       .def("start", &Client::start, R"def(start(self: c104.Client) -> None
 
 start client and connect all connections
@@ -1195,12 +1358,78 @@ Example
 >>> my_client.on_new_point(callable=cl_on_new_point)
 )def",
           "callable"_a)
+      .def(
+          "on_fleet_state", &Client::setOnFleetStateCallback,
+          R"def(on_fleet_state(self: c104.Client, callable: collections.abc.Callable[[c104.Client, dict[c104.ConnectionState, int]], None]) -> None
+
+set python callback that will be executed with the number of connections per state after connection states changed
+
+All state changes of all connections within the window of state_change_window_ms are reported by a single call. No call is made if the counts did not change compared to the last call.
+
+Parameters
+----------
+callable: collections.abc.Callable[[c104.Client, dict[c104.ConnectionState, int]], None]
+    callback function reference
+
+Returns
+-------
+None
+
+Raises
+------
+ValueError
+    callable signature does not match exactly
+
+**Callable signature**
+
+Callable Parameters
+-------------------
+client: c104.Client
+    client instance
+states: dict[c104.ConnectionState, int]
+    number of connections per state
+
+Callable Returns
+----------------
+None
+
+Example
+-------
+>>> def cl_on_fleet_state(client: c104.Client, states: dict[c104.ConnectionState, int]) -> None:
+>>>     print("FLEET {0} open, {1} closed".format(states[c104.ConnectionState.OPEN], states[c104.ConnectionState.CLOSED]))
+>>>
+>>> my_client.state_change_window_ms = 1000
+>>> my_client.on_fleet_state(callable=cl_on_fleet_state)
+)def",
+          "callable"_a)
+      .def(
+          "__arrow_c_array__",
+          [](Client &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(Client_getPoints(self))
+                ->toArrayCapsules();
+          },
+          arrowDoc("__arrow_c_array__", "Client", ARROW_C_ARRAY_DOC,
+                   "my_client")
+              .c_str(),
+          "requested_schema"_a = py::none())
+      .def(
+          "__arrow_c_stream__",
+          [](Client &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(Client_getPoints(self))
+                ->toStreamCapsule();
+          },
+          arrowDoc("__arrow_c_stream__", "Client", ARROW_C_STREAM_DOC,
+                   "my_client")
+              .c_str(),
+          "requested_schema"_a = py::none())
       .def("__repr__", &Client::toString);
 
   py::class_<Server, std::shared_ptr<Server>>(
       m, "Server",
       "This class represents a local server and provides access to meta "
-      "information and containing stations")
+      "information and containing stations. Instances created in a sub "
+      "interpreter run their callbacks in that interpreter, a per-interpreter "
+      "GIL requires a build against pybind11 3 or later")
       .def(
           py::init(&Server::create),
           R"def(__init__(self: c104.Server, ip: str = "0.0.0.0", port: int = 2404, tick_rate_ms: int = 100, select_timeout_ms = 100, max_connections: int = 0, transport_security: c104.TransportSecurity = None) -> None
@@ -1264,6 +1493,39 @@ Example
           "protocol_parameters", &Server::getParameters,
           "c104.ProtocolParameters: read and update protocol parameters",
           py::return_value_policy::reference)
+      .def_property_readonly(
+          "raw_batch_statistics", &Server::getRawBatchStatistics,
+          "dict[str, int]: raw batch statistics: frames, batches, "
+          "pending_batches, pending_bytes and dropped_frames (read-only)")
+      .def_property_readonly(
+          "rejected_messages", &Server::getRejectedMessageCounts,
+          "dict[c104.Umc, int]: number of rejected incoming messages per "
+          "cause (read-only)")
+      .def_property_readonly(
+          "background_scan", &Server::getBackgroundScanStatistics,
+          "dict[str, typing.Any]: background scan configuration and cycle "
+          "statistics: enabled, rate, cycles, points, deferred, cycle_points, "
+          "last_cycle_ms and current_cycle_ms (read-only)")
+      .def_property_readonly(
+          "bandwidth_statistics", &Server::getBandwidthStatistics,
+          "list[dict[str, typing.Any]]: bandwidth shaping statistics per open "
+          "connection: ip, rate, burst, bytes, frames, bypassed_bytes, "
+          "delayed_frames, held_frames, held_bytes, dropped_frames, "
+          "coalesced_frames, held_ms and max_held_ms (read-only)")
+      .def_property_readonly(
+          "admission_statistics", &Server::getAdmissionStatistics,
+          "dict[str, typing.Any]: admission rules, limits and decision "
+          "counters: allow, deny, max_connections_per_ip, accept_rate, "
+          "accept_rate_per_ip, burst, accepted, undecided, rejected_denied, "
+          "rejected_not_allowed, rejected_cap, rejected_rate, "
+          "rejected_callback, open and tracked (read-only)")
+      .def_property_readonly(
+          "command_executor", &Server::getCommandExecutorStatistics,
+          "dict[str, int]: command executor statistics: workers, dispatched, "
+          "executed, pending and max_pending (read-only)")
+      .def_property_readonly(
+          "is_loopback", &Server::isLoopback,
+          "bool: test if this endpoint is served in-process (read-only)")
       .def_property("max_connections", &Server::getMaxOpenConnections,
                     &Server::setMaxOpenConnections,
                     "int: maximum number of open connections, 0 = no limit",
@@ -1288,6 +1550,182 @@ stop local server socket
 Example
 -------
 >>> my_server.stop()
+)def")
+      .def("enable_background_scan", &Server::enableBackgroundScan,
+           R"def(enable_background_scan(self: c104.Server, points_per_second: int = 0) -> None
+
+continuously cycle through all monitoring points of all stations and send them with cause of transmission BACKGROUND_SCAN in packed ASDUs
+
+The scan keeps the database of clients up to date without the burst load of a general interrogation. Enabling the scan again restarts the cycle.
+
+Parameters
+----------
+points_per_second: int
+    number of points to send per second, 0 = send a batch of points per tick only while the send windows of all active connections are available
+
+Example
+-------
+>>> my_server.enable_background_scan(points_per_second=200)
+)def",
+           "points_per_second"_a = 0)
+      .def("disable_background_scan", &Server::disableBackgroundScan,
+           R"def(disable_background_scan(self: c104.Server) -> None
+
+stop the background scan, statistics are kept
+
+Example
+-------
+>>> my_server.disable_background_scan()
+)def")
+      .def("enable_command_executor", &Server::enableCommandExecutor,
+           R"def(enable_command_executor(self: c104.Server, workers: int = 0) -> None
+
+handle incoming commands in a pool of worker threads instead of the thread of the client connection
+
+Commands are assigned to workers by common address and information object address. Commands of different points are executed in parallel, so a slow on_receive callback of one point does not delay commands of other stations on the same connection. Commands of the same point are executed in the order of arrival and the activation confirmation is always sent before the activation termination. Enabling the executor again restarts the pool after all pending commands are executed. Pending commands are executed before the server stops and the pool is restarted with the server. Pending commands of a closed connection are dropped.
+
+Parameters
+----------
+workers: int
+    number of worker threads, 0 = number of hardware threads
+
+Example
+-------
+>>> my_server.enable_command_executor(workers=4)
+)def",
+           "workers"_a = 0)
+      .def("disable_command_executor", &Server::disableCommandExecutor,
+           R"def(disable_command_executor(self: c104.Server) -> None
+
+execute all pending commands and handle new commands in the thread of the client connection again
+
+Example
+-------
+>>> my_server.disable_command_executor()
+)def")
+      .def("set_bandwidth_limit", &Server::setBandwidthLimit,
+           R"def(set_bandwidth_limit(self: c104.Server, bytes_per_second: int, burst_bytes: int = 0, ip: str | None = None) -> None
+
+limit the outgoing bandwidth per client connection via token bucket
+
+Frames that exceed the limit are held back per connection. Interrogation responses and spontaneous data are released before periodic and background scan data. Confirmations are never held back, but count towards the limit.
+
+Parameters
+----------
+bytes_per_second: int
+    limit in bytes per second including protocol overhead, 0 = unlimited
+burst_bytes: int
+    bucket size in bytes, 0 = traffic of two ticks
+ip: str, optional
+    limit only connections from this ip, None = default limit for all connections without an ip specific limit
+
+Raises
+------
+ValueError
+    ip is invalid
+
+Example
+-------
+>>> my_server.set_bandwidth_limit(bytes_per_second=1200)
+>>> my_server.set_bandwidth_limit(bytes_per_second=8000, ip="192.168.50.10")
+)def",
+           "bytes_per_second"_a, "burst_bytes"_a = 0, "ip"_a = std::nullopt)
+      .def("add_admission_rule", &Server::addAdmissionRule,
+           R"def(add_admission_rule(self: c104.Server, cidr: str, allow: bool = True) -> None
+
+allow or deny connection requests from an IPv4 network
+
+Admission rules are evaluated natively for every connection request before the on_connect callback: denied networks, connection cap per ip, accept rate limits and finally allowed networks. Peers in an allowed network are accepted without calling on_connect. If at least one allowed network exists, all other peers are rejected. Otherwise the on_connect callback decides about the remaining requests.
+
+Parameters
+----------
+cidr: str
+    network in CIDR notation, a plain address matches a single peer
+allow: bool
+    accept or reject matching peers
+
+Raises
+------
+ValueError
+    cidr is invalid
+
+Example
+-------
+>>> my_server.add_admission_rule(cidr="192.168.50.0/24")
+>>> my_server.add_admission_rule(cidr="192.168.50.66", allow=False)
+)def",
+           "cidr"_a, "allow"_a = true)
+      .def("clear_admission_rules", &Server::clearAdmissionRules,
+           R"def(clear_admission_rules(self: c104.Server) -> None
+
+remove all allowed and denied networks, limits are kept
+
+Example
+-------
+>>> my_server.clear_admission_rules()
+)def")
+      .def("set_admission_limits", &Server::setAdmissionLimits,
+           R"def(set_admission_limits(self: c104.Server, max_connections_per_ip: int = 0, accept_rate: float = 0.0, accept_rate_per_ip: float = 0.0, burst: int = 5) -> None
+
+limit open connections per peer ip and the rate of connection requests that pass the native admission rules
+
+Requests exceeding a limit are rejected without calling on_connect.
+
+Parameters
+----------
+max_connections_per_ip: int
+    open connections per peer ip, 0 = unlimited
+accept_rate: float
+    connection requests per second from all peers, 0 = unlimited
+accept_rate_per_ip: float
+    connection requests per second per peer ip, 0 = unlimited
+burst: int
+    number of connection requests passed at once before the rate applies
+
+Raises
+------
+ValueError
+    a rate is negative
+
+Example
+-------
+>>> my_server.set_admission_limits(max_connections_per_ip=2, accept_rate_per_ip=0.5)
+)def",
+           "max_connections_per_ip"_a = 0, "accept_rate"_a = 0.0,
+           "accept_rate_per_ip"_a = 0.0, "burst"_a = 5)
+      .def("enable_loopback", &Server::enableLoopback,
+           R"def(enable_loopback(self: c104.Server, latency_ms: int = 0, bandwidth: int = 0) -> None
+
+serve this endpoint in-process: clients of the same process that connect to the servers ip and port exchange frames via memory instead of the network stack
+
+The transport replaces the socket layer of lib60870 and is intended for deterministic benchmarks of the protocol stack. It takes effect on the next start of the server, the link parameters apply to new connections.
+
+Parameters
+----------
+latency_ms: int
+    one way delay per frame in milliseconds, 0 = immediate
+bandwidth: int
+    bytes per second in each direction, 0 = unlimited
+
+Raises
+------
+RuntimeError
+    the build does not support the loopback transport (build option C104_LOOPBACK_TRANSPORT, Linux only)
+
+Example
+-------
+>>> my_server.enable_loopback(latency_ms=5, bandwidth=8000)
+>>> my_server.start()
+)def",
+           "latency_ms"_a = 0, "bandwidth"_a = 0)
+      .def("disable_loopback", &Server::disableLoopback,
+           R"def(disable_loopback(self: c104.Server) -> None
+
+serve this endpoint via TCP again after the next start of the server
+
+Example
+-------
+>>> my_server.disable_loopback()
 )def")
       .def(
           "add_station", &Server::addStation,
@@ -1413,6 +1851,56 @@ Example
 >>> my_server.on_send_raw(callable=sv_on_send_raw)
 )def",
           "callable"_a)
+      .def(
+          "on_raw_batch", &Server::setOnRawBatchCallback,
+          R"def(on_raw_batch(self: c104.Server, callable: collections.abc.Callable[[c104.Server, c104.RawFrameBatch], None], max_frames: int = 1000, max_delay_ms: int = 100) -> None
+
+set python callback that receives incoming and outgoing raw messages in batches
+
+Frames are collected natively and delivered with a single callback per batch, instead of one callback per message like on_receive_raw and on_send_raw. Batches are delivered if they contain max_frames frames or if the oldest frame is older than max_delay_ms, the age is checked on every message and on every tick. An incomplete batch is delivered to the previous callback if the callback is replaced or removed and if the server stops.
+
+Parameters
+----------
+callable: collections.abc.Callable[[c104.Server, c104.RawFrameBatch], None]
+    callback function reference, None to remove the callback
+max_frames: int
+    number of frames per batch
+max_delay_ms: int
+    maximum age of the oldest frame of a batch in milliseconds
+
+Returns
+-------
+None
+
+Raises
+------
+ValueError
+    callable signature does not match exactly or max_frames is 0
+
+**Callable signature**
+
+Callable Parameters
+-------------------
+server: c104.Server
+    server instance
+batch: c104.RawFrameBatch
+    frames received or sent since the last batch
+
+Callable Returns
+----------------
+None
+
+Example
+-------
+>>> def sv_on_raw_batch(server: c104.Server, batch: c104.RawFrameBatch) -> None:
+>>>     data = batch.data
+>>>     offsets = batch.offsets
+>>>     for i in range(len(batch)):
+>>>         frame = data[offsets[i]:offsets[i + 1]]
+>>>
+>>> my_server.on_raw_batch(callable=sv_on_raw_batch, max_frames=500, max_delay_ms=200)
+)def",
+          "callable"_a, "max_frames"_a = 1000, "max_delay_ms"_a = 100)
       .def(
           "on_connect", &Server::setOnConnectCallback,
           R"def(on_connect(self: c104.Server, callable: collections.abc.Callable[[c104.Server, ip], bool]) -> None
@@ -1546,6 +2034,28 @@ Example
 >>> my_server.on_unexpected_message(callable=sv_on_unexpected_message)
 )def",
           "callable"_a)
+      .def(
+          "__arrow_c_array__",
+          [](Server &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(
+                       StationVector_getPoints(self.getStations()))
+                ->toArrayCapsules();
+          },
+          arrowDoc("__arrow_c_array__", "Server", ARROW_C_ARRAY_DOC,
+                   "my_server")
+              .c_str(),
+          "requested_schema"_a = py::none())
+      .def(
+          "__arrow_c_stream__",
+          [](Server &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(
+                       StationVector_getPoints(self.getStations()))
+                ->toStreamCapsule();
+          },
+          arrowDoc("__arrow_c_stream__", "Server", ARROW_C_STREAM_DOC,
+                   "my_server")
+              .c_str(),
+          "requested_schema"_a = py::none())
       .def("__repr__", &Server::toString);
 
   py::class_<Remote::Connection, std::shared_ptr<Remote::Connection>>(
@@ -1587,6 +2097,19 @@ Example
           "protocol_parameters", &Remote::Connection::getParameters,
           "c104.ProtocolParameters: read and update protocol parameters",
           py::return_value_policy::reference)
+      .def_property_readonly(
+          "aggregation", &Remote::Connection::getAggregationStatistics,
+          "dict[str, typing.Any]: interval aggregation statistics: enabled, "
+          "interval_ms, points, samples, intervals, skipped, dropped, "
+          "pending_bytes and last_batch_size (read-only)")
+      .def_property_readonly(
+          "raw_batch_statistics", &Remote::Connection::getRawBatchStatistics,
+          "dict[str, int]: raw batch statistics: frames, batches, "
+          "pending_batches, pending_bytes and dropped_frames (read-only)")
+      .def_property_readonly(
+          "rejected_messages", &Remote::Connection::getRejectedMessageCounts,
+          "dict[c104.Umc, int]: number of rejected incoming messages per "
+          "cause (read-only)")
       .def("connect", &Remote::Connection::connect,
            R"def(connect(self: c104.Connection) -> None
 
@@ -1761,25 +2284,113 @@ Example
 )def",
           "common_address"_a, "with_time"_a = true,
           "wait_for_response"_a = true, py::return_value_policy::copy)
-      .def(
-          "get_station", &Remote::Connection::getStation,
-          R"def(get_station(self: c104.Connection, common_address: int) -> c104.Station | None
+      .def("enable_rtt_probe", &Remote::Connection::enableRoundTripProbe,
+           R"def(enable_rtt_probe(self: c104.Connection, common_address: int, interval_ms: int = 10000, threshold_ms: int = 0) -> None
 
-get a station object via common address
+periodically measure the round trip time to the remote terminal unit (server) via test commands with timestamp
 
 Parameters
 ----------
 common_address: int
-    station common address (value between 1 and 65534)
+    station common address used for the test commands
+interval_ms: int
+    interval between two probes, a probe without response within this interval is counted as lost
+threshold_ms: int
+    threshold of the averaged round trip time that triggers the on_rtt_threshold callback, 0 = disabled
 
 Returns
 -------
-c104.Station, optional
-    station object, if found, else None
+None
 
-Example
--------
->>> station_14 = my_connection.get_station(common_address=14)
+Raises
+------
+ValueError
+    interval_ms is below 100
+
+Example
+-------
+>>> my_connection.enable_rtt_probe(common_address=47, interval_ms=5000, threshold_ms=200)
+)def",
+           "common_address"_a, "interval_ms"_a = 10000, "threshold_ms"_a = 0)
+      .def("disable_rtt_probe", &Remote::Connection::disableRoundTripProbe,
+           R"def(disable_rtt_probe(self: c104.Connection) -> None
+
+stop measuring the round trip time, collected statistics are kept
+
+Example
+-------
+>>> my_connection.disable_rtt_probe()
+)def")
+      .def("enable_lost_update_detection",
+           &Remote::Connection::enableLostUpdateDetection,
+           R"def(enable_lost_update_detection(self: c104.Connection, tolerance: float = 0.0, max_discrepancies: int = 100) -> None
+
+compare the values of general and group interrogation responses against the last spontaneously received values to detect lost updates
+
+Every interrogated value that differs from the last spontaneous value of the point counts as a discrepancy, for example after a queue overflow or a reconnect. The interrogated value becomes the new reference, so that a lost update is counted once. Points that were never reported spontaneously are not checked. Enabling the detection again resets the statistics.
+
+Parameters
+----------
+tolerance: float
+    accepted absolute difference of numeric values
+max_discrepancies: int
+    number of recent discrepancies to keep for inspection
+
+Example
+-------
+>>> my_connection.enable_lost_update_detection(tolerance=0.01)
+>>> my_connection.interrogation(common_address=47)
+>>> print(my_connection.lost_updates["discrepancies"])
+)def",
+           "tolerance"_a = 0.0, "max_discrepancies"_a = 100)
+      .def("disable_lost_update_detection",
+           &Remote::Connection::disableLostUpdateDetection,
+           R"def(disable_lost_update_detection(self: c104.Connection) -> None
+
+stop detecting lost updates, collected statistics are kept
+
+Example
+-------
+>>> my_connection.disable_lost_update_detection()
+)def")
+      .def_property_readonly(
+          "lost_updates",
+          [](const Remote::Connection &self) {
+            return self.getLostUpdateDetector().toDict();
+          },
+          "dict[str, typing.Any]: lost update statistics: enabled, tolerance, "
+          "checked, unchecked, discrepancies, stations (per common address: "
+          "checked, unchecked, discrepancies and last_discrepancy_at) and "
+          "recent (list of discrepancies with common_address, io_address, "
+          "type, expected, expected_at, expected_spontaneous, interrogated "
+          "and interrogated_at) (read-only)")
+      .def_property_readonly(
+          "rtt",
+          [](const Remote::Connection &self) {
+            return self.getRoundTripMonitor().toDict();
+          },
+          "dict[str, typing.Any]: round trip time statistics: count, lost, "
+          "last_ms, min_ms, max_ms, ema_fast_ms, ema_slow_ms, "
+          "histogram_bounds_ms and histogram (read-only)")
+      .def(
+          "get_station", &Remote::Connection::getStation,
+          R"def(get_station(self: c104.Connection, common_address: int) -> c104.Station | None
+
+get a station object via common address
+
+Parameters
+----------
+common_address: int
+    station common address (value between 1 and 65534)
+
+Returns
+-------
+c104.Station, optional
+    station object, if found, else None
+
+Example
+-------
+>>> station_14 = my_connection.get_station(common_address=14)
 )def",
           "common_address"_a)
       .def(
@@ -1885,6 +2496,106 @@ Example
 >>> my_connection.on_send_raw(callable=con_on_send_raw)
 )def",
           "callable"_a)
+      .def(
+          "on_raw_batch", &Remote::Connection::setOnRawBatchCallback,
+          R"def(on_raw_batch(self: c104.Connection, callable: collections.abc.Callable[[c104.Connection, c104.RawFrameBatch], None], max_frames: int = 1000, max_delay_ms: int = 100) -> None
+
+set python callback that receives incoming and outgoing raw messages in batches
+
+Frames are collected natively and delivered with a single callback per batch, instead of one callback per message like on_receive_raw and on_send_raw. Batches are delivered if they contain max_frames frames or if the oldest frame is older than max_delay_ms, the age is checked on every message and on every tick. An incomplete batch is delivered to the previous callback if the callback is replaced or removed and if the client stops.
+
+Parameters
+----------
+callable: collections.abc.Callable[[c104.Connection, c104.RawFrameBatch], None]
+    callback function reference, None to remove the callback
+max_frames: int
+    number of frames per batch
+max_delay_ms: int
+    maximum age of the oldest frame of a batch in milliseconds
+
+Returns
+-------
+None
+
+Raises
+------
+ValueError
+    callable signature does not match exactly or max_frames is 0
+
+**Callable signature**
+
+Callable Parameters
+-------------------
+connection: c104.Connection
+    connection instance
+batch: c104.RawFrameBatch
+    frames received or sent since the last batch
+
+Callable Returns
+----------------
+None
+
+Example
+-------
+>>> def con_on_raw_batch(connection: c104.Connection, batch: c104.RawFrameBatch) -> None:
+>>>     data = batch.data
+>>>     offsets = batch.offsets
+>>>     for i in range(len(batch)):
+>>>         frame = data[offsets[i]:offsets[i + 1]]
+>>>
+>>> my_connection.on_raw_batch(callable=con_on_raw_batch, max_frames=500, max_delay_ms=200)
+)def",
+          "callable"_a, "max_frames"_a = 1000, "max_delay_ms"_a = 100)
+      .def(
+          "on_aggregate", &Remote::Connection::setOnAggregateCallback,
+          R"def(on_aggregate(self: c104.Connection, callable: collections.abc.Callable[[c104.Connection, datetime.datetime, datetime.datetime, list[dict[str, typing.Any]]], None], interval_ms: int = 60000) -> None
+
+set python callback that receives min, max, average and last value of every point once per interval instead of every received value
+
+Received values of single, double, step, measured and integrated totals points are aggregated natively. Intervals are aligned to multiples of interval_ms since the unix epoch, so an interval of one minute starts at every full minute. Measured values are averaged weighted by the time each value was valid, the last value of an interval is carried into the next one. Other values are averaged per received value. Points without a new value in an interval are reported with count 0 and their last value. Setting the callback again restarts the aggregation.
+
+Parameters
+----------
+callable: collections.abc.Callable[[c104.Connection, datetime.datetime, datetime.datetime, list[dict[str, typing.Any]]], None]
+    callback function reference, None to stop aggregating
+interval_ms: int
+    length of an aggregation interval in milliseconds
+
+Returns
+-------
+None
+
+Raises
+------
+ValueError
+    callable signature does not match exactly or interval_ms is 0
+
+**Callable signature**
+
+Callable Parameters
+-------------------
+connection: c104.Connection
+    connection instance
+start: datetime.datetime
+    begin of the interval
+end: datetime.datetime
+    end of the interval
+aggregates: list[dict[str, typing.Any]]
+    one dict per point with common_address, io_address, type, count, min, max, average, last and last_at
+
+Callable Returns
+----------------
+None
+
+Example
+-------
+>>> def con_on_aggregate(connection: c104.Connection, start: datetime.datetime, end: datetime.datetime, aggregates: list[dict[str, typing.Any]]) -> None:
+>>>     for aggregate in aggregates:
+>>>         historian.write(end, aggregate["io_address"], aggregate["average"])
+>>>
+>>> my_connection.on_aggregate(callable=con_on_aggregate, interval_ms=60000)
+)def",
+          "callable"_a, "interval_ms"_a = 60000)
       .def(
           "on_state_change", &Remote::Connection::setOnStateChangeCallback,
           R"def(on_state_change(self: c104.Connection, callable: collections.abc.Callable[[c104.Connection, c104.ConnectionState], None]) -> None
@@ -1924,11 +2635,199 @@ Example
 >>>     print("CON {0}:{1} STATE changed to {2}".format(connection.ip, connection.port, state))
 >>>
 >>> my_connection.on_state_change(callable=con_on_state_change)
+)def",
+          "callable"_a)
+      .def(
+          "on_rtt_threshold",
+          &Remote::Connection::setOnRoundTripThresholdCallback,
+          R"def(on_rtt_threshold(self: c104.Connection, callable: collections.abc.Callable[[c104.Connection, float, bool], None]) -> None
+
+set python callback that will be executed if the averaged round trip time crosses the threshold configured via enable_rtt_probe
+
+Parameters
+----------
+callable: collections.abc.Callable[[c104.Connection, float, bool], None]
+    callback function reference
+
+Returns
+-------
+None
+
+Raises
+------
+ValueError
+    callable signature does not match exactly
+
+**Callable signature**
+
+Callable Parameters
+-------------------
+connection: c104.Connection
+    connection instance
+rtt_ms: float
+    averaged round trip time in milliseconds
+exceeded: bool
+    True if the threshold is exceeded, False if the round trip time recovered
+
+Callable Returns
+----------------
+None
+
+Example
+-------
+>>> def con_on_rtt_threshold(connection: c104.Connection, rtt_ms: float, exceeded: bool) -> None:
+>>>     print("CON {0}:{1} RTT {2:.1f} ms, degraded: {3}".format(connection.ip, connection.port, rtt_ms, exceeded))
+>>>
+>>> my_connection.on_rtt_threshold(callable=con_on_rtt_threshold)
 )def",
           "callable"_a)
       .def("__repr__", &Remote::Connection::toString);
   ;
 
+  py::class_<Remote::RawFrameColumn>(m, "_RawFrameColumn",
+                                     py::buffer_protocol())
+      .def_buffer([](Remote::RawFrameColumn &self) -> py::buffer_info {
+        return self.batch->getBufferInfo(self.column);
+      });
+
+  auto const rawFrameColumn = [](Remote::RawFrameBatch::Column column) {
+    return [column](const std::shared_ptr<Remote::RawFrameBatch> &self) {
+      return py::memoryview(py::cast(Remote::RawFrameColumn{self, column}));
+    };
+  };
+
+  py::class_<Remote::RawFrameBatch, std::shared_ptr<Remote::RawFrameBatch>>(
+      m, "RawFrameBatch",
+      "This class provides read-only access to a batch of raw messages without "
+      "copying, all columns are memoryviews of native buffers")
+      .def_property_readonly(
+          "data", rawFrameColumn(Remote::RawFrameBatch::DATA),
+          "memoryview: all frames concatenated, format B (read-only)")
+      .def_property_readonly(
+          "offsets", rawFrameColumn(Remote::RawFrameBatch::OFFSETS),
+          "memoryview: start offset of every frame in data and the total "
+          "length as last element, format I (read-only)")
+      .def_property_readonly(
+          "timestamps", rawFrameColumn(Remote::RawFrameBatch::TIMESTAMPS),
+          "memoryview: time of every frame in nanoseconds since epoch, format "
+          "q (read-only)")
+      .def_property_readonly(
+          "directions", rawFrameColumn(Remote::RawFrameBatch::DIRECTIONS),
+          "memoryview: 1 for sent and 0 for received frames, format B "
+          "(read-only)")
+      .def("frame", &Remote::RawFrameBatch::getFrame,
+           R"def(frame(self: c104.RawFrameBatch, index: int) -> bytes
+
+get a copy of a single frame
+
+Parameters
+----------
+index: int
+    frame index
+
+Returns
+-------
+bytes
+    raw message bytes
+
+Raises
+------
+IndexError
+    index is out of range
+
+Example
+-------
+>>> first = batch.frame(0)
+)def",
+           "index"_a)
+      .def("__len__", &Remote::RawFrameBatch::size)
+      .def("__repr__", &Remote::RawFrameBatch::toString);
+
+  py::class_<Object::StationDiff>(
+      m, "StationDiff",
+      "This class collects point additions, removals and configuration "
+      "changes that are applied to a station at once")
+      .def(py::init<>(), R"def(__init__(self: c104.StationDiff) -> None
+
+create a new empty station diff
+
+Example
+-------
+>>> diff = c104.StationDiff()
+)def")
+      .def_property_readonly("size", &Object::StationDiff::size,
+                             "int: number of collected changes (read-only)")
+      .def("add_point", &Object::StationDiff::addPoint,
+           R"def(add_point(self: c104.StationDiff, io_address: int, type: c104.Type, report_ms: int = 0, related_io_address: int = None, related_io_autoreturn: bool = False, command_mode: c104.CommandMode = c104.CommandMode.DIRECT) -> None
+
+add a new point, the arguments are validated when the diff is applied
+
+Parameters
+----------
+io_address: int
+    point information object address (value between 0 and 16777215)
+type: c104.Type
+    point information type
+report_ms: int
+    automatic reporting interval in milliseconds (monitoring points server-sided only), 0 = disabled
+related_io_address: int, optional
+    related monitoring point identified by information object address (for control points server-sided only)
+related_io_autoreturn: bool
+    automatically transmit related monitoring point on incoming client command (for control points server-sided only)
+command_mode: c104.CommandMode
+    command transmission mode (direct or select-and-execute)
+
+Example
+-------
+>>> diff.add_point(io_address=35, type=c104.Type.M_ME_NC_1, report_ms=1000)
+)def",
+           "io_address"_a, "type"_a, "report_ms"_a = 0,
+           "related_io_address"_a = std::nullopt,
+           "related_io_autoreturn"_a = false,
+           "command_mode"_a = DIRECT_COMMAND)
+      .def("remove_point", &Object::StationDiff::removePoint,
+           R"def(remove_point(self: c104.StationDiff, io_address: int) -> None
+
+remove an existing point
+
+Parameters
+----------
+io_address: int
+    point information object address (value between 0 and 16777215)
+
+Example
+-------
+>>> diff.remove_point(io_address=34)
+)def",
+           "io_address"_a)
+      .def("configure_point", &Object::StationDiff::configurePoint,
+           R"def(configure_point(self: c104.StationDiff, io_address: int, report_ms: int | None = None, related_io_address: int | None = None, related_io_autoreturn: bool | None = None, command_mode: c104.CommandMode | None = None) -> None
+
+change options of an existing or added point, options set to None are kept
+
+Parameters
+----------
+io_address: int
+    point information object address (value between 0 and 16777215)
+report_ms: int, optional
+    automatic reporting interval in milliseconds, 0 = disabled
+related_io_address: int, optional
+    related monitoring point identified by information object address
+related_io_autoreturn: bool, optional
+    automatically transmit related monitoring point on incoming client command
+command_mode: c104.CommandMode, optional
+    command transmission mode (direct or select-and-execute)
+
+Example
+-------
+>>> diff.configure_point(io_address=11, report_ms=5000)
+)def",
+           "io_address"_a, "report_ms"_a = std::nullopt,
+           "related_io_address"_a = std::nullopt,
+           "related_io_autoreturn"_a = std::nullopt,
+           "command_mode"_a = std::nullopt)
+      .def("__repr__", &Object::StationDiff::toString);
+
   py::class_<Object::Station, std::shared_ptr<Object::Station>>(
       m, "Station",
       "This class represents local or remote stations and provides access to "
@@ -1952,6 +2851,15 @@ Example
       .def_property_readonly(
           "points", &Object::Station::getPoints,
           "list[c104.Point] list of all Point objects (read-only)")
+      .def_property_readonly(
+          "counter_freeze",
+          [](Object::Station &self) {
+            return self.getCounterFreeze().toDict();
+          },
+          "dict[str, typing.Any]: counter freeze schedule and statistics: "
+          "enabled, interval_ms, offset_ms, reset, freezes, skipped, unsent, "
+          "points, last_frozen_at, last_snapshot_ms, last_transmission_ms and "
+          "next_freeze_at (read-only)")
       .def(
           "get_point", &Object::Station::getPoint,
           R"def(get_point(self: c104.Station, io_address: int) -> c104.Point | None
@@ -2019,6 +2927,135 @@ Example
           "io_address"_a, "type"_a, "report_ms"_a = 0,
           "related_io_address"_a = std::nullopt,
           "related_io_autoreturn"_a = false, "command_mode"_a = DIRECT_COMMAND)
+      .def("remove_point", &Object::Station::removePoint,
+           R"def(remove_point(self: c104.Station, io_address: int) -> bool
+
+remove an existing point from this station
+
+Parameters
+----------
+io_address: int
+    point information object address (value between 0 and 16777215)
+
+Returns
+-------
+bool
+    True if the point was removed, else False
+
+Example
+-------
+>>> sv_station_1.remove_point(io_address=34)
+)def",
+           "io_address"_a)
+      .def("select_points", &Object::Station::selectPoints,
+           R"def(select_points(self: c104.Station, tags: list[str] = [], first_io_address: int = 0, last_io_address: int = 16777215) -> list[c104.Point]
+
+select points via tag and information object address indexes without iterating all points
+
+Parameters
+----------
+tags: list[str]
+    points must have all of these tags, an empty list selects points regardless of tags
+first_io_address: int
+    lowest information object address to select
+last_io_address: int
+    highest information object address to select
+
+Returns
+-------
+list[c104.Point]
+    matching points sorted by information object address
+
+Example
+-------
+>>> breakers_of_bay_1 = sv_station_1.select_points(tags=["bay:E01", "breaker"])
+>>> points_100_199 = sv_station_1.select_points(first_io_address=100, last_io_address=199)
+)def",
+           "tags"_a = std::vector<std::string>{}, "first_io_address"_a = 0,
+           "last_io_address"_a = MAX_INFORMATION_OBJECT_ADDRESS)
+      .def("apply_diff", &Object::Station::applyDiff,
+           R"def(apply_diff(self: c104.Station, diff: c104.StationDiff) -> None
+
+apply point additions, removals and configuration changes at once without restarting the server or client
+
+Concurrent readers such as interrogations see either the complete old or the complete new point list. Points that are not part of the diff keep their values, callbacks and selections.
+
+Parameters
+----------
+diff: c104.StationDiff
+    changes to apply
+
+Raises
+------
+ValueError
+    a point to remove or configure does not exist, a point to add already exists or an option is invalid, no change is applied in this case
+
+Example
+-------
+>>> diff = c104.StationDiff()
+>>> diff.remove_point(io_address=34)
+>>> diff.add_point(io_address=35, type=c104.Type.M_ME_NC_1, report_ms=1000)
+>>> diff.configure_point(io_address=11, report_ms=5000)
+>>> sv_station_1.apply_diff(diff=diff)
+)def",
+           "diff"_a)
+      .def("enable_counter_freeze", &Object::Station::enableCounterFreeze,
+           R"def(enable_counter_freeze(self: c104.Station, interval_ms: int = 900000, reset: bool = False, offset_ms: int = 0) -> None
+
+freeze all integrated totals (M_IT_NA_1, M_IT_TB_1) of this server station at wall-clock aligned boundaries and send the frozen values with cause of transmission SPONTANEOUS in packed ASDUs
+
+Boundaries are multiples of the interval since the unix epoch plus the offset, an interval of 15 minutes freezes at :00, :15, :30 and :45. Each freeze advances the sequence number of every counter and uses the boundary as timestamp of the frozen reading. Counters are frozen in a single pass under the station lock.
+
+Parameters
+----------
+interval_ms: int
+    time between two freezes in milliseconds
+reset: bool
+    reset the counters to zero after each freeze (counter freeze with reset)
+offset_ms: int
+    shift of the boundaries in milliseconds, must be less than interval_ms
+
+Raises
+------
+RuntimeError
+    station is not a server station
+ValueError
+    interval_ms is zero or offset_ms is not less than interval_ms
+
+Example
+-------
+>>> sv_station_1.enable_counter_freeze(interval_ms=900000, reset=True)
+)def",
+           "interval_ms"_a = 900000, "reset"_a = false, "offset_ms"_a = 0)
+      .def("disable_counter_freeze", &Object::Station::disableCounterFreeze,
+           R"def(disable_counter_freeze(self: c104.Station) -> None
+
+stop freezing integrated totals, statistics are kept
+
+Example
+-------
+>>> sv_station_1.disable_counter_freeze()
+)def")
+      .def(
+          "__arrow_c_array__",
+          [](Object::Station &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(self.getPoints())
+                ->toArrayCapsules();
+          },
+          arrowDoc("__arrow_c_array__", "Station", ARROW_C_ARRAY_DOC,
+                   "my_station")
+              .c_str(),
+          "requested_schema"_a = py::none())
+      .def(
+          "__arrow_c_stream__",
+          [](Object::Station &self, const py::object &requested_schema) {
+            return Module::ArrowPointTable::create(self.getPoints())
+                ->toStreamCapsule();
+          },
+          arrowDoc("__arrow_c_stream__", "Station", ARROW_C_STREAM_DOC,
+                   "my_station")
+              .c_str(),
+          "requested_schema"_a = py::none())
       .def("__repr__", &Object::Station::toString);
 
   py::class_<Object::DataPoint, std::shared_ptr<Object::DataPoint>>(
@@ -2052,6 +3089,15 @@ Example
       .def_property_readonly("selected_by",
                              &Object::DataPoint::getSelectedByOriginatorAddress,
                              "int | None : originator address (0-255) or None")
+      .def_property_readonly(
+          "command_policy",
+          [](const Object::DataPoint &self) {
+            return self.getCommandPolicy().toDict();
+          },
+          "dict[str, typing.Any] : native command policy and counters: "
+          "active, mirror, min_value, max_value, min_interval_ms, "
+          "reject_invalid_quality, accepted, mirrored, rejected_range, "
+          "rejected_rate, rejected_quality and rejected_mirror (read-only)")
       .def_property("report_ms", &Object::DataPoint::getReportInterval_ms,
                     &Object::DataPoint::setReportInterval_ms,
                     "int : interval in milliseconds between periodic "
@@ -2091,16 +3137,124 @@ Example
                              "value "
                              "itself or None (read-only)",
                              py::return_value_policy::copy)
+      .def_property_readonly("tags", &Object::DataPoint::getTags,
+                             "list[str] : tags of this point (read-only)")
+      .def("set_command_policy", &Object::DataPoint::setCommandPolicy,
+           R"def(set_command_policy(self: c104.Point, mirror: bool = False, min_value: float | None = None, max_value: float | None = None, min_interval_ms: int = 0, reject_invalid_quality: bool = False) -> None
+
+handle received commands of this server-sided control point natively, without acquiring the GIL for rejected or mirrored commands
+
+Rules are evaluated in this order: value range, quality of the related monitoring point and minimum interval since the last accepted command. A command that violates a rule is answered with a negative confirmation and on_receive is not called. Accepted commands are passed to on_receive, unless mirror is enabled: then the commanded value is copied into the related monitoring point and the command is confirmed without calling python. Combine mirror with related_io_autoreturn to report the mirrored value. Setting a policy again resets its counters.
+
+Parameters
+----------
+mirror: bool
+    copy the commanded value into the related monitoring point (related_io_address), which must have the same value type
+min_value: float, optional
+    lowest accepted value
+max_value: float, optional
+    highest accepted value
+min_interval_ms: int
+    minimum time in milliseconds between two accepted commands, 0 = no limit
+reject_invalid_quality: bool
+    reject commands while the related monitoring point has an invalid quality
+
+Raises
+------
+ValueError
+    point is not a server-sided control point, mirror is requested for a step command or min_value is greater than max_value
+
+Example
+-------
+>>> setpoint = sv_station_1.add_point(io_address=12, type=c104.Type.C_SE_NC_1, related_io_address=11, related_io_autoreturn=True)
+>>> setpoint.set_command_policy(mirror=True, min_value=0.0, max_value=100.0, min_interval_ms=1000)
+)def",
+           "mirror"_a = false, "min_value"_a = std::nullopt,
+           "max_value"_a = std::nullopt, "min_interval_ms"_a = 0,
+           "reject_invalid_quality"_a = false)
+      .def("clear_command_policy", &Object::DataPoint::clearCommandPolicy,
+           R"def(clear_command_policy(self: c104.Point) -> None
+
+remove the native command policy, received commands are handled by on_receive only
+
+Example
+-------
+>>> setpoint.clear_command_policy()
+)def")
+      .def("add_tag", &Object::DataPoint::addTag,
+           R"def(add_tag(self: c104.Point, tag: str) -> None
+
+add a tag to this point, the parent station indexes the point by its tags for fast selections
+
+Parameters
+----------
+tag: str
+    tag name, for example a bay, a signal group or a data source
+
+Raises
+------
+ValueError
+    tag is empty
+
+Example
+-------
+>>> point.add_tag("bay:E01")
+>>> point.add_tag("breaker")
+)def",
+           "tag"_a)
+      .def("remove_tag", &Object::DataPoint::removeTag,
+           R"def(remove_tag(self: c104.Point, tag: str) -> bool
+
+remove a tag from this point
+
+Parameters
+----------
+tag: str
+    tag name
+
+Returns
+-------
+bool
+    True if the point had this tag, else False
+
+Example
+-------
+>>> point.remove_tag("breaker")
+)def",
+           "tag"_a)
+      .def("has_tag", &Object::DataPoint::hasTag,
+           R"def(has_tag(self: c104.Point, tag: str) -> bool
+
+test if this point has a tag
+
+Parameters
+----------
+tag: str
+    tag name
+
+Returns
+-------
+bool
+    True if the point has this tag, else False
+
+Example
+-------
+>>> if point.has_tag("breaker"):
+>>>     print("breaker position")
+)def",
+           "tag"_a)
       .def(
           "on_receive", &Object::DataPoint::setOnReceiveCallback,
-          R"def(on_receive(self: c104.Point, callable: collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState]) -> None
+          R"def(on_receive(self: c104.Point, callable: typing.Union[collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState], collections.abc.Callable[[int, float, int, int], c104.ResponseState]]) -> None
 
 set python callback that will be executed on every incoming message
 this can be either a command or an monitoring message
 
+A callable with the lightweight signature (io_address, value, quality, recorded_at_ms) receives plain scalars instead of point, information and message objects, which is considerably cheaper per call. The dispatch is selected by the signature of the callable.
+
 Parameters
 ----------
-callable: collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState]
+callable: typing.Union[collections.abc.Callable[[c104.Point, c104.Information, c104.IncomingMessage], c104.ResponseState], collections.abc.Callable[[int, float, int, int], c104.ResponseState]]
     callback function reference
 
 Returns
@@ -2128,6 +3282,24 @@ Callable Returns
 c104.ResponseState
     send command SUCCESS or FAILURE response
 
+**Lightweight callable signature**
+
+Callable Parameters
+-------------------
+io_address: int
+    information object address of the point
+value: float
+    new value as number, booleans and enums are passed as their integer value, NaN if the value has no numeric representation
+quality: int
+    quality bitset as integer, 0 if the type has no quality
+recorded_at_ms: int
+    recorded timestamp in milliseconds since epoch, 0 if the message has no timestamp
+
+Callable Returns
+----------------
+c104.ResponseState
+    send command SUCCESS or FAILURE response
+
 Example
 -------
 >>> def on_setpoint_command(point: c104.Point, previous_info: c104.Information, message: c104.IncomingMessage) -> c104.ResponseState:
@@ -2146,6 +3318,12 @@ Example
 >>> sv_measurement_point.value = 12.34
 >>> sv_command_point = sv_station_2.add_point(io_address=12, type=c104.Type.C_SE_NC_1, report_ms=0, related_io_address=sv_measurement_point.io_address, related_io_autoreturn=True, command_mode=c104.CommandMode.SELECT_AND_EXECUTE)
 >>> sv_command_point.on_receive(callable=on_setpoint_command)
+>>>
+>>> def on_measurement(io_address: int, value: float, quality: int, recorded_at_ms: int) -> c104.ResponseState:
+>>>     print("CL] IOA: {0}, value: {1}, quality: {2}".format(io_address, value, quality))
+>>>     return c104.ResponseState.NONE
+>>>
+>>> cl_measurement_point.on_receive(callable=on_measurement)
 )def",
           "callable"_a)
       .def(
@@ -2333,6 +3511,25 @@ Example
 >>> cl_single_command_point.transmit(cause=c104.Cot.ACTIVATION)
 )def",
            "cause"_a, py::return_value_policy::copy)
+      .def("prepare_command", &Object::DataPoint::prepareCommand,
+           R"def(prepare_command(self: c104.Point) -> None
+
+**Client-side point**
+encode the command frame of this point once, following transmissions only patch value, timestamp and cause of transmission in place
+
+This reduces the latency of frequently transmitted commands like setpoints. The frame is encoded from scratch again if the point type changes.
+
+Raises
+------
+ValueError
+    parent station or connection reference is invalid, point is server-sided or not a command
+
+Example
+-------
+>>> cl_setpoint.prepare_command()
+>>> cl_setpoint.value = 12.5
+>>> cl_setpoint.transmit(cause=c104.Cot.ACTIVATION)
+)def")
       .def("__repr__", &Object::DataPoint::toString);
 
   py::class_<Object::Information, std::shared_ptr<Object::Information>>(
@@ -0,0 +1,288 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file AdmissionControl.cpp
+ * @brief native accept or reject decision for incoming connections
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "AdmissionControl.h"
+
+using namespace Remote;
+
+/**
+ * @brief parse a dotted IPv4 address
+ */
+static std::optional<std::uint32_t> parseIPv4(const std::string &s) {
+  std::uint32_t address = 0;
+  std::size_t pos = 0;
+  for (int octet = 0; octet < 4; octet++) {
+    if (octet > 0) {
+      if (pos >= s.size() || s[pos] != '.') {
+        return std::nullopt;
+      }
+      pos++;
+    }
+    std::size_t const start = pos;
+    std::uint32_t value = 0;
+    while (pos < s.size() && pos - start < 3 && std::isdigit(s[pos])) {
+      value = value * 10 + (s[pos] - '0');
+      pos++;
+    }
+    if (pos == start || value > 255) {
+      return std::nullopt;
+    }
+    address = (address << 8) | value;
+  }
+  if (pos != s.size()) {
+    return std::nullopt;
+  }
+  return address;
+}
+
+std::string AdmissionControl::toIP(const std::string &peer_address) {
+  if (!peer_address.empty() && peer_address.front() == '[') {
+    // [IPv6]:port
+    auto const end = peer_address.find(']');
+    return peer_address.substr(1, end == std::string::npos ? std::string::npos
+                                                            : end - 1);
+  }
+  auto const colon = peer_address.find(':');
+  if (colon != std::string::npos && colon == peer_address.rfind(':')) {
+    // IPv4:port
+    return peer_address.substr(0, colon);
+  }
+  return peer_address;
+}
+
+bool AdmissionControl::TokenBucket::tryConsume(
+    const double rate, const double size,
+    const std::chrono::steady_clock::time_point now) {
+  if (refilledAt == std::chrono::steady_clock::time_point{}) {
+    tokens = size;
+  } else {
+    double const elapsed =
+        std::chrono::duration<double>(now - refilledAt).count();
+    tokens = std::min(size, tokens + elapsed * rate);
+  }
+  refilledAt = now;
+  if (tokens < 1) {
+    return false;
+  }
+  tokens -= 1;
+  return true;
+}
+
+void AdmissionControl::addRule(const std::string &cidr, const bool allow) {
+  auto const slash = cidr.find('/');
+  auto const address = parseIPv4(cidr.substr(0, slash));
+  int prefix = 32;
+  if (slash != std::string::npos) {
+    std::string const length = cidr.substr(slash + 1);
+    if (length.empty() || length.size() > 2 ||
+        !std::all_of(length.begin(), length.end(),
+                     [](char c) { return std::isdigit(c); })) {
+      prefix = -1;
+    } else {
+      prefix = std::stoi(length);
+    }
+  }
+  if (!address.has_value() || prefix < 0 || prefix > 32) {
+    throw std::invalid_argument("Network " + cidr + " is invalid!");
+  }
+
+  std::uint32_t const mask =
+      prefix == 0 ? 0 : ~std::uint32_t{0} << (32 - prefix);
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  (allow ? allowed : denied)
+      .push_back({cidr, address.value() & mask, mask});
+}
+
+void AdmissionControl::clearRules() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  allowed.clear();
+  denied.clear();
+}
+
+void AdmissionControl::setLimits(
+    const std::uint_fast32_t max_connections_per_ip, const double accept_rate,
+    const double accept_rate_per_ip, const std::uint_fast32_t burst_size) {
+  if (accept_rate < 0 || accept_rate_per_ip < 0) {
+    throw std::invalid_argument("Accept rate must not be negative!");
+  }
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  maxConnectionsPerIP = max_connections_per_ip;
+  acceptRate = accept_rate;
+  acceptRatePerIP = accept_rate_per_ip;
+  burst = std::max<std::uint_fast32_t>(burst_size, 1);
+}
+
+bool AdmissionControl::matches(const std::vector<Network> &networks,
+                               const std::optional<std::uint32_t> address) {
+  if (!address.has_value()) {
+    return false;
+  }
+  return std::any_of(networks.begin(), networks.end(),
+                     [&address](const Network &network) {
+                       return (address.value() & network.mask) ==
+                              network.address;
+                     });
+}
+
+AdmissionControl::Verdict
+AdmissionControl::evaluate(const std::string &peer_address) {
+  std::string const ip = toIP(peer_address);
+  auto const address = parseIPv4(ip);
+  auto const now = std::chrono::steady_clock::now();
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  if (matches(denied, address)) {
+    rejectedDenied++;
+    return Verdict::Reject;
+  }
+
+  bool const allow = matches(allowed, address);
+  if (!allow && !allowed.empty()) {
+    rejectedNotAllowed++;
+    return Verdict::Reject;
+  }
+
+  auto it = peers.find(ip);
+  if (maxConnectionsPerIP > 0 && it != peers.end() &&
+      it->second.open >= maxConnectionsPerIP) {
+    rejectedCap++;
+    return Verdict::Reject;
+  }
+
+  if (acceptRate > 0 && !global.tryConsume(acceptRate, burst, now)) {
+    rejectedRate++;
+    return Verdict::Reject;
+  }
+  if (acceptRatePerIP > 0) {
+    if (it == peers.end()) {
+      prune(now);
+      it = peers.emplace(ip, Peer{}).first;
+    }
+    if (!it->second.bucket.tryConsume(acceptRatePerIP, burst, now)) {
+      rejectedRate++;
+      return Verdict::Reject;
+    }
+  }
+
+  if (allow) {
+    accepted++;
+    return Verdict::Accept;
+  }
+  undecided++;
+  return Verdict::Undecided;
+}
+
+bool AdmissionControl::isIdle(
+    const TokenBucket &bucket,
+    const std::chrono::steady_clock::time_point now) const {
+  if (acceptRatePerIP <= 0 ||
+      bucket.refilledAt == std::chrono::steady_clock::time_point{}) {
+    // the bucket is not used
+    return true;
+  }
+  double const elapsed =
+      std::chrono::duration<double>(now - bucket.refilledAt).count();
+  return bucket.tokens + elapsed * acceptRatePerIP >= burst;
+}
+
+void AdmissionControl::prune(const std::chrono::steady_clock::time_point now) {
+  if (peers.size() < ADMISSION_MAX_TRACKED_PEERS) {
+    return;
+  }
+  for (auto it = peers.begin(); it != peers.end();) {
+    if (it->second.open == 0 && isIdle(it->second.bucket, now)) {
+      it = peers.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void AdmissionControl::opened(const std::string &peer_address) {
+  std::string const ip = toIP(peer_address);
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto it = peers.find(ip);
+  if (it == peers.end()) {
+    prune(std::chrono::steady_clock::now());
+    it = peers.emplace(ip, Peer{}).first;
+  }
+  it->second.open++;
+}
+
+void AdmissionControl::closed(const std::string &peer_address) {
+  std::string const ip = toIP(peer_address);
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto it = peers.find(ip);
+  if (it != peers.end() && it->second.open > 0) {
+    it->second.open--;
+  }
+}
+
+void AdmissionControl::rejectedByCallback() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  rejectedCallback++;
+}
+
+py::dict AdmissionControl::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::list allow;
+  for (const auto &network : allowed) {
+    allow.append(network.cidr);
+  }
+  py::list deny;
+  for (const auto &network : denied) {
+    deny.append(network.cidr);
+  }
+  std::uint_fast64_t open = 0;
+  for (const auto &peer : peers) {
+    open += peer.second.open;
+  }
+
+  py::dict result;
+  result["allow"] = allow;
+  result["deny"] = deny;
+  result["max_connections_per_ip"] = maxConnectionsPerIP;
+  result["accept_rate"] = acceptRate;
+  result["accept_rate_per_ip"] = acceptRatePerIP;
+  result["burst"] = static_cast<std::uint_fast32_t>(burst);
+  result["accepted"] = accepted;
+  result["undecided"] = undecided;
+  result["rejected_denied"] = rejectedDenied;
+  result["rejected_not_allowed"] = rejectedNotAllowed;
+  result["rejected_cap"] = rejectedCap;
+  result["rejected_rate"] = rejectedRate;
+  result["rejected_callback"] = rejectedCallback;
+  result["open"] = open;
+  result["tracked"] = peers.size();
+  return result;
+}
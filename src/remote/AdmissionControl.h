@@ -0,0 +1,180 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file AdmissionControl.h
+ * @brief native accept or reject decision for incoming connections
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_ADMISSIONCONTROL_H
+#define C104_REMOTE_ADMISSIONCONTROL_H
+
+#include <optional>
+#include <unordered_map>
+
+#include "module/GilAwareMutex.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief number of tracked peers after which idle peers are forgotten
+constexpr std::size_t ADMISSION_MAX_TRACKED_PEERS = 4096;
+
+/**
+ * @brief decides about incoming connection requests without python
+ *
+ * Rules are evaluated in this order: denied networks, per-peer connection cap,
+ * global and per-peer accept rate (token buckets), allowed networks. A request
+ * that matches an allowed network is accepted. If allowed networks are
+ * configured, all other requests are rejected. Otherwise the request is left
+ * undecided and the server asks the python on_connect callback.
+ * Networks are IPv4 CIDR blocks, IPv6 peers only pass caps and rate limits.
+ */
+class AdmissionControl {
+public:
+  enum class Verdict { Accept, Reject, Undecided };
+
+  /**
+   * @brief add an allowed or denied network
+   * @param cidr IPv4 address with optional prefix length, e.g. 10.0.0.0/8
+   * @param allow allow or deny matching peers
+   * @throws std::invalid_argument if cidr is invalid
+   */
+  void addRule(const std::string &cidr, bool allow);
+
+  /**
+   * @brief remove all allowed and denied networks
+   */
+  void clearRules();
+
+  /**
+   * @brief Setter for caps and accept rate limits
+   * @param max_connections_per_ip open connections per peer, 0 = unlimited
+   * @param accept_rate accepted requests per second, 0 = unlimited
+   * @param accept_rate_per_ip accepted requests per second and peer, 0 =
+   * unlimited
+   * @param burst number of requests accepted at once, at least 1
+   */
+  void setLimits(std::uint_fast32_t max_connections_per_ip, double accept_rate,
+                 double accept_rate_per_ip, std::uint_fast32_t burst);
+
+  /**
+   * @brief evaluate the native rules for a connection request
+   * @param peer_address peer address with or without port
+   * @return verdict, accepted requests consume rate tokens
+   */
+  Verdict evaluate(const std::string &peer_address);
+
+  /**
+   * @brief count an accepted connection for the per-peer cap
+   */
+  void opened(const std::string &peer_address);
+
+  /**
+   * @brief uncount a closed connection
+   */
+  void closed(const std::string &peer_address);
+
+  /**
+   * @brief count a request rejected by python
+   */
+  void rejectedByCallback();
+
+  /**
+   * @brief strip the port and brackets from a peer address
+   */
+  static std::string toIP(const std::string &peer_address);
+
+  /**
+   * @brief Getter for configuration and statistics as python dictionary
+   * @return dict with allow, deny, max_connections_per_ip, accept_rate,
+   * accept_rate_per_ip, burst, accepted, undecided, rejected_denied,
+   * rejected_not_allowed, rejected_cap, rejected_rate, rejected_callback,
+   * open and tracked
+   */
+  py::dict toDict() const;
+
+private:
+  struct Network {
+    std::string cidr;
+    std::uint32_t address;
+    std::uint32_t mask;
+  };
+
+  struct TokenBucket {
+    double tokens{0};
+    std::chrono::steady_clock::time_point refilledAt{};
+
+    bool tryConsume(double rate, double burst,
+                    std::chrono::steady_clock::time_point now);
+  };
+
+  struct Peer {
+    std::uint_fast32_t open{0};
+    TokenBucket bucket{};
+  };
+
+  static bool matches(const std::vector<Network> &networks,
+                      std::optional<std::uint32_t> address);
+
+  /**
+   * @brief test if a peer bucket is unused or refilled completely
+   */
+  bool isIdle(const TokenBucket &bucket,
+              std::chrono::steady_clock::time_point now) const;
+
+  /**
+   * @brief forget peers without open connections and with an idle bucket, the
+   * lock must be held
+   */
+  void prune(std::chrono::steady_clock::time_point now);
+
+  /// @brief MUTEX Lock to access rules, buckets and statistics
+  mutable Module::GilAwareMutex access_mutex{"AdmissionControl::access_mutex"};
+
+  std::vector<Network> allowed{};
+  std::vector<Network> denied{};
+
+  std::uint_fast32_t maxConnectionsPerIP{0};
+  double acceptRate{0};
+  double acceptRatePerIP{0};
+  double burst{1};
+
+  TokenBucket global{};
+  std::unordered_map<std::string, Peer> peers{};
+
+  std::uint_fast64_t accepted{0};
+  std::uint_fast64_t undecided{0};
+  std::uint_fast64_t rejectedDenied{0};
+  std::uint_fast64_t rejectedNotAllowed{0};
+  std::uint_fast64_t rejectedCap{0};
+  std::uint_fast64_t rejectedRate{0};
+  std::uint_fast64_t rejectedCallback{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_ADMISSIONCONTROL_H
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file BackgroundScan.cpp
+ * @brief pacing and progress of a server-side background scan
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "BackgroundScan.h"
+
+using namespace Remote;
+
+void BackgroundScan::enable(const std::uint_fast32_t pointsPerSecond) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto const now = std::chrono::steady_clock::now();
+  rate.store(pointsPerSecond);
+  cursor = Cursor{0, 0, cursor.generation + 1};
+  credit = 0;
+  creditedAt = now;
+  cycleStartedAt = now;
+  cyclePoints = 0;
+  enabled.store(true);
+}
+
+void BackgroundScan::disable() { enabled.store(false); }
+
+bool BackgroundScan::isEnabled() const { return enabled.load(); }
+
+std::uint_fast32_t BackgroundScan::getRate() const { return rate.load(); }
+
+std::size_t BackgroundScan::takeBudget() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto const now = std::chrono::steady_clock::now();
+  double const perSecond = rate.load();
+  credit += perSecond * std::chrono::duration<double>(now - creditedAt).count();
+  creditedAt = now;
+  credit = std::min(credit, perSecond);
+
+  auto const budget = static_cast<std::size_t>(credit);
+  credit -= static_cast<double>(budget);
+  return budget;
+}
+
+void BackgroundScan::refundBudget(const std::size_t unused) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  credit = std::min(credit + static_cast<double>(unused),
+                    static_cast<double>(rate.load()));
+}
+
+void BackgroundScan::recordDeferred() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  deferred++;
+}
+
+BackgroundScan::Cursor BackgroundScan::getCursor() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  return cursor;
+}
+
+void BackgroundScan::advance(const Cursor &next, const std::size_t sent) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (next.generation != cursor.generation) {
+    return;
+  }
+  cursor = next;
+  points += sent;
+  cyclePoints += sent;
+}
+
+void BackgroundScan::completeCycle(const Cursor &last) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (last.generation != cursor.generation) {
+    return;
+  }
+  auto const now = std::chrono::steady_clock::now();
+  lastCycle_ms =
+      std::chrono::duration<double, std::milli>(now - cycleStartedAt).count();
+  cycleStartedAt = now;
+  cycles++;
+  cyclePoints = 0;
+  cursor = Cursor{0, 0, cursor.generation};
+}
+
+py::dict BackgroundScan::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  bool const active = enabled.load();
+
+  py::dict result;
+  result["enabled"] = active;
+  result["rate"] = rate.load();
+  result["cycles"] = cycles;
+  result["points"] = points;
+  result["deferred"] = deferred;
+  result["cycle_points"] = cyclePoints;
+  result["last_cycle_ms"] = lastCycle_ms;
+  result["current_cycle_ms"] =
+      active ? std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - cycleStartedAt)
+                   .count()
+             : 0.0;
+  return result;
+}
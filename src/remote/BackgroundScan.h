@@ -0,0 +1,161 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file BackgroundScan.h
+ * @brief pacing and progress of a server-side background scan
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_BACKGROUNDSCAN_H
+#define C104_REMOTE_BACKGROUNDSCAN_H
+
+#include "module/GilAwareMutex.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief number of points per step if the scan only uses idle send windows
+constexpr std::size_t BACKGROUND_SCAN_IDLE_BATCH = 64;
+
+/**
+ * @brief paces a background scan that cycles through all monitoring points of
+ * a server and collects cycle statistics
+ *
+ * The scan either sends a configured number of points per second or a fixed
+ * batch per step while the send windows of all connections are available.
+ */
+class BackgroundScan {
+public:
+  /// @brief position of the next point to scan
+  struct Cursor {
+    /// @brief index of the station in the server station list
+    std::size_t station{0};
+
+    /// @brief lowest information object address of the next point
+    std::uint_fast32_t informationObjectAddress{0};
+
+    /// @brief incremented on restart, outdated cursors are ignored
+    std::uint_fast64_t generation{0};
+  };
+
+  /**
+   * @brief start a new scan cycle
+   * @param pointsPerSecond send rate, 0 = only use idle send windows
+   */
+  void enable(std::uint_fast32_t pointsPerSecond);
+
+  /**
+   * @brief stop scanning, statistics are kept
+   */
+  void disable();
+
+  bool isEnabled() const;
+
+  /**
+   * @brief Getter for the configured rate
+   * @return points per second, 0 = only use idle send windows
+   */
+  std::uint_fast32_t getRate() const;
+
+  /**
+   * @brief Get the number of points that may be sent now according to the
+   * configured rate, unused credit is limited to one second
+   * @return number of points
+   */
+  std::size_t takeBudget();
+
+  /**
+   * @brief give back points of a budget that were not sent, because the scan
+   * cycle completed before the budget was used up
+   * @param unused number of points
+   */
+  void refundBudget(std::size_t unused);
+
+  /**
+   * @brief count a step that was skipped because a send window was full
+   */
+  void recordDeferred();
+
+  Cursor getCursor() const;
+
+  /**
+   * @brief store the progress of a step
+   * @param cursor position of the next point, ignored if outdated
+   * @param sent number of points sent in this step
+   */
+  void advance(const Cursor &cursor, std::size_t sent);
+
+  /**
+   * @brief finish the current scan cycle and start the next one
+   * @param cursor cursor of the finished cycle, ignored if outdated
+   */
+  void completeCycle(const Cursor &cursor);
+
+  /**
+   * @brief Getter for configuration and statistics as python dictionary
+   * @return dict with enabled, rate, cycles, points, deferred, cycle_points,
+   * last_cycle_ms and current_cycle_ms
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief MUTEX Lock to access cursor and statistics
+  mutable Module::GilAwareMutex access_mutex{"BackgroundScan::access_mutex"};
+
+  std::atomic_bool enabled{false};
+
+  /// @brief points per second, 0 = only use idle send windows
+  std::atomic_uint_fast32_t rate{0};
+
+  Cursor cursor{};
+
+  /// @brief unused send budget in points
+  double credit{0};
+
+  /// @brief time of the last budget calculation
+  std::chrono::steady_clock::time_point creditedAt{};
+
+  /// @brief start of the current cycle
+  std::chrono::steady_clock::time_point cycleStartedAt{};
+
+  /// @brief number of completed cycles
+  std::uint_fast64_t cycles{0};
+
+  /// @brief number of points sent in total
+  std::uint_fast64_t points{0};
+
+  /// @brief number of steps skipped because of a full send window
+  std::uint_fast64_t deferred{0};
+
+  /// @brief number of points sent in the current cycle
+  std::uint_fast64_t cyclePoints{0};
+
+  /// @brief duration of the last completed cycle in milliseconds
+  double lastCycle_ms{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_BACKGROUNDSCAN_H
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file BandwidthShaper.cpp
+ * @brief token bucket rate limit for outgoing frames of a connection
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "BandwidthShaper.h"
+
+using namespace Remote;
+
+BandwidthShaper::BandwidthShaper(std::string peer_ip)
+    : ip(std::move(peer_ip)) {}
+
+BandwidthShaper::~BandwidthShaper() {
+  for (std::size_t i = 0; i < held.size(); i++) {
+    for (auto &frame : held[i]) {
+      discard(frame, i > 0);
+    }
+  }
+}
+
+void BandwidthShaper::unaccount(const Frame &frame, const bool low) {
+  Module::MemoryBudget::remove(
+      low ? Module::MemoryBudget::Subsystem::HeldPeriodicFrames
+          : Module::MemoryBudget::Subsystem::HeldFrames,
+      FRAME_FOOTPRINT);
+  heldBytes -= frame.size;
+}
+
+void BandwidthShaper::discard(Frame &frame, const bool low) {
+  unaccount(frame, low);
+  CS101_ASDU_destroy(frame.asdu);
+}
+
+void BandwidthShaper::configure(const std::uint_fast32_t bytesPerSecond,
+                                const std::uint_fast32_t burstBytes) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  refill(std::chrono::steady_clock::now());
+  rate.store(bytesPerSecond);
+  burst = std::max<double>(burstBytes, MAX_APDU_SIZE);
+  tokens = std::min(tokens, burst);
+}
+
+std::uint_fast32_t BandwidthShaper::getRate() const { return rate.load(); }
+
+void BandwidthShaper::refill(const std::chrono::steady_clock::time_point now) {
+  double const elapsed =
+      std::chrono::duration<double>(now - refilledAt).count();
+  refilledAt = now;
+  tokens = std::min(burst, tokens + elapsed * rate.load());
+}
+
+void BandwidthShaper::account(const std::size_t size) {
+  bytes += size;
+  frames++;
+}
+
+bool BandwidthShaper::tryConsume(const std::size_t size, const bool low) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  // keep the order of frames with the same or a higher priority
+  if (!held[0].empty() || (low && !held[1].empty())) {
+    return false;
+  }
+  if (rate.load() > 0) {
+    refill(std::chrono::steady_clock::now());
+    if (tokens < static_cast<double>(size)) {
+      return false;
+    }
+    tokens -= static_cast<double>(size);
+  }
+  account(size);
+  return true;
+}
+
+void BandwidthShaper::hold(CS101_ASDU asdu, const std::size_t size,
+                           const bool low, const std::uint_fast64_t key) {
+  using Stage = Module::MemoryBudget::Stage;
+  auto const stage = Module::MemoryBudget::getStage();
+
+  if (low && stage >= Stage::DropPeriodic) {
+    // periodic data is sent again in the next cycle
+    std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+    std::size_t const count = held[1].size() + 1;
+    for (auto &frame : held[1]) {
+      discard(frame, true);
+    }
+    held[1].clear();
+    droppedFrames += count;
+    Module::MemoryBudget::recordShed(Stage::DropPeriodic, count);
+    return;
+  }
+
+  CS101_ASDU const copy = CS101_ASDU_clone(asdu, nullptr);
+  if (!copy) {
+    return;
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto &queue = held[low ? 1 : 0];
+
+  if (0 != key && !low && stage >= Stage::Coalesce) {
+    // the newer value takes the place of the older frame of the same point
+    for (auto it = queue.rbegin(); it != queue.rend(); ++it) {
+      if (it->key == key) {
+        CS101_ASDU_destroy(it->asdu);
+        heldBytes = heldBytes - it->size + size;
+        it->asdu = copy;
+        it->size = size;
+        coalescedFrames++;
+        Module::MemoryBudget::recordShed(Stage::Coalesce);
+        return;
+      }
+    }
+  }
+
+  if (queue.size() >= BANDWIDTH_MAX_HELD_FRAMES) {
+    discard(queue.front(), low);
+    queue.pop_front();
+    droppedFrames++;
+  }
+  queue.push_back({copy, size, std::chrono::steady_clock::now(), key});
+  heldBytes += size;
+  delayedFrames++;
+  Module::MemoryBudget::add(
+      low ? Module::MemoryBudget::Subsystem::HeldPeriodicFrames
+          : Module::MemoryBudget::Subsystem::HeldFrames,
+      FRAME_FOOTPRINT);
+}
+
+bool BandwidthShaper::hasHeldFrames() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  return !held[0].empty();
+}
+
+void BandwidthShaper::charge(const std::size_t size) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (rate.load() > 0) {
+    refill(std::chrono::steady_clock::now());
+    tokens = std::max(-burst, tokens - static_cast<double>(size));
+  }
+  bypassedBytes += size;
+  account(size);
+}
+
+CS101_ASDU BandwidthShaper::releaseNext() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  auto const now = std::chrono::steady_clock::now();
+  bool const limited = rate.load() > 0;
+  if (limited) {
+    refill(now);
+  }
+
+  for (std::size_t i = 0; i < held.size(); i++) {
+    auto &queue = held[i];
+    if (queue.empty()) {
+      continue;
+    }
+    auto &frame = queue.front();
+    if (limited && tokens < static_cast<double>(frame.size)) {
+      return nullptr;
+    }
+    if (limited) {
+      tokens -= static_cast<double>(frame.size);
+    }
+    double const waited =
+        std::chrono::duration<double, std::milli>(now - frame.heldAt).count();
+    held_ms += waited;
+    maxHeld_ms = std::max(maxHeld_ms, waited);
+    account(frame.size);
+
+    // hand the frame over without destroying it
+    CS101_ASDU const asdu = frame.asdu;
+    unaccount(frame, i > 0);
+    queue.pop_front();
+    return asdu;
+  }
+  return nullptr;
+}
+
+py::dict BandwidthShaper::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::dict result;
+  result["ip"] = ip;
+  result["rate"] = rate.load();
+  result["burst"] = static_cast<std::uint_fast32_t>(burst);
+  result["bytes"] = bytes;
+  result["frames"] = frames;
+  result["bypassed_bytes"] = bypassedBytes;
+  result["delayed_frames"] = delayedFrames;
+  result["held_frames"] = held[0].size() + held[1].size();
+  result["held_bytes"] = heldBytes;
+  result["dropped_frames"] = droppedFrames;
+  result["coalesced_frames"] = coalescedFrames;
+  result["held_ms"] = held_ms;
+  result["max_held_ms"] = maxHeld_ms;
+  return result;
+}
@@ -0,0 +1,209 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file BandwidthShaper.h
+ * @brief token bucket rate limit for outgoing frames of a connection
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_BANDWIDTHSHAPER_H
+#define C104_REMOTE_BANDWIDTHSHAPER_H
+
+#include <deque>
+
+#include "module/GilAwareMutex.h"
+#include "module/MemoryBudget.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief maximum length of an APDU including start byte and length field
+constexpr std::size_t MAX_APDU_SIZE = 255;
+
+/// @brief maximum number of held frames per priority, older frames are
+/// dropped if exceeded
+constexpr std::size_t BANDWIDTH_MAX_HELD_FRAMES = 4096;
+
+/**
+ * @brief token bucket that limits the outgoing bytes per second of a single
+ * master connection
+ *
+ * Frames that exceed the budget are copied and held in one of two FIFO queues.
+ * Normal frames (interrogation responses, spontaneous data) are always
+ * released before low priority frames (periodic and background data).
+ * Confirmations bypass the shaper, but their size is charged to the bucket.
+ * Held frames are accounted in the memory budget, which may drop periodic
+ * frames or coalesce spontaneous frames of the same point.
+ */
+class BandwidthShaper {
+public:
+  /**
+   * @param ip peer ip address
+   */
+  explicit BandwidthShaper(std::string ip);
+
+  ~BandwidthShaper();
+
+  BandwidthShaper(const BandwidthShaper &) = delete;
+  BandwidthShaper &operator=(const BandwidthShaper &) = delete;
+
+  const std::string &getIP() const { return ip; }
+
+  /**
+   * @brief Setter for the rate limit
+   * @param bytesPerSecond limit in bytes per second, 0 = unlimited
+   * @param burstBytes bucket size in bytes, at least MAX_APDU_SIZE
+   */
+  void configure(std::uint_fast32_t bytesPerSecond,
+                 std::uint_fast32_t burstBytes);
+
+  /**
+   * @brief Getter for the rate limit
+   * @return bytes per second, 0 = unlimited
+   */
+  std::uint_fast32_t getRate() const;
+
+  /**
+   * @brief Consume tokens for a frame that should be sent now
+   * @param size frame size in bytes
+   * @param low low priority frame
+   * @return true if the frame may be sent now, false if it must be held
+   */
+  bool tryConsume(std::size_t size, bool low);
+
+  /**
+   * @brief Copy a frame into a queue until tokens are available
+   * @param asdu frame to hold, the caller keeps ownership
+   * @param size frame size in bytes
+   * @param low low priority frame
+   * @param key identifies the point of a single object frame that may be
+   * replaced by a newer frame under memory pressure, 0 = never replace
+   */
+  void hold(CS101_ASDU asdu, std::size_t size, bool low,
+            std::uint_fast64_t key = 0);
+
+  /**
+   * @brief Test if normal priority frames are held
+   */
+  bool hasHeldFrames() const;
+
+  /**
+   * @brief Charge the size of a frame that bypassed the shaper, the bucket may
+   * run into debt of one bucket size
+   * @param size frame size in bytes
+   */
+  void charge(std::size_t size);
+
+  /**
+   * @brief Take the next held frame in priority order if tokens are available,
+   * so that it can be sent without holding the lock of the shaper
+   * @return frame owned by the caller, that must destroy it after sending, or
+   * nullptr if no frame may be sent now
+   */
+  CS101_ASDU releaseNext();
+
+  /**
+   * @brief Getter for configuration and statistics as python dictionary
+   * @return dict with ip, rate, burst, bytes, frames, bypassed_bytes,
+   * delayed_frames, held_frames, held_bytes, dropped_frames,
+   * coalesced_frames, held_ms and max_held_ms
+   */
+  py::dict toDict() const;
+
+private:
+  struct Frame {
+    CS101_ASDU asdu;
+    std::size_t size;
+    std::chrono::steady_clock::time_point heldAt;
+    std::uint_fast64_t key;
+  };
+
+  /// @brief accounted memory of a held frame
+  static constexpr std::size_t FRAME_FOOTPRINT =
+      sizeof(sCS101_StaticASDU) + sizeof(Frame);
+
+  /**
+   * @brief give back the accounted memory of a held frame, the lock must be
+   * held
+   */
+  void unaccount(const Frame &frame, bool low);
+
+  /**
+   * @brief give back the accounted memory of a held frame and destroy it, the
+   * lock must be held
+   */
+  void discard(Frame &frame, bool low);
+
+  /**
+   * @brief add tokens for the elapsed time, the lock must be held
+   */
+  void refill(std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief update statistics of a sent frame, the lock must be held
+   */
+  void account(std::size_t size);
+
+  /// @brief peer ip address
+  const std::string ip;
+
+  /// @brief MUTEX Lock to access bucket, queues and statistics
+  mutable Module::GilAwareMutex access_mutex{"BandwidthShaper::access_mutex"};
+
+  /// @brief limit in bytes per second, 0 = unlimited
+  std::atomic_uint_fast32_t rate{0};
+
+  /// @brief bucket size in bytes
+  double burst{MAX_APDU_SIZE};
+
+  /// @brief available bytes, negative after bypassed frames
+  double tokens{MAX_APDU_SIZE};
+
+  /// @brief time of the last refill
+  std::chrono::steady_clock::time_point refilledAt{
+      std::chrono::steady_clock::now()};
+
+  /// @brief held frames: [0] normal priority, [1] low priority
+  std::array<std::deque<Frame>, 2> held{};
+
+  std::size_t heldBytes{0};
+
+  std::uint_fast64_t bytes{0};
+  std::uint_fast64_t frames{0};
+  std::uint_fast64_t bypassedBytes{0};
+  std::uint_fast64_t delayedFrames{0};
+  std::uint_fast64_t droppedFrames{0};
+  std::uint_fast64_t coalescedFrames{0};
+
+  /// @brief total time frames were held back in milliseconds
+  double held_ms{0};
+
+  /// @brief longest time a frame was held back in milliseconds
+  double maxHeld_ms{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_BANDWIDTHSHAPER_H
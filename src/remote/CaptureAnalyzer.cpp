@@ -0,0 +1,623 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CaptureAnalyzer.cpp
+ * @brief offline analysis of captured IEC 60870-5-104 traffic
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "CaptureAnalyzer.h"
+#include "remote/message/IncomingMessage.h"
+
+#include <cstring>
+
+using namespace Remote;
+
+namespace {
+
+using ConnectionStatistics = CaptureAnalyzer::ConnectionStatistics;
+using DirectionStatistics = CaptureAnalyzer::DirectionStatistics;
+
+/// @brief sequence numbers of I-frames are counted modulo 2^15
+constexpr std::uint16_t SEQUENCE_MODULO = 32768;
+
+sCS101_AppLayerParameters createAppLayerParameters() {
+  sCS101_AppLayerParameters parameters{};
+  parameters.sizeOfTypeId = 1;
+  parameters.sizeOfVSQ = 1;
+  parameters.sizeOfCOT = 2;
+  parameters.originatorAddress = 0;
+  parameters.sizeOfCA = 2;
+  parameters.sizeOfIOA = 3;
+  parameters.maxSizeOfASDU = 249;
+  return parameters;
+}
+
+sCS101_AppLayerParameters appLayerParameters = createAppLayerParameters();
+
+/**
+ * @brief test if sequence number a is before b (modulo 2^15)
+ */
+bool isBefore(const std::uint16_t a, const std::uint16_t b) {
+  std::uint16_t const distance = (b - a + SEQUENCE_MODULO) % SEQUENCE_MODULO;
+  return distance > 0 && distance < SEQUENCE_MODULO / 2;
+}
+
+void confirm(DirectionStatistics &sender, const std::uint16_t receiveSequence,
+             const std::int64_t timestamp_ns) {
+  while (!sender.unconfirmed.empty() &&
+         isBefore(sender.unconfirmed.front().first, receiveSequence)) {
+    sender.ackLatency.add(
+        static_cast<double>(timestamp_ns - sender.unconfirmed.front().second) /
+        1e6);
+    sender.unconfirmed.pop_front();
+  }
+}
+
+void processAsdu(ConnectionStatistics &connection,
+                 const std::int64_t timestamp_ns,
+                 const std::uint8_t *asduBuffer, const std::size_t size) {
+  connection.asdus++;
+  connection.asduBytes += size;
+
+  CS101_ASDU asdu = CS101_ASDU_createFromBuffer(
+      &appLayerParameters, const_cast<std::uint8_t *>(asduBuffer),
+      static_cast<int>(size));
+  if (!asdu) {
+    connection.rejected[INVALID_TYPE_ID]++;
+    return;
+  }
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+  CS101_ASDU_destroy(asdu);
+
+  if (!message->isValid()) {
+    connection.rejected[message->getRejectCause()]++;
+    return;
+  }
+
+  int const cot = message->getCauseOfTransmission();
+  connection.causes[cot]++;
+  connection.types[message->getType()]++;
+  connection.objects += message->getNumberOfObject();
+
+  while (message->next()) {
+    std::uint64_t const key =
+        (static_cast<std::uint64_t>(message->getCommonAddress()) << 32) |
+        message->getIOA();
+    auto &point = connection.points[key];
+    if (point.count > 0) {
+      point.interArrival.add(
+          static_cast<double>(timestamp_ns - point.last_ns) / 1e6);
+    } else {
+      point.first_ns = timestamp_ns;
+    }
+    point.type = message->getType();
+    point.last_ns = timestamp_ns;
+    point.count++;
+    point.causes[cot]++;
+  }
+}
+
+void processApdu(ConnectionStatistics &connection, const std::size_t direction,
+                 const std::int64_t timestamp_ns, const std::uint8_t *apdu,
+                 const std::size_t size) {
+  auto &sender = connection.directions[direction];
+  auto &receiver = connection.directions[1 - direction];
+
+  if (0 == connection.first_ns) {
+    connection.first_ns = timestamp_ns;
+  }
+  connection.last_ns = timestamp_ns;
+  sender.bytes += size;
+
+  if (size < 6) {
+    sender.skippedBytes += size;
+    return;
+  }
+
+  auto const readSequence = [apdu](const std::size_t offset) {
+    return static_cast<std::uint16_t>(
+        (apdu[offset] | (apdu[offset + 1] << 8)) >> 1);
+  };
+
+  if (0 == (apdu[2] & 0x01)) {
+    sender.iFrames++;
+    std::uint16_t const sendSequence = readSequence(2);
+    if (sender.expectedSendSequence.has_value() &&
+        sender.expectedSendSequence.value() != sendSequence) {
+      sender.sequenceGaps++;
+      sender.missingFrames +=
+          (sendSequence - sender.expectedSendSequence.value() +
+           SEQUENCE_MODULO) %
+          SEQUENCE_MODULO;
+    }
+    sender.expectedSendSequence = (sendSequence + 1) % SEQUENCE_MODULO;
+    sender.unconfirmed.emplace_back(sendSequence, timestamp_ns);
+    confirm(receiver, readSequence(4), timestamp_ns);
+    processAsdu(connection, timestamp_ns, apdu + 6, size - 6);
+  } else if (0x01 == (apdu[2] & 0x03)) {
+    sender.sFrames++;
+    confirm(receiver, readSequence(4), timestamp_ns);
+  } else {
+    sender.uFrames++;
+  }
+}
+
+/**
+ * @brief split a byte stream into APDUs, incomplete APDUs stay buffered
+ */
+void processStream(ConnectionStatistics &connection,
+                   const std::size_t direction,
+                   const std::int64_t timestamp_ns) {
+  auto &state = connection.directions[direction];
+  auto &buffer = state.buffer;
+  std::size_t offset = 0;
+  while (buffer.size() - offset >= 2) {
+    if (buffer[offset] != 0x68 || buffer[offset + 1] < 4) {
+      // resynchronize on the next start byte
+      state.skippedBytes++;
+      offset++;
+      continue;
+    }
+    std::size_t const size = buffer[offset + 1] + 2;
+    if (buffer.size() - offset < size) {
+      break;
+    }
+    processApdu(connection, direction, timestamp_ns, buffer.data() + offset,
+                size);
+    offset += size;
+  }
+  buffer.erase(buffer.begin(), buffer.begin() + offset);
+}
+
+std::string ipv6ToString(const std::uint8_t *address) {
+  std::ostringstream oss;
+  oss << "[" << std::hex;
+  for (int i = 0; i < 16; i += 2) {
+    oss << (i ? ":" : "") << ((address[i] << 8) | address[i + 1]);
+  }
+  oss << "]";
+  return oss.str();
+}
+
+} // namespace
+
+void CaptureAnalyzer::Distribution::add(const double value_ms) {
+  if (0 == count) {
+    min_ms = max_ms = value_ms;
+  } else {
+    min_ms = std::min(min_ms, value_ms);
+    max_ms = std::max(max_ms, value_ms);
+  }
+  count++;
+  sum_ms += value_ms;
+  std::size_t bucket = 0;
+  while (bucket < CAPTURE_HISTOGRAM_BOUNDS_MS.size() &&
+         value_ms > CAPTURE_HISTOGRAM_BOUNDS_MS[bucket]) {
+    bucket++;
+  }
+  histogram[bucket]++;
+}
+
+std::string CaptureAnalyzer::Distribution::toString() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3) << "n=" << count
+      << " min=" << min_ms << "ms avg=" << mean_ms() << "ms max=" << max_ms
+      << "ms";
+  if (count > 0) {
+    oss << " |";
+    for (std::size_t i = 0; i < histogram.size(); i++) {
+      if (histogram[i] == 0)
+        continue;
+      oss << (i < CAPTURE_HISTOGRAM_BOUNDS_MS.size() ? " <=" : " >")
+          << std::setprecision(0)
+          << CAPTURE_HISTOGRAM_BOUNDS_MS[std::min(
+                 i, CAPTURE_HISTOGRAM_BOUNDS_MS.size() - 1)]
+          << "ms:" << histogram[i];
+    }
+  }
+  return oss.str();
+}
+
+CaptureAnalyzer::CaptureAnalyzer(std::vector<std::uint16_t> serverPorts)
+    : ports(std::move(serverPorts)) {}
+
+void CaptureAnalyzer::analyze(const std::string &name, const std::uint8_t *data,
+                              const std::size_t size) {
+  if (size >= CAPTURE_NATIVE_MAGIC_SIZE &&
+      0 == std::memcmp(data, CAPTURE_NATIVE_MAGIC, CAPTURE_NATIVE_MAGIC_SIZE)) {
+    analyzeNative(name, data, size);
+  } else {
+    analyzePcap(name, data, size);
+  }
+}
+
+void CaptureAnalyzer::print(std::ostream &out, const std::size_t top) const {
+  for (const auto &entry : connections) {
+    printConnection(out, entry.second, top);
+  }
+}
+
+CaptureAnalyzer::ConnectionStatistics &
+CaptureAnalyzer::getConnection(const std::string &name,
+                               const std::string &label0,
+                               const std::string &label1) {
+  auto &connection = connections[name];
+  if (connection.name.empty()) {
+    connection.name = name;
+    connection.directions[0].label = label0;
+    connection.directions[1].label = label1;
+  }
+  return connection;
+}
+
+void CaptureAnalyzer::analyzeNative(const std::string &name,
+                                    const std::uint8_t *data,
+                                    const std::size_t size) {
+  auto &connection = getConnection(name, "sent", "received");
+  std::size_t offset = CAPTURE_NATIVE_MAGIC_SIZE;
+  while (size - offset >= 11) {
+    std::int64_t timestamp_ns;
+    std::memcpy(&timestamp_ns, data + offset, sizeof(timestamp_ns));
+    std::size_t const direction = data[offset + 8] ? 0 : 1;
+    std::size_t const apduSize = data[offset + 10] + 2;
+    if (data[offset + 9] != 0x68 || size - offset - 9 < apduSize) {
+      throw std::runtime_error("Truncated or corrupt record in " + name);
+    }
+    processApdu(connection, direction, timestamp_ns, data + offset + 9,
+                apduSize);
+    offset += 9 + apduSize;
+  }  if (offset < size) {
+    throw std::runtime_error("Truncated record in " + name);
+  }
+}
+
+void CaptureAnalyzer::analyzePcap(const std::string &name,
+                                  const std::uint8_t *data,
+                                  const std::size_t size) {
+  if (size < 24) {
+    throw std::runtime_error("Unknown file format: " + name);
+  }
+  std::uint32_t magic;
+  std::memcpy(&magic, data, 4);
+  bool swapped;
+  bool nanoseconds;
+  switch (magic) {
+  case 0xa1b2c3d4:
+    swapped = false;
+    nanoseconds = false;
+    break;
+  case 0xd4c3b2a1:
+    swapped = true;
+    nanoseconds = false;
+    break;
+  case 0xa1b23c4d:
+    swapped = false;
+    nanoseconds = true;
+    break;
+  case 0x4d3cb2a1:
+    swapped = true;
+    nanoseconds = true;
+    break;
+  default:
+    throw std::runtime_error("Unknown file format (pcapng?): " + name);
+  }
+  auto const read32 = [swapped](const std::uint8_t *p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, 4);
+    if (swapped) {
+      value = ((value & 0xff) << 24) | ((value & 0xff00) << 8) |
+              ((value >> 8) & 0xff00) | (value >> 24);
+    }
+    return value;
+  };
+  std::uint32_t const linkType = read32(data + 20) & 0x0fffffff;
+
+  std::size_t offset = 24;
+  while (size - offset >= 16) {
+    std::uint32_t const seconds = read32(data + offset);
+    std::uint32_t const fraction = read32(data + offset + 4);
+    std::uint32_t const captured = read32(data + offset + 8);
+    offset += 16;
+    if (size - offset < captured) {
+      std::cerr << "[c104.analyzer] Truncated packet in " << name
+                << std::endl;
+      break;
+    }
+    std::int64_t const timestamp_ns =
+        static_cast<std::int64_t>(seconds) * 1000000000 +
+        (nanoseconds ? fraction : static_cast<std::int64_t>(fraction) * 1000);
+    processFrame(linkType, timestamp_ns, data + offset, captured);
+    offset += captured;
+  }
+}
+
+void CaptureAnalyzer::processFrame(const std::uint32_t linkType,
+                                   const std::int64_t timestamp_ns,
+                                   const std::uint8_t *frame,
+                                   const std::size_t size) {
+  std::uint16_t etherType = 0;
+  std::size_t header = 0;
+  switch (linkType) {
+  case 1: // Ethernet
+    if (size < 14)
+      return;
+    etherType = (frame[12] << 8) | frame[13];
+    header = 14;
+    while ((etherType == 0x8100 || etherType == 0x88a8) &&
+           size >= header + 4) {
+      etherType = (frame[header + 2] << 8) | frame[header + 3];
+      header += 4;
+    }
+    break;
+  case 113: // Linux cooked capture v1
+    if (size < 16)
+      return;
+    etherType = (frame[14] << 8) | frame[15];
+    header = 16;
+    break;
+  case 276: // Linux cooked capture v2
+    if (size < 20)
+      return;
+    etherType = (frame[0] << 8) | frame[1];
+    header = 20;
+    break;
+  case 0: { // BSD loopback, address family in host byte order
+    if (size < 4)
+      return;
+    std::uint32_t family;
+    std::memcpy(&family, frame, 4);
+    etherType = family == 2 ? 0x0800 : 0x86dd;
+    header = 4;
+  } break;
+  case 12:
+  case 101: // raw IP
+  case 228: // raw IPv4
+  case 229: // raw IPv6
+    if (size < 1)
+      return;
+    etherType = (frame[0] >> 4) == 4 ? 0x0800 : 0x86dd;
+    break;
+  default:
+    return;
+  }
+  processIp(etherType, timestamp_ns, frame + header, size - header);
+}
+
+void CaptureAnalyzer::processIp(const std::uint16_t etherType,
+                                const std::int64_t timestamp_ns,
+                                const std::uint8_t *packet, std::size_t size) {
+  std::string source;
+  std::string destination;
+  std::size_t header;
+  if (etherType == 0x0800) {
+    if (size < 20 || packet[9] != 6)
+      return;
+    // fragments are not reassembled
+    if ((((packet[6] & 0x3f) << 8) | packet[7]) != 0)
+      return;
+    header = (packet[0] & 0x0f) * 4;
+    size = std::min<std::size_t>(size, (packet[2] << 8) | packet[3]);
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", packet[12],
+                  packet[13], packet[14], packet[15]);
+    source = buffer;
+    std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", packet[16],
+                  packet[17], packet[18], packet[19]);
+    destination = buffer;
+  } else if (etherType == 0x86dd) {
+    // extension headers are not supported
+    if (size < 40 || packet[6] != 6)
+      return;
+    header = 40;
+    size = std::min<std::size_t>(size, 40 + ((packet[4] << 8) | packet[5]));
+    source = ipv6ToString(packet + 8);
+    destination = ipv6ToString(packet + 24);
+  } else {
+    return;
+  }
+  if (size < header + 20)
+    return;
+  processTcp(timestamp_ns, source, destination, packet + header,
+             size - header);
+}
+
+void CaptureAnalyzer::processTcp(const std::int64_t timestamp_ns,
+                                 const std::string &source,
+                                 const std::string &destination,
+                                 const std::uint8_t *segment,
+                                 const std::size_t size) {
+  std::uint16_t const sourcePort = (segment[0] << 8) | segment[1];
+  std::uint16_t const destinationPort = (segment[2] << 8) | segment[3];
+  std::uint32_t const sequence = (segment[4] << 24) | (segment[5] << 16) |
+                                 (segment[6] << 8) | segment[7];
+  std::size_t const header = (segment[12] >> 4) * 4;
+  std::uint8_t const flags = segment[13];
+  if (header < 20 || header > size)
+    return;
+
+  std::size_t direction;
+  std::string name;
+  if (isServerPort(destinationPort)) {
+    direction = 0;
+    name = source + ":" + std::to_string(sourcePort) + " -> " + destination +
+           ":" + std::to_string(destinationPort);
+  } else if (isServerPort(sourcePort)) {
+    direction = 1;
+    name = destination + ":" + std::to_string(destinationPort) + " -> " +
+           source + ":" + std::to_string(sourcePort);
+  } else {
+    return;
+  }
+
+  auto &connection =
+      getConnection(name, "client -> server", "server -> client");
+  auto &state = connection.directions[direction];
+
+  std::uint32_t next = sequence;
+  if (flags & 0x02) {
+    // SYN starts a new session on this address pair
+    if (0 == direction) {
+      connection.directions[0].resetSession();
+      connection.directions[1].resetSession();
+    }
+    next++;
+    state.nextTcpSequence = next;
+  }
+
+  const std::uint8_t *payload = segment + header;
+  std::size_t length = size - header;
+  if (length > 0) {
+    if (state.nextTcpSequence.has_value()) {
+      auto const delta = static_cast<std::int32_t>(
+          sequence - state.nextTcpSequence.value());
+      if (delta < 0) {
+        // retransmission, drop the bytes that were already processed
+        auto const overlap = static_cast<std::size_t>(-delta);
+        if (overlap >= length)
+          return;
+        payload += overlap;
+        length -= overlap;
+      } else if (delta > 0) {
+        // bytes missing in the capture
+        state.lostBytes += delta;
+        state.buffer.clear();
+      }
+    }
+    state.buffer.insert(state.buffer.end(), payload, payload + length);
+    next = sequence + static_cast<std::uint32_t>(size - header);
+    state.nextTcpSequence = next;
+    processStream(connection, direction, timestamp_ns);
+  }
+}
+
+bool CaptureAnalyzer::isServerPort(const std::uint16_t port) const {
+  return std::find(ports.begin(), ports.end(), port) != ports.end();
+}
+
+void CaptureAnalyzer::printConnection(std::ostream &out,
+                                      const ConnectionStatistics &connection,
+                                      const std::size_t top) {
+  double const duration_s =
+      static_cast<double>(connection.last_ns - connection.first_ns) / 1e9;
+  auto const rate = [duration_s](const double count) {
+    return duration_s > 0 ? count / duration_s : 0.0;
+  };
+
+  out << std::fixed << std::setprecision(3);
+  out << "CONNECTION " << connection.name << std::endl;
+  out << "  duration " << duration_s << "s" << std::endl;
+
+  for (const auto &direction : connection.directions) {
+    auto const frames =
+        direction.iFrames + direction.sFrames + direction.uFrames;
+    out << "  " << direction.label << ": " << frames << " frames ("
+        << rate(frames) << "/s), I " << direction.iFrames << ", S "
+        << direction.sFrames << ", U " << direction.uFrames << ", "
+        << direction.bytes << " bytes (" << rate(direction.bytes) << "B/s)"
+        << std::endl;
+    out << "    sequence gaps " << direction.sequenceGaps
+        << ", missing I-frames " << direction.missingFrames
+        << ", unconfirmed " << direction.unconfirmed.size()
+        << ", lost bytes " << direction.lostBytes << ", skipped bytes "
+        << direction.skippedBytes << std::endl;
+    out << "    ack latency " << direction.ackLatency.toString()
+        << std::endl;
+  }
+
+  out << "  asdus " << connection.asdus << ", information objects "
+      << connection.objects << ", objects per asdu "
+      << (connection.asdus
+              ? static_cast<double>(connection.objects) / connection.asdus
+              : 0.0)
+      << ", fill factor "
+      << (connection.asdus
+              ? 100.0 * connection.asduBytes /
+                    (connection.asdus * appLayerParameters.maxSizeOfASDU)
+              : 0.0)
+      << "%" << std::endl;
+
+  out << "  cot";
+  for (const auto &cause : connection.causes) {
+    out << " " << CS101_CauseOfTransmission_toString(
+                      static_cast<CS101_CauseOfTransmission>(cause.first))
+        << ":" << cause.second;
+  }
+  out << std::endl << "  type";
+  for (const auto &type : connection.types) {
+    out << " "
+        << TypeID_toString(static_cast<IEC60870_5_TypeID>(type.first))
+        << ":" << type.second;
+  }
+  out << std::endl;
+  if (!connection.rejected.empty()) {
+    out << "  rejected";
+    for (const auto &cause : connection.rejected) {
+      out << " " << UnexpectedMessageCause_toString(cause.first) << ":"
+          << cause.second;
+    }
+    out << std::endl;
+  }
+
+  std::vector<std::pair<std::uint64_t, const PointStatistics *>> points;
+  points.reserve(connection.points.size());
+  for (const auto &point : connection.points) {
+    points.emplace_back(point.first, &point.second);
+  }
+  std::sort(points.begin(), points.end(), [](const auto &a, const auto &b) {
+    return a.second->count != b.second->count
+               ? a.second->count > b.second->count
+               : a.first < b.first;
+  });
+  if (top > 0 && points.size() > top) {
+    points.resize(top);
+  }
+
+  out << "  points " << connection.points.size() << std::endl;
+  for (const auto &entry : points) {
+    const auto &point = *entry.second;
+    double const span_s =
+        static_cast<double>(point.last_ns - point.first_ns) / 1e9;
+    out << "    CA " << (entry.first >> 32) << " IOA "
+        << (entry.first & 0xffffffff) << " "
+        << TypeID_toString(point.type) << ": " << point.count
+        << " updates ("
+        << (span_s > 0 ? static_cast<double>(point.count - 1) / span_s
+                       : 0.0)
+        << "/s), cot";
+    for (const auto &cause : point.causes) {
+      out << " "
+          << CS101_CauseOfTransmission_toString(
+                 static_cast<CS101_CauseOfTransmission>(cause.first))
+          << ":" << cause.second;
+    }
+    out << std::endl
+        << "      inter-arrival " << point.interArrival.toString()
+        << std::endl;
+  }
+  out << std::endl;
+}
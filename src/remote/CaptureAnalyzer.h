@@ -0,0 +1,218 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CaptureAnalyzer.h
+ * @brief offline analysis of captured IEC 60870-5-104 traffic
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_CAPTUREANALYZER_H
+#define C104_REMOTE_CAPTUREANALYZER_H
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+#include "types.h"
+
+namespace Remote {
+
+/// @brief magic of native capture files
+constexpr char CAPTURE_NATIVE_MAGIC[] = "C104CAP1";
+constexpr std::size_t CAPTURE_NATIVE_MAGIC_SIZE = 8;
+
+/// @brief upper bounds of the histogram buckets in milliseconds, an additional
+/// bucket counts all larger values
+constexpr std::array<double, 12> CAPTURE_HISTOGRAM_BOUNDS_MS{
+    1, 5, 10, 50, 100, 500, 1000, 5000, 10000, 30000, 60000, 300000};
+
+/**
+ * @brief collects statistics of all connections in captured traffic
+ *
+ * Input formats
+ *
+ * pcap: classic libpcap files (microsecond or nanosecond timestamps, both
+ * byte orders) with Ethernet, VLAN, Linux cooked (v1/v2), BSD loopback or raw
+ * IP link layers. TCP streams from or to one of the server ports are
+ * reassembled per direction. pcapng is not supported, convert it with
+ * "editcap -F pcap".
+ *
+ * native: magic "C104CAP1" followed by records of a little endian int64
+ * timestamp in nanoseconds since epoch, one direction byte (1 = sent, 0 =
+ * received) and the complete APDU (0x68, length, ...). Such a file can be
+ * written from a c104.RawFrameBatch callback:
+ *
+ *   for i in range(len(batch)):
+ *       file.write(struct.pack("<qB", batch.timestamps[i],
+ *                              batch.directions[i]) + batch.frame(i))
+ */
+class CaptureAnalyzer {
+public:
+  /**
+   * @brief count, mean, extremes and histogram of durations
+   */
+  struct Distribution {
+    std::uint_fast64_t count{0};
+    double sum_ms{0};
+    double min_ms{0};
+    double max_ms{0};
+    std::array<std::uint_fast64_t, CAPTURE_HISTOGRAM_BOUNDS_MS.size() + 1>
+        histogram{};
+
+    void add(double value_ms);
+
+    double mean_ms() const { return count ? sum_ms / count : 0; }
+
+    std::string toString() const;
+  };
+
+  struct PointStatistics {
+    IEC60870_5_TypeID type{};
+    std::uint_fast64_t count{0};
+    std::int64_t first_ns{0};
+    std::int64_t last_ns{0};
+    Distribution interArrival{};
+    std::map<int, std::uint_fast64_t> causes{};
+  };
+
+  struct DirectionStatistics {
+    std::string label;
+
+    // tcp reassembly
+    std::vector<std::uint8_t> buffer{};
+    std::optional<std::uint32_t> nextTcpSequence{std::nullopt};
+    std::uint_fast64_t lostBytes{0};
+    std::uint_fast64_t skippedBytes{0};
+
+    // apci
+    std::uint_fast64_t iFrames{0};
+    std::uint_fast64_t sFrames{0};
+    std::uint_fast64_t uFrames{0};
+    std::uint_fast64_t bytes{0};
+    std::optional<std::uint16_t> expectedSendSequence{std::nullopt};
+    std::uint_fast64_t sequenceGaps{0};
+    std::uint_fast64_t missingFrames{0};
+
+    /// @brief unconfirmed I-frames by send sequence number and timestamp
+    std::deque<std::pair<std::uint16_t, std::int64_t>> unconfirmed{};
+
+    /// @brief time until the peer confirmed an I-frame via S- or I-frame
+    Distribution ackLatency{};
+
+    void resetSession() {
+      buffer.clear();
+      nextTcpSequence.reset();
+      expectedSendSequence.reset();
+      unconfirmed.clear();
+    }
+  };
+
+  struct ConnectionStatistics {
+    std::string name;
+    std::array<DirectionStatistics, 2> directions{};
+    std::int64_t first_ns{0};
+    std::int64_t last_ns{0};
+
+    // asdu
+    std::uint_fast64_t asdus{0};
+    std::uint_fast64_t asduBytes{0};
+    std::uint_fast64_t objects{0};
+    std::map<int, std::uint_fast64_t> causes{};
+    std::map<int, std::uint_fast64_t> types{};
+    std::map<UnexpectedMessageCause, std::uint_fast64_t> rejected{};
+
+    /// @brief per common address (upper 32 bits) and information object
+    /// address
+    std::unordered_map<std::uint64_t, PointStatistics> points{};
+  };
+
+  /**
+   * @param serverPorts tcp ports that identify the server side of pcap streams
+   */
+  explicit CaptureAnalyzer(std::vector<std::uint16_t> serverPorts);
+
+  /**
+   * @brief analyze a complete pcap or native capture
+   * @param name name of the capture, used as connection name of native
+   * captures and in error messages
+   * @param data capture contents
+   * @param size number of bytes
+   * @throws std::runtime_error if the capture has an unknown format or a
+   * corrupt native record
+   */
+  void analyze(const std::string &name, const std::uint8_t *data,
+               std::size_t size);
+
+  /**
+   * @brief Getter for the statistics of all connections by name
+   */
+  const std::map<std::string, ConnectionStatistics> &getConnections() const {
+    return connections;
+  }
+
+  /**
+   * @brief print a report of all connections
+   * @param out output stream
+   * @param top number of points per connection, 0 = all
+   */
+  void print(std::ostream &out, std::size_t top) const;
+
+private:
+  std::vector<std::uint16_t> ports;
+
+  std::map<std::string, ConnectionStatistics> connections{};
+
+  ConnectionStatistics &getConnection(const std::string &name,
+                                      const std::string &label0,
+                                      const std::string &label1);
+
+  void analyzeNative(const std::string &name, const std::uint8_t *data,
+                     std::size_t size);
+
+  void analyzePcap(const std::string &name, const std::uint8_t *data,
+                   std::size_t size);
+
+  void processFrame(std::uint32_t linkType, std::int64_t timestamp_ns,
+                    const std::uint8_t *frame, std::size_t size);
+
+  void processIp(std::uint16_t etherType, std::int64_t timestamp_ns,
+                 const std::uint8_t *packet, std::size_t size);
+
+  void processTcp(std::int64_t timestamp_ns, const std::string &source,
+                  const std::string &destination, const std::uint8_t *segment,
+                  std::size_t size);
+
+  bool isServerPort(std::uint16_t port) const;
+
+  static void printConnection(std::ostream &out,
+                              const ConnectionStatistics &connection,
+                              std::size_t top);
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_CAPTUREANALYZER_H
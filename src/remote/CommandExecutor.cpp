@@ -0,0 +1,183 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandExecutor.cpp
+ * @brief worker pool that executes commands of different points in parallel
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "CommandExecutor.h"
+#include "module/Interpreter.h"
+#include "module/ScopedGilRelease.h"
+
+using namespace Remote;
+
+CommandExecutor::~CommandExecutor() { stop(); }
+
+void CommandExecutor::Worker::run(const std::shared_ptr<Worker> &worker,
+                                  PyInterpreterState *interpreter) {
+  Module::Interpreter_bind(interpreter);
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(worker->mutex);
+      worker->wait.wait(lock, [&worker]() {
+        return worker->stopping || !worker->queue.empty();
+      });
+      if (worker->queue.empty()) {
+        // stopping and drained
+        return;
+      }
+      job = std::move(worker->queue.front());
+      worker->queue.pop_front();
+    }
+
+    try {
+      job();
+    } catch (const std::exception &e) {
+      std::cerr << "[c104.CommandExecutor] Job failed: " << e.what()
+                << std::endl;
+    }
+
+    std::lock_guard<std::mutex> const lock(worker->mutex);
+    worker->executed++;
+  }
+}
+
+void CommandExecutor::start(std::size_t count,
+                            PyInterpreterState *interpreter) {
+  if (0 == count) {
+    count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+
+  stop();
+
+  std::lock_guard<std::mutex> const lock(pool_mutex);
+  workers.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    auto worker = std::make_shared<Worker>();
+    worker->thread = std::thread(&Worker::run, worker, interpreter);
+    workers.push_back(std::move(worker));
+  }
+  DEBUG_PRINT(Debug::Server,
+              "CommandExecutor] Started " + std::to_string(count) + " workers");
+}
+
+void CommandExecutor::stop() {
+  // pending jobs may wait for the GIL
+  Module::ScopedGilRelease const scoped("CommandExecutor.stop");
+
+  // new jobs are rejected once the workers are swapped out, the pool is not
+  // locked while pending jobs are finished
+  std::vector<std::shared_ptr<Worker>> stopping;
+  {
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+    stopping.swap(workers);
+  }
+  if (stopping.empty()) {
+    return;
+  }
+  for (auto &worker : stopping) {
+    {
+      std::lock_guard<std::mutex> const worker_lock(worker->mutex);
+      worker->stopping = true;
+    }
+    worker->wait.notify_one();
+  }
+  std::uint_fast64_t executed = 0;
+  for (auto &worker : stopping) {
+    if (worker->thread.get_id() == std::this_thread::get_id()) {
+      // the last owner is released by a job, the thread keeps its worker
+      worker->thread.detach();
+    } else {
+      worker->thread.join();
+    }
+    std::lock_guard<std::mutex> const worker_lock(worker->mutex);
+    executed += worker->executed;
+  }
+  {
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+    retiredExecuted += executed;
+  }
+  DEBUG_PRINT(Debug::Server, "CommandExecutor] Stopped");
+}
+
+bool CommandExecutor::isRunning() const {
+  std::lock_guard<std::mutex> const lock(pool_mutex);
+  return !workers.empty();
+}
+
+bool CommandExecutor::dispatch(const std::uint_fast16_t ca,
+                               const std::uint_fast32_t ioa, Job job) {
+  std::lock_guard<std::mutex> const lock(pool_mutex);
+  if (workers.empty()) {
+    return false;
+  }
+
+  // mix the point key to spread neighbouring addresses across workers
+  std::uint_fast64_t key = (static_cast<std::uint_fast64_t>(ca) << 24) | ioa;
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  auto &worker = workers[key % workers.size()];
+
+  {
+    std::lock_guard<std::mutex> const worker_lock(worker->mutex);
+    worker->queue.push_back(std::move(job));
+    worker->maxPending = std::max(worker->maxPending, worker->queue.size());
+  }
+  worker->wait.notify_one();
+  dispatched++;
+  return true;
+}
+
+py::dict CommandExecutor::toDict() const {
+  std::size_t count;
+  std::uint_fast64_t total_dispatched;
+  std::uint_fast64_t executed;
+  std::size_t pending = 0;
+  std::size_t max_pending = 0;
+  {
+    std::lock_guard<std::mutex> const lock(pool_mutex);
+    count = workers.size();
+    total_dispatched = dispatched;
+    executed = retiredExecuted;
+    for (auto const &worker : workers) {
+      std::lock_guard<std::mutex> const worker_lock(worker->mutex);
+      executed += worker->executed;
+      pending += worker->queue.size();
+      max_pending = std::max(max_pending, worker->maxPending);
+    }
+  }
+
+  py::dict result;
+  result["workers"] = count;
+  result["dispatched"] = total_dispatched;
+  result["executed"] = executed;
+  result["pending"] = pending;
+  result["max_pending"] = max_pending;
+  return result;
+}
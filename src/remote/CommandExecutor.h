@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandExecutor.h
+ * @brief worker pool that executes commands of different points in parallel
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_COMMANDEXECUTOR_H
+#define C104_REMOTE_COMMANDEXECUTOR_H
+
+#include <deque>
+
+#include "types.h"
+
+namespace Remote {
+
+/**
+ * @brief executes jobs on a fixed number of worker threads keyed by point
+ *
+ * All jobs of a point (common address and information object address) are
+ * queued to the same worker and executed in the order of dispatch, jobs of
+ * different points may run in parallel. Each worker thread is bound to the
+ * python interpreter of the owner.
+ */
+class CommandExecutor {
+public:
+  using Job = std::function<void()>;
+
+  // noncopyable
+  CommandExecutor() = default;
+  CommandExecutor(const CommandExecutor &) = delete;
+  CommandExecutor &operator=(const CommandExecutor &) = delete;
+
+  /**
+   * @brief finish pending jobs and stop the workers
+   */
+  ~CommandExecutor();
+
+  /**
+   * @brief start the worker threads, a running pool is drained and restarted
+   * @param workers number of threads, 0 = number of hardware threads
+   * @param interpreter interpreter to bind the threads to
+   */
+  void start(std::size_t workers, PyInterpreterState *interpreter);
+
+  /**
+   * @brief execute all pending jobs and stop the worker threads
+   */
+  void stop();
+
+  /**
+   * @brief test if workers are running
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief queue a job behind all pending jobs of the same point
+   * @param ca common address
+   * @param ioa information object address
+   * @param job job to execute
+   * @return false if the pool is not running
+   */
+  bool dispatch(std::uint_fast16_t ca, std::uint_fast32_t ioa, Job job);
+
+  /**
+   * @brief Getter for statistics as python dictionary
+   * @return dict with workers, dispatched, executed, pending and max_pending
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief job queue and thread, shared with the thread to outlive a detached
+  /// thread
+  struct Worker {
+    std::mutex mutex{};
+    std::condition_variable wait{};
+    std::deque<Job> queue{};
+    bool stopping{false};
+    std::thread thread{};
+
+    std::uint_fast64_t executed{0};
+    std::size_t maxPending{0};
+
+    static void run(const std::shared_ptr<Worker> &worker,
+                    PyInterpreterState *interpreter);
+  };
+
+  /// @brief MUTEX Lock to start, stop and dispatch
+  mutable std::mutex pool_mutex{};
+
+  std::vector<std::shared_ptr<Worker>> workers{};
+
+  std::uint_fast64_t dispatched{0};
+
+  /// @brief executed jobs of stopped workers
+  std::uint_fast64_t retiredExecuted{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_COMMANDEXECUTOR_H
@@ -34,9 +34,11 @@
 #include "module/ScopedGilAcquire.h"
 #include "module/ScopedGilRelease.h"
 #include "remote/Helper.h"
+#include "remote/message/CommandTemplate.h"
 #include "remote/message/IncomingMessage.h"
 #include "remote/message/OutgoingMessage.h"
 #include "remote/message/PointCommand.h"
+#include <pybind11/chrono.h>
 
 using namespace Remote;
 using namespace std::chrono_literals;
@@ -47,7 +49,9 @@ Connection::Connection(
     const ConnectionInit _init,
     std::shared_ptr<Remote::TransportSecurity> transport_security,
     const uint_fast8_t originator_address)
-    : client(_client), ip(_ip), port(_port), init(_init),
+    : client(_client),
+      interpreter(_client ? _client->getInterpreter() : nullptr), ip(_ip),
+      port(_port), init(_init),
       commandTimeout_ms(command_timeout_ms) {
   Assert_IPv4(_ip);
   Assert_Port(_port);
@@ -100,14 +104,34 @@ void Connection::setState(ConnectionState connectionState) {
   ConnectionState const prev = state.load();
   if (prev != connectionState) {
     state.store(connectionState);
-    if (py_onStateChange.is_set()) {
-      if (auto c = getClient()) {
-        c->scheduleTask([this, connectionState]() {
-          DEBUG_PRINT(Debug::Connection, "CALLBACK on_state_change");
-          Module::ScopedGilAcquire const scoped("Connection.on_state_change");
-          this->py_onStateChange.call(shared_from_this(), connectionState);
-        });
+    if (auto c = getClient()) {
+      if (py_onStateChange.is_set()) {
+        std::uint_fast16_t const window = c->getStateChangeWindow_ms();
+        std::weak_ptr<Connection> weak = weak_from_this();
+        if (0 == window) {
+          notifiedState.store(connectionState);
+          c->scheduleTask([weak, connectionState]() {
+            auto instance = weak.lock();
+            if (!instance) {
+              return;
+            }
+            DEBUG_PRINT(Debug::Connection, "CALLBACK on_state_change");
+            Module::ScopedGilAcquire const scoped(
+                "Connection.on_state_change");
+            instance->py_onStateChange.call(instance, connectionState);
+          });
+        } else if (!stateChangePending.exchange(true)) {
+          // report the latest state once per window
+          c->scheduleTask(
+              [weak]() {
+                if (auto instance = weak.lock()) {
+                  instance->notifyStateChange();
+                }
+              },
+              window);
+        }
       }
+      c->onConnectionStateChange();
     }
     DEBUG_PRINT(Debug::Connection,
                 "state] " + ConnectionState_toString(prev) + " -> " +
@@ -115,6 +139,18 @@ void Connection::setState(ConnectionState connectionState) {
   }
 }
 
+void Connection::notifyStateChange() {
+  stateChangePending.store(false);
+  ConnectionState const current = state.load();
+  if (notifiedState.exchange(current) == current) {
+    // flapped back to the reported state within the window
+    return;
+  }
+  DEBUG_PRINT(Debug::Connection, "CALLBACK on_state_change (coalesced)");
+  Module::ScopedGilAcquire const scoped("Connection.on_state_change");
+  py_onStateChange.call(shared_from_this(), current);
+}
+
 void Connection::setOriginatorAddress(uint_fast8_t address) {
   std::uint_fast8_t const prev = originatorAddress.load();
   if (prev != address) {
@@ -328,6 +364,12 @@ void Connection::setClosed() {
     return;
   }
 
+  {
+    // an unanswered round trip probe is not lost, but obsolete
+    std::lock_guard<std::mutex> const lock(roundTripProbe_mutex);
+    roundTripProbeCounter.reset();
+  }
+
   if (CLOSED_AWAIT_OPEN != current && CLOSED_AWAIT_RECONNECT != current) {
     // set disconnected if connected previously
     disconnectedAt.store(std::chrono::system_clock::now());
@@ -338,8 +380,21 @@ void Connection::setClosed() {
     setState(CLOSED);
   } else {
     setState(CLOSED_AWAIT_RECONNECT);
-    if (auto c = getClient()) {
-      c->scheduleTask([this]() { this->connect(); }, 1000);
+    // a flapping connection keeps a single pending reconnect
+    if (!reconnectPending.exchange(true)) {
+      if (auto c = getClient()) {
+        std::weak_ptr<Connection> weak = weak_from_this();
+        c->scheduleTask(
+            [weak]() {
+              if (auto instance = weak.lock()) {
+                instance->reconnectPending.store(false);
+                instance->connect();
+              }
+            },
+            1000);
+      } else {
+        reconnectPending.store(false);
+      }
     }
   }
 
@@ -556,6 +611,11 @@ CS104_APCIParameters Connection::getParameters() const {
   return CS104_Connection_getAPCIParameters(connection);
 }
 
+std::map<UnexpectedMessageCause, std::uint_fast32_t>
+Connection::getRejectedMessageCounts() const {
+  return RejectionCounters_toMap(rejectedMessages);
+}
+
 void Connection::onReceiveRaw(unsigned char *msg, unsigned char msgSize) {
   if (py_onReceiveRaw.is_set()) {
     if (auto c = getClient()) {
@@ -577,6 +637,84 @@ void Connection::onReceiveRaw(unsigned char *msg, unsigned char msgSize) {
   }
 }
 
+void Connection::setOnRawBatchCallback(py::object &callable,
+                                       const std::size_t max_frames,
+                                       const std::uint_fast32_t max_delay_ms) {
+  // hand pending frames to the previous callback
+  deliverRawBatches(true);
+  rawTap.configure(max_frames, max_delay_ms);
+  py_onRawBatch.reset(callable);
+}
+
+void Connection::onRawFrame(unsigned char *msg, unsigned char msgSize,
+                            const bool sent) {
+  if (py_onRawBatch.is_set() && rawTap.append(msg, msgSize, sent)) {
+    if (auto c = getClient()) {
+      std::weak_ptr<Connection> weak = weak_from_this();
+      c->scheduleTask([weak]() {
+        if (auto instance = weak.lock()) {
+          instance->deliverRawBatches();
+        }
+      });
+    }
+  }
+}
+
+void Connection::deliverRawBatches(const bool flush) {
+  auto self = weak_from_this().lock();
+  if (!self || !py_onRawBatch.is_set())
+    return;
+
+  auto const batches = rawTap.collect(flush);
+  if (batches.empty())
+    return;
+
+  DEBUG_PRINT(Debug::Connection, "CALLBACK on_raw_batch");
+  Module::ScopedGilAcquire const scoped("Connection.on_raw_batch");
+  for (auto const &batch : batches) {
+    py_onRawBatch.call(self, batch);
+  }
+}
+
+py::dict Connection::getRawBatchStatistics() const { return rawTap.toDict(); }
+
+void Connection::setOnAggregateCallback(py::object &callable,
+                                        const std::uint_fast32_t interval_ms) {
+  if (callable.is_none()) {
+    py_onAggregate.reset(callable);
+    aggregator.disable();
+    return;
+  }
+
+  aggregator.enable(interval_ms);
+  try {
+    py_onAggregate.reset(callable);
+  } catch (...) {
+    aggregator.disable();
+    throw;
+  }
+}
+
+void Connection::deliverAggregates() {
+  if (!aggregator.isEnabled())
+    return;
+
+  auto const batches = aggregator.collect(std::chrono::system_clock::now());
+  if (batches.empty())
+    return;
+
+  DEBUG_PRINT(Debug::Connection, "CALLBACK on_aggregate");
+  Module::ScopedGilAcquire const scoped("Connection.on_aggregate");
+  for (auto const &batch : batches) {
+    py_onAggregate.call(shared_from_this(), batch.start, batch.end,
+                        IntervalAggregator::toList(batch));
+  }
+}
+
+py::dict Connection::getAggregationStatistics() const {
+  return aggregator.toDict();
+}
+
 void Connection::setOnSendRawCallback(py::object &callable) {
   py_onSendRaw.reset(callable);
 }
@@ -764,6 +902,127 @@ bool Connection::test(std::uint_fast16_t commonAddress, bool with_time,
   return result;
 }
 
+void Connection::enableRoundTripProbe(const std::uint_fast16_t commonAddress,
+                                      const std::uint_fast32_t interval_ms,
+                                      const std::uint_fast32_t threshold_ms) {
+  if (interval_ms < 100) {
+    throw std::invalid_argument("interval_ms must be 100 or greater");
+  }
+
+  roundTripProbeCommonAddress.store(commonAddress);
+  roundTripMonitor.setThreshold_ms(threshold_ms);
+  {
+    std::lock_guard<std::mutex> const lock(roundTripProbe_mutex);
+    roundTripProbeNextAt = std::chrono::steady_clock::now();
+  }
+  roundTripProbeInterval_ms.store(interval_ms);
+}
+
+void Connection::disableRoundTripProbe() {
+  roundTripProbeInterval_ms.store(0);
+
+  std::lock_guard<std::mutex> const lock(roundTripProbe_mutex);
+  roundTripProbeCounter.reset();
+}
+
+void Connection::enableLostUpdateDetection(
+    const double tolerance, const std::size_t max_discrepancies) {
+  lostUpdateDetector.enable(tolerance, max_discrepancies);
+}
+
+void Connection::disableLostUpdateDetection() {
+  lostUpdateDetector.disable();
+}
+
+const LostUpdateDetector &Connection::getLostUpdateDetector() const {
+  return lostUpdateDetector;
+}
+
+void Connection::probeRoundTrip(
+    const std::chrono::steady_clock::time_point now) {
+  std::uint_fast32_t const interval_ms = roundTripProbeInterval_ms.load();
+  if (0 == interval_ms || !isOpen() || isMuted()) {
+    return;
+  }
+
+  std::uint_fast16_t counter;
+  {
+    std::lock_guard<std::mutex> const lock(roundTripProbe_mutex);
+    if (now < roundTripProbeNextAt) {
+      return;
+    }
+    if (roundTripProbeCounter.has_value()) {
+      // previous probe was not answered within one interval
+      roundTripMonitor.recordLost();
+    }
+    counter = static_cast<std::uint16_t>(testSequenceCounter++);
+    roundTripProbeCounter = counter;
+    roundTripProbeSentAt = std::chrono::steady_clock::now();
+    roundTripProbeNextAt = now + std::chrono::milliseconds(interval_ms);
+  }
+
+  sCP56Time2a time{};
+  from_time_point(&time, std::chrono::system_clock::now());
+
+  std::unique_lock<Module::GilAwareMutex> lock(connection_mutex);
+  bool const result = CS104_Connection_sendTestCommandWithTimestamp(
+      connection, roundTripProbeCommonAddress.load(), counter, &time);
+  lock.unlock();
+
+  if (!result) {
+    std::lock_guard<std::mutex> const probe_lock(roundTripProbe_mutex);
+    roundTripProbeCounter.reset();
+  }
+}
+
+void Connection::onRoundTripProbeResponse(CS101_ASDU asdu) {
+  auto const receivedAt = std::chrono::steady_clock::now();
+
+  auto io = (TestCommandWithCP56Time2a)CS101_ASDU_getElement(asdu, 0);
+  if (!io) {
+    return;
+  }
+  std::uint_fast16_t const counter = TestCommandWithCP56Time2a_getCounter(io);
+  TestCommandWithCP56Time2a_destroy(io);
+
+  std::chrono::steady_clock::duration rtt;
+  {
+    std::lock_guard<std::mutex> const lock(roundTripProbe_mutex);
+    if (!roundTripProbeCounter.has_value() ||
+        roundTripProbeCounter.value() != counter) {
+      // response to a test command sent via test()
+      return;
+    }
+    roundTripProbeCounter.reset();
+    rtt = receivedAt - roundTripProbeSentAt;
+  }
+
+  if (roundTripMonitor.record(rtt) && py_onRoundTripThreshold.is_set()) {
+    double const average_ms = roundTripMonitor.getAverage_ms();
+    bool const exceeded = roundTripMonitor.isExceeded();
+    if (auto c = getClient()) {
+      std::weak_ptr<Connection> weak = weak_from_this();
+      c->scheduleTask([weak, average_ms, exceeded]() {
+        auto instance = weak.lock();
+        if (!instance) {
+          return;
+        }
+        DEBUG_PRINT(Debug::Connection, "CALLBACK on_rtt_threshold");
+        Module::ScopedGilAcquire const scoped("Connection.on_rtt_threshold");
+        instance->py_onRoundTripThreshold.call(instance, average_ms, exceeded);
+      });
+    }
+  }
+}
+
+const RoundTripMonitor &Connection::getRoundTripMonitor() const {
+  return roundTripMonitor;
+}
+
+void Connection::setOnRoundTripThresholdCallback(py::object &callable) {
+  py_onRoundTripThreshold.reset(callable);
+}
+
 bool Connection::transmit(std::shared_ptr<Object::DataPoint> point,
                           const CS101_CauseOfTransmission cause) {
   auto type = point->getType();
@@ -774,6 +1033,18 @@ bool Connection::transmit(std::shared_ptr<Object::DataPoint> point,
   }
 
   bool selectAndExecute = point->getCommandMode() == SELECT_AND_EXECUTE_COMMAND;
+
+  // patch pre-encoded frame
+  if (auto commandTemplate = getCommandTemplate(point)) {
+    if (selectAndExecute &&
+        !command(commandTemplate, point, cause, true, COMMAND_AWAIT_CON)) {
+      return false;
+    }
+    return command(commandTemplate, point, cause, false,
+                   selectAndExecute ? COMMAND_AWAIT_CON_TERM
+                                    : COMMAND_AWAIT_CON);
+  }
+
   // send select command
   if (selectAndExecute) {
     auto message = Message::PointCommand::create(point, true);
@@ -826,6 +1097,88 @@ bool Connection::command(std::shared_ptr<Message::OutgoingMessage> message,
   return result;
 }
 
+bool Connection::command(
+    const std::shared_ptr<Message::CommandTemplate> &commandTemplate,
+    const std::shared_ptr<Object::DataPoint> &point,
+    const CS101_CauseOfTransmission cause, const bool select,
+    const CommandProcessState state) {
+  Module::ScopedGilRelease const scoped("Connection.command");
+
+  if (!isOpen())
+    return false;
+
+  auto const info = point->getInfo();
+  std::string const &cmdId = commandTemplate->getCommandId();
+  prepareCommandSuccess(cmdId, state);
+
+  // the frame is shared by all transmissions of this point, patch and send
+  // it under the connection lock
+  std::unique_lock<Module::GilAwareMutex> lock(connection_mutex);
+  CS101_ASDU const asdu = commandTemplate->prepare(*info, cause, select);
+  if (!asdu) {
+    lock.unlock();
+    cancelCommandSuccess(cmdId);
+    auto message = Message::PointCommand::create(point, select);
+    message->setCauseOfTransmission(cause);
+    return command(std::move(message), true, state);
+  }
+  bool const result = CS104_Connection_sendASDU(connection, asdu);
+  lock.unlock();
+
+  DEBUG_PRINT(Debug::Connection,
+              "command SEND template " + std::to_string(result));
+  if (result) {
+    return awaitCommandSuccess(cmdId);
+  }
+  // result not required anymore, because no message was sent
+  cancelCommandSuccess(cmdId);
+  return false;
+}
+
+void Connection::prepareCommand(std::shared_ptr<Object::DataPoint> point) {
+  auto const type = point->getType();
+  if (type <= S_IT_TC_1 || type >= M_EI_NA_1) {
+    throw std::invalid_argument("Invalid point type");
+  }
+  auto station = point->getStation();
+  if (!station || station->getConnection().get() != this) {
+    throw std::invalid_argument("Point does not belong to this connection");
+  }
+  std::uint_fast64_t const key =
+      (static_cast<std::uint_fast64_t>(station->getCommonAddress()) << 32) |
+      point->getInformationObjectAddress();
+
+  std::unique_lock<Module::GilAwareMutex> lock(connection_mutex);
+  auto commandTemplate = Message::CommandTemplate::create(
+      point, CS104_Connection_getAppLayerParameters(connection));
+  lock.unlock();
+
+  std::lock_guard<std::mutex> const templates_lock(commandTemplates_mutex);
+  commandTemplates[key] = std::move(commandTemplate);
+}
+
+std::shared_ptr<Message::CommandTemplate> Connection::getCommandTemplate(
+    const std::shared_ptr<Object::DataPoint> &point) {
+  auto station = point->getStation();
+  if (!station) {
+    return {nullptr};
+  }
+
+  std::lock_guard<std::mutex> const lock(commandTemplates_mutex);
+  auto it = commandTemplates.find(
+      (static_cast<std::uint_fast64_t>(station->getCommonAddress()) << 32) |
+      point->getInformationObjectAddress());
+  if (it == commandTemplates.end()) {
+    return {nullptr};
+  }
+  if (it->second->getType() != point->getType()) {
+    // point was replaced by a point of another type
+    commandTemplates.erase(it);
+    return {nullptr};
+  }
+  return it->second;
+}
+
 bool Connection::read(std::shared_ptr<Object::DataPoint> point,
                       const bool wait_for_response) {
   Module::ScopedGilRelease const scoped("Connection.read");
@@ -871,15 +1224,15 @@ void Connection::rawMessageHandler(void *parameter, uint_fast8_t *msg,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Connection> instance{};
-
-  try {
-    instance = static_cast<Connection *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance =
+      static_cast<Connection *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Connection, "Ignore raw message in shutdown");
     return;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
+  instance->onRawFrame(msg, msgSize, sent);
   if (sent) {
     instance->onSendRaw(msg, msgSize);
   } else {
@@ -905,16 +1258,15 @@ void Connection::connectionHandler(void *parameter, CS104_Connection connection,
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Connection> instance{};
-
-  try {
-    instance = static_cast<Connection *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance =
+      static_cast<Connection *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Connection, "Ignore connection event " +
                                        ConnectionEvent_toString(event) +
                                        " in shutdown");
     return;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   switch (event) {
   case CS104_CONNECTION_OPENED: {
@@ -956,13 +1308,13 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
     begin = std::chrono::steady_clock::now();
   }
 
-  std::shared_ptr<Connection> instance{};
-  try {
-    instance = static_cast<Connection *>(parameter)->shared_from_this();
-  } catch (const std::bad_weak_ptr &e) {
+  auto instance =
+      static_cast<Connection *>(parameter)->weak_from_this().lock();
+  if (!instance) {
     DEBUG_PRINT(Debug::Connection, "asdu_handler] Connection removed");
     return false;
   }
+  Module::Interpreter_bind(instance->getInterpreter());
 
   auto client = instance->getClient();
   if (!client || !client->isRunning()) {
@@ -982,9 +1334,17 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
   auto parameters =
       CS104_Connection_getAppLayerParameters(instance->connection);
 
-  try {
-    auto message = Remote::Message::IncomingMessage::create(asdu, parameters);
+  auto message = Remote::Message::IncomingMessage::create(asdu, parameters);
+  if (!message->isValid()) {
+    instance->rejectedMessages[message->getRejectCause()]++;
+    DEBUG_PRINT_CONDITION(
+        debug, Debug::Connection,
+        "asdu_handler] Invalid message format: " +
+            UnexpectedMessageCause_toString(message->getRejectCause()));
+    return true;
+  }
 
+  try {
     IEC60870_5_TypeID const type = message->getType();
     CS101_CauseOfTransmission const cot = message->getCauseOfTransmission();
 
@@ -996,7 +1356,18 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
         instance->setCommandSuccess(message);
       }
 
+      bool const detectLostUpdates = instance->lostUpdateDetector.isEnabled();
+      bool const aggregate = instance->aggregator.isEnabled();
+      auto const receivedAt = aggregate
+                                  ? std::chrono::system_clock::now()
+                                  : std::chrono::system_clock::time_point{};
+
       while (message->next()) {
+        if (detectLostUpdates && message->getInfo()) {
+          instance->lostUpdateDetector.record(
+              cot, message->getCommonAddress(), message->getIOA(), type,
+              message->getInfo()->getValue());
+        }
         auto station = instance->getStation(message->getCommonAddress());
         if (!station) {
           client->onNewStation(instance, message->getCommonAddress());
@@ -1011,12 +1382,19 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
           }
           if (point) {
             point->onReceive(message);
+            if (aggregate) {
+              instance->aggregator.record(message->getCommonAddress(),
+                                          message->getIOA(), type,
+                                          message->getInfo(), receivedAt);
+            }
           } else {
+            instance->rejectedMessages[UNKNOWN_IOA]++;
             DEBUG_PRINT_CONDITION(debug, Debug::Connection,
                                   "asdu_handler] Message ignored: Unknown IOA");
           }
         } else {
           // @todo add error callback?
+          instance->rejectedMessages[UNKNOWN_CA]++;
           DEBUG_PRINT_CONDITION(debug, Debug::Connection,
                                 "asdu_handler] Message ignored: Unknown CA");
         }
@@ -1043,6 +1421,9 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
 
     // command response
     if (type < P_ME_NA_1) {
+      if (C_TS_TA_1 == type && CS101_COT_ACTIVATION_CON == cot) {
+        instance->onRoundTripProbeResponse(asdu);
+      }
       instance->setCommandSuccess(message);
 
       if (debug) {
@@ -1072,7 +1453,7 @@ bool Connection::asduHandler(void *parameter, int address, CS101_ASDU asdu) {
     }
 
   } catch (const std::exception &e) {
-    DEBUG_PRINT(Debug::Connection, "asdu_handler] Invalid message format: " +
+    DEBUG_PRINT(Debug::Connection, "asdu_handler] Message processing failed: " +
                                        std::string(e.what()));
   }
 
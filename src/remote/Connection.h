@@ -35,6 +35,10 @@
 #include "module/Callback.h"
 #include "module/GilAwareMutex.h"
 #include "object/Station.h"
+#include "remote/IntervalAggregator.h"
+#include "remote/LostUpdateDetector.h"
+#include "remote/RawFrameTap.h"
+#include "remote/RoundTripMonitor.h"
 #include "types.h"
 
 namespace Remote {
@@ -119,6 +123,12 @@ public:
 
   std::shared_ptr<Client> getClient() const;
 
+  /**
+   * @brief Getter for the python interpreter of the owning client
+   * @return interpreter or nullptr for the main interpreter
+   */
+  PyInterpreterState *getInterpreter() const { return interpreter; }
+
   // Station accessors
 
   /**
@@ -244,6 +254,13 @@ public:
    */
   CS104_APCIParameters getParameters() const;
 
+  /**
+   * @brief Getter for the number of rejected incoming messages per cause
+   * @return map of counters since connection creation
+   */
+  std::map<UnexpectedMessageCause, std::uint_fast32_t>
+  getRejectedMessageCounts() const;
+
   /**
    * @brief set python callback that will be executed on incoming message
    * @throws std::invalid_argument if callable signature does not match
@@ -260,6 +277,60 @@ public:
 
   void onSendRaw(unsigned char *msg, unsigned char msgSize);
 
+  /**
+   * @brief set python callback that receives raw frames in batches instead of
+   * one call per frame
+   * @param callable python callback or None
+   * @param max_frames deliver a batch after this number of frames
+   * @param max_delay_ms deliver a batch if its oldest frame is older, checked
+   * on every frame and every tick
+   * @throws std::invalid_argument if callable signature does not match or
+   * max_frames is 0
+   */
+  void setOnRawBatchCallback(py::object &callable, std::size_t max_frames,
+                             std::uint_fast32_t max_delay_ms);
+
+  /**
+   * @brief add a frame to the raw batch, schedule delivery if a batch is ready
+   */
+  void onRawFrame(unsigned char *msg, unsigned char msgSize, bool sent);
+
+  /**
+   * @brief deliver complete batches to the raw batch callback
+   * @param flush also deliver an incomplete batch
+   */
+  void deliverRawBatches(bool flush = false);
+
+  /**
+   * @brief Getter for raw batch statistics
+   * @return dict with frames, batches, pending_batches, pending_bytes and
+   * dropped_frames
+   */
+  py::dict getRawBatchStatistics() const;
+
+  /**
+   * @brief set python callback that receives aggregates of all received
+   * values once per interval instead of every value
+   * @param callable python callback or None to stop aggregating
+   * @param interval_ms length of an aggregation interval in milliseconds
+   * @throws std::invalid_argument if callable signature does not match or
+   * interval_ms is 0
+   */
+  void setOnAggregateCallback(py::object &callable,
+                              std::uint_fast32_t interval_ms);
+
+  /**
+   * @brief deliver completed aggregation intervals to the aggregate callback
+   */
+  void deliverAggregates();
+
+  /**
+   * @brief Getter for aggregation statistics
+   * @return dict with enabled, interval_ms, points, samples, intervals,
+   * skipped, dropped, pending_bytes and last_batch_size
+   */
+  py::dict getAggregationStatistics() const;
+
   /**
    * @brief set python callback that will be executed on connection state
    * changes
@@ -320,6 +391,65 @@ public:
   bool test(std::uint_fast16_t commonAddress, bool with_time = true,
             bool wait_for_response = true);
 
+  /**
+   * @brief periodically measure the round trip time via test commands
+   * @param commonAddress station address used for test commands
+   * @param interval_ms interval between two probes
+   * @param threshold_ms threshold of the averaged round trip time, 0 = disabled
+   * @throws std::invalid_argument if interval is below 100ms
+   */
+  void enableRoundTripProbe(std::uint_fast16_t commonAddress,
+                            std::uint_fast32_t interval_ms,
+                            std::uint_fast32_t threshold_ms);
+
+  /**
+   * @brief stop measuring the round trip time, statistics are kept
+   */
+  void disableRoundTripProbe();
+
+  /**
+   * @brief send a round trip probe if due, called from client thread
+   * @param now current time
+   */
+  void probeRoundTrip(std::chrono::steady_clock::time_point now);
+
+  /**
+   * @brief handle the activation confirmation of a test command
+   * @param asdu incoming C_TS_TA_1 message
+   */
+  void onRoundTripProbeResponse(CS101_ASDU asdu);
+
+  /**
+   * @brief Getter for round trip time statistics
+   */
+  const RoundTripMonitor &getRoundTripMonitor() const;
+
+  /**
+   * @brief compare interrogation results against the last spontaneously
+   * received values to detect lost updates, statistics are reset
+   * @param tolerance accepted absolute difference of numeric values
+   * @param max_discrepancies number of recent discrepancies to keep
+   */
+  void enableLostUpdateDetection(double tolerance = 0,
+                                 std::size_t max_discrepancies = 100);
+
+  /**
+   * @brief stop detecting lost updates, statistics are kept
+   */
+  void disableLostUpdateDetection();
+
+  /**
+   * @brief Getter for lost update statistics
+   */
+  const LostUpdateDetector &getLostUpdateDetector() const;
+
+  /**
+   * @brief set python callback that will be executed if the averaged round
+   * trip time crosses the threshold
+   * @throws std::invalid_argument if callable signature does not match
+   */
+  void setOnRoundTripThresholdCallback(py::object &callable);
+
   /**
    * @brief transmit a command to a remote server
    * @param point control point
@@ -343,6 +473,29 @@ public:
                bool wait_for_response = true,
                CommandProcessState state = COMMAND_AWAIT_CON);
 
+  /**
+   * @brief patch and send a pre-encoded command frame and wait for the
+   * response, encodes the command from scratch if the template cannot be used
+   * @param commandTemplate prepared frame of the point
+   * @param point control point
+   * @param cause reason for transmission
+   * @param select select flag for select-and-execute command mode
+   * @param state command process state
+   * @returns if command was confirmed
+   */
+  bool command(const std::shared_ptr<Message::CommandTemplate> &commandTemplate,
+               const std::shared_ptr<Object::DataPoint> &point,
+               CS101_CauseOfTransmission cause, bool select,
+               CommandProcessState state = COMMAND_AWAIT_CON);
+
+  /**
+   * @brief encode the command frame of a control point once, later
+   * transmissions of this point only patch value and timestamp
+   * @param point client-sided control point of this connection
+   * @throws std::invalid_argument if point type is not a supported command
+   */
+  void prepareCommand(std::shared_ptr<Object::DataPoint> point);
+
   /**
    * @brief send a point read command to remote server
    * @param point monitoring point
@@ -407,6 +560,9 @@ private:
   /// @brief client object reference
   std::weak_ptr<Client> client{};
 
+  /// @brief python interpreter of the owning client, nullptr for main
+  PyInterpreterState *const interpreter{nullptr};
+
   /// @brief MUTEX Lock to access non atomic connection information
   mutable Module::GilAwareMutex connection_mutex{
       "Connection::connection_mutex"};
@@ -438,6 +594,15 @@ private:
   /// @brief current state of state machine behaviour
   std::atomic<ConnectionState> state{CLOSED};
 
+  /// @brief last state passed to on_state_change
+  std::atomic<ConnectionState> notifiedState{CLOSED};
+
+  /// @brief coalesced state change notification is scheduled
+  std::atomic_bool stateChangePending{false};
+
+  /// @brief reconnect after connection loss is scheduled
+  std::atomic_bool reconnectPending{false};
+
   /// @brief timestamp of last successfully connection opening
   std::atomic<std::chrono::system_clock::time_point> connectedAt{};
 
@@ -465,6 +630,55 @@ private:
   /// @brief sequence counter number
   std::atomic_uint_fast64_t testSequenceCounter{0};
 
+  /// @brief number of rejected incoming messages per cause
+  RejectionCounters rejectedMessages{};
+
+  /// @brief round trip time statistics
+  RoundTripMonitor roundTripMonitor{};
+
+  /// @brief consistency of spontaneous and interrogated values
+  LostUpdateDetector lostUpdateDetector{};
+
+  /// @brief interval between two round trip probes, 0 = disabled
+  std::atomic_uint_fast32_t roundTripProbeInterval_ms{0};
+
+  /// @brief station address used for round trip probes
+  std::atomic_uint_fast16_t roundTripProbeCommonAddress{0};
+
+  /// @brief MUTEX Lock to access round trip probe state
+  mutable std::mutex roundTripProbe_mutex{};
+
+  /// @brief test sequence counter of the unanswered round trip probe
+  std::optional<std::uint_fast16_t> roundTripProbeCounter{std::nullopt};
+
+  /// @brief send time of the unanswered round trip probe
+  std::chrono::steady_clock::time_point roundTripProbeSentAt{};
+
+  /// @brief time of the next round trip probe
+  std::chrono::steady_clock::time_point roundTripProbeNextAt{};
+
+  /// @brief MUTEX Lock to access command templates
+  mutable std::mutex commandTemplates_mutex{};
+
+  /// @brief pre-encoded command frames by common address (upper 32 bits) and
+  /// information object address (must be accessed with commandTemplates_mutex)
+  std::unordered_map<std::uint_fast64_t,
+                     std::shared_ptr<Message::CommandTemplate>>
+      commandTemplates{};
+
+  /**
+   * @brief Get the command template of a point, if one was prepared
+   * @param point control point
+   * @return template matching the point type or nullptr
+   */
+  std::shared_ptr<Message::CommandTemplate>
+  getCommandTemplate(const std::shared_ptr<Object::DataPoint> &point);
+
+  /// @brief python callback function pointer
+  Module::Callback<void> py_onRoundTripThreshold{
+      "Connection.on_rtt_threshold",
+      "(connection: c104.Connection, rtt_ms: float, exceeded: bool) -> None"};
+
   /// @brief python callback function pointer
   Module::Callback<void> py_onReceiveRaw{
       "Connection.on_receive_raw",
@@ -475,6 +689,23 @@ private:
       "Connection.on_send_raw",
       "(connection: c104.Connection, data: bytes) -> None"};
 
+  /// @brief python callback function pointer
+  Module::Callback<void> py_onRawBatch{
+      "Connection.on_raw_batch",
+      "(connection: c104.Connection, batch: c104.RawFrameBatch) -> None"};
+
+  /// @brief collects raw frames for py_onRawBatch
+  Remote::RawFrameTap rawTap{};
+
+  /// @brief python callback function pointer
+  Module::Callback<void> py_onAggregate{
+      "Connection.on_aggregate",
+      "(connection: c104.Connection, start: datetime.datetime, end: "
+      "datetime.datetime, aggregates: list[dict[str, typing.Any]]) -> None"};
+
+  /// @brief running aggregates for py_onAggregate
+  Remote::IntervalAggregator aggregator{};
+
   /// @brief python callback function pointer
   Module::Callback<void> py_onStateChange{
       "Connection.on_state_change",
@@ -486,6 +717,12 @@ private:
    */
   void setState(ConnectionState connectionState);
 
+  /**
+   * @brief report the current state once after the state change window, if
+   * it differs from the last reported state
+   */
+  void notifyStateChange();
+
 public:
   std::string toString() const {
     size_t len = 0;
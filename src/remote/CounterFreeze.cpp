@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CounterFreeze.cpp
+ * @brief wall-clock aligned freeze schedule of integrated totals
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "CounterFreeze.h"
+#include <pybind11/chrono.h>
+
+using namespace Remote;
+
+void CounterFreeze::enable(const std::uint_fast32_t interval,
+                           const bool resetCounters,
+                           const std::uint_fast32_t offset) {
+  if (0 == interval) {
+    throw std::invalid_argument("The freeze interval must be positive");
+  }
+  if (offset >= interval) {
+    throw std::invalid_argument(
+        "The freeze offset must be less than the freeze interval");
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  interval_ms = interval;
+  offset_ms = offset;
+  reset.store(resetCounters);
+  nextFreezeAt =
+      nextBoundary(std::chrono::system_clock::now(), interval, offset);
+  enabled.store(true);
+}
+
+void CounterFreeze::disable() { enabled.store(false); }
+
+bool CounterFreeze::isEnabled() const { return enabled.load(); }
+
+bool CounterFreeze::isReset() const { return reset.load(); }
+
+std::chrono::system_clock::time_point
+CounterFreeze::nextBoundary(const std::chrono::system_clock::time_point now,
+                            const std::uint_fast32_t interval,
+                            const std::uint_fast32_t offset) {
+  std::int64_t const since_epoch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          now.time_since_epoch())
+          .count();
+  std::int64_t const period = interval;
+  std::int64_t phase =
+      (since_epoch - static_cast<std::int64_t>(offset)) % period;
+  if (phase < 0) {
+    phase += period;
+  }
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::milliseconds(since_epoch - phase + period)));
+}
+
+std::optional<std::chrono::system_clock::time_point>
+CounterFreeze::takeDue(const std::chrono::system_clock::time_point now) {
+  if (!enabled.load())
+    return std::nullopt;
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (now < nextFreezeAt)
+    return std::nullopt;
+
+  auto const due = nextFreezeAt;
+  nextFreezeAt = nextBoundary(now, interval_ms, offset_ms);
+  auto const behind = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          nextFreezeAt - due)
+                          .count() /
+                      interval_ms;
+  if (behind > 1) {
+    skipped += behind - 1;
+  }
+  return due;
+}
+
+void CounterFreeze::record(
+    const std::chrono::system_clock::time_point frozen_at,
+    const std::size_t count,
+    const std::chrono::steady_clock::duration snapshot,
+    const std::optional<std::chrono::steady_clock::duration> transmission) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  freezes++;
+  points = count;
+  lastFrozenAt = frozen_at;
+  lastSnapshot_ms = std::chrono::duration<double, std::milli>(snapshot).count();
+  if (transmission.has_value()) {
+    lastTransmission_ms =
+        std::chrono::duration<double, std::milli>(transmission.value())
+            .count();
+  } else {
+    lastTransmission_ms = 0;
+    unsent++;
+  }
+}
+
+py::dict CounterFreeze::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  bool const isEnabled = enabled.load();
+
+  py::dict result;
+  result["enabled"] = isEnabled;
+  result["interval_ms"] = interval_ms;
+  result["offset_ms"] = offset_ms;
+  result["reset"] = reset.load();
+  result["freezes"] = freezes;
+  result["skipped"] = skipped;
+  result["unsent"] = unsent;
+  result["points"] = points;
+  result["last_frozen_at"] = lastFrozenAt.has_value()
+                                 ? py::cast(lastFrozenAt.value())
+                                 : py::none();
+  result["last_snapshot_ms"] = lastSnapshot_ms;
+  result["last_transmission_ms"] = lastTransmission_ms;
+  result["next_freeze_at"] = isEnabled ? py::cast(nextFreezeAt) : py::none();
+  return result;
+}
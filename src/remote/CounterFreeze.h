@@ -0,0 +1,150 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CounterFreeze.h
+ * @brief wall-clock aligned freeze schedule of integrated totals
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_COUNTERFREEZE_H
+#define C104_REMOTE_COUNTERFREEZE_H
+
+#include <optional>
+
+#include "module/GilAwareMutex.h"
+#include "types.h"
+
+namespace Remote {
+
+/**
+ * @brief schedules counter freeze cycles of a station at wall-clock boundaries
+ * and collects freeze statistics
+ *
+ * Freezes are due at every multiple of the interval since the unix epoch plus
+ * the offset, so an interval of 15 minutes freezes at :00, :15, :30 and :45.
+ */
+class CounterFreeze {
+public:
+  /**
+   * @brief start freezing at the next boundary
+   * @param interval_ms time between two freezes in milliseconds
+   * @param reset reset the counters to zero after each freeze
+   * @param offset_ms shift of the boundaries in milliseconds
+   * @throws std::invalid_argument if the interval is zero or the offset is not
+   * less than the interval
+   */
+  void enable(std::uint_fast32_t interval_ms, bool reset,
+              std::uint_fast32_t offset_ms);
+
+  /**
+   * @brief stop freezing, statistics are kept
+   */
+  void disable();
+
+  bool isEnabled() const;
+
+  /**
+   * @brief Getter for the counter reset option
+   */
+  bool isReset() const;
+
+  /**
+   * @brief Get the first boundary after a point in time
+   * @param now point in time
+   * @param interval_ms time between two boundaries in milliseconds
+   * @param offset_ms shift of the boundaries in milliseconds
+   * @return boundary strictly after now
+   */
+  static std::chrono::system_clock::time_point
+  nextBoundary(std::chrono::system_clock::time_point now,
+               std::uint_fast32_t interval_ms, std::uint_fast32_t offset_ms);
+
+  /**
+   * @brief test if a freeze is due and schedule the next one, boundaries
+   * missed in between are counted as skipped
+   * @param now current wall-clock time
+   * @return boundary of the due freeze, if any
+   */
+  std::optional<std::chrono::system_clock::time_point>
+  takeDue(std::chrono::system_clock::time_point now);
+
+  /**
+   * @brief store the result of a freeze
+   * @param frozen_at boundary of the freeze
+   * @param points number of frozen counters
+   * @param snapshot time needed to freeze all counters
+   * @param transmission time needed to send the frozen values, if sent
+   */
+  void record(std::chrono::system_clock::time_point frozen_at,
+              std::size_t points, std::chrono::steady_clock::duration snapshot,
+              std::optional<std::chrono::steady_clock::duration> transmission);
+
+  /**
+   * @brief Getter for configuration and statistics as python dictionary
+   * @return dict with enabled, interval_ms, offset_ms, reset, freezes,
+   * skipped, unsent, points, last_frozen_at, last_snapshot_ms,
+   * last_transmission_ms and next_freeze_at
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief MUTEX Lock to access schedule and statistics
+  mutable Module::GilAwareMutex access_mutex{"CounterFreeze::access_mutex"};
+
+  std::atomic_bool enabled{false};
+
+  /// @brief reset counters after freezing
+  std::atomic_bool reset{false};
+
+  std::uint_fast32_t interval_ms{0};
+
+  std::uint_fast32_t offset_ms{0};
+
+  /// @brief boundary of the next freeze
+  std::chrono::system_clock::time_point nextFreezeAt{};
+
+  /// @brief number of freezes
+  std::uint_fast64_t freezes{0};
+
+  /// @brief number of boundaries missed because the server was busy
+  std::uint_fast64_t skipped{0};
+
+  /// @brief number of freezes without active connection to send them to
+  std::uint_fast64_t unsent{0};
+
+  /// @brief number of counters frozen by the last freeze
+  std::size_t points{0};
+
+  std::optional<std::chrono::system_clock::time_point> lastFrozenAt{};
+
+  double lastSnapshot_ms{0};
+
+  double lastTransmission_ms{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_COUNTERFREEZE_H
@@ -0,0 +1,302 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file IntervalAggregator.cpp
+ * @brief aggregation of received point values over wall-clock intervals
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "IntervalAggregator.h"
+#include "object/InfoTraits.h"
+#include <pybind11/chrono.h>
+
+using namespace Remote;
+
+namespace {
+
+bool isMeasured(const IEC60870_5_TypeID type) {
+  switch (type) {
+  case M_ME_NA_1:
+  case M_ME_NB_1:
+  case M_ME_NC_1:
+  case M_ME_ND_1:
+  case M_ME_TD_1:
+  case M_ME_TE_1:
+  case M_ME_TF_1:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::chrono::system_clock::time_point
+alignedStart(const std::chrono::system_clock::time_point at,
+             const std::uint_fast32_t interval_ms) {
+  std::int64_t const since_epoch =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          at.time_since_epoch())
+          .count();
+  std::int64_t const period = interval_ms;
+  std::int64_t phase = since_epoch % period;
+  if (phase < 0) {
+    phase += period;
+  }
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::milliseconds(since_epoch - phase)));
+}
+
+std::size_t footprint(const IntervalAggregator::Batch &batch) {
+  return sizeof(IntervalAggregator::Batch) +
+         batch.aggregates.capacity() * sizeof(IntervalAggregator::Aggregate);
+}
+
+} // namespace
+
+IntervalAggregator::~IntervalAggregator() {
+  Module::MemoryBudget::remove(Module::MemoryBudget::Subsystem::Aggregates,
+                               pendingBytes);
+}
+
+void IntervalAggregator::clearPending() {
+  pending.clear();
+  Module::MemoryBudget::remove(Module::MemoryBudget::Subsystem::Aggregates,
+                               pendingBytes);
+  pendingBytes = 0;
+}
+
+void IntervalAggregator::enable(const std::uint_fast32_t interval) {
+  if (0 == interval) {
+    throw std::invalid_argument("The aggregation interval must be positive");
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  interval_ms = interval;
+  intervalStart = alignedStart(std::chrono::system_clock::now(), interval);
+  intervalEnd = intervalStart + std::chrono::milliseconds(interval);
+  states.clear();
+  clearPending();
+  enabled.store(true);
+}
+
+void IntervalAggregator::disable() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  enabled.store(false);
+  states.clear();
+  clearPending();
+}
+
+bool IntervalAggregator::isEnabled() const { return enabled.load(); }
+
+bool IntervalAggregator::isAggregated(const IEC60870_5_TypeID type) {
+  switch (type) {
+  case M_SP_NA_1:
+  case M_SP_TB_1:
+  case M_DP_NA_1:
+  case M_DP_TB_1:
+  case M_ST_NA_1:
+  case M_ST_TB_1:
+  case M_IT_NA_1:
+  case M_IT_TB_1:
+    return true;
+  default:
+    return isMeasured(type);
+  }
+}
+
+void IntervalAggregator::hold(
+    State &state, const std::chrono::system_clock::time_point until) const {
+  auto const from = std::max(state.lastAt, intervalStart);
+  if (until <= from)
+    return;
+
+  double const duration_ms =
+      std::chrono::duration<double, std::milli>(until - from).count();
+  state.weighted += state.last * duration_ms;
+  state.covered_ms += duration_ms;
+}
+
+void IntervalAggregator::advance(
+    const std::chrono::system_clock::time_point now) {
+  if (now < intervalEnd)
+    return;
+
+  Batch batch{intervalStart, intervalEnd, {}};
+  batch.aggregates.reserve(states.size());
+  for (auto &entry : states) {
+    auto &state = entry.second;
+    hold(state, intervalEnd);
+
+    Aggregate aggregate;
+    aggregate.commonAddress =
+        static_cast<std::uint_fast16_t>(entry.first >> 32);
+    aggregate.informationObjectAddress =
+        static_cast<std::uint_fast32_t>(entry.first & 0xFFFFFFFF);
+    aggregate.type = state.type;
+    aggregate.count = state.count;
+    aggregate.min = state.min;
+    aggregate.max = state.max;
+    if (isMeasured(state.type) && state.covered_ms > 0) {
+      aggregate.average = state.weighted / state.covered_ms;
+    } else if (state.count > 0) {
+      aggregate.average = state.sum / state.count;
+    } else {
+      aggregate.average = state.last;
+    }
+    aggregate.last = state.last;
+    aggregate.lastAt = state.lastAt;
+    batch.aggregates.push_back(aggregate);
+
+    // carry the last value into the next interval
+    state.count = 0;
+    state.min = state.max = state.sum = state.last;
+    state.weighted = state.covered_ms = 0;
+  }
+
+  intervals++;
+  lastBatchSize = batch.aggregates.size();
+  if (!batch.aggregates.empty()) {
+    using Module::MemoryBudget;
+    if (MemoryBudget::getStage() >= MemoryBudget::Stage::RefuseHistory) {
+      dropped++;
+      MemoryBudget::recordShed(MemoryBudget::Stage::RefuseHistory);
+    } else {
+      if (pending.size() >= AGGREGATOR_MAX_PENDING_BATCHES) {
+        auto const bytes = footprint(pending.front());
+        pendingBytes -= bytes;
+        MemoryBudget::remove(MemoryBudget::Subsystem::Aggregates, bytes);
+        pending.pop_front();
+        dropped++;
+      }
+      auto const bytes = footprint(batch);
+      pendingBytes += bytes;
+      MemoryBudget::add(MemoryBudget::Subsystem::Aggregates, bytes);
+      pending.push_back(std::move(batch));
+    }
+  }
+
+  // continue with the interval that contains now, intervals in between did
+  // not receive a value and are not reported
+  auto const start = alignedStart(now, interval_ms);
+  auto const missed =
+      (start - intervalEnd) / std::chrono::milliseconds(interval_ms);
+  if (missed > 0) {
+    skipped += missed;
+  }
+  intervalStart = start;
+  intervalEnd = start + std::chrono::milliseconds(interval_ms);
+}
+
+void IntervalAggregator::record(
+    const std::uint_fast16_t commonAddress,
+    const std::uint_fast32_t informationObjectAddress,
+    const IEC60870_5_TypeID type,
+    const std::shared_ptr<Object::Information> &info,
+    const std::chrono::system_clock::time_point at) {
+  if (!enabled.load() || !info || !isAggregated(type))
+    return;
+
+  double value = 0;
+  if (!Object::visitNative(type, info.get(), [&value](auto *typed) {
+        value = Object::nativeToDouble(typed->getNativeValue());
+      })) {
+    return;
+  }
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  advance(at);
+
+  auto const key = (static_cast<std::uint_fast64_t>(commonAddress) << 32) |
+                   informationObjectAddress;
+  auto const arrived = std::max(at, intervalStart);
+  auto it = states.find(key);
+  if (it == states.end()) {
+    it = states.emplace(key, State{}).first;
+    it->second.type = type;
+    it->second.min = it->second.max = value;
+  } else {
+    hold(it->second, arrived);
+  }
+
+  auto &state = it->second;
+  state.count++;
+  state.min = std::min(state.min, value);
+  state.max = std::max(state.max, value);
+  state.sum += value;
+  state.last = value;
+  state.lastAt = arrived;
+  samples++;
+}
+
+std::vector<IntervalAggregator::Batch>
+IntervalAggregator::collect(const std::chrono::system_clock::time_point now) {
+  std::vector<Batch> result;
+  if (!enabled.load())
+    return result;
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  advance(now);
+  result.reserve(pending.size());
+  for (auto &batch : pending) {
+    result.push_back(std::move(batch));
+  }
+  clearPending();
+  return result;
+}
+
+py::list IntervalAggregator::toList(const Batch &batch) {
+  py::list result;
+  for (const auto &aggregate : batch.aggregates) {
+    py::dict item;
+    item["common_address"] = aggregate.commonAddress;
+    item["io_address"] = aggregate.informationObjectAddress;
+    item["type"] = std::string(TypeID_toString(aggregate.type));
+    item["count"] = aggregate.count;
+    item["min"] = aggregate.min;
+    item["max"] = aggregate.max;
+    item["average"] = aggregate.average;
+    item["last"] = aggregate.last;
+    item["last_at"] = py::cast(aggregate.lastAt);
+    result.append(item);
+  }
+  return result;
+}
+
+py::dict IntervalAggregator::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::dict result;
+  result["enabled"] = enabled.load();
+  result["interval_ms"] = interval_ms;
+  result["points"] = states.size();
+  result["samples"] = samples;
+  result["intervals"] = intervals;
+  result["skipped"] = skipped;
+  result["dropped"] = dropped;
+  result["pending_bytes"] = pendingBytes;
+  result["last_batch_size"] = lastBatchSize;
+  return result;
+}
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file IntervalAggregator.h
+ * @brief aggregation of received point values over wall-clock intervals
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_INTERVALAGGREGATOR_H
+#define C104_REMOTE_INTERVALAGGREGATOR_H
+
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+#include "module/GilAwareMutex.h"
+#include "module/MemoryBudget.h"
+#include "object/Information.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief maximum number of completed batches kept until they are collected
+constexpr std::size_t AGGREGATOR_MAX_PENDING_BATCHES = 16;
+
+/**
+ * @brief maintains running aggregates of received values per point and
+ * completes a batch of aggregates at every interval boundary
+ *
+ * Intervals are aligned to multiples of the interval length since the unix
+ * epoch. Measured values are averaged weighted by the time each value was
+ * valid, the last value of an interval is carried into the next interval.
+ * Other numeric values are averaged per sample. Completed batches are
+ * accounted in the memory budget until they are collected, new batches are
+ * refused if the budget is exhausted.
+ */
+class IntervalAggregator {
+public:
+  /// @brief aggregated values of a point over one interval
+  struct Aggregate {
+    std::uint_fast16_t commonAddress{0};
+    std::uint_fast32_t informationObjectAddress{0};
+    IEC60870_5_TypeID type{M_ME_NC_1};
+
+    /// @brief number of values received in the interval
+    std::uint_fast64_t count{0};
+
+    double min{0};
+    double max{0};
+    double average{0};
+    double last{0};
+
+    /// @brief arrival time of the last value, may be before the interval
+    std::chrono::system_clock::time_point lastAt{};
+  };
+
+  /// @brief aggregates of all known points for one interval
+  struct Batch {
+    std::chrono::system_clock::time_point start{};
+    std::chrono::system_clock::time_point end{};
+    std::vector<Aggregate> aggregates{};
+  };
+
+  ~IntervalAggregator();
+
+  /**
+   * @brief start aggregating with a new interval, known values are dropped
+   * @param interval_ms length of an interval in milliseconds
+   * @throws std::invalid_argument if the interval is zero
+   */
+  void enable(std::uint_fast32_t interval_ms);
+
+  /**
+   * @brief stop aggregating, known values and pending batches are dropped
+   */
+  void disable();
+
+  bool isEnabled() const;
+
+  /**
+   * @brief test if a type is aggregated, only numeric monitoring types are
+   */
+  static bool isAggregated(IEC60870_5_TypeID type);
+
+  /**
+   * @brief add a received value, completes the current interval first if
+   * the value arrived after its end
+   * @param commonAddress common address of the station
+   * @param informationObjectAddress information object address of the point
+   * @param type type of the received message
+   * @param info received information
+   * @param at arrival time
+   */
+  void record(std::uint_fast16_t commonAddress,
+              std::uint_fast32_t informationObjectAddress,
+              IEC60870_5_TypeID type,
+              const std::shared_ptr<Object::Information> &info,
+              std::chrono::system_clock::time_point at);
+
+  /**
+   * @brief complete the current interval if it ended and take all completed
+   * batches
+   * @param now current wall-clock time
+   * @return completed batches in order
+   */
+  std::vector<Batch> collect(std::chrono::system_clock::time_point now);
+
+  /**
+   * @brief Convert a batch into a python list of dictionaries
+   * @return list of dict with common_address, io_address, type, count, min,
+   * max, average, last and last_at
+   */
+  static py::list toList(const Batch &batch);
+
+  /**
+   * @brief Getter for configuration and statistics as python dictionary
+   * @return dict with enabled, interval_ms, points, samples, intervals,
+   * skipped, dropped, pending_bytes and last_batch_size
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief running aggregate of a point in the current interval
+  struct State {
+    IEC60870_5_TypeID type{M_ME_NC_1};
+    std::uint_fast64_t count{0};
+    double min{0};
+    double max{0};
+    double sum{0};
+
+    /// @brief sum of value times validity in milliseconds
+    double weighted{0};
+
+    /// @brief milliseconds of the interval with a known value
+    double covered_ms{0};
+
+    double last{0};
+    std::chrono::system_clock::time_point lastAt{};
+  };
+
+  /**
+   * @brief add the time since the last value to the weighted sum, requires
+   * access_mutex
+   */
+  void hold(State &state, std::chrono::system_clock::time_point until) const;
+
+  /**
+   * @brief complete the current interval if it ended before now and start
+   * the interval that contains now, requires access_mutex
+   */
+  void advance(std::chrono::system_clock::time_point now);
+
+  /**
+   * @brief drop all pending batches and give back their memory, requires
+   * access_mutex
+   */
+  void clearPending();
+
+  /// @brief MUTEX Lock to access aggregates and statistics
+  mutable Module::GilAwareMutex access_mutex{
+      "IntervalAggregator::access_mutex"};
+
+  std::atomic_bool enabled{false};
+
+  std::uint_fast32_t interval_ms{0};
+
+  std::chrono::system_clock::time_point intervalStart{};
+
+  std::chrono::system_clock::time_point intervalEnd{};
+
+  /// @brief running aggregates by common address and information object
+  /// address
+  std::unordered_map<std::uint_fast64_t, State> states{};
+
+  /// @brief completed batches that were not collected yet
+  std::deque<Batch> pending{};
+
+  /// @brief accounted memory of pending batches
+  std::size_t pendingBytes{0};
+
+  /// @brief number of received values
+  std::uint_fast64_t samples{0};
+
+  /// @brief number of completed intervals
+  std::uint_fast64_t intervals{0};
+
+  /// @brief number of intervals without tick or value, not reported
+  std::uint_fast64_t skipped{0};
+
+  /// @brief number of batches dropped because they were not collected or
+  /// the memory budget was exhausted
+  std::uint_fast64_t dropped{0};
+
+  std::size_t lastBatchSize{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_INTERVALAGGREGATOR_H
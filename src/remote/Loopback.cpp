@@ -0,0 +1,688 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file Loopback.cpp
+ * @brief in-process transport between client and server of the same process
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "Loopback.h"
+
+#ifdef C104_LOOPBACK_TRANSPORT
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "hal_socket.h"
+#endif
+
+using namespace Remote;
+
+#ifdef C104_LOOPBACK_TRANSPORT
+
+// original HAL functions, resolved by the linker option --wrap
+extern "C" {
+void __real_Handleset_reset(HandleSet self);
+void __real_Handleset_addSocket(HandleSet self, const Socket sock);
+int __real_Handleset_waitReady(HandleSet self, unsigned int timeoutMs);
+void __real_Handleset_destroy(HandleSet self);
+ServerSocket __real_TcpServerSocket_create(const char *address, int port);
+void __real_ServerSocket_listen(ServerSocket self);
+Socket __real_ServerSocket_accept(ServerSocket self);
+void __real_ServerSocket_setBacklog(ServerSocket self, int backlog);
+void __real_ServerSocket_destroy(ServerSocket self);
+Socket __real_TcpSocket_create(void);
+void __real_Socket_setConnectTimeout(Socket self, uint32_t timeoutInMs);
+bool __real_Socket_connect(Socket self, const char *address, int port);
+bool __real_Socket_connectAsync(Socket self, const char *address, int port);
+SocketState __real_Socket_checkAsyncConnectState(Socket self);
+int __real_Socket_read(Socket self, uint8_t *buf, int size);
+int __real_Socket_write(Socket self, uint8_t *buf, int size);
+char *__real_Socket_getLocalAddress(Socket self);
+char *__real_Socket_getPeerAddress(Socket self);
+char *__real_Socket_getPeerAddressStatic(Socket self, char *peerAddressString);
+void __real_Socket_destroy(Socket self);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief first port number of emulated client addresses
+constexpr std::uint_fast16_t LOOPBACK_FIRST_CLIENT_PORT = 49152;
+
+struct Chunk {
+  std::vector<std::uint8_t> data;
+  std::size_t offset;
+  Clock::time_point deliverAt;
+};
+
+/// @brief one direction of a connection
+struct Pipe {
+  std::deque<Chunk> chunks{};
+
+  /// @brief point in time the last chunk leaves the emulated link
+  Clock::time_point transmitted{};
+
+  bool writerClosed{false};
+  bool readerClosed{false};
+};
+
+struct Channel {
+  std::chrono::milliseconds latency{0};
+  std::uint_fast64_t bandwidth{0};
+  std::string clientAddress{};
+  std::string serverAddress{};
+  Pipe toServer{};
+  Pipe toClient{};
+};
+
+struct LoopbackSocket;
+
+struct Endpoint {
+  std::string ip;
+  std::uint_fast16_t port;
+  std::chrono::milliseconds latency;
+  std::uint_fast64_t bandwidth;
+
+  /// @brief server socket of a started server, nullptr = connection refused
+  LoopbackSocket *listener{nullptr};
+
+  /// @brief connected channels that are not accepted yet
+  std::deque<std::shared_ptr<Channel>> backlog{};
+};
+
+/**
+ * A listener has an endpoint, a connected socket has a channel. A client
+ * socket is created before its destination is known, it holds a platform
+ * socket until it connects to a loopback endpoint.
+ */
+struct LoopbackSocket {
+  /// @brief the platform socket structs start with the file descriptor, so
+  /// unwrapped HAL calls fail like on a closed socket
+  int fd{-1};
+
+  Socket platform{nullptr};
+  std::shared_ptr<Endpoint> endpoint{nullptr};
+  std::shared_ptr<Channel> channel{nullptr};
+  bool serverSide{false};
+};
+
+/// @brief loopback sockets added to a handle set
+struct Selection {
+  std::vector<LoopbackSocket *> sockets{};
+  bool platform{false};
+
+  /// @brief a thread waits on this set, it must not be erased by others
+  bool waiting{false};
+};
+
+std::mutex state_mutex;
+std::condition_variable state_changed;
+std::vector<std::shared_ptr<Endpoint>> endpoints;
+std::unordered_set<void *> sockets;
+std::unordered_map<HandleSet, Selection> selections;
+std::uint_fast16_t nextClientPort{LOOPBACK_FIRST_CLIENT_PORT};
+
+/// @brief number of endpoints and loopback sockets, the HAL is passed
+/// through without locking while this is zero
+std::atomic_size_t active{0};
+
+bool isActive() { return active.load(std::memory_order_acquire) > 0; }
+
+void retain() { active.fetch_add(1, std::memory_order_acq_rel); }
+
+void release() {
+  if (1 == active.fetch_sub(1, std::memory_order_acq_rel)) {
+    // the selection of a waiting thread is erased when the wait returns
+    for (auto it = selections.begin(); it != selections.end();) {
+      it = it->second.waiting ? std::next(it) : selections.erase(it);
+    }
+  }
+}
+
+LoopbackSocket *find(void *handle) {
+  return sockets.count(handle) ? static_cast<LoopbackSocket *>(handle)
+                               : nullptr;
+}
+
+LoopbackSocket *createSocket() {
+  auto *socket = new LoopbackSocket();
+  sockets.insert(socket);
+  retain();
+  return socket;
+}
+
+void destroySocket(LoopbackSocket *socket) {
+  sockets.erase(socket);
+  for (auto &selection : selections) {
+    auto &list = selection.second.sockets;
+    list.erase(std::remove(list.begin(), list.end(), socket), list.end());
+  }
+  delete socket;
+  release();
+  state_changed.notify_all();
+}
+
+std::shared_ptr<Endpoint> findEndpoint(const char *address, const int port) {
+  for (auto &endpoint : endpoints) {
+    if (endpoint->port == static_cast<std::uint_fast16_t>(port) &&
+        (!address || endpoint->ip == address || endpoint->ip == "0.0.0.0")) {
+      return endpoint;
+    }
+  }
+  return nullptr;
+}
+
+Pipe &inbound(LoopbackSocket *socket) {
+  return socket->serverSide ? socket->channel->toServer
+                            : socket->channel->toClient;
+}
+
+Pipe &outbound(LoopbackSocket *socket) {
+  return socket->serverSide ? socket->channel->toClient
+                            : socket->channel->toServer;
+}
+
+void closePipes(Pipe &in, Pipe &out) {
+  out.writerClosed = true;
+  in.readerClosed = true;
+  in.chunks.clear();
+}
+
+bool isReadable(const Pipe &pipe, const Clock::time_point now) {
+  if (pipe.chunks.empty()) {
+    return pipe.writerClosed;
+  }
+  return pipe.chunks.front().deliverAt <= now;
+}
+
+std::shared_ptr<Endpoint> findListening(const char *address, const int port) {
+  auto endpoint = findEndpoint(address, port);
+  return endpoint && endpoint->listener ? endpoint : nullptr;
+}
+
+void connectEndpoint(LoopbackSocket *socket,
+                     const std::shared_ptr<Endpoint> &endpoint,
+                     const char *address, const int port) {
+  // the destination is served in-process, drop the platform socket
+  __real_Socket_destroy(socket->platform);
+  socket->platform = nullptr;
+
+  auto channel = std::make_shared<Channel>();
+  channel->latency = endpoint->latency;
+  channel->bandwidth = endpoint->bandwidth;
+  channel->serverAddress = std::string(address) + ":" + std::to_string(port);
+  channel->clientAddress = "127.0.0.1:" + std::to_string(nextClientPort);
+  nextClientPort = nextClientPort < 65535 ? nextClientPort + 1
+                                          : LOOPBACK_FIRST_CLIENT_PORT;
+
+  socket->channel = channel;
+  endpoint->backlog.push_back(std::move(channel));
+  state_changed.notify_all();
+}
+
+int readPipe(Pipe &pipe, uint8_t *buf, const int size) {
+  auto const now = Clock::now();
+  std::size_t count = 0;
+  while (count < static_cast<std::size_t>(size) && !pipe.chunks.empty() &&
+         pipe.chunks.front().deliverAt <= now) {
+    auto &chunk = pipe.chunks.front();
+    std::size_t const length =
+        std::min(size - count, chunk.data.size() - chunk.offset);
+    std::memcpy(buf + count, chunk.data.data() + chunk.offset, length);
+    chunk.offset += length;
+    count += length;
+    if (chunk.offset == chunk.data.size()) {
+      pipe.chunks.pop_front();
+    }
+  }
+  if (0 == count && pipe.chunks.empty() && pipe.writerClosed) {
+    return -1;
+  }
+  return static_cast<int>(count);
+}
+
+int writePipe(const Channel &channel, Pipe &pipe, const uint8_t *buf,
+          const int size) {
+  if (pipe.writerClosed || pipe.readerClosed) {
+    return -1;
+  }
+  if (size <= 0) {
+    return 0;
+  }
+
+  auto const now = Clock::now();
+  auto sent = now;
+  if (channel.bandwidth > 0) {
+    // frames are queued without limit, lib60870 limits unconfirmed frames (k)
+    pipe.transmitted = std::max(now, pipe.transmitted) +
+                       std::chrono::nanoseconds(size * 1000000000ULL /
+                                                channel.bandwidth);
+    sent = pipe.transmitted;
+  }
+  pipe.chunks.push_back(
+      {std::vector<std::uint8_t>(buf, buf + size), 0, sent + channel.latency});
+  state_changed.notify_all();
+  return size;
+}
+
+} // namespace
+
+extern "C" {
+
+void __wrap_Handleset_reset(HandleSet self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    selections.erase(self);
+  }
+  __real_Handleset_reset(self);
+}
+
+void __wrap_Handleset_addSocket(HandleSet self, const Socket sock) {
+  Socket platform = sock;
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    auto &selection = selections[self];
+    if (auto *socket = find(sock)) {
+      if (!socket->platform) {
+        selection.sockets.push_back(socket);
+        return;
+      }
+      platform = socket->platform;
+    }
+    selection.platform = true;
+  }
+  __real_Handleset_addSocket(self, platform);
+}
+
+int __wrap_Handleset_waitReady(HandleSet self, unsigned int timeoutMs) {
+  if (isActive()) {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    auto it = selections.find(self);
+    if (it != selections.end() && !it->second.sockets.empty()) {
+      // references to map elements stay valid while other sets are added,
+      // release() keeps the selection while it is waited on
+      auto &selection = it->second;
+      selection.waiting = true;
+      auto const deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+      while (true) {
+        auto const now = Clock::now();
+        auto wakeup = deadline;
+        int ready = 0;
+        for (auto *socket : selection.sockets) {
+          if (socket->endpoint) {
+            ready += socket->endpoint->backlog.empty() ? 0 : 1;
+          } else if (socket->channel) {
+            auto const &pipe = inbound(socket);
+            if (isReadable(pipe, now)) {
+              ready++;
+            } else if (!pipe.chunks.empty()) {
+              wakeup = std::min(wakeup, pipe.chunks.front().deliverAt);
+            }
+          }
+        }
+        if (0 == ready && selection.platform) {
+          // mixed sets poll the platform sockets in short intervals
+          lock.unlock();
+          ready = std::max(0, __real_Handleset_waitReady(self, 0));
+          lock.lock();
+          wakeup = std::min(wakeup, now + std::chrono::milliseconds(1));
+        }
+        if (ready > 0 || now >= deadline) {
+          selection.waiting = false;
+          if (!isActive()) {
+            selections.erase(self);
+          }
+          return ready;
+        }
+        state_changed.wait_until(lock, wakeup);
+      }
+    }
+  }
+  return __real_Handleset_waitReady(self, timeoutMs);
+}
+
+void __wrap_Handleset_destroy(HandleSet self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    selections.erase(self);
+  }
+  __real_Handleset_destroy(self);
+}
+
+ServerSocket __wrap_TcpServerSocket_create(const char *address, int port) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto endpoint = findEndpoint(address, port)) {
+      if (endpoint->listener) {
+        // address in use
+        return nullptr;
+      }
+      auto *listener = createSocket();
+      listener->endpoint = endpoint;
+      endpoint->listener = listener;
+      return reinterpret_cast<ServerSocket>(listener);
+    }
+  }
+  return __real_TcpServerSocket_create(address, port);
+}
+
+void __wrap_ServerSocket_listen(ServerSocket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (find(self)) {
+      return;
+    }
+  }
+  __real_ServerSocket_listen(self);
+}
+
+Socket __wrap_ServerSocket_accept(ServerSocket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *listener = find(self)) {
+      auto &backlog = listener->endpoint->backlog;
+      if (backlog.empty()) {
+        return nullptr;
+      }
+      auto *socket = createSocket();
+      socket->channel = std::move(backlog.front());
+      socket->serverSide = true;
+      backlog.pop_front();
+      return reinterpret_cast<Socket>(socket);
+    }
+  }
+  return __real_ServerSocket_accept(self);
+}
+
+void __wrap_ServerSocket_setBacklog(ServerSocket self, int backlog) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (find(self)) {
+      return;
+    }
+  }
+  __real_ServerSocket_setBacklog(self, backlog);
+}
+
+void __wrap_ServerSocket_destroy(ServerSocket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *listener = find(self)) {
+      auto &endpoint = listener->endpoint;
+      for (auto &channel : endpoint->backlog) {
+        closePipes(channel->toServer, channel->toClient);
+      }
+      endpoint->backlog.clear();
+      endpoint->listener = nullptr;
+      destroySocket(listener);
+      return;
+    }
+  }
+  __real_ServerSocket_destroy(self);
+}
+
+Socket __wrap_TcpSocket_create(void) {
+  Socket platform = __real_TcpSocket_create();
+  if (!platform || !isActive()) {
+    return platform;
+  }
+  std::lock_guard<std::mutex> const lock(state_mutex);
+  auto *socket = createSocket();
+  socket->platform = platform;
+  return reinterpret_cast<Socket>(socket);
+}
+
+void __wrap_Socket_setConnectTimeout(Socket self, uint32_t timeoutInMs) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return;
+      }
+      self = socket->platform;
+    }
+  }
+  __real_Socket_setConnectTimeout(self, timeoutInMs);
+}
+
+bool __wrap_Socket_connect(Socket self, const char *address, int port) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return false;
+      }
+      // endpoints without a started server are reached via the platform
+      if (auto endpoint = findListening(address, port)) {
+        connectEndpoint(socket, endpoint, address, port);
+        return true;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_connect(self, address, port);
+}
+
+bool __wrap_Socket_connectAsync(Socket self, const char *address, int port) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return false;
+      }
+      if (auto endpoint = findListening(address, port)) {
+        connectEndpoint(socket, endpoint, address, port);
+        return true;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_connectAsync(self, address, port);
+}
+
+SocketState __wrap_Socket_checkAsyncConnectState(Socket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return socket->channel ? SOCKET_STATE_CONNECTED : SOCKET_STATE_FAILED;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_checkAsyncConnectState(self);
+}
+
+int __wrap_Socket_read(Socket self, uint8_t *buf, int size) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return socket->channel ? readPipe(inbound(socket), buf, size) : -1;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_read(self, buf, size);
+}
+
+int __wrap_Socket_write(Socket self, uint8_t *buf, int size) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        return socket->channel
+                   ? writePipe(*socket->channel, outbound(socket), buf, size)
+                   : -1;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_write(self, buf, size);
+}
+
+char *__wrap_Socket_getLocalAddress(Socket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        if (!socket->channel) {
+          return nullptr;
+        }
+        return strdup(socket->serverSide
+                          ? socket->channel->serverAddress.c_str()
+                          : socket->channel->clientAddress.c_str());
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_getLocalAddress(self);
+}
+
+char *__wrap_Socket_getPeerAddress(Socket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        if (!socket->channel) {
+          return nullptr;
+        }
+        return strdup(socket->serverSide
+                          ? socket->channel->clientAddress.c_str()
+                          : socket->channel->serverAddress.c_str());
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_getPeerAddress(self);
+}
+
+char *__wrap_Socket_getPeerAddressStatic(Socket self,
+                                         char *peerAddressString) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (!socket->platform) {
+        if (!socket->channel) {
+          return nullptr;
+        }
+        // addresses are "a.b.c.d:port", shorter than the HAL minimum buffer
+        std::strcpy(peerAddressString,
+                    socket->serverSide
+                        ? socket->channel->clientAddress.c_str()
+                        : socket->channel->serverAddress.c_str());
+        return peerAddressString;
+      }
+      self = socket->platform;
+    }
+  }
+  return __real_Socket_getPeerAddressStatic(self, peerAddressString);
+}
+
+void __wrap_Socket_destroy(Socket self) {
+  if (isActive()) {
+    std::lock_guard<std::mutex> const lock(state_mutex);
+    if (auto *socket = find(self)) {
+      if (socket->channel) {
+        closePipes(inbound(socket), outbound(socket));
+      }
+      if (socket->platform) {
+        __real_Socket_destroy(socket->platform);
+      }
+      destroySocket(socket);
+      return;
+    }
+  }
+  __real_Socket_destroy(self);
+}
+
+} // extern "C"
+
+bool Loopback::isSupported() { return true; }
+
+void Loopback::enable(const std::string &ip, const std::uint_fast16_t port,
+                      const std::uint_fast32_t latency_ms,
+                      const std::uint_fast64_t bandwidth) {
+  std::lock_guard<std::mutex> const lock(state_mutex);
+  for (auto &endpoint : endpoints) {
+    if (endpoint->ip == ip && endpoint->port == port) {
+      endpoint->latency = std::chrono::milliseconds(latency_ms);
+      endpoint->bandwidth = bandwidth;
+      return;
+    }
+  }
+  endpoints.push_back(std::make_shared<Endpoint>(
+      Endpoint{ip, port, std::chrono::milliseconds(latency_ms), bandwidth}));
+  retain();
+}
+
+void Loopback::disable(const std::string &ip, const std::uint_fast16_t port) {
+  std::lock_guard<std::mutex> const lock(state_mutex);
+  for (auto it = endpoints.begin(); it != endpoints.end(); ++it) {
+    if ((*it)->ip == ip && (*it)->port == port) {
+      endpoints.erase(it);
+      release();
+      return;
+    }
+  }
+}
+
+bool Loopback::isEnabled(const std::string &ip,
+                         const std::uint_fast16_t port) {
+  std::lock_guard<std::mutex> const lock(state_mutex);
+  for (auto &endpoint : endpoints) {
+    if (endpoint->ip == ip && endpoint->port == port) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#else
+
+bool Loopback::isSupported() { return false; }
+
+void Loopback::enable(const std::string &ip, const std::uint_fast16_t port,
+                      const std::uint_fast32_t latency_ms,
+                      const std::uint_fast64_t bandwidth) {
+  throw std::runtime_error(
+      "Loopback transport is not supported by this build");
+}
+
+void Loopback::disable(const std::string &ip, const std::uint_fast16_t port) {}
+
+bool Loopback::isEnabled(const std::string &ip,
+                         const std::uint_fast16_t port) {
+  return false;
+}
+
+#endif // C104_LOOPBACK_TRANSPORT
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file Loopback.h
+ * @brief in-process transport between client and server of the same process
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_LOOPBACK_H
+#define C104_REMOTE_LOOPBACK_H
+
+#include "types.h"
+
+namespace Remote {
+
+/**
+ * @brief in-memory replacement of the lib60870 socket HAL for registered
+ * server endpoints
+ *
+ * The HAL functions are wrapped at link time (C104_LOOPBACK_TRANSPORT). A
+ * server socket that is created for a registered endpoint and all client
+ * sockets that connect to it exchange frames via in-memory pipes instead of
+ * the kernel network stack. Each direction of a connection delays frames by a
+ * fixed latency and serializes them at a fixed bandwidth, so that results are
+ * reproducible. All other sockets are passed to the platform HAL unchanged.
+ */
+class Loopback {
+public:
+  /**
+   * @brief test if this build wraps the socket HAL
+   */
+  static bool isSupported();
+
+  /**
+   * @brief register a server endpoint, it is served in-process as soon as a
+   * server is started on it
+   * @param ip bind address of the server, "0.0.0.0" matches all addresses
+   * @param port tcp port of the server
+   * @param latency_ms one way delay per frame, 0 = immediate
+   * @param bandwidth bytes per second in each direction, 0 = unlimited
+   * @throws std::runtime_error if the build does not support loopback
+   */
+  static void enable(const std::string &ip, std::uint_fast16_t port,
+                     std::uint_fast32_t latency_ms,
+                     std::uint_fast64_t bandwidth);
+
+  /**
+   * @brief unregister a server endpoint, existing connections stay open
+   * @param ip bind address of the server
+   * @param port tcp port of the server
+   */
+  static void disable(const std::string &ip, std::uint_fast16_t port);
+
+  /**
+   * @brief test if an endpoint is registered
+   */
+  static bool isEnabled(const std::string &ip, std::uint_fast16_t port);
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_LOOPBACK_H
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file LostUpdateDetector.cpp
+ * @brief compare interrogation results against the spontaneous stream
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "LostUpdateDetector.h"
+#include <pybind11/chrono.h>
+
+using namespace Remote;
+
+struct InfoValueToNumberVisitor {
+  std::optional<double> operator()(std::monostate value) const {
+    return std::nullopt;
+  }
+  template <typename T> std::optional<double> operator()(const T &value) const {
+    if constexpr (std::is_arithmetic_v<T>) {
+      return static_cast<double>(value);
+    } else if constexpr (std::is_enum_v<T>) {
+      return static_cast<double>(
+          static_cast<std::underlying_type_t<T>>(value));
+    } else {
+      return static_cast<double>(value.get());
+    }
+  }
+};
+
+static bool isEqual(const InfoValue &a, const InfoValue &b,
+                    const double tolerance) {
+  if (a.index() != b.index()) {
+    return false;
+  }
+  auto const x = std::visit(InfoValueToNumberVisitor(), a);
+  auto const y = std::visit(InfoValueToNumberVisitor(), b);
+  if (!x.has_value() || !y.has_value()) {
+    return true;
+  }
+  return std::abs(x.value() - y.value()) <= tolerance;
+}
+
+void LostUpdateDetector::enable(const double value,
+                                const std::size_t max_discrepancies) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  tolerance = value;
+  maxDiscrepancies = max_discrepancies;
+  references.clear();
+  stations.clear();
+  recent.clear();
+  enabled.store(true);
+}
+
+void LostUpdateDetector::disable() { enabled.store(false); }
+
+bool LostUpdateDetector::isEnabled() const { return enabled.load(); }
+
+void LostUpdateDetector::record(const CS101_CauseOfTransmission cot,
+                                const std::uint_fast16_t commonAddress,
+                                const std::uint_fast32_t ioa,
+                                const IEC60870_5_TypeID type,
+                                const InfoValue &value) {
+  bool const spontaneous = CS101_COT_SPONTANEOUS == cot ||
+                           CS101_COT_RETURN_INFO_REMOTE == cot ||
+                           CS101_COT_RETURN_INFO_LOCAL == cot;
+  bool const interrogated = CS101_COT_INTERROGATED_BY_STATION <= cot &&
+                            cot <= CS101_COT_INTERROGATED_BY_GROUP_16;
+  if (!spontaneous && !interrogated) {
+    return;
+  }
+
+  auto const now = std::chrono::system_clock::now();
+  std::uint_fast64_t const key =
+      (static_cast<std::uint_fast64_t>(commonAddress) << 32) | ioa;
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (!enabled.load()) {
+    return;
+  }
+
+  auto it = references.find(key);
+  if (spontaneous) {
+    if (it == references.end()) {
+      references.emplace(key, Reference{value, now, true});
+    } else {
+      it->second = Reference{value, now, true};
+    }
+    return;
+  }
+
+  auto &station = stations[commonAddress];
+  if (it == references.end()) {
+    // never reported spontaneously
+    station.unchecked++;
+    return;
+  }
+
+  station.checked++;
+  auto &reference = it->second;
+  if (!isEqual(reference.value, value, tolerance)) {
+    station.discrepancies++;
+    station.lastDiscrepancyAt = now;
+    if (maxDiscrepancies > 0) {
+      if (recent.size() >= maxDiscrepancies) {
+        recent.pop_front();
+      }
+      recent.push_back({commonAddress, ioa, type, reference.value,
+                        reference.receivedAt, reference.spontaneous, value,
+                        now});
+    }
+  }
+  reference = Reference{value, now, false};
+}
+
+py::dict LostUpdateDetector::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  std::uint_fast64_t checked = 0;
+  std::uint_fast64_t unchecked = 0;
+  std::uint_fast64_t discrepancies = 0;
+  py::dict byStation;
+  for (const auto &station : stations) {
+    checked += station.second.checked;
+    unchecked += station.second.unchecked;
+    discrepancies += station.second.discrepancies;
+
+    py::dict counters;
+    counters["checked"] = station.second.checked;
+    counters["unchecked"] = station.second.unchecked;
+    counters["discrepancies"] = station.second.discrepancies;
+    counters["last_discrepancy_at"] =
+        station.second.lastDiscrepancyAt.has_value()
+            ? py::cast(station.second.lastDiscrepancyAt.value())
+            : py::none();
+    byStation[py::int_(station.first)] = counters;
+  }
+
+  py::list events;
+  for (const auto &discrepancy : recent) {
+    py::dict event;
+    event["common_address"] = discrepancy.commonAddress;
+    event["io_address"] = discrepancy.informationObjectAddress;
+    event["type"] = std::string(TypeID_toString(discrepancy.type));
+    event["expected"] = InfoValue_toString(discrepancy.expectedValue);
+    event["expected_at"] = py::cast(discrepancy.expectedAt);
+    event["expected_spontaneous"] = discrepancy.expectedSpontaneous;
+    event["interrogated"] = InfoValue_toString(discrepancy.interrogatedValue);
+    event["interrogated_at"] = py::cast(discrepancy.interrogatedAt);
+    events.append(event);
+  }
+
+  py::dict result;
+  result["enabled"] = enabled.load();
+  result["tolerance"] = tolerance;
+  result["checked"] = checked;
+  result["unchecked"] = unchecked;
+  result["discrepancies"] = discrepancies;
+  result["stations"] = byStation;
+  result["recent"] = events;
+  return result;
+}
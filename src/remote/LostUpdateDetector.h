@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file LostUpdateDetector.h
+ * @brief compare interrogation results against the spontaneous stream
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_LOSTUPDATEDETECTOR_H
+#define C104_REMOTE_LOSTUPDATEDETECTOR_H
+
+#include <deque>
+#include <unordered_map>
+
+#include "module/GilAwareMutex.h"
+#include "types.h"
+
+namespace Remote {
+
+/**
+ * @brief detects updates that were lost between server and client
+ *
+ * The detector remembers the last spontaneously received value of every
+ * point. If a general or group interrogation reports a different value, an
+ * update was lost on the way (queue overflow, reconnect, ...) and a
+ * discrepancy is counted. Each interrogated value becomes the new reference,
+ * so a lost update is counted once. Points that were never reported
+ * spontaneously are not checked.
+ */
+class LostUpdateDetector {
+public:
+  struct Discrepancy {
+    std::uint_fast16_t commonAddress;
+    std::uint_fast32_t informationObjectAddress;
+    IEC60870_5_TypeID type;
+    /// @brief last known value, reported spontaneously or by the previous
+    /// interrogation
+    InfoValue expectedValue;
+    std::chrono::system_clock::time_point expectedAt;
+    bool expectedSpontaneous;
+    InfoValue interrogatedValue;
+    std::chrono::system_clock::time_point interrogatedAt;
+  };
+
+  /**
+   * @brief start comparing, collected references and statistics are reset
+   * @param value accepted absolute difference of numeric values
+   * @param max_discrepancies number of recent discrepancies to keep
+   */
+  void enable(double value, std::size_t max_discrepancies);
+
+  /**
+   * @brief stop comparing, statistics are kept
+   */
+  void disable();
+
+  bool isEnabled() const;
+
+  /**
+   * @brief process a received monitoring value
+   * @param cot cause of transmission of the message
+   * @param commonAddress station address
+   * @param ioa information object address
+   * @param type message type
+   * @param value received value
+   */
+  void record(CS101_CauseOfTransmission cot, std::uint_fast16_t commonAddress,
+              std::uint_fast32_t ioa, IEC60870_5_TypeID type,
+              const InfoValue &value);
+
+  /**
+   * @brief Getter for statistics as python dictionary
+   * @return dict with enabled, tolerance, checked, unchecked, discrepancies,
+   * stations (per common address: checked, unchecked, discrepancies and
+   * last_discrepancy_at) and recent (list of dicts with common_address,
+   * io_address, type, expected, expected_at, expected_spontaneous,
+   * interrogated and interrogated_at)
+   */
+  py::dict toDict() const;
+
+private:
+  struct Reference {
+    InfoValue value;
+    std::chrono::system_clock::time_point receivedAt;
+    bool spontaneous;
+  };
+
+  struct StationCounters {
+    std::uint_fast64_t checked{0};
+    std::uint_fast64_t unchecked{0};
+    std::uint_fast64_t discrepancies{0};
+    std::optional<std::chrono::system_clock::time_point> lastDiscrepancyAt{
+        std::nullopt};
+  };
+
+  /// @brief MUTEX Lock to access references and statistics
+  mutable Module::GilAwareMutex access_mutex{
+      "LostUpdateDetector::access_mutex"};
+
+  std::atomic_bool enabled{false};
+
+  double tolerance{0};
+
+  std::size_t maxDiscrepancies{0};
+
+  /// @brief last known value by common address (upper 32 bits) and
+  /// information object address
+  std::unordered_map<std::uint_fast64_t, Reference> references{};
+
+  std::map<std::uint_fast16_t, StationCounters> stations{};
+
+  /// @brief most recent discrepancies, oldest first
+  std::deque<Discrepancy> recent{};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_LOSTUPDATEDETECTOR_H
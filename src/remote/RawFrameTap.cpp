@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file RawFrameTap.cpp
+ * @brief collect raw frames natively and deliver them in batches
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "RawFrameTap.h"
+
+using namespace Remote;
+
+// typical APDU size, used to reserve the data buffer
+constexpr std::size_t TYPICAL_FRAME_SIZE = 32;
+
+RawFrameBatch::RawFrameBatch(const std::size_t capacity) {
+  data.reserve(capacity * TYPICAL_FRAME_SIZE);
+  offsets.reserve(capacity + 1);
+  timestamps.reserve(capacity);
+  directions.reserve(capacity);
+}
+
+void RawFrameBatch::add(const unsigned char *msg, const std::size_t size,
+                        const bool sent, const std::int64_t timestamp_ns) {
+  data.insert(data.end(), msg, msg + size);
+  offsets.push_back(static_cast<std::uint32_t>(data.size()));
+  timestamps.push_back(timestamp_ns);
+  directions.push_back(sent ? 1 : 0);
+}
+
+std::size_t RawFrameBatch::getFootprint() const {
+  return sizeof(RawFrameBatch) + data.capacity() +
+         offsets.capacity() * sizeof(std::uint32_t) +
+         timestamps.capacity() * sizeof(std::int64_t) + directions.capacity();
+}
+
+py::bytes RawFrameBatch::getFrame(const std::size_t index) const {
+  if (index >= size()) {
+    throw std::out_of_range("Invalid frame index " + std::to_string(index));
+  }
+  return {reinterpret_cast<const char *>(data.data()) + offsets[index],
+          offsets[index + 1] - offsets[index]};
+}
+
+py::buffer_info RawFrameBatch::getBufferInfo(const Column column) {
+  switch (column) {
+  case OFFSETS:
+    return py::buffer_info(offsets.data(), offsets.size(), true);
+  case TIMESTAMPS:
+    return py::buffer_info(timestamps.data(), timestamps.size(), true);
+  case DIRECTIONS:
+    return py::buffer_info(directions.data(), directions.size(), true);
+  default:
+    return py::buffer_info(data.data(), data.size(), true);
+  }
+}
+
+std::string RawFrameBatch::toString() const {
+  std::ostringstream oss;
+  oss << "<104.RawFrameBatch frames=" << std::to_string(size())
+      << ", bytes=" << std::to_string(data.size()) << " at " << std::hex
+      << std::showbase << reinterpret_cast<std::uintptr_t>(this) << ">";
+  return oss.str();
+}
+
+RawFrameTap::~RawFrameTap() {
+  Module::MemoryBudget::remove(Module::MemoryBudget::Subsystem::RawFrames,
+                               readyBytes);
+}
+
+void RawFrameTap::configure(const std::size_t max_frames,
+                            const std::uint_fast32_t max_delay_ms) {
+  if (0 == max_frames) {
+    throw std::invalid_argument("max_frames must be at least 1");
+  }
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  maxFrames = max_frames;
+  maxDelay = std::chrono::milliseconds(max_delay_ms);
+}
+
+bool RawFrameTap::append(const unsigned char *msg, const std::size_t size,
+                         const bool sent) {
+  auto const timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  if (!current) {
+    current = std::make_shared<RawFrameBatch>(maxFrames);
+  }
+  current->add(msg, size, sent, timestamp_ns);
+  frames++;
+
+  if (current->size() >= maxFrames ||
+      std::chrono::steady_clock::now() - current->getCreatedAt() >= maxDelay) {
+    complete();
+  }
+
+  if (ready.empty() || scheduled) {
+    return false;
+  }
+  scheduled = true;
+  return true;
+}
+
+std::vector<std::shared_ptr<RawFrameBatch>>
+RawFrameTap::collect(const bool flush) {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  scheduled = false;
+
+  bool const expired =
+      current &&
+      std::chrono::steady_clock::now() - current->getCreatedAt() >= maxDelay;
+  if (current && (flush || expired)) {
+    complete();
+  }
+
+  std::vector<std::shared_ptr<RawFrameBatch>> result(ready.begin(),
+                                                     ready.end());
+  ready.clear();
+  Module::MemoryBudget::remove(Module::MemoryBudget::Subsystem::RawFrames,
+                               readyBytes);
+  readyBytes = 0;
+  return result;
+}
+
+void RawFrameTap::complete() {
+  using Module::MemoryBudget;
+
+  auto batch = std::move(current);
+  current = nullptr;
+  batches++;
+
+  if (MemoryBudget::getStage() >= MemoryBudget::Stage::RefuseHistory) {
+    droppedFrames += batch->size();
+    MemoryBudget::recordShed(MemoryBudget::Stage::RefuseHistory);
+    return;
+  }
+
+  if (ready.size() >= RAW_FRAME_TAP_MAX_PENDING) {
+    auto const footprint = ready.front()->getFootprint();
+    droppedFrames += ready.front()->size();
+    readyBytes -= footprint;
+    MemoryBudget::remove(MemoryBudget::Subsystem::RawFrames, footprint);
+    ready.pop_front();
+  }
+  auto const footprint = batch->getFootprint();
+  readyBytes += footprint;
+  MemoryBudget::add(MemoryBudget::Subsystem::RawFrames, footprint);
+  ready.push_back(std::move(batch));
+}
+
+py::dict RawFrameTap::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::dict result;
+  result["frames"] = frames;
+  result["batches"] = batches;
+  result["pending_batches"] = ready.size();
+  result["pending_bytes"] = readyBytes;
+  result["dropped_frames"] = droppedFrames;
+  return result;
+}
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @file RawFrameTap.h
+ * @brief collect raw frames natively and deliver them in batches
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_RAWFRAMETAP_H
+#define C104_REMOTE_RAWFRAMETAP_H
+
+#include <deque>
+
+#include "module/GilAwareMutex.h"
+#include "module/MemoryBudget.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief maximum number of undelivered batches, the oldest batch is dropped
+/// if a callback cannot keep up
+constexpr std::size_t RAW_FRAME_TAP_MAX_PENDING = 64;
+
+/**
+ * @brief immutable batch of raw frames in contiguous buffers
+ *
+ * Frame i is stored in data[offsets[i]:offsets[i + 1]], it was received or
+ * sent at timestamps[i] (nanoseconds since epoch), directions[i] is 1 for sent
+ * and 0 for received frames.
+ */
+class RawFrameBatch {
+public:
+  enum Column { DATA, OFFSETS, TIMESTAMPS, DIRECTIONS };
+
+  /**
+   * @param capacity expected number of frames
+   */
+  explicit RawFrameBatch(std::size_t capacity);
+
+  /**
+   * @brief copy a frame into the batch
+   */
+  void add(const unsigned char *msg, std::size_t size, bool sent,
+           std::int64_t timestamp_ns);
+
+  /**
+   * @brief Getter for the number of frames
+   */
+  std::size_t size() const { return timestamps.size(); }
+
+  /**
+   * @brief Getter for the allocated memory of all columns in bytes
+   */
+  std::size_t getFootprint() const;
+
+  /**
+   * @brief Getter for the creation time of the batch
+   */
+  std::chrono::steady_clock::time_point getCreatedAt() const {
+    return createdAt;
+  }
+
+  /**
+   * @brief Get a copy of a single frame
+   * @throws std::out_of_range if index is invalid
+   */
+  py::bytes getFrame(std::size_t index) const;
+
+  /**
+   * @brief Describe a column for the python buffer protocol, the memory is
+   * owned by this batch
+   */
+  py::buffer_info getBufferInfo(Column column);
+
+  std::string toString() const;
+
+private:
+  const std::chrono::steady_clock::time_point createdAt{
+      std::chrono::steady_clock::now()};
+
+  std::vector<std::uint8_t> data{};
+  std::vector<std::uint32_t> offsets{0};
+  std::vector<std::int64_t> timestamps{};
+  std::vector<std::uint8_t> directions{};
+};
+
+/**
+ * @brief column of a batch that exports its memory via the python buffer
+ * protocol and keeps the batch alive
+ */
+struct RawFrameColumn {
+  std::shared_ptr<RawFrameBatch> batch;
+  RawFrameBatch::Column column;
+};
+
+/**
+ * @brief accumulates raw frames without the GIL and hands them over as
+ * batches after a number of frames or a delay
+ *
+ * Complete batches are accounted in the memory budget until they are
+ * collected, new batches are refused if the budget is exhausted.
+ */
+class RawFrameTap {
+public:
+  RawFrameTap() = default;
+
+  ~RawFrameTap();
+
+  RawFrameTap(const RawFrameTap &) = delete;
+  RawFrameTap &operator=(const RawFrameTap &) = delete;
+
+  /**
+   * @brief Setter for the batch limits
+   * @param maxFrames frames per batch
+   * @param maxDelay_ms maximum age of the oldest frame in a batch
+   * @throws std::invalid_argument if maxFrames is 0
+   */
+  void configure(std::size_t maxFrames, std::uint_fast32_t maxDelay_ms);
+
+  /**
+   * @brief Add a frame to the current batch
+   * @return true if a batch is ready and no delivery is scheduled yet
+   */
+  bool append(const unsigned char *msg, std::size_t size, bool sent);
+
+  /**
+   * @brief Take all ready batches and the current batch, if it exceeded the
+   * delay, and allow scheduling of the next delivery
+   * @param flush also take the current batch regardless of its age
+   */
+  std::vector<std::shared_ptr<RawFrameBatch>> collect(bool flush = false);
+
+  /**
+   * @brief Getter for statistics as python dictionary
+   * @return dict with frames, batches, pending_batches, pending_bytes and
+   * dropped_frames
+   */
+  py::dict toDict() const;
+
+private:
+  /**
+   * @brief queue the current batch for delivery or refuse it if the memory
+   * budget is exhausted, the lock must be held
+   */
+  void complete();
+
+  /// @brief MUTEX Lock to access batches and statistics
+  mutable Module::GilAwareMutex access_mutex{"RawFrameTap::access_mutex"};
+
+  std::size_t maxFrames{1000};
+
+  std::chrono::milliseconds maxDelay{100};
+
+  /// @brief batch that is currently filled
+  std::shared_ptr<RawFrameBatch> current{nullptr};
+
+  /// @brief complete batches waiting for delivery
+  std::deque<std::shared_ptr<RawFrameBatch>> ready{};
+
+  /// @brief accounted memory of ready batches
+  std::size_t readyBytes{0};
+
+  /// @brief a delivery task is scheduled
+  bool scheduled{false};
+
+  std::uint_fast64_t frames{0};
+  std::uint_fast64_t batches{0};
+  std::uint_fast64_t droppedFrames{0};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_RAWFRAMETAP_H
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file RoundTripMonitor.cpp
+ * @brief round trip time statistics of a connection
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "RoundTripMonitor.h"
+
+using namespace Remote;
+
+// smoothing factors as used for TCP SRTT (RFC 6298) and a long term average
+constexpr double EMA_FAST_ALPHA = 1.0 / 8;
+constexpr double EMA_SLOW_ALPHA = 1.0 / 64;
+
+void RoundTripMonitor::setThreshold_ms(std::uint_fast32_t value) {
+  threshold_ms.store(value);
+  if (0 == value) {
+    exceeded.store(false);
+  }
+}
+
+std::uint_fast32_t RoundTripMonitor::getThreshold_ms() const {
+  return threshold_ms.load();
+}
+
+bool RoundTripMonitor::record(std::chrono::steady_clock::duration rtt) {
+  double const sample_ms =
+      std::chrono::duration<double, std::milli>(rtt).count();
+  double average_ms;
+
+  {
+    std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+    if (0 == count) {
+      min_ms = max_ms = emaFast_ms = emaSlow_ms = sample_ms;
+    } else {
+      min_ms = std::min(min_ms, sample_ms);
+      max_ms = std::max(max_ms, sample_ms);
+      emaFast_ms += EMA_FAST_ALPHA * (sample_ms - emaFast_ms);
+      emaSlow_ms += EMA_SLOW_ALPHA * (sample_ms - emaSlow_ms);
+    }
+    last_ms = sample_ms;
+    count++;
+
+    std::size_t bucket = 0;
+    while (bucket < ROUND_TRIP_HISTOGRAM_BOUNDS_MS.size() &&
+           sample_ms > ROUND_TRIP_HISTOGRAM_BOUNDS_MS[bucket]) {
+      bucket++;
+    }
+    histogram[bucket]++;
+
+    average_ms = emaFast_ms;
+  }
+
+  std::uint_fast32_t const threshold = threshold_ms.load();
+  if (0 == threshold) {
+    return false;
+  }
+  bool const now_exceeded = average_ms > threshold;
+  return exceeded.exchange(now_exceeded) != now_exceeded;
+}
+
+void RoundTripMonitor::recordLost() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  lost++;
+}
+
+void RoundTripMonitor::reset() {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  count = 0;
+  lost = 0;
+  last_ms = min_ms = max_ms = emaFast_ms = emaSlow_ms = 0;
+  histogram.fill(0);
+  exceeded.store(false);
+}
+
+bool RoundTripMonitor::isExceeded() const { return exceeded.load(); }
+
+double RoundTripMonitor::getAverage_ms() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+  return emaFast_ms;
+}
+
+py::dict RoundTripMonitor::toDict() const {
+  std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
+
+  py::list bounds;
+  for (auto bound : ROUND_TRIP_HISTOGRAM_BOUNDS_MS) {
+    bounds.append(bound);
+  }
+  py::list buckets;
+  for (auto bucket : histogram) {
+    buckets.append(bucket);
+  }
+
+  py::dict result;
+  result["count"] = count;
+  result["lost"] = lost;
+  result["last_ms"] = last_ms;
+  result["min_ms"] = min_ms;
+  result["max_ms"] = max_ms;
+  result["ema_fast_ms"] = emaFast_ms;
+  result["ema_slow_ms"] = emaSlow_ms;
+  result["histogram_bounds_ms"] = bounds;
+  result["histogram"] = buckets;
+  return result;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file RoundTripMonitor.h
+ * @brief round trip time statistics of a connection
+ *
+ * @package iec104-python
+ * @namespace Remote
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_ROUNDTRIPMONITOR_H
+#define C104_REMOTE_ROUNDTRIPMONITOR_H
+
+#include "module/GilAwareMutex.h"
+#include "types.h"
+
+namespace Remote {
+
+/// @brief upper bounds of the round trip time histogram buckets in
+/// milliseconds, an additional bucket counts all larger samples
+constexpr std::array<std::uint_fast32_t, 12> ROUND_TRIP_HISTOGRAM_BOUNDS_MS{
+    1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000};
+
+/**
+ * @brief collects round trip time samples of a connection in a histogram and
+ * two exponential moving averages and detects threshold crossings
+ */
+class RoundTripMonitor {
+public:
+  /**
+   * @brief Setter for the threshold of the fast moving average
+   * @param threshold_ms threshold in milliseconds, 0 = disabled
+   */
+  void setThreshold_ms(std::uint_fast32_t threshold_ms);
+
+  /**
+   * @brief Getter for the threshold of the fast moving average
+   * @return threshold in milliseconds, 0 = disabled
+   */
+  std::uint_fast32_t getThreshold_ms() const;
+
+  /**
+   * @brief add a measured round trip time
+   * @param rtt measured duration between probe and response
+   * @return if the threshold state changed with this sample
+   */
+  bool record(std::chrono::steady_clock::duration rtt);
+
+  /**
+   * @brief count a probe that was not answered in time
+   */
+  void recordLost();
+
+  /**
+   * @brief drop all samples
+   */
+  void reset();
+
+  /**
+   * @brief test if the fast moving average is above the threshold
+   */
+  bool isExceeded() const;
+
+  /**
+   * @brief Getter for the fast exponential moving average
+   * @return round trip time in milliseconds
+   */
+  double getAverage_ms() const;
+
+  /**
+   * @brief Getter for all statistics as python dictionary
+   * @return dict with count, lost, last_ms, min_ms, max_ms, ema_fast_ms,
+   * ema_slow_ms, histogram_bounds_ms and histogram
+   */
+  py::dict toDict() const;
+
+private:
+  /// @brief MUTEX Lock to access statistics
+  mutable Module::GilAwareMutex access_mutex{
+      "RoundTripMonitor::access_mutex"};
+
+  /// @brief threshold in milliseconds, 0 = disabled
+  std::atomic_uint_fast32_t threshold_ms{0};
+
+  /// @brief state of fast moving average compared to threshold
+  std::atomic_bool exceeded{false};
+
+  /// @brief number of answered probes
+  std::uint_fast64_t count{0};
+
+  /// @brief number of probes without response
+  std::uint_fast64_t lost{0};
+
+  double last_ms{0};
+  double min_ms{0};
+  double max_ms{0};
+
+  /// @brief moving average reacting on short term changes
+  double emaFast_ms{0};
+
+  /// @brief moving average representing the long term link quality
+  double emaSlow_ms{0};
+
+  std::array<std::uint_fast64_t, ROUND_TRIP_HISTOGRAM_BOUNDS_MS.size() + 1>
+      histogram{};
+};
+
+} // namespace Remote
+
+#endif // C104_REMOTE_ROUNDTRIPMONITOR_H
@@ -0,0 +1,218 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandTemplate.cpp
+ * @brief pre-encoded command frame that is patched per transmission
+ *
+ * @package iec104-python
+ * @namespace Remote::Message
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <cstring>
+
+#include "CommandTemplate.h"
+#include "PointCommand.h"
+#include "object/Information.h"
+#include "object/Station.h"
+
+using namespace Remote::Message;
+
+namespace {
+
+void writeUInt16(std::uint8_t *target, const std::uint16_t value) {
+  target[0] = static_cast<std::uint8_t>(value & 0xff);
+  target[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void writeUInt32(std::uint8_t *target, const std::uint32_t value) {
+  target[0] = static_cast<std::uint8_t>(value & 0xff);
+  target[1] = static_cast<std::uint8_t>((value >> 8) & 0xff);
+  target[2] = static_cast<std::uint8_t>((value >> 16) & 0xff);
+  target[3] = static_cast<std::uint8_t>(value >> 24);
+}
+
+/// @brief command qualifier octet (SCO, DCO, RCO) as encoded by lib60870
+std::uint8_t commandOctet(const CS101_QualifierOfCommand qualifier,
+                          const std::uint8_t state, const std::uint8_t se) {
+  return static_cast<std::uint8_t>(
+      ((static_cast<std::uint8_t>(qualifier) & 0x1f) << 2) | state | se);
+}
+
+} // namespace
+
+CommandTemplate::CommandTemplate(std::shared_ptr<Object::DataPoint> point,
+                                 CS101_AppLayerParameters parameters)
+    : type(point->getType()) {
+  auto station = point->getStation();
+  if (!station) {
+    throw std::invalid_argument("Station reference deleted");
+  }
+  auto const ca = station->getCommonAddress();
+  cmdId = std::to_string(ca) + "-" + TypeID_toString(type) + "-" +
+          std::to_string(point->getInformationObjectAddress());
+
+  // let lib60870 encode the frame once, throws for unsupported types
+  auto const command = PointCommand::create(point, false);
+  asdu = CS101_ASDU_create(parameters, false, CS101_COT_ACTIVATION,
+                           parameters->originatorAddress, ca, false, false);
+  if (!asdu ||
+      !CS101_ASDU_addInformationObject(asdu, command->getInformationObject())) {
+    if (asdu) {
+      CS101_ASDU_destroy(asdu);
+    }
+    throw std::invalid_argument("Cannot encode command template for " + cmdId);
+  }
+  int const payloadSize = CS101_ASDU_getPayloadSize(asdu);
+  std::uint8_t *const payload = CS101_ASDU_getPayload(asdu);
+  element = payload + parameters->sizeOfIOA;
+
+  // use in-place encoding only if it reproduces the element layout of
+  // lib60870
+  std::vector<std::uint8_t> const reference(element, payload + payloadSize);
+  patchable = encode(*point->getInfo(), false) &&
+              std::equal(reference.begin(), reference.end(), element);
+  std::copy(reference.begin(), reference.end(), element);
+
+  DEBUG_PRINT(Debug::Message, "CommandTemplate] " + cmdId + " | patchable " +
+                                  std::to_string(patchable));
+}
+
+CommandTemplate::~CommandTemplate() {
+  if (asdu) {
+    CS101_ASDU_destroy(asdu);
+  }
+}
+
+CS101_ASDU CommandTemplate::prepare(const Object::Information &info,
+                                    const CS101_CauseOfTransmission cause,
+                                    const bool select) {
+  if (!patchable || !encode(info, select)) {
+    return nullptr;
+  }
+  CS101_ASDU_setCOT(asdu, cause);
+  return asdu;
+}
+
+bool CommandTemplate::encode(const Object::Information &info,
+                             const bool select) {
+  std::uint8_t const se = select ? 0x80 : 0x00;
+  std::size_t timeOffset = 0;
+
+  switch (type) {
+  case C_SC_NA_1:
+  case C_SC_TA_1: {
+    auto i = dynamic_cast<const Object::SingleCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    element[0] = commandOctet(i->getQualifier(), i->isOn() ? 0x01 : 0x00, se);
+    timeOffset = 1;
+  } break;
+
+  case C_DC_NA_1:
+  case C_DC_TA_1: {
+    auto i = dynamic_cast<const Object::DoubleCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    element[0] = commandOctet(i->getQualifier(),
+                              static_cast<std::uint8_t>(i->getState()) & 0x03,
+                              se);
+    timeOffset = 1;
+  } break;
+
+  case C_RC_NA_1:
+  case C_RC_TA_1: {
+    auto i = dynamic_cast<const Object::StepCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    element[0] = commandOctet(i->getQualifier(),
+                              static_cast<std::uint8_t>(i->getStep()) & 0x03,
+                              se);
+    timeOffset = 1;
+  } break;
+
+  case C_BO_NA_1:
+  case C_BO_TA_1: {
+    auto i = dynamic_cast<const Object::BinaryCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    writeUInt32(element, i->getBlob().get());
+    timeOffset = 4;
+  } break;
+
+  case C_SE_NA_1:
+  case C_SE_TA_1: {
+    auto i = dynamic_cast<const Object::NormalizedCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    // same rounding as lib60870, -1.0 is encoded as -32768
+    auto const scaled =
+        static_cast<int>((i->getTarget().get() * 32767.5) - 0.5);
+    writeUInt16(element, static_cast<std::uint16_t>(scaled));
+    element[2] = static_cast<std::uint8_t>(i->getQualifier().get()) | se;
+    timeOffset = 3;
+  } break;
+
+  case C_SE_NB_1:
+  case C_SE_TB_1: {
+    auto i = dynamic_cast<const Object::ScaledCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    writeUInt16(element, static_cast<std::uint16_t>(i->getTarget().get()));
+    element[2] = static_cast<std::uint8_t>(i->getQualifier().get()) | se;
+    timeOffset = 3;
+  } break;
+
+  case C_SE_NC_1:
+  case C_SE_TC_1: {
+    auto i = dynamic_cast<const Object::ShortCmd *>(&info);
+    if (!i) {
+      return false;
+    }
+    float const target = i->getTarget();
+    std::uint32_t bits;
+    std::memcpy(&bits, &target, sizeof(bits));
+    writeUInt32(element, bits);
+    element[4] = static_cast<std::uint8_t>(i->getQualifier().get()) | se;
+    timeOffset = 5;
+  } break;
+
+  default:
+    return false;
+  }
+
+  if (type >= C_SC_TA_1) {
+    sCP56Time2a time{};
+    from_time_point(&time,
+                    info.getRecordedAt().value_or(info.getProcessedAt()));
+    std::copy(time.encodedValue, time.encodedValue + sizeof(time.encodedValue),
+              element + timeOffset);
+  }
+  return true;
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file CommandTemplate.h
+ * @brief pre-encoded command frame that is patched per transmission
+ *
+ * @package iec104-python
+ * @namespace Remote::Message
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_MESSAGE_COMMANDTEMPLATE_H
+#define C104_REMOTE_MESSAGE_COMMANDTEMPLATE_H
+
+#include "object/DataPoint.h"
+#include "types.h"
+
+namespace Remote {
+namespace Message {
+
+/**
+ * @brief Command ASDU of a single control point that is encoded once
+ *
+ * Header, common address, information object address and qualifiers are
+ * encoded via lib60870 when the template is created. Each transmission only
+ * rewrites the cause of transmission, the element bytes and the timestamp in
+ * place. The template is not thread-safe, transmissions have to be serialized
+ * by the owning connection.
+ */
+class CommandTemplate {
+public:
+  // noncopyable
+  CommandTemplate(const CommandTemplate &) = delete;
+  CommandTemplate &operator=(const CommandTemplate &) = delete;
+
+  /**
+   * @brief Create a template from the current information of a control point
+   * @param point client-sided control point
+   * @param parameters application layer parameters of the connection
+   * @throws std::invalid_argument if point type is not a supported command
+   */
+  [[nodiscard]] static std::shared_ptr<CommandTemplate>
+  create(std::shared_ptr<Object::DataPoint> point,
+         CS101_AppLayerParameters parameters) {
+    // Not using std::make_shared because the constructor is private.
+    return std::shared_ptr<CommandTemplate>(
+        new CommandTemplate(std::move(point), parameters));
+  }
+
+  /**
+   * @brief free the encoded ASDU
+   */
+  ~CommandTemplate();
+
+  IEC60870_5_TypeID getType() const { return type; }
+
+  /**
+   * @brief Test if the element encoding of this type can be patched in place
+   * @return false if transmissions must be encoded from scratch
+   */
+  bool isPatchable() const { return patchable; }
+
+  /**
+   * @brief Getter for the identifier used to match command responses
+   */
+  const std::string &getCommandId() const { return cmdId; }
+
+  /**
+   * @brief Write information, cause of transmission and select flag into the
+   * encoded frame
+   * @param info command information of the point
+   * @param cause cause of transmission
+   * @param select select flag for select-and-execute command mode
+   * @return ASDU ready to be sent or nullptr if info does not match the type
+   */
+  CS101_ASDU prepare(const Object::Information &info,
+                     CS101_CauseOfTransmission cause, bool select);
+
+private:
+  CommandTemplate(std::shared_ptr<Object::DataPoint> point,
+                  CS101_AppLayerParameters parameters);
+
+  /**
+   * @brief encode element and timestamp of info into the payload
+   * @return false if info does not match the template type
+   */
+  bool encode(const Object::Information &info, bool select);
+
+  /// @brief IEC60870-5 TypeID of the command
+  const IEC60870_5_TypeID type;
+
+  /// @brief encoded ASDU, owned by this template
+  CS101_ASDU asdu{nullptr};
+
+  /// @brief position of the element behind the information object address
+  std::uint8_t *element{nullptr};
+
+  /// @brief patching reproduces the encoding of lib60870
+  bool patchable{false};
+
+  /// @brief identifier of the command in the awaiting response map
+  std::string cmdId{};
+};
+
+} // namespace Message
+} // namespace Remote
+
+#endif // C104_REMOTE_MESSAGE_COMMANDTEMPLATE_H
@@ -47,8 +47,12 @@ IncomingMessage::IncomingMessage(CS101_ASDU packet,
     asdu = CS101_ASDU_clone(packet, nullptr);
   }
   if (asdu) {
-    extractMetaData();
-    first();
+    rejectCause = extractMetaData();
+    if (NO_ERROR_CAUSE == rejectCause) {
+      first();
+    }
+  } else {
+    rejectCause = INVALID_STRUCTURE;
   }
   DEBUG_PRINT(Debug::Message, "Created (incoming)");
 }
@@ -63,7 +67,7 @@ IncomingMessage::~IncomingMessage() {
   DEBUG_PRINT(Debug::Message, "Removed (incoming)");
 }
 
-void IncomingMessage::extractMetaData() {
+UnexpectedMessageCause IncomingMessage::extractMetaData() {
   {
     std::lock_guard<Module::GilAwareMutex> const lock(access_mutex);
 
@@ -98,39 +102,32 @@ void IncomingMessage::extractMetaData() {
   case M_EP_TC_1:
   case C_TS_NA_1:
   case C_CD_NA_1: {
-    throw std::invalid_argument("CP24Time based messages not supported by norm "
-                                "IEC60870-5-104 (101 only)!");
+    // CP24Time based messages not supported by norm IEC60870-5-104 (101 only)
+    return INVALID_TYPE_ID;
   }
   }
 
   if (type >= C_SC_NA_1 && type < F_DR_TA_1) {
     // REJECT sequence in non-sequence context
-    if (sequence) {
-      throw std::invalid_argument("IncomingMessage with TypeID " +
-                                  std::string(TypeID_toString(type)) +
-                                  " must not be marked as sequence.");
-    }
     // REJECT multiple objects in non-list context
-    if (numberOfObject > 1) {
-      throw std::invalid_argument(
-          "IncomingMessage with TypeID " + std::string(TypeID_toString(type)) +
-          " must not contain more than one information object.");
+    if (sequence || numberOfObject > 1) {
+      return INVALID_STRUCTURE;
     }
   }
 
   // REJECT global common address in non-global context
   if (type < C_IC_NA_1 && type > C_RP_NA_1 &&
       commonAddress == IEC60870_GLOBAL_COMMON_ADDRESS) {
-    throw std::invalid_argument(
-        "IncomingMessage with TypeID " + std::string(TypeID_toString(type)) +
-        " must use a single common address and not the global common address.");
+    return UNKNOWN_CA;
   }
 
   // REJECT file transfer @todo handle file transfer
   if (type >= F_FR_NA_1) {
-    throw std::invalid_argument(
-        "lib60870-c does not support file transfer messages.");
+    // lib60870-c does not support file transfer messages
+    return UNKNOWN_TYPE_ID;
   }
+
+  return NO_ERROR_CAUSE;
 }
 
 CS101_ASDU IncomingMessage::getAsdu() const { return asdu; }
@@ -203,6 +200,14 @@ std::string IncomingMessage::getRawMessageString() const {
   return formatted;
 }
 
+bool IncomingMessage::isValid() const {
+  return NO_ERROR_CAUSE == rejectCause;
+}
+
+UnexpectedMessageCause IncomingMessage::getRejectCause() const {
+  return rejectCause;
+}
+
 std::uint_fast8_t IncomingMessage::getNumberOfObject() const {
   return numberOfObject;
 }
@@ -662,8 +667,8 @@ bool IncomingMessage::isValidCauseOfTransmission() const {
   case M_EP_TC_1:
   case C_TS_NA_1:
   case C_CD_NA_1: {
-    throw std::invalid_argument(
-        "[104.IncomingMessage] type not supported by norm IEC60870-5-104!");
+    // type not supported by norm IEC60870-5-104
+    result = false;
   } break;
   case M_SP_NA_1:
   case M_DP_NA_1:
@@ -50,8 +50,7 @@ public:
    * CS101_ASDU packet via object oriented methods
    * @param packet internal incoming message
    * @param app_layer_parameters connection parameters
-   * @throws std::invalid_argument if information value is incompatible with
-   * information type
+   * @note malformed packets do not throw, test isValid() before use
    */
   [[nodiscard]] static std::shared_ptr<IncomingMessage>
   create(CS101_ASDU packet, CS101_AppLayerParameters app_layer_parameters) {
@@ -71,6 +70,18 @@ public:
    */
   CS101_ASDU getAsdu() const;
 
+  /**
+   * @brief test if the packet passed meta data validation
+   * @return if message can be processed
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Getter for the reason this packet was rejected by validation
+   * @return NO_ERROR_CAUSE if message is valid
+   */
+  UnexpectedMessageCause getRejectCause() const;
+
   /**
    * @brief Getter for raw bytes
    * @return bytes
@@ -104,8 +115,6 @@ public:
   /**
    * @brief test if cause of transmission is compatible with information type
    * @return if cause is valid
-   * @throws std::invalid_argument if feature is not yet implemented for that
-   * information type
    */
   bool isValidCauseOfTransmission() const;
 
@@ -127,8 +136,6 @@ private:
    * CS101_ASDU packet via object oriented methods
    * @param packet internal incoming message
    * @param app_layer_parameters connection parameters
-   * @throws std::invalid_argument if information value is incompatible with
-   * information type
    */
   explicit IncomingMessage(CS101_ASDU packet,
                            CS101_AppLayerParameters app_layer_parameters);
@@ -155,16 +162,22 @@ private:
   /// @brief number of available information objects inside this message
   std::atomic_uint_fast8_t numberOfObject{0};
 
+  /// @brief result of meta data validation, NO_ERROR_CAUSE if valid
+  std::atomic<UnexpectedMessageCause> rejectCause{NO_ERROR_CAUSE};
+
   /**
-   * @brief extract meta data from this message: commonAddress,
+   * @brief extract and validate meta data from this message: commonAddress,
    * originatorAddress, message identifier and mode, ...
-   * @throws std::invalid_argument if information value is incompatible with
-   * information type
+   * @return NO_ERROR_CAUSE or the reason why this message must be rejected
    */
-  void extractMetaData();
+  UnexpectedMessageCause extractMetaData();
 
   /**
    * @brief extract values of an information object at the current position
+   *
+   * The information is constructed from the native value and quality types
+   * of its class (see Object::InfoTraits), the InfoValue variant is not
+   * involved in decoding.
    */
   void extractInformation();
 };
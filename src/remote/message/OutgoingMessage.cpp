@@ -40,7 +40,8 @@
 using namespace Remote::Message;
 
 OutgoingMessage::OutgoingMessage(
-    const std::shared_ptr<Object::DataPoint> &point)
+    const std::shared_ptr<Object::DataPoint> &point,
+    std::shared_ptr<Object::Information> point_info)
     : IMessageInterface() {
   if (!point)
     throw std::invalid_argument("Cannot create OutgoingMessage without point");
@@ -48,7 +49,7 @@ OutgoingMessage::OutgoingMessage(
   io = nullptr;
 
   type = point->getType();
-  info = point->getInfo();
+  info = point_info ? std::move(point_info) : point->getInfo();
 
   causeOfTransmission = CS101_COT_UNKNOWN_COT;
 
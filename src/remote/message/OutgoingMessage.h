@@ -70,8 +70,12 @@ protected:
    * to a given DataPoint
    * @param point point that defines the receiver and related information of the
    * outgoing message
+   * @param point_info information to send instead of the current information of
+   * the point
    */
-  explicit OutgoingMessage(const std::shared_ptr<Object::DataPoint> &point);
+  explicit OutgoingMessage(
+      const std::shared_ptr<Object::DataPoint> &point,
+      std::shared_ptr<Object::Information> point_info = nullptr);
 };
 
 } // namespace Message
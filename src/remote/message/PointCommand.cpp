@@ -43,114 +43,114 @@ PointCommand::PointCommand(std::shared_ptr<Object::DataPoint> point,
   switch (type) {
 
   case C_SC_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::SingleCmd>(info);
+    auto *i = Object::infoCast<C_SC_NA_1>(info.get());
     io = (InformationObject)SingleCommand_create(
-        nullptr, informationObjectAddress, i->isOn(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()));
   } break;
 
   case C_SC_TA_1: {
-    auto i = std::dynamic_pointer_cast<Object::SingleCmd>(info);
+    auto *i = Object::infoCast<C_SC_TA_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)SingleCommandWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->isOn(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()), &time);
   } break;
 
   case C_DC_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::DoubleCmd>(info);
+    auto *i = Object::infoCast<C_DC_NA_1>(info.get());
     io = (InformationObject)DoubleCommand_create(
-        nullptr, informationObjectAddress, i->getState(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()));
   } break;
 
   case C_DC_TA_1: {
-    auto i = std::dynamic_pointer_cast<Object::DoubleCmd>(info);
+    auto *i = Object::infoCast<C_DC_TA_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)DoubleCommandWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getState(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()), &time);
   } break;
 
   case C_RC_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::StepCmd>(info);
+    auto *i = Object::infoCast<C_RC_NA_1>(info.get());
     io = (InformationObject)StepCommand_create(
-        nullptr, informationObjectAddress, i->getStep(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()));
   } break;
 
   case C_RC_TA_1: {
-    auto i = std::dynamic_pointer_cast<Object::StepCmd>(info);
+    auto *i = Object::infoCast<C_RC_TA_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)StepCommandWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getStep(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         static_cast<uint8_t>(i->getQualifier()), &time);
   } break;
 
   case C_BO_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryCmd>(info);
+    auto *i = Object::infoCast<C_BO_NA_1>(info.get());
     io = (InformationObject)Bitstring32Command_create(
-        nullptr, informationObjectAddress, i->getBlob().get());
+        nullptr, informationObjectAddress, i->getNativeValue());
   } break;
 
   case C_BO_TA_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryCmd>(info);
+    auto *i = Object::infoCast<C_BO_TA_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)Bitstring32CommandWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getBlob().get(), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(), &time);
   } break;
 
   case C_SE_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::NormalizedCmd>(info);
+    auto *i = Object::infoCast<C_SE_NA_1>(info.get());
     io = (InformationObject)SetpointCommandNormalized_create(
-        nullptr, informationObjectAddress, i->getTarget().get(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get());
   } break;
 
   case C_SE_TA_1: {
-    auto i = std::dynamic_pointer_cast<Object::NormalizedCmd>(info);
+    auto *i = Object::infoCast<C_SE_TA_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)SetpointCommandNormalizedWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getTarget().get(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get(), &time);
   } break;
 
   case C_SE_NB_1: {
-    auto i = std::dynamic_pointer_cast<Object::ScaledCmd>(info);
+    auto *i = Object::infoCast<C_SE_NB_1>(info.get());
     io = (InformationObject)SetpointCommandScaled_create(
-        nullptr, informationObjectAddress, i->getTarget().get(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get());
   } break;
 
   case C_SE_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::ScaledCmd>(info);
+    auto *i = Object::infoCast<C_SE_TB_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)SetpointCommandScaledWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getTarget().get(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get(), &time);
   } break;
 
     // float Setpoint Command (SHORT)
   case C_SE_NC_1: {
-    auto i = std::dynamic_pointer_cast<Object::ShortCmd>(info);
+    auto *i = Object::infoCast<C_SE_NC_1>(info.get());
     io = (InformationObject)SetpointCommandShort_create(
-        nullptr, informationObjectAddress, i->getTarget(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get());
   } break;
 
     // float Setpoint Command (SHORT) + Extended Time
   case C_SE_TC_1: {
-    auto i = std::dynamic_pointer_cast<Object::ShortCmd>(info);
+    auto *i = Object::infoCast<C_SE_TC_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)SetpointCommandShortWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getTarget(), select,
+        nullptr, informationObjectAddress, i->getNativeValue(), select,
         i->getQualifier().get(), &time);
   } break;
 
@@ -35,141 +35,142 @@
 
 using namespace Remote::Message;
 
-PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point)
-    : OutgoingMessage(point) {
+PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point,
+                           std::shared_ptr<Object::Information> point_info)
+    : OutgoingMessage(point, std::move(point_info)) {
   causeOfTransmission = CS101_COT_SPONTANEOUS;
 
   switch (type) {
 
   // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_SP_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::SingleInfo>(info);
+    auto *i = Object::infoCast<M_SP_NA_1>(info.get());
     io = (InformationObject)SinglePointInformation_create(
-        nullptr, informationObjectAddress, i->isOn(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_SP_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::SingleInfo>(info);
+    auto *i = Object::infoCast<M_SP_TB_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)SinglePointWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->isOn(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
     // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_DP_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::DoubleInfo>(info);
+    auto *i = Object::infoCast<M_DP_NA_1>(info.get());
     io = (InformationObject)DoublePointInformation_create(
-        nullptr, informationObjectAddress, i->getState(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_DP_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::DoubleInfo>(info);
+    auto *i = Object::infoCast<M_DP_TB_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)DoublePointWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getState(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
     // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_ST_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::StepInfo>(info);
+    auto *i = Object::infoCast<M_ST_NA_1>(info.get());
     io = (InformationObject)StepPositionInformation_create(
-        nullptr, informationObjectAddress, i->getPosition().get(),
+        nullptr, informationObjectAddress, i->getNativeValue(),
         i->isTransient(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 2,3,5,11,12,20-36
   case M_ST_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::StepInfo>(info);
+    auto *i = Object::infoCast<M_ST_TB_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)StepPositionWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getPosition().get(),
+        nullptr, informationObjectAddress, i->getNativeValue(),
         i->isTransient(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
   case M_BO_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryInfo>(info);
+    auto *i = Object::infoCast<M_BO_NA_1>(info.get());
     io = (InformationObject)BitString32_create(
-        nullptr, informationObjectAddress, i->getBlob().get());
+        nullptr, informationObjectAddress, i->getNativeValue());
   } break;
 
   case M_BO_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryInfo>(info);
+    auto *i = Object::infoCast<M_BO_TB_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)Bitstring32WithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getBlob().get(), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(), &time);
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::NormalizedInfo>(info);
+    auto *i = Object::infoCast<M_ME_NA_1>(info.get());
     io = (InformationObject)MeasuredValueNormalized_create(
-        nullptr, informationObjectAddress, i->getActual().get(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_TD_1: {
-    auto i = std::dynamic_pointer_cast<Object::NormalizedInfo>(info);
+    auto *i = Object::infoCast<M_ME_TD_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)MeasuredValueNormalizedWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getActual().get(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_NB_1: {
-    auto i = std::dynamic_pointer_cast<Object::ScaledInfo>(info);
+    auto *i = Object::infoCast<M_ME_NB_1>(info.get());
     io = (InformationObject)MeasuredValueScaled_create(
-        nullptr, informationObjectAddress, i->getActual().get(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_TE_1: {
-    auto i = std::dynamic_pointer_cast<Object::ScaledInfo>(info);
+    auto *i = Object::infoCast<M_ME_TE_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)MeasuredValueScaledWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getActual().get(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_NC_1: {
-    auto i = std::dynamic_pointer_cast<Object::ShortInfo>(info);
+    auto *i = Object::infoCast<M_ME_NC_1>(info.get());
     io = (InformationObject)MeasuredValueShort_create(
-        nullptr, informationObjectAddress, i->getActual(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // Valid cause of transmission: 1,2,3,5,20-36
   case M_ME_TF_1: {
-    auto i = std::dynamic_pointer_cast<Object::ShortInfo>(info);
+    auto *i = Object::infoCast<M_ME_TF_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     io = (InformationObject)MeasuredValueShortWithCP56Time2a_create(
-        nullptr, informationObjectAddress, i->getActual(),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &time);
+        nullptr, informationObjectAddress, i->getNativeValue(),
+        static_cast<uint8_t>(i->getNativeQuality()), &time);
   } break;
 
   case M_IT_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryCounterInfo>(info);
-    auto q = std::get<BinaryCounterQuality>(i->getQuality());
+    auto *i = Object::infoCast<M_IT_NA_1>(info.get());
+    auto q = i->getNativeQuality();
     BinaryCounterReading _value = BinaryCounterReading_create(
-        nullptr, i->getCounter(), i->getSequence().get(),
+        nullptr, i->getNativeValue(), i->getSequence().get(),
         ::test(q, BinaryCounterQuality::Carry),
         ::test(q, BinaryCounterQuality::Adjusted),
         ::test(q, BinaryCounterQuality::Invalid));
@@ -178,12 +179,12 @@ PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point)
   } break;
 
   case M_IT_TB_1: {
-    auto i = std::dynamic_pointer_cast<Object::BinaryCounterInfo>(info);
-    auto q = std::get<BinaryCounterQuality>(i->getQuality());
+    auto *i = Object::infoCast<M_IT_TB_1>(info.get());
+    auto q = i->getNativeQuality();
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     BinaryCounterReading _value = BinaryCounterReading_create(
-        nullptr, i->getCounter(), i->getSequence().get(),
+        nullptr, i->getNativeValue(), i->getSequence().get(),
         ::test(q, BinaryCounterQuality::Carry),
         ::test(q, BinaryCounterQuality::Adjusted),
         ::test(q, BinaryCounterQuality::Invalid));
@@ -192,24 +193,20 @@ PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point)
   } break;
 
   case M_EP_TD_1: {
-    auto i =
-        std::dynamic_pointer_cast<Object::ProtectionEquipmentEventInfo>(info);
+    auto *i = Object::infoCast<M_EP_TD_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     sCP16Time2a elapsed{};
     CP16Time2a_setEplapsedTimeInMs(&elapsed, i->getElapsed_ms().get());
     tSingleEvent event =
-        ((static_cast<uint8_t>(i->getState()) & 0b00000111) |
-         (static_cast<uint8_t>(std::get<Quality>(i->getQuality())) &
-          0b11111000));
+        ((static_cast<uint8_t>(i->getNativeValue()) & 0b00000111) |
+         (static_cast<uint8_t>(i->getNativeQuality()) & 0b11111000));
     io = (InformationObject)EventOfProtectionEquipmentWithCP56Time2a_create(
         nullptr, informationObjectAddress, &event, &elapsed, &time);
   } break;
 
   case M_EP_TE_1: {
-    auto i =
-        std::dynamic_pointer_cast<Object::ProtectionEquipmentStartEventsInfo>(
-            info);
+    auto *i = Object::infoCast<M_EP_TE_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     sCP16Time2a elapsed{};
@@ -217,30 +214,26 @@ PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point)
     io = (InformationObject)
         PackedStartEventsOfProtectionEquipmentWithCP56Time2a_create(
             nullptr, informationObjectAddress,
-            static_cast<uint8_t>(i->getEvents()),
-            static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &elapsed,
-            &time);
+            static_cast<uint8_t>(i->getNativeValue()),
+            static_cast<uint8_t>(i->getNativeQuality()), &elapsed, &time);
   } break;
 
   case M_EP_TF_1: {
-    auto i =
-        std::dynamic_pointer_cast<Object::ProtectionEquipmentOutputCircuitInfo>(
-            info);
+    auto *i = Object::infoCast<M_EP_TF_1>(info.get());
     sCP56Time2a time{};
     from_time_point(&time, i->getRecordedAt().value_or(i->getProcessedAt()));
     sCP16Time2a elapsed{};
     CP16Time2a_setEplapsedTimeInMs(&elapsed, i->getRelayOperating_ms().get());
     io = (InformationObject)PackedOutputCircuitInfoWithCP56Time2a_create(
         nullptr, informationObjectAddress,
-        static_cast<uint8_t>(i->getCircuits()),
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())), &elapsed,
-        &time);
+        static_cast<uint8_t>(i->getNativeValue()),
+        static_cast<uint8_t>(i->getNativeQuality()), &elapsed, &time);
   } break;
 
   case M_PS_NA_1: {
-    auto i = std::dynamic_pointer_cast<Object::StatusWithChangeDetection>(info);
+    auto *i = Object::infoCast<M_PS_NA_1>(info.get());
     sStatusAndStatusChangeDetection sscd{};
-    auto status = static_cast<uint16_t>(i->getStatus());
+    auto status = static_cast<uint16_t>(i->getNativeValue());
     auto changed = static_cast<uint16_t>(i->getChanged());
     sscd.encodedValue[0] = (status >> 0) & 0b11111111;
     sscd.encodedValue[1] = (status >> 8) & 0b11111111;
@@ -248,14 +241,14 @@ PointMessage::PointMessage(std::shared_ptr<Object::DataPoint> point)
     sscd.encodedValue[3] = (changed >> 8) & 0b11111111;
     io = (InformationObject)PackedSinglePointWithSCD_create(
         nullptr, informationObjectAddress, &sscd,
-        static_cast<uint8_t>(std::get<Quality>(i->getQuality())));
+        static_cast<uint8_t>(i->getNativeQuality()));
   } break;
 
     // float Measurement Value (NORMALIZED) - Quality
   case M_ME_ND_1: {
-    auto i = std::dynamic_pointer_cast<Object::NormalizedInfo>(info);
+    auto *i = Object::infoCast<M_ME_ND_1>(info.get());
     io = (InformationObject)MeasuredValueNormalizedWithoutQuality_create(
-        nullptr, informationObjectAddress, i->getActual().get());
+        nullptr, informationObjectAddress, i->getNativeValue());
   } break;
 
     // End of initialization
@@ -45,9 +45,11 @@ namespace Message {
 class PointMessage : public OutgoingMessage {
 public:
   [[nodiscard]] static std::shared_ptr<PointMessage>
-  create(std::shared_ptr<Object::DataPoint> point) {
+  create(std::shared_ptr<Object::DataPoint> point,
+         std::shared_ptr<Object::Information> point_info = nullptr) {
     // Not using std::make_shared because the constructor is private.
-    return std::shared_ptr<PointMessage>(new PointMessage(std::move(point)));
+    return std::shared_ptr<PointMessage>(
+        new PointMessage(std::move(point), std::move(point_info)));
   }
 
   /**
@@ -60,8 +62,11 @@ private:
    * @brief Create a message for a certain DataPoint, type of message is
    * identified via DataPoint
    * @param point point who's value should be reported to remote client
+   * @param point_info snapshot of the point information to report instead of
+   * the current information, must match the point type
    */
-  explicit PointMessage(std::shared_ptr<Object::DataPoint> point);
+  explicit PointMessage(std::shared_ptr<Object::DataPoint> point,
+                        std::shared_ptr<Object::Information> point_info);
 };
 } // namespace Message
 
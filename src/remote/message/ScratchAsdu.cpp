@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file ScratchAsdu.cpp
+ * @brief reusable thread-local ASDU buffers for outgoing messages
+ *
+ * @package iec104-python
+ * @namespace Remote::Message
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include "ScratchAsdu.h"
+
+using namespace Remote::Message;
+
+namespace {
+
+/// @brief stack of static ASDU buffers of one thread
+struct ScratchPool {
+  std::vector<std::unique_ptr<sCS101_StaticASDU>> buffers{};
+  std::size_t used{0};
+};
+
+thread_local ScratchPool pool{};
+
+std::atomic_uint_fast64_t acquiredCount{0};
+std::atomic_uint_fast64_t allocatedCount{0};
+
+} // namespace
+
+ScratchAsdu::ScratchAsdu(CS101_AppLayerParameters parameters,
+                         const bool isSequence,
+                         const CS101_CauseOfTransmission cot, const int oa,
+                         const int ca, const bool isTest,
+                         const bool isNegative)
+    : parameters(parameters), isSequence(isSequence), cot(cot), oa(oa),
+      ca(ca), isTest(isTest), isNegative(isNegative) {
+  if (pool.used == pool.buffers.size()) {
+    pool.buffers.push_back(std::make_unique<sCS101_StaticASDU>());
+    allocatedCount++;
+  }
+  buffer = pool.buffers[pool.used++].get();
+  acquiredCount++;
+  reset();
+}
+
+ScratchAsdu::~ScratchAsdu() { pool.used--; }
+
+void ScratchAsdu::reset() {
+  asdu = CS101_ASDU_initializeStatic(buffer, parameters, isSequence, cot, oa,
+                                     ca, isTest, isNegative);
+}
+
+std::uint_fast64_t ScratchAsdu::getAcquiredCount() {
+  return acquiredCount.load();
+}
+
+std::uint_fast64_t ScratchAsdu::getAllocatedCount() {
+  return allocatedCount.load();
+}
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ *
+ * @file ScratchAsdu.h
+ * @brief reusable thread-local ASDU buffers for outgoing messages
+ *
+ * @package iec104-python
+ * @namespace Remote::Message
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#ifndef C104_REMOTE_MESSAGE_SCRATCHASDU_H
+#define C104_REMOTE_MESSAGE_SCRATCHASDU_H
+
+#include "types.h"
+
+namespace Remote {
+namespace Message {
+
+/**
+ * @brief Outgoing ASDU in a reusable buffer of the calling thread
+ *
+ * Each thread keeps a small stack of static ASDU buffers. A ScratchAsdu takes
+ * the next free buffer for its lifetime, new buffers are only allocated if
+ * more ASDUs are in use at the same time than ever before on this thread.
+ * lib60870 copies an ASDU when it is sent or enqueued, so the buffer can be
+ * reused right after sending.
+ */
+class ScratchAsdu {
+public:
+  // noncopyable, nonmovable: buffers are released in reverse order
+  ScratchAsdu(const ScratchAsdu &) = delete;
+  ScratchAsdu &operator=(const ScratchAsdu &) = delete;
+
+  /**
+   * @brief Take a buffer and initialize an empty ASDU, arguments match
+   * CS101_ASDU_create
+   */
+  ScratchAsdu(CS101_AppLayerParameters parameters, bool isSequence,
+              CS101_CauseOfTransmission cot, int oa, int ca, bool isTest,
+              bool isNegative);
+
+  /**
+   * @brief give the buffer back to the thread
+   */
+  ~ScratchAsdu();
+
+  /**
+   * @brief Getter for the ASDU, must not be destroyed
+   */
+  CS101_ASDU get() const { return asdu; }
+
+  /**
+   * @brief remove all information objects to fill the buffer again
+   */
+  void reset();
+
+  /**
+   * @brief Getter for the number of ASDUs taken from buffers (all threads)
+   */
+  static std::uint_fast64_t getAcquiredCount();
+
+  /**
+   * @brief Getter for the number of buffers allocated on the heap (all
+   * threads), does not grow in steady-state operation
+   */
+  static std::uint_fast64_t getAllocatedCount();
+
+private:
+  /// @brief thread-local buffer
+  sCS101_StaticASDU *buffer{nullptr};
+
+  CS101_ASDU asdu{nullptr};
+
+  const CS101_AppLayerParameters parameters;
+  const bool isSequence;
+  const CS101_CauseOfTransmission cot;
+  const int oa;
+  const int ca;
+  const bool isTest;
+  const bool isNegative;
+};
+
+} // namespace Message
+} // namespace Remote
+
+#endif // C104_REMOTE_MESSAGE_SCRATCHASDU_H
@@ -119,6 +119,15 @@ void from_time_point(CP56Time2a time,
   CP56Time2a_createFromMsTimestamp(time, static_cast<uint64_t>(millis));
 }
 
+std::map<UnexpectedMessageCause, std::uint_fast32_t>
+RejectionCounters_toMap(const RejectionCounters &counters) {
+  std::map<UnexpectedMessageCause, std::uint_fast32_t> result;
+  for (std::size_t i = NO_ERROR_CAUSE + 1; i < counters.size(); i++) {
+    result[static_cast<UnexpectedMessageCause>(i)] = counters[i].load();
+  }
+  return result;
+}
+
 struct InfoValueToStringVisitor {
   std::string operator()(std::monostate value) const { return "N.A."; }
   std::string operator()(bool value) const { return std::to_string(value); }
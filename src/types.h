@@ -33,6 +33,7 @@
 #define C104_TYPES_H
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <bitset>
 #include <chrono>
@@ -124,6 +125,17 @@ struct Task {
 };
 constexpr auto TASK_DELAY_THRESHOLD = std::chrono::milliseconds(100);
 
+typedef std::array<std::atomic_uint_fast32_t, UNEXPECTED_MESSAGE_CAUSE_COUNT>
+    RejectionCounters;
+
+/**
+ * @brief Convert rejection counters into a map keyed by cause
+ * @param counters per cause counters
+ * @return map with one entry per cause, NO_ERROR_CAUSE excluded
+ */
+std::map<UnexpectedMessageCause, std::uint_fast32_t>
+RejectionCounters_toMap(const RejectionCounters &counters);
+
 typedef std::variant<std::monostate, bool, DoublePointValue, LimitedInt7,
                      StepCommandValue, Byte32, NormalizedFloat, LimitedInt16,
                      float, int32_t, EventState, StartEvents, OutputCircuits,
@@ -147,6 +159,8 @@ namespace Message {
 class IncomingMessage;
 
 class OutgoingMessage;
+
+class CommandTemplate;
 } // namespace Message
 class Connection;
 class TransportSecurity;
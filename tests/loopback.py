@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+
+"""
+ Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology FIT
+
+ This file is part of iec104-python.
+ iec104-python is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ iec104-python is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+
+ See LICENSE file for the complete license text.
+"""
+
+# Benchmark: command round trips per second between a client and a server of
+# the same process via TCP on 127.0.0.1 and via the in-process loopback
+# transport, optionally with emulated latency and bandwidth.
+#
+# requires a build with CMAKE_ARGS="-DC104_LOOPBACK_TRANSPORT=ON"
+#
+# usage: loopback.py [SECONDS] [LATENCY_MS] [BANDWIDTH]
+
+import sys
+import time
+
+import c104
+
+PORT = 24140
+
+
+def on_command(point: c104.Point, previous_info: c104.Information, message: c104.IncomingMessage) -> c104.ResponseState:
+    return c104.ResponseState.SUCCESS
+
+
+def run(loopback: bool, seconds: float, latency_ms: int = 0, bandwidth: int = 0) -> float:
+    server = c104.Server(ip="127.0.0.1", port=PORT)
+    if loopback:
+        server.enable_loopback(latency_ms=latency_ms, bandwidth=bandwidth)
+    sv_station = server.add_station(common_address=1)
+    sv_command = sv_station.add_point(io_address=1, type=c104.Type.C_SC_NA_1)
+    sv_command.on_receive(callable=on_command)
+    server.start()
+
+    client = c104.Client()
+    connection = client.add_connection(ip="127.0.0.1", port=PORT, init=c104.Init.NONE)
+    cl_station = connection.add_station(common_address=1)
+    cl_command = cl_station.add_point(io_address=1, type=c104.Type.C_SC_NA_1)
+    client.start()
+
+    while not connection.is_connected:
+        time.sleep(0.01)
+
+    executed = 0
+    start = time.monotonic()
+    deadline = start + seconds
+    while time.monotonic() < deadline:
+        cl_command.value = not cl_command.value
+        if cl_command.transmit(cause=c104.Cot.ACTIVATION):
+            executed += 1
+    elapsed = time.monotonic() - start
+
+    client.stop()
+    server.stop()
+    server.disable_loopback()
+    return executed / elapsed
+
+
+def main():
+    seconds = float(sys.argv[1]) if len(sys.argv) > 1 else 5.0
+    latency_ms = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+    bandwidth = int(sys.argv[3]) if len(sys.argv) > 3 else 0
+
+    tcp = run(False, seconds)
+    print(f"tcp: {tcp:.0f} commands/s")
+    try:
+        memory = run(True, seconds)
+    except RuntimeError as e:
+        print(f"loopback: {e}")
+        return
+    print(f"loopback: {memory:.0f} commands/s, {memory / tcp:.2f}x")
+    if latency_ms or bandwidth:
+        shaped = run(True, seconds, latency_ms, bandwidth)
+        print(f"loopback ({latency_ms} ms, {bandwidth} B/s): {shaped:.0f} commands/s")
+
+
+if __name__ == "__main__":
+    main()
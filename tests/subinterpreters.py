@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+
+"""
+ Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology FIT
+
+ This file is part of iec104-python.
+ iec104-python is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ iec104-python is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+
+ See LICENSE file for the complete license text.
+"""
+
+# Benchmark: callback throughput of N server/client pairs, each pair running in
+# its own sub interpreter with its own GIL (PEP 684, Python 3.12+).
+#
+# usage: subinterpreters.py [N] [SECONDS]
+
+import os
+import sys
+import tempfile
+import threading
+import time
+
+BASE_PORT = 24040
+
+WORKER = """
+import c104
+import time
+
+executed = 0
+
+def on_command(point: c104.Point, previous_info: c104.Information, message: c104.IncomingMessage) -> c104.ResponseState:
+    global executed
+    executed += 1
+    sum(range(500))  # some python work per callback
+    return c104.ResponseState.SUCCESS
+
+server = c104.Server(ip="127.0.0.1", port={port})
+sv_station = server.add_station(common_address=1)
+sv_command = sv_station.add_point(io_address=1, type=c104.Type.C_SC_NA_1)
+sv_command.on_receive(callable=on_command)
+server.start()
+
+client = c104.Client()
+connection = client.add_connection(ip="127.0.0.1", port={port}, init=c104.Init.NONE)
+cl_station = connection.add_station(common_address=1)
+cl_command = cl_station.add_point(io_address=1, type=c104.Type.C_SC_NA_1)
+client.start()
+
+while not connection.is_connected:
+    time.sleep(0.01)
+
+deadline = time.monotonic() + {seconds}
+while time.monotonic() < deadline:
+    cl_command.value = not cl_command.value
+    cl_command.transmit(cause=c104.Cot.ACTIVATION)
+
+client.stop()
+server.stop()
+
+with open({result!r}, "w") as result:
+    result.write(str(executed))
+"""
+
+
+def create_interpreter():
+    try:
+        from concurrent import interpreters  # Python 3.14+
+
+        interp = interpreters.create()
+        return interp.exec
+    except ImportError:
+        pass
+    try:
+        import _interpreters  # Python 3.13
+
+        interp_id = _interpreters.create()
+        return lambda code: _interpreters.exec(interp_id, code)
+    except ImportError:
+        import _xxsubinterpreters  # Python 3.12
+
+        interp_id = _xxsubinterpreters.create(isolated=True)
+        return lambda code: _xxsubinterpreters.run_string(interp_id, code)
+
+
+def run(count: int, seconds: float) -> int:
+    with tempfile.TemporaryDirectory() as tmp:
+        results = [os.path.join(tmp, f"{i}.txt") for i in range(count)]
+        runners = [create_interpreter() for _ in range(count)]
+        threads = [
+            threading.Thread(target=runner, args=(WORKER.format(port=BASE_PORT + i, seconds=seconds, result=results[i]),))
+            for i, runner in enumerate(runners)
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        total = 0
+        for path in results:
+            with open(path) as result:
+                total += int(result.read())
+        return total
+
+
+def main():
+    count = int(sys.argv[1]) if len(sys.argv) > 1 else os.cpu_count() or 1
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 5.0
+
+    if sys.version_info < (3, 12):
+        print("per-interpreter GIL requires Python 3.12 or newer")
+        return
+
+    baseline = run(1, seconds) / seconds
+    print(f"1 interpreter: {baseline:.0f} callbacks/s")
+    if count > 1:
+        t = time.time()
+        total = run(count, seconds) / seconds
+        print(f"{count} interpreters: {total:.0f} callbacks/s, speedup {total / baseline:.2f}x ({time.time() - t:.1f} s)")
+
+
+if __name__ == "__main__":
+    main()
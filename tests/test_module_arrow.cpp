@@ -0,0 +1,143 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+
+#include "Server.h"
+#include "module/ArrowExport.h"
+#include "object/DataPoint.h"
+#include "object/Station.h"
+#include "types.h"
+
+namespace {
+
+bool isValid(const struct ArrowArray *column, std::size_t index) {
+  if (column->buffers[0] == nullptr) {
+    return true;
+  }
+  auto const *bitmap = static_cast<const std::uint8_t *>(column->buffers[0]);
+  return (bitmap[index / 8] >> (index % 8)) & 1;
+}
+
+template <typename T>
+T valueAt(const struct ArrowArray *column, std::size_t index) {
+  return static_cast<const T *>(column->buffers[1])[index];
+}
+
+} // namespace
+
+TEST_CASE("Export station via arrow", "[module::arrow]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto single = station->addPoint(11, IEC60870_5_TypeID::M_SP_NA_1);
+  auto scaled = station->addPoint(12, IEC60870_5_TypeID::M_ME_TE_1);
+  station->addPoint(13, IEC60870_5_TypeID::C_SC_NA_1);
+
+  single->setInfo(Object::SingleInfo::create(true));
+  scaled->setInfo(
+      Object::ScaledInfo::create(LimitedInt16(334), Quality::Invalid,
+                                 std::chrono::system_clock::time_point(
+                                     std::chrono::milliseconds(1234567890))));
+
+  auto table = Module::ArrowPointTable::create(station->getPoints());
+  REQUIRE(table->getLength() == 3);
+
+  SECTION("Schema") {
+    struct ArrowSchema schema {};
+    table->exportSchema(&schema);
+    REQUIRE(std::strcmp(schema.format, "+s") == 0);
+    REQUIRE(schema.n_children == 7);
+
+    const char *const formats[] = {"S", "I", "u", "g", "S", "tsm:UTC",
+                                   "tsm:UTC"};
+    const char *const names[] = {"common_address", "io_address", "type",
+                                 "value",          "quality",    "recorded_at",
+                                 "processed_at"};
+    for (std::int64_t i = 0; i < schema.n_children; i++) {
+      REQUIRE(std::strcmp(schema.children[i]->format, formats[i]) == 0);
+      REQUIRE(std::strcmp(schema.children[i]->name, names[i]) == 0);
+    }
+    REQUIRE(schema.children[0]->flags == 0);
+    REQUIRE(schema.children[3]->flags == ARROW_FLAG_NULLABLE);
+    REQUIRE(schema.children[4]->flags == ARROW_FLAG_NULLABLE);
+    REQUIRE(schema.children[5]->flags == ARROW_FLAG_NULLABLE);
+
+    schema.release(&schema);
+    REQUIRE(schema.release == nullptr);
+  }
+
+  SECTION("Columns") {
+    struct ArrowArray array {};
+    table->exportArray(&array);
+    REQUIRE(array.length == 3);
+    REQUIRE(array.n_children == 7);
+
+    auto const *commonAddress = array.children[0];
+    auto const *ioAddress = array.children[1];
+    auto const *type = array.children[2];
+    auto const *value = array.children[3];
+    auto const *quality = array.children[4];
+    auto const *recordedAt = array.children[5];
+    auto const *processedAt = array.children[6];
+
+    for (std::size_t i = 0; i < 3; i++) {
+      REQUIRE(valueAt<std::uint16_t>(commonAddress, i) == 10);
+      REQUIRE(valueAt<std::uint32_t>(ioAddress, i) == 11 + i);
+      REQUIRE(valueAt<std::int64_t>(processedAt, i) > 0);
+    }
+
+    auto const *offsets = static_cast<const std::int32_t *>(type->buffers[1]);
+    auto const *chars = static_cast<const char *>(type->buffers[2]);
+    REQUIRE(std::string(chars + offsets[0], offsets[1] - offsets[0]) ==
+            "M_SP_NA_1");
+    REQUIRE(std::string(chars + offsets[1], offsets[2] - offsets[1]) ==
+            "M_ME_TE_1");
+    REQUIRE(std::string(chars + offsets[2], offsets[3] - offsets[2]) ==
+            "C_SC_NA_1");
+
+    REQUIRE(value->null_count == 0);
+    REQUIRE(valueAt<double>(value, 0) == 1.0);
+    REQUIRE(valueAt<double>(value, 1) == 334.0);
+    REQUIRE(valueAt<double>(value, 2) == 0.0);
+
+    // commands carry no quality
+    REQUIRE(quality->null_count == 1);
+    REQUIRE(isValid(quality, 0));
+    REQUIRE(valueAt<std::uint16_t>(quality, 0) == 0);
+    REQUIRE(isValid(quality, 1));
+    REQUIRE(valueAt<std::uint16_t>(quality, 1) == 0x80);
+    REQUIRE_FALSE(isValid(quality, 2));
+
+    // only the time tagged point has a recorded_at timestamp
+    REQUIRE(recordedAt->null_count == 2);
+    REQUIRE_FALSE(isValid(recordedAt, 0));
+    REQUIRE(isValid(recordedAt, 1));
+    REQUIRE(valueAt<std::int64_t>(recordedAt, 1) == 1234567890);
+    REQUIRE_FALSE(isValid(recordedAt, 2));
+
+    array.release(&array);
+    REQUIRE(array.release == nullptr);
+  }
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <pybind11/eval.h>
+
+#include "Server.h"
+#include "module/Callback.h"
+#include "object/DataPoint.h"
+#include "object/Station.h"
+#include "remote/message/IncomingMessage.h"
+#include "types.h"
+
+static sCS101_AppLayerParameters appLayerParameters{.sizeOfTypeId = 1,
+                                                    .sizeOfVSQ = 0,
+                                                    .sizeOfCOT = 2,
+                                                    .originatorAddress = 99,
+                                                    .sizeOfCA = 2,
+                                                    .sizeOfIOA = 3,
+                                                    .maxSizeOfASDU = 249};
+
+/// @brief python function with the parameters of Point.on_receive
+static py::object createOnReceive(const char *result) {
+  py::module_::import("_c104");
+  py::dict scope;
+  py::exec(std::string("import _c104\n"
+                       "def on_receive(point, previous_info, message):\n"
+                       "    return ") +
+               result + "\n",
+           scope);
+  return scope["on_receive"];
+}
+
+/// @brief python functions with the annotated signatures of Point.on_receive,
+/// classes are moved to the c104 module as done by the python package
+static py::dict createAnnotatedOnReceive() {
+  py::module_::import("_c104");
+  py::dict scope;
+  py::exec(R"(
+import _c104 as c104
+for name in ("Point", "Information", "IncomingMessage", "ResponseState"):
+    getattr(c104, name).__module__ = "c104"
+
+def on_receive(point: c104.Point, previous_info: c104.Information,
+               message: c104.IncomingMessage) -> c104.ResponseState:
+    return c104.ResponseState.SUCCESS
+
+def on_receive_value(io_address: int, value: float, quality: int,
+                     recorded_at_ms: int) -> c104.ResponseState:
+    if io_address == 11 and value == 1 and recorded_at_ms == 0:
+        return c104.ResponseState.SUCCESS
+    return c104.ResponseState.FAILURE
+
+def on_receive_invalid(io_address: int, value: float) -> c104.ResponseState:
+    return c104.ResponseState.SUCCESS
+)",
+           scope);
+  return scope;
+}
+
+TEST_CASE("Call callback", "[module::callback]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  Module::Callback<CommandResponseState> callback(
+      "Point.on_receive", "(point, previous_info, message)");
+  auto callable = createOnReceive("_c104.ResponseState.SUCCESS");
+  callback.reset(callable);
+  REQUIRE(callback.is_set());
+
+  REQUIRE(callback.call(point, point->getInfo(), py::none()));
+  REQUIRE(callback.getResult() == RESPONSE_STATE_SUCCESS);
+}
+
+TEST_CASE("Remove callback with invalid result", "[module::callback]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  Module::Callback<CommandResponseState> callback(
+      "Point.on_receive", "(point, previous_info, message)");
+  auto callable = createOnReceive("'invalid'");
+  callback.reset(callable);
+
+  REQUIRE_FALSE(callback.call(point, point->getInfo(), py::none()));
+  REQUIRE_FALSE(callback.is_set());
+}
+
+TEST_CASE("Select on_receive dispatch by signature", "[module::callback]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 10, false, false);
+  InformationObject io =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io);
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+
+  auto scope = createAnnotatedOnReceive();
+
+  // scalar arguments: the callable checks address, value and timestamp
+  py::object callable = scope["on_receive_value"];
+  point->setOnReceiveCallback(callable);
+  REQUIRE(point->onReceive(message) == RESPONSE_STATE_SUCCESS);
+
+  callable = scope["on_receive"];
+  point->setOnReceiveCallback(callable);
+  REQUIRE(point->onReceive(message) == RESPONSE_STATE_SUCCESS);
+
+  callable = scope["on_receive_invalid"];
+  REQUIRE_THROWS_AS(point->setOnReceiveCallback(callable),
+                    std::invalid_argument);
+  REQUIRE(point->onReceive(message) == RESPONSE_STATE_SUCCESS);
+
+  InformationObject_destroy(io);
+  CS101_ASDU_destroy(asdu);
+}
+
+TEST_CASE("Benchmark callback", "[.][benchmark][module::callback]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 10, false, false);
+  InformationObject io =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io);
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+  auto info = point->getInfo();
+
+  Module::Callback<CommandResponseState> callback(
+      "Point.on_receive", "(point, previous_info, message)");
+  auto callable = createOnReceive("_c104.ResponseState.SUCCESS");
+  callback.reset(callable);
+
+  BENCHMARK("on_receive") {
+    callback.call(point, info, message);
+    return callback.getResult();
+  };
+
+  InformationObject_destroy(io);
+  CS101_ASDU_destroy(asdu);
+}
+
+TEST_CASE("Benchmark on_receive dispatch", "[.][benchmark][module::callback]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 10, false, false);
+  InformationObject io =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io);
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+
+  auto scope = createAnnotatedOnReceive();
+
+  py::object callable = scope["on_receive"];
+  point->setOnReceiveCallback(callable);
+  BENCHMARK("object arguments") { return point->onReceive(message); };
+
+  callable = scope["on_receive_value"];
+  point->setOnReceiveCallback(callable);
+  BENCHMARK("scalar arguments") { return point->onReceive(message); };
+
+  InformationObject_destroy(io);
+  CS101_ASDU_destroy(asdu);
+}
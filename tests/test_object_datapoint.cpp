@@ -22,12 +22,14 @@
  *
  */
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "Server.h"
 #include "object/DataPoint.h"
 #include "object/Station.h"
 #include "remote/message/IncomingMessage.h"
+#include "remote/message/PointMessage.h"
 #include "types.h"
 
 TEST_CASE("Create point", "[object::point]") {
@@ -99,3 +101,118 @@ TEST_CASE("Set point value via message", "[object::point]") {
   InformationObject_destroy(io);
   CS101_ASDU_destroy(asdu);
 }
+
+TEST_CASE("Handle commands via policy", "[object::point]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto measurement = station->addPoint(11, IEC60870_5_TypeID::M_ME_NC_1);
+  auto setpoint = station->addPoint(12, IEC60870_5_TypeID::C_SE_NC_1, 0, 11);
+  REQUIRE_THROWS(measurement->setCommandPolicy(true, std::nullopt,
+                                               std::nullopt, 0, false));
+  REQUIRE_THROWS(setpoint->setCommandPolicy(false, 10.0, 0.0, 0, false));
+  setpoint->setCommandPolicy(true, 0.0, 100.0, 0, true);
+
+  sCS101_AppLayerParameters appLayerParameters{.sizeOfTypeId = 1,
+                                               .sizeOfVSQ = 0,
+                                               .sizeOfCOT = 2,
+                                               .originatorAddress = 99,
+                                               .sizeOfCA = 2,
+                                               .sizeOfIOA = 3,
+                                               .maxSizeOfASDU = 249};
+  auto const command = [&appLayerParameters, &setpoint](float value) {
+    CS101_ASDU asdu = CS101_ASDU_create(
+        &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 10, false, false);
+    InformationObject io = (InformationObject)SetpointCommandShort_create(
+        nullptr, 12, value, false, 0);
+    CS101_ASDU_addInformationObject(asdu, io);
+    auto message =
+        Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+    auto const result = setpoint->onReceive(message);
+    InformationObject_destroy(io);
+    CS101_ASDU_destroy(asdu);
+    return result;
+  };
+
+  // accepted and mirrored into the related point
+  REQUIRE(command(42.5f) == RESPONSE_STATE_SUCCESS);
+  REQUIRE(measurement->getNativeValue<M_ME_NC_1>() == 42.5f);
+
+  // out of range
+  REQUIRE(command(150.0f) == RESPONSE_STATE_FAILURE);
+  REQUIRE(measurement->getNativeValue<M_ME_NC_1>() == 42.5f);
+
+  // related point has an invalid quality
+  measurement->setQuality(Quality::Invalid);
+  REQUIRE(command(10.0f) == RESPONSE_STATE_FAILURE);
+
+  auto const policy = setpoint->getCommandPolicy().toDict();
+  REQUIRE(policy["accepted"].cast<int>() == 1);
+  REQUIRE(policy["mirrored"].cast<int>() == 1);
+  REQUIRE(policy["rejected_range"].cast<int>() == 1);
+  REQUIRE(policy["rejected_quality"].cast<int>() == 1);
+}
+
+TEST_CASE("Native point value access", "[object::point]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+
+  auto scaled = station->addPoint(11, IEC60870_5_TypeID::M_ME_TE_1);
+  scaled->setNativeValue<M_ME_TE_1>(-1234);
+  REQUIRE(scaled->getNativeValue<M_ME_TE_1>() == -1234);
+  REQUIRE(std::get<LimitedInt16>(scaled->getValue()).get() == -1234);
+  REQUIRE(scaled->getRecordedAt().has_value());
+  scaled->setNativeQuality<M_ME_TE_1>(Quality::Invalid);
+  REQUIRE(std::get<Quality>(scaled->getQuality()) == Quality::Invalid);
+  REQUIRE_THROWS_AS(scaled->getNativeValue<M_ME_NB_1>(),
+                    std::invalid_argument);
+
+  auto normalized = station->addPoint(12, IEC60870_5_TypeID::M_ME_NA_1);
+  REQUIRE_THROWS_AS(normalized->setNativeValue<M_ME_NA_1>(1.5f),
+                    std::out_of_range);
+  normalized->setNativeValue<M_ME_NA_1>(0.25f);
+  REQUIRE(normalized->getNativeValue<M_ME_NA_1>() == 0.25f);
+  REQUIRE(normalized->getRecordedAt().has_value() == false);
+
+  auto command = station->addPoint(13, IEC60870_5_TypeID::C_SC_NA_1);
+  command->setNativeValue<C_SC_NA_1>(true);
+  REQUIRE(std::get<bool>(command->getValue()) == true);
+}
+
+template <IEC60870_5_TypeID TYPE>
+static void
+benchmarkEncoding(const std::shared_ptr<Object::Station> &station,
+                  const std::uint_fast32_t ioa,
+                  const typename Object::InfoTraits<TYPE>::value_type value,
+                  const InfoValue &boxed) {
+  auto point = station->addPoint(ioa, TYPE);
+  std::string const name = TypeID_toString(TYPE);
+
+  BENCHMARK(name + " variant set and encode") {
+    point->setValue(boxed);
+    return Remote::Message::PointMessage::create(point)
+        ->getInformationObject();
+  };
+
+  BENCHMARK(name + " native set and encode") {
+    point->setNativeValue<TYPE>(value);
+    return Remote::Message::PointMessage::create(point)
+        ->getInformationObject();
+  };
+}
+
+TEST_CASE("Benchmark native value encoding",
+          "[.][benchmark][object::point]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+
+  benchmarkEncoding<M_SP_NA_1>(station, 11, true, true);
+  benchmarkEncoding<M_DP_NA_1>(station, 12, IEC60870_DOUBLE_POINT_ON,
+                               IEC60870_DOUBLE_POINT_ON);
+  benchmarkEncoding<M_ST_NA_1>(station, 13, 17, LimitedInt7(17));
+  benchmarkEncoding<M_BO_NA_1>(station, 14, 0x5a5a, Byte32(0x5a5a));
+  benchmarkEncoding<M_ME_NA_1>(station, 15, 0.5f, NormalizedFloat(0.5f));
+  benchmarkEncoding<M_ME_NB_1>(station, 16, -1234, LimitedInt16(-1234));
+  benchmarkEncoding<M_ME_NC_1>(station, 17, 230.5f, 230.5f);
+  benchmarkEncoding<M_ME_TF_1>(station, 18, 230.5f, 230.5f);
+  benchmarkEncoding<M_IT_NA_1>(station, 19, 4711, std::int32_t{4711});
+}
@@ -24,6 +24,7 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include "Server.h"
 #include "object/DataPoint.h"
 #include "object/Station.h"
 #include "types.h"
@@ -32,3 +33,118 @@ TEST_CASE("Create station", "[object::station]") {
   auto station = Object::Station::create(14, nullptr, nullptr);
   REQUIRE(station->getCommonAddress() == 14);
 }
+
+TEST_CASE("Apply station diff", "[object::station]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto point_11 = station->addPoint(11, IEC60870_5_TypeID::M_SP_NA_1);
+  station->addPoint(12, IEC60870_5_TypeID::M_ME_NC_1);
+  station->addPoint(13, IEC60870_5_TypeID::C_SC_NA_1);
+
+  Object::StationDiff diff;
+  diff.removePoint(12);
+  diff.addPoint(14, IEC60870_5_TypeID::M_ME_NC_1);
+  diff.configurePoint(13, std::nullopt, 11, true);
+  station->applyDiff(diff);
+
+  REQUIRE(station->getPoints().size() == 3);
+  REQUIRE(station->getPoint(11) == point_11);
+  REQUIRE(station->getPoint(12) == nullptr);
+  REQUIRE(station->getPoint(14)->getType() == IEC60870_5_TypeID::M_ME_NC_1);
+  REQUIRE(station->getPoint(13)->getRelatedInformationObjectAddress() == 11);
+  REQUIRE(station->getPoint(13)->getRelatedInformationObjectAutoReturn());
+}
+
+TEST_CASE("Reject invalid station diff", "[object::station]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+
+  Object::StationDiff diff;
+  diff.addPoint(12, IEC60870_5_TypeID::M_SP_NA_1);
+  diff.configurePoint(11, std::nullopt, std::nullopt, std::nullopt,
+                      SELECT_AND_EXECUTE_COMMAND);
+  // auto return requires a related point
+  diff.configurePoint(12, std::nullopt, std::nullopt, true);
+  REQUIRE_THROWS_AS(station->applyDiff(diff), std::invalid_argument);
+
+  REQUIRE(station->getPoints().size() == 1);
+  REQUIRE(station->getPoint(12) == nullptr);
+  REQUIRE(station->getPoint(11)->getCommandMode() == DIRECT_COMMAND);
+}
+
+TEST_CASE("Select points by tag and range", "[object::station]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  for (std::uint_fast32_t ioa = 1; ioa <= 20; ioa++) {
+    auto point = station->addPoint(ioa, IEC60870_5_TypeID::M_SP_NA_1);
+    point->addTag(ioa <= 10 ? "bay:E01" : "bay:E02");
+    if (ioa % 2 == 0) {
+      point->addTag("breaker");
+    }
+  }
+
+  auto breakers = station->selectPoints({"bay:E01", "breaker"});
+  REQUIRE(breakers.size() == 5);
+  REQUIRE(breakers.front()->getInformationObjectAddress() == 2);
+  REQUIRE(breakers.back()->getInformationObjectAddress() == 10);
+
+  REQUIRE(station->selectPoints({}, 5, 14).size() == 10);
+  REQUIRE(station->selectPoints({"breaker"}, 5, 14).size() == 5);
+  REQUIRE(station->selectPoints({"unknown"}).empty());
+
+  REQUIRE(station->getPoint(2)->removeTag("breaker"));
+  station->removePoint(4);
+  REQUIRE(station->selectPoints({"bay:E01", "breaker"}).size() == 3);
+}
+
+TEST_CASE("Scan points in address order", "[object::station]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  for (std::uint_fast32_t ioa : {30, 10, 20, 40}) {
+    station->addPoint(ioa, IEC60870_5_TypeID::M_ME_NC_1);
+  }
+
+  auto first = station->scanPoints(0, 3);
+  REQUIRE(first.size() == 3);
+  REQUIRE(first.front()->getInformationObjectAddress() == 10);
+  REQUIRE(first.back()->getInformationObjectAddress() == 30);
+
+  auto rest = station->scanPoints(31, 3);
+  REQUIRE(rest.size() == 1);
+  REQUIRE(rest.front()->getInformationObjectAddress() == 40);
+
+  REQUIRE(station->scanPoints(41, 3).empty());
+}
+
+TEST_CASE("Freeze counters", "[object::station]") {
+  auto server = Server::create();
+  auto station = server->addStation(10);
+  auto counter_1 = station->addPoint(1, IEC60870_5_TypeID::M_IT_NA_1);
+  auto counter_2 = station->addPoint(2, IEC60870_5_TypeID::M_IT_TB_1);
+  station->addPoint(3, IEC60870_5_TypeID::M_ME_NC_1);
+  counter_1->setNativeValue<M_IT_NA_1>(100);
+  counter_2->setNativeValue<M_IT_TB_1>(200);
+
+  auto const frozen_at = std::chrono::system_clock::now();
+  auto const frozen = station->freezeCounters(true, frozen_at);
+  REQUIRE(frozen.size() == 2);
+  REQUIRE(frozen[0].second->getCounter() == 100);
+  REQUIRE(frozen[0].second->getSequence().get() == 1);
+  REQUIRE(frozen[0].second->getRecordedAt() == frozen_at);
+  REQUIRE(frozen[0].second->isReadonly());
+  REQUIRE(counter_1->getNativeValue<M_IT_NA_1>() == 0);
+  REQUIRE(counter_2->getNativeValue<M_IT_TB_1>() == 0);
+
+  // the next boundary is aligned to the interval plus offset
+  auto const now = std::chrono::system_clock::time_point(
+      std::chrono::milliseconds(1000 * 900 * 4 + 1234));
+  auto const next = Remote::CounterFreeze::nextBoundary(now, 900000, 5000);
+  REQUIRE(next == std::chrono::system_clock::time_point(
+                      std::chrono::milliseconds(1000 * 900 * 4 + 5000)));
+
+  REQUIRE_THROWS(station->enableCounterFreeze(0, false, 0));
+  REQUIRE_THROWS(station->enableCounterFreeze(1000, false, 1000));
+  station->enableCounterFreeze(1000, false, 0);
+  REQUIRE(station->getCounterFreeze().isEnabled());
+}
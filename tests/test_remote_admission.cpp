@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "remote/AdmissionControl.h"
+#include "types.h"
+
+TEST_CASE("Admit connections", "[remote::admission]") {
+  using Verdict = Remote::AdmissionControl::Verdict;
+  Remote::AdmissionControl admission;
+
+  REQUIRE(admission.evaluate("10.0.0.1:50000") == Verdict::Undecided);
+  REQUIRE_THROWS_AS(admission.addRule("10.0.0.256/8", true),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(admission.addRule("10.0.0.0/33", true),
+                    std::invalid_argument);
+
+  admission.addRule("10.0.0.0/8", true);
+  admission.addRule("10.0.0.66", false);
+  REQUIRE(admission.evaluate("10.1.2.3:50000") == Verdict::Accept);
+  REQUIRE(admission.evaluate("10.0.0.66:50000") == Verdict::Reject);
+  REQUIRE(admission.evaluate("192.168.0.1:50000") == Verdict::Reject);
+  REQUIRE(admission.evaluate("[::1]:50000") == Verdict::Reject);
+
+  admission.setLimits(1, 0, 1, 1);
+  admission.opened("10.1.2.3:50000");
+  REQUIRE(admission.evaluate("10.1.2.3:50001") == Verdict::Reject);
+  admission.closed("10.1.2.3:50000");
+  REQUIRE(admission.evaluate("10.1.2.3:50001") == Verdict::Accept);
+  // burst is exhausted, the other peer has its own bucket
+  REQUIRE(admission.evaluate("10.1.2.3:50002") == Verdict::Reject);
+  REQUIRE(admission.evaluate("10.1.2.4:50000") == Verdict::Accept);
+
+  admission.clearRules();
+  REQUIRE(admission.evaluate("192.168.0.1:50000") == Verdict::Undecided);
+  admission.rejectedByCallback();
+
+  auto const stats = admission.toDict();
+  REQUIRE(stats["accepted"].cast<int>() == 3);
+  REQUIRE(stats["undecided"].cast<int>() == 2);
+  REQUIRE(stats["rejected_denied"].cast<int>() == 1);
+  REQUIRE(stats["rejected_not_allowed"].cast<int>() == 2);
+  REQUIRE(stats["rejected_cap"].cast<int>() == 1);
+  REQUIRE(stats["rejected_rate"].cast<int>() == 1);
+  REQUIRE(stats["rejected_callback"].cast<int>() == 1);
+  REQUIRE(stats["open"].cast<int>() == 0);
+}
+
+TEST_CASE("Forget idle peers", "[remote::admission]") {
+  Remote::AdmissionControl admission;
+  // caps only, peer buckets are not used
+  admission.setLimits(1, 0, 0, 1);
+  admission.opened("192.168.0.1:50000");
+
+  auto const peers = Remote::ADMISSION_MAX_TRACKED_PEERS + 100;
+  for (std::size_t i = 0; i < peers; i++) {
+    std::string const ip =
+        "10." + std::to_string(i / 256) + "." + std::to_string(i % 256) + ".1";
+    admission.opened(ip + ":50000");
+    admission.closed(ip + ":50000");
+  }
+
+  auto const stats = admission.toDict();
+  REQUIRE(stats["tracked"].cast<std::size_t>() <
+          Remote::ADMISSION_MAX_TRACKED_PEERS);
+  // peers with open connections are kept
+  REQUIRE(stats["open"].cast<int>() == 1);
+  REQUIRE(admission.evaluate("192.168.0.1:50001") ==
+          Remote::AdmissionControl::Verdict::Reject);
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "object/Information.h"
+#include "remote/IntervalAggregator.h"
+#include "types.h"
+
+TEST_CASE("Aggregate values per interval", "[remote::aggregation]") {
+  Remote::IntervalAggregator aggregator;
+  REQUIRE_THROWS(aggregator.enable(0));
+  aggregator.enable(60000);
+
+  // a fixed minute boundary in the future
+  auto const start = std::chrono::system_clock::time_point(
+      std::chrono::milliseconds(60000LL * 33400000));
+  auto const at = [start](int seconds) {
+    return start + std::chrono::seconds(seconds);
+  };
+  auto const value = [](float v) {
+    return std::make_shared<Object::ShortInfo>(v, Quality::None, std::nullopt,
+                                               false);
+  };
+
+  aggregator.record(1, 11, M_ME_NC_1, value(10), at(10));
+  aggregator.record(1, 11, M_ME_NC_1, value(40), at(40));
+  aggregator.record(1, 12, M_SP_NA_1,
+                    std::make_shared<Object::SingleInfo>(true, Quality::None,
+                                                         std::nullopt, false),
+                    at(20));
+  REQUIRE(aggregator.collect(at(59)).empty());
+
+  auto batches = aggregator.collect(at(60));
+  REQUIRE(batches.size() == 1);
+  REQUIRE(batches[0].start == start);
+  REQUIRE(batches[0].aggregates.size() == 2);
+  for (const auto &aggregate : batches[0].aggregates) {
+    if (aggregate.informationObjectAddress == 11) {
+      REQUIRE(aggregate.count == 2);
+      REQUIRE(aggregate.min == 10);
+      REQUIRE(aggregate.max == 40);
+      REQUIRE(aggregate.last == 40);
+      // 10 for 30 seconds and 40 for 20 seconds
+      REQUIRE(aggregate.average == 22);
+    } else {
+      REQUIRE(aggregate.count == 1);
+      REQUIRE(aggregate.average == 1);
+    }
+  }
+
+  // the last value is carried into intervals without new values
+  batches = aggregator.collect(at(120));
+  REQUIRE(batches.size() == 1);
+  REQUIRE(batches[0].aggregates[0].count == 0);
+  REQUIRE(batches[0].aggregates[0].average ==
+          batches[0].aggregates[0].last);
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+#include "remote/CaptureAnalyzer.h"
+#include "types.h"
+
+namespace {
+
+/// @brief single point information M_SP_NA_1 of IOA 1 in station 1
+const std::vector<std::uint8_t> SINGLE_POINT_ASDU{1, 1, 3, 0, 1, 0,
+                                                  1, 0, 0, 1};
+
+std::vector<std::uint8_t> iFrame(const std::uint16_t sendSequence,
+                                 const std::uint16_t receiveSequence) {
+  std::vector<std::uint8_t> apdu{
+      0x68,
+      static_cast<std::uint8_t>(4 + SINGLE_POINT_ASDU.size()),
+      static_cast<std::uint8_t>((sendSequence << 1) & 0xff),
+      static_cast<std::uint8_t>((sendSequence << 1) >> 8),
+      static_cast<std::uint8_t>((receiveSequence << 1) & 0xff),
+      static_cast<std::uint8_t>((receiveSequence << 1) >> 8)};
+  apdu.insert(apdu.end(), SINGLE_POINT_ASDU.begin(), SINGLE_POINT_ASDU.end());
+  return apdu;
+}
+
+std::vector<std::uint8_t> sFrame(const std::uint16_t receiveSequence) {
+  return {0x68,
+          4,
+          0x01,
+          0x00,
+          static_cast<std::uint8_t>((receiveSequence << 1) & 0xff),
+          static_cast<std::uint8_t>((receiveSequence << 1) >> 8)};
+}
+
+void append32(std::vector<std::uint8_t> &buffer, const std::uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    buffer.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+/// @brief native capture record
+void appendRecord(std::vector<std::uint8_t> &capture,
+                  const std::int64_t timestamp_ns, const bool sent,
+                  const std::vector<std::uint8_t> &apdu) {
+  std::uint8_t timestamp[8];
+  std::memcpy(timestamp, &timestamp_ns, sizeof(timestamp));
+  capture.insert(capture.end(), timestamp, timestamp + sizeof(timestamp));
+  capture.push_back(sent ? 1 : 0);
+  capture.insert(capture.end(), apdu.begin(), apdu.end());
+}
+
+std::vector<std::uint8_t> nativeCapture() {
+  return {Remote::CAPTURE_NATIVE_MAGIC,
+          Remote::CAPTURE_NATIVE_MAGIC + Remote::CAPTURE_NATIVE_MAGIC_SIZE};
+}
+
+/// @brief pcap record of an IPv4 segment from 10.0.0.1:50000 to 10.0.0.2:2404
+/// on a raw IP link
+void appendSegment(std::vector<std::uint8_t> &capture,
+                   const std::uint32_t microseconds,
+                   const std::uint32_t sequence, const std::uint8_t flags,
+                   const std::vector<std::uint8_t> &payload) {
+  std::size_t const size = 40 + payload.size();
+  append32(capture, 0);
+  append32(capture, microseconds);
+  append32(capture, static_cast<std::uint32_t>(size));
+  append32(capture, static_cast<std::uint32_t>(size));
+
+  std::vector<std::uint8_t> packet{
+      0x45, 0, static_cast<std::uint8_t>(size >> 8),
+      static_cast<std::uint8_t>(size & 0xff), 0, 0, 0, 0, 64, 6, 0, 0, 10, 0,
+      0, 1, 10, 0, 0, 2,
+      // tcp
+      0xc3, 0x50, 0x09, 0x64, static_cast<std::uint8_t>(sequence >> 24),
+      static_cast<std::uint8_t>(sequence >> 16),
+      static_cast<std::uint8_t>(sequence >> 8),
+      static_cast<std::uint8_t>(sequence), 0, 0, 0, 0, 0x50, flags, 0xff, 0xff,
+      0, 0, 0, 0};
+  capture.insert(capture.end(), packet.begin(), packet.end());
+  capture.insert(capture.end(), payload.begin(), payload.end());
+}
+
+std::vector<std::uint8_t> pcapCapture() {
+  std::vector<std::uint8_t> capture;
+  append32(capture, 0xa1b2c3d4);
+  append32(capture, 0x00040002); // version 2.4
+  append32(capture, 0);
+  append32(capture, 0);
+  append32(capture, 65535);
+  append32(capture, 101); // raw IP
+  return capture;
+}
+
+} // namespace
+
+TEST_CASE("Analyze sequence gaps", "[remote::analyzer]") {
+  auto capture = nativeCapture();
+  appendRecord(capture, 1000000000, true, iFrame(0, 0));
+  appendRecord(capture, 1100000000, true, iFrame(1, 0));
+  // I-frame 2 is missing
+  appendRecord(capture, 1200000000, true, iFrame(3, 0));
+  appendRecord(capture, 1250000000, false, sFrame(4));
+
+  Remote::CaptureAnalyzer analyzer({2404});
+  analyzer.analyze("gaps", capture.data(), capture.size());
+
+  auto const &connection = analyzer.getConnections().at("gaps");
+  auto const &sent = connection.directions[0];
+  REQUIRE(sent.iFrames == 3);
+  REQUIRE(sent.sequenceGaps == 1);
+  REQUIRE(sent.missingFrames == 1);
+  REQUIRE(sent.unconfirmed.empty());
+  REQUIRE(sent.ackLatency.count == 3);
+  REQUIRE(sent.ackLatency.min_ms == 50);
+  REQUIRE(sent.ackLatency.max_ms == 250);
+  REQUIRE(connection.directions[1].sFrames == 1);
+
+  REQUIRE(connection.asdus == 3);
+  REQUIRE(connection.objects == 3);
+  auto const &point = connection.points.at((std::uint64_t{1} << 32) | 1);
+  REQUIRE(point.count == 3);
+  REQUIRE(point.interArrival.count == 2);
+  REQUIRE(point.interArrival.mean_ms() == 100);
+}
+
+TEST_CASE("Analyze retransmitted segments", "[remote::analyzer]") {
+  auto const first = iFrame(0, 0);
+  auto const second = iFrame(1, 0);
+  auto const third = iFrame(2, 0);
+  std::uint32_t const start = 1000;
+
+  auto capture = pcapCapture();
+  appendSegment(capture, 0, start, 0x02, {});
+  appendSegment(capture, 1000, start + 1, 0x18, first);
+  // retransmission of the first and overlapping retransmission of both frames
+  appendSegment(capture, 2000, start + 1, 0x18, first);
+  std::vector<std::uint8_t> both(first);
+  both.insert(both.end(), second.begin(), second.end());
+  appendSegment(capture, 3000, start + 1, 0x18, both);
+  // the third frame is lost in the capture, a fourth frame follows
+  std::uint32_t const next = start + 1 + both.size() + third.size();
+  appendSegment(capture, 4000, next, 0x18, iFrame(3, 0));
+
+  Remote::CaptureAnalyzer analyzer({2404});
+  analyzer.analyze("retransmits", capture.data(), capture.size());
+
+  REQUIRE(analyzer.getConnections().size() == 1);
+  auto const &connection = analyzer.getConnections().begin()->second;
+  REQUIRE(connection.name == "10.0.0.1:50000 -> 10.0.0.2:2404");
+  auto const &client = connection.directions[0];
+  REQUIRE(client.iFrames == 3);
+  REQUIRE(client.lostBytes == third.size());
+  REQUIRE(client.sequenceGaps == 1);
+  REQUIRE(client.missingFrames == 1);
+  REQUIRE(client.skippedBytes == 0);
+}
+
+TEST_CASE("Analyze truncated records", "[remote::analyzer]") {
+  Remote::CaptureAnalyzer analyzer({2404});
+
+  SECTION("Native record header") {
+    auto capture = nativeCapture();
+    appendRecord(capture, 1000000000, true, iFrame(0, 0));
+    capture.insert(capture.end(), {0, 0, 0});
+    REQUIRE_THROWS_AS(
+        analyzer.analyze("native", capture.data(), capture.size()),
+        std::runtime_error);
+  }
+
+  SECTION("Native APDU") {
+    auto capture = nativeCapture();
+    appendRecord(capture, 1000000000, true, iFrame(0, 0));
+    capture.resize(capture.size() - 1);
+    REQUIRE_THROWS_AS(
+        analyzer.analyze("native", capture.data(), capture.size()),
+        std::runtime_error);
+  }
+
+  SECTION("Pcap packet") {
+    auto capture = pcapCapture();
+    appendSegment(capture, 0, 1000, 0x02, {});
+    appendSegment(capture, 1000, 1001, 0x18, iFrame(0, 0));
+    appendSegment(capture, 2000, 1001 + 16, 0x18, iFrame(1, 0));
+    capture.resize(capture.size() - 1);
+    analyzer.analyze("pcap", capture.data(), capture.size());
+
+    // complete packets before the truncated one are analyzed
+    auto const &connection = analyzer.getConnections().begin()->second;
+    REQUIRE(connection.directions[0].iFrames == 1);
+  }
+
+  SECTION("Unknown format") {
+    std::vector<std::uint8_t> const capture(32, 0);
+    REQUIRE_THROWS_AS(
+        analyzer.analyze("unknown", capture.data(), capture.size()),
+        std::runtime_error);
+  }
+}
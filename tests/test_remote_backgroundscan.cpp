@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "remote/BackgroundScan.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Pace background scan budget", "[remote::backgroundscan]") {
+  Remote::BackgroundScan scan;
+
+  SECTION("Budget follows the rate") {
+    scan.enable(1000);
+    std::this_thread::sleep_for(50ms);
+    auto const budget = scan.takeBudget();
+    REQUIRE(budget >= 40);
+    REQUIRE(budget <= 1000);
+
+    // credit was consumed, an immediate second tick gets (almost) nothing
+    REQUIRE(scan.takeBudget() < budget);
+  }
+
+  SECTION("Unused credit is limited to one second") {
+    scan.enable(20);
+    std::this_thread::sleep_for(1200ms);
+    REQUIRE(scan.takeBudget() == 20);
+  }
+
+  SECTION("Idle mode has no budget") {
+    scan.enable(0);
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(scan.takeBudget() == 0);
+    scan.refundBudget(10);
+    REQUIRE(scan.takeBudget() == 0);
+  }
+
+  SECTION("Refunded budget is available in the next tick") {
+    scan.enable(1000);
+    std::this_thread::sleep_for(50ms);
+    auto const budget = scan.takeBudget();
+    REQUIRE(budget > 0);
+    scan.refundBudget(budget);
+    REQUIRE(scan.takeBudget() >= budget);
+
+    // refunds are limited to one second as well
+    scan.refundBudget(5000);
+    REQUIRE(scan.takeBudget() == 1000);
+  }
+}
+
+TEST_CASE("Roll over background scan cycles", "[remote::backgroundscan]") {
+  Remote::BackgroundScan scan;
+  scan.enable(100);
+
+  auto cursor = scan.getCursor();
+  REQUIRE(cursor.station == 0);
+  REQUIRE(cursor.informationObjectAddress == 0);
+
+  cursor.station = 1;
+  cursor.informationObjectAddress = 12;
+  scan.advance(cursor, 5);
+  REQUIRE(scan.getCursor().station == 1);
+  REQUIRE(scan.getCursor().informationObjectAddress == 12);
+
+  cursor.station = 2;
+  cursor.informationObjectAddress = 0;
+  scan.advance(cursor, 3);
+  scan.completeCycle(cursor);
+
+  auto stats = scan.toDict();
+  REQUIRE(stats["cycles"].cast<std::uint64_t>() == 1);
+  REQUIRE(stats["points"].cast<std::uint64_t>() == 8);
+  REQUIRE(stats["cycle_points"].cast<std::uint64_t>() == 0);
+  REQUIRE(stats["last_cycle_ms"].cast<double>() >= 0.0);
+  REQUIRE(scan.getCursor().station == 0);
+  REQUIRE(scan.getCursor().informationObjectAddress == 0);
+
+  SECTION("Outdated cursors are ignored after a restart") {
+    scan.enable(100);
+    scan.advance(cursor, 4);
+    scan.completeCycle(cursor);
+
+    stats = scan.toDict();
+    REQUIRE(stats["cycles"].cast<std::uint64_t>() == 1);
+    REQUIRE(stats["points"].cast<std::uint64_t>() == 8);
+    REQUIRE(scan.getCursor().generation == cursor.generation + 1);
+  }
+
+  SECTION("Disabling keeps the statistics") {
+    scan.disable();
+    REQUIRE_FALSE(scan.isEnabled());
+    stats = scan.toDict();
+    REQUIRE(stats["cycles"].cast<std::uint64_t>() == 1);
+    REQUIRE(stats["current_cycle_ms"].cast<double>() == 0.0);
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "module/MemoryBudget.h"
+#include "remote/BandwidthShaper.h"
+#include "remote/RawFrameTap.h"
+#include "remote/message/ScratchAsdu.h"
+#include "types.h"
+
+static sCS101_AppLayerParameters appLayerParameters{.sizeOfTypeId = 1,
+                                                    .sizeOfVSQ = 0,
+                                                    .sizeOfCOT = 2,
+                                                    .originatorAddress = 99,
+                                                    .sizeOfCA = 2,
+                                                    .sizeOfIOA = 3,
+                                                    .maxSizeOfASDU = 249};
+
+TEST_CASE("Shed load within memory budget", "[remote::budget]") {
+  using Module::MemoryBudget;
+  auto const before = MemoryBudget::toDict();
+
+  Remote::BandwidthShaper shaper("127.0.0.1");
+  shaper.configure(1000, 255);
+  REQUIRE(shaper.tryConsume(255, false));
+
+  Remote::Message::ScratchAsdu const periodic(
+      &appLayerParameters, false, CS101_COT_PERIODIC, 0, 14, false, false);
+  Remote::Message::ScratchAsdu const spontaneous(
+      &appLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 14, false, false);
+  shaper.hold(periodic.get(), 20, true);
+  shaper.hold(spontaneous.get(), 20, false, 42);
+  shaper.hold(spontaneous.get(), 20, false, 42);
+  REQUIRE(shaper.toDict()["held_frames"].cast<int>() == 3);
+  REQUIRE(MemoryBudget::getUsage() > 0);
+
+  // 85 %: periodic frames are dropped
+  MemoryBudget::setLimit(MemoryBudget::getUsage() * 100 / 85);
+  REQUIRE(MemoryBudget::getStage() == MemoryBudget::Stage::DropPeriodic);
+  shaper.hold(periodic.get(), 20, true);
+  REQUIRE(shaper.toDict()["held_frames"].cast<int>() == 2);
+
+  // 95 %: spontaneous frames of the same point are coalesced
+  MemoryBudget::setLimit(MemoryBudget::getUsage() * 100 / 95);
+  REQUIRE(MemoryBudget::getStage() == MemoryBudget::Stage::Coalesce);
+  shaper.hold(spontaneous.get(), 20, false, 42);
+  shaper.hold(spontaneous.get(), 20, false, 0);
+  REQUIRE(shaper.toDict()["held_frames"].cast<int>() == 3);
+  REQUIRE(shaper.toDict()["coalesced_frames"].cast<int>() == 1);
+
+  // 100 %: new batches are refused
+  MemoryBudget::setLimit(MemoryBudget::getUsage());
+  REQUIRE(MemoryBudget::getStage() == MemoryBudget::Stage::RefuseHistory);
+  Remote::RawFrameTap tap;
+  tap.configure(1, 1000);
+  unsigned char const frame[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
+  REQUIRE_FALSE(tap.append(frame, sizeof(frame), true));
+  REQUIRE(tap.collect().empty());
+  REQUIRE(tap.toDict()["dropped_frames"].cast<int>() == 1);
+
+  auto const after = MemoryBudget::toDict();
+  REQUIRE(after["dropped_periodic"].cast<int>() -
+              before["dropped_periodic"].cast<int>() ==
+          2);
+  REQUIRE(after["coalesced"].cast<int>() - before["coalesced"].cast<int>() ==
+          1);
+  REQUIRE(after["refused_history"].cast<int>() -
+              before["refused_history"].cast<int>() ==
+          1);
+  REQUIRE(after["subsystems"]["held_periodic_frames"].cast<int>() == 0);
+
+  MemoryBudget::setLimit(0);
+  REQUIRE(MemoryBudget::getStage() == MemoryBudget::Stage::None);
+}
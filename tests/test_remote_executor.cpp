@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <future>
+
+#include "remote/CommandExecutor.h"
+#include "types.h"
+
+TEST_CASE("Execute commands per point", "[remote::executor]") {
+  Remote::CommandExecutor executor;
+  REQUIRE_FALSE(executor.dispatch(1, 11, []() {}));
+
+  executor.start(4, nullptr);
+  REQUIRE(executor.isRunning());
+
+  // a blocked point does not delay other points
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic_int others{0};
+  REQUIRE(executor.dispatch(1, 11, [released]() { released.wait(); }));
+  for (std::uint_fast32_t ioa = 12; ioa < 20; ioa++) {
+    REQUIRE(executor.dispatch(1, ioa, [&others]() { others++; }));
+  }
+  for (int i = 0; i < 100 && others.load() == 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  REQUIRE(others.load() > 0);
+
+  // commands of the same point keep their order
+  std::vector<int> order;
+  for (int i = 0; i < 50; i++) {
+    REQUIRE(executor.dispatch(1, 11, [&order, i]() { order.push_back(i); }));
+  }
+  release.set_value();
+  executor.stop();
+  REQUIRE_FALSE(executor.isRunning());
+
+  REQUIRE(order.size() == 50);
+  REQUIRE(std::is_sorted(order.begin(), order.end()));
+  auto const stats = executor.toDict();
+  REQUIRE(stats["dispatched"].cast<int>() == 59);
+  REQUIRE(stats["executed"].cast<int>() == 59);
+  REQUIRE(stats["pending"].cast<int>() == 0);
+
+  // jobs finished by stop may dispatch without blocking the pool
+  executor.start(1, nullptr);
+  std::atomic_bool redispatched{true};
+  REQUIRE(executor.dispatch(1, 11, [&executor, &redispatched]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    redispatched = executor.dispatch(1, 12, []() {});
+  }));
+  executor.stop();
+  REQUIRE_FALSE(redispatched.load());
+}
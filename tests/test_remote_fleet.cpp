@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <pybind11/eval.h>
+
+#include "Client.h"
+#include "remote/Connection.h"
+#include "types.h"
+
+TEST_CASE("Count connections per state", "[remote::fleet]") {
+  auto client = Client::create();
+  client->addConnection("127.0.0.1", 2404);
+  client->addConnection("127.0.0.1", 2405);
+  client->setStateChangeWindow_ms(500);
+  REQUIRE(client->getStateChangeWindow_ms() == 500);
+
+  auto const states = client->getFleetState();
+  REQUIRE(states.size() == 6);
+  REQUIRE(states.at(CLOSED) == 2);
+  REQUIRE(states.at(OPEN) == 0);
+}
+
+TEST_CASE("Coalesce state changes", "[remote::fleet]") {
+  py::module_::import("_c104");
+  py::dict scope;
+  py::exec(R"(
+states = []
+fleet_states = []
+
+def on_state_change(connection, state):
+    states.append(state)
+
+def on_fleet_state(client, counts):
+    fleet_states.append(counts)
+)",
+           scope);
+
+  auto client = Client::create();
+  client->setStateChangeWindow_ms(200);
+  client->start();
+  auto connection = client->addConnection("127.0.0.1", 2404, INIT_MUTED);
+  py::object onStateChange = scope["on_state_change"];
+  py::object onFleetState = scope["on_fleet_state"];
+  connection->setOnStateChangeCallback(onStateChange);
+  client->setOnFleetStateCallback(onFleetState);
+
+  // the connection flaps within the window, the latest state is reported once
+  {
+    py::gil_scoped_release const release;
+    connection->setOpen();
+    connection->setClosed();
+    connection->setOpen();
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  }
+  REQUIRE(py::len(scope["states"]) == 1);
+  REQUIRE(scope["states"].cast<py::list>()[0].cast<ConnectionState>() ==
+          OPEN_MUTED);
+  REQUIRE(py::len(scope["fleet_states"]) == 1);
+
+  // a revert to the reported state is neither reported per connection nor
+  // for the fleet
+  {
+    py::gil_scoped_release const release;
+    connection->setClosed();
+    connection->setOpen();
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  }
+  REQUIRE(py::len(scope["states"]) == 1);
+  REQUIRE(py::len(scope["fleet_states"]) == 1);
+
+  client->stop();
+}
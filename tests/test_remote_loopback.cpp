@@ -0,0 +1,96 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "Client.h"
+#include "Server.h"
+#include "remote/Connection.h"
+#include "remote/Loopback.h"
+#include "types.h"
+
+#ifdef C104_LOOPBACK_TRANSPORT
+
+/**
+ * @brief start a server with an in-process endpoint and measure the time a
+ * client needs to open a connection (STARTDT act and con)
+ * @return duration until the connection is open, or -1ms on timeout
+ */
+static std::chrono::milliseconds
+openLoopback(const std::uint_fast16_t port, const std::uint_fast32_t latency,
+             const std::uint_fast64_t bandwidth) {
+  auto server = Server::create("127.0.0.1", port);
+  server->enableLoopback(latency, bandwidth);
+  REQUIRE(server->isLoopback());
+  server->start();
+
+  auto client = Client::create();
+  auto connection = client->addConnection("127.0.0.1", port, INIT_NONE);
+
+  std::chrono::milliseconds duration(-1);
+  {
+    py::gil_scoped_release const release;
+    auto const begin = std::chrono::steady_clock::now();
+    client->start();
+    auto const deadline = begin + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (connection->getState() == OPEN) {
+        duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - begin);
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    client->stop();
+    server->stop();
+  }
+  server->disableLoopback();
+  return duration;
+}
+
+TEST_CASE("Pace loopback transport", "[remote::loopback]") {
+  REQUIRE(Remote::Loopback::isSupported());
+
+  SECTION("Unlimited link") {
+    auto const duration = openLoopback(24150, 0, 0);
+    REQUIRE(duration.count() >= 0);
+  }
+
+  SECTION("Delay frames by latency") {
+    // STARTDT act and con travel the link once each
+    auto const duration = openLoopback(24151, 100, 0);
+    REQUIRE(duration >= std::chrono::milliseconds(200));
+  }
+
+  SECTION("Serialize frames at bandwidth") {
+    // STARTDT act and con are 6 bytes each, 60 B/s = 100ms per frame
+    auto const duration = openLoopback(24152, 0, 60);
+    REQUIRE(duration >= std::chrono::milliseconds(200));
+  }
+}
+
+#endif // C104_LOOPBACK_TRANSPORT
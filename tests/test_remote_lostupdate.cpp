@@ -0,0 +1,52 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "remote/LostUpdateDetector.h"
+#include "types.h"
+
+TEST_CASE("Detect lost updates", "[remote::lostupdate]") {
+  Remote::LostUpdateDetector detector;
+  detector.enable(0.5, 10);
+
+  detector.record(CS101_COT_SPONTANEOUS, 1, 11, M_ME_NC_1, 10.0f);
+  detector.record(CS101_COT_SPONTANEOUS, 1, 12, M_SP_NA_1, true);
+
+  // within tolerance, lost update and never reported spontaneously
+  detector.record(CS101_COT_INTERROGATED_BY_STATION, 1, 11, M_ME_NC_1, 10.4f);
+  detector.record(CS101_COT_INTERROGATED_BY_STATION, 1, 12, M_SP_NA_1, false);
+  detector.record(CS101_COT_INTERROGATED_BY_STATION, 1, 13, M_SP_NA_1, false);
+
+  // the interrogated value is the new reference
+  detector.record(CS101_COT_INTERROGATED_BY_STATION, 1, 12, M_SP_NA_1, false);
+
+  auto const stats = detector.toDict();
+  REQUIRE(stats["checked"].cast<int>() == 3);
+  REQUIRE(stats["unchecked"].cast<int>() == 1);
+  REQUIRE(stats["discrepancies"].cast<int>() == 1);
+  auto const recent = stats["recent"].cast<py::list>();
+  REQUIRE(recent.size() == 1);
+  REQUIRE(recent[0]["io_address"].cast<int>() == 12);
+}
@@ -0,0 +1,312 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+#include "Client.h"
+#include "object/Information.h"
+#include "remote/Connection.h"
+#include "remote/message/CommandTemplate.h"
+#include "remote/message/IncomingMessage.h"
+#include "remote/message/PointCommand.h"
+#include "remote/message/ScratchAsdu.h"
+#include "types.h"
+
+static sCS101_AppLayerParameters appLayerParameters{.sizeOfTypeId = 1,
+                                                    .sizeOfVSQ = 0,
+                                                    .sizeOfCOT = 2,
+                                                    .originatorAddress = 99,
+                                                    .sizeOfCA = 2,
+                                                    .sizeOfIOA = 3,
+                                                    .maxSizeOfASDU = 249};
+
+TEST_CASE("Reject malformed message", "[remote::message]") {
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 14, false, false);
+  InformationObject io1 =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  InformationObject io2 =
+      (InformationObject)SingleCommand_create(nullptr, 12, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io1);
+  CS101_ASDU_addInformationObject(asdu, io2);
+
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+  REQUIRE(message->isValid() == false);
+  REQUIRE(message->getRejectCause() == INVALID_STRUCTURE);
+
+  InformationObject_destroy(io1);
+  InformationObject_destroy(io2);
+  CS101_ASDU_destroy(asdu);
+}
+
+TEST_CASE("Accept valid message", "[remote::message]") {
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_ACTIVATION, 0, 14, false, false);
+  InformationObject io =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io);
+
+  auto message =
+      Remote::Message::IncomingMessage::create(asdu, &appLayerParameters);
+  REQUIRE(message->isValid() == true);
+  REQUIRE(message->getRejectCause() == NO_ERROR_CAUSE);
+  REQUIRE(message->getIOA() == 11);
+
+  InformationObject_destroy(io);
+  CS101_ASDU_destroy(asdu);
+}
+
+TEST_CASE("Benchmark rejected message", "[.][benchmark][remote::message]") {
+  CS101_ASDU asdu = CS101_ASDU_create(
+      &appLayerParameters, true, CS101_COT_ACTIVATION, 0, 14, false, false);
+  InformationObject io =
+      (InformationObject)SingleCommand_create(nullptr, 11, true, false, 0);
+  CS101_ASDU_addInformationObject(asdu, io);
+
+  BENCHMARK("reject sequence command") {
+    return Remote::Message::IncomingMessage::create(asdu, &appLayerParameters)
+        ->getRejectCause();
+  };
+
+  InformationObject_destroy(io);
+  CS101_ASDU_destroy(asdu);
+}
+
+TEST_CASE("Patch command template", "[remote::message]") {
+  auto client = Client::create();
+  auto connection = client->addConnection("127.0.0.1");
+  auto station = connection->addStation(14);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SE_TC_1);
+
+  auto commandTemplate =
+      Remote::Message::CommandTemplate::create(point, &appLayerParameters);
+  REQUIRE(commandTemplate->isPatchable());
+
+  point->setInfo(Object::ShortCmd::create(-12.5, LimitedUInt7(3),
+                                          std::chrono::system_clock::now()));
+  CS101_ASDU patched = commandTemplate->prepare(
+      *point->getInfo(), CS101_COT_DEACTIVATION, true);
+  REQUIRE(patched != nullptr);
+  REQUIRE(CS101_ASDU_getCOT(patched) == CS101_COT_DEACTIVATION);
+
+  auto command = Remote::Message::PointCommand::create(point, true);
+  CS101_ASDU expected = CS101_ASDU_create(
+      &appLayerParameters, false, CS101_COT_DEACTIVATION,
+      appLayerParameters.originatorAddress, 14, false, false);
+  CS101_ASDU_addInformationObject(expected, command->getInformationObject());
+
+  int const size = CS101_ASDU_getPayloadSize(expected);
+  REQUIRE(CS101_ASDU_getPayloadSize(patched) == size);
+  REQUIRE(std::memcmp(CS101_ASDU_getPayload(patched),
+                      CS101_ASDU_getPayload(expected), size) == 0);
+
+  CS101_ASDU_destroy(expected);
+}
+
+/// @brief information of every supported command type with values at the
+/// limits of each type, with and without recorded timestamp
+static std::vector<
+    std::pair<IEC60870_5_TypeID, std::shared_ptr<Object::Information>>>
+createCommandTable() {
+  std::vector<
+      std::pair<IEC60870_5_TypeID, std::shared_ptr<Object::Information>>>
+      table;
+  std::optional<std::chrono::system_clock::time_point> const timestamps[] = {
+      std::nullopt, std::chrono::system_clock::now()};
+  auto const qualifiers = {CS101_QualifierOfCommand::NONE,
+                           CS101_QualifierOfCommand::SHORT_PULSE,
+                           CS101_QualifierOfCommand::PERSISTENT};
+
+  for (auto const &recordedAt : timestamps) {
+    for (auto const type :
+         {IEC60870_5_TypeID::C_SC_NA_1, IEC60870_5_TypeID::C_SC_TA_1}) {
+      for (auto const qualifier : qualifiers) {
+        for (auto const on : {false, true}) {
+          table.emplace_back(
+              type, Object::SingleCmd::create(on, qualifier, recordedAt));
+        }
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_DC_NA_1, IEC60870_5_TypeID::C_DC_TA_1}) {
+      for (auto const qualifier : qualifiers) {
+        for (auto const state :
+             {IEC60870_DOUBLE_POINT_OFF, IEC60870_DOUBLE_POINT_ON}) {
+          table.emplace_back(
+              type, Object::DoubleCmd::create(state, qualifier, recordedAt));
+        }
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_RC_NA_1, IEC60870_5_TypeID::C_RC_TA_1}) {
+      for (auto const qualifier : qualifiers) {
+        for (auto const step : {IEC60870_STEP_LOWER, IEC60870_STEP_HIGHER}) {
+          table.emplace_back(
+              type, Object::StepCmd::create(step, qualifier, recordedAt));
+        }
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_BO_NA_1, IEC60870_5_TypeID::C_BO_TA_1}) {
+      for (std::uint32_t const blob : {0x00000000u, 0x12345678u, 0xffffffffu}) {
+        table.emplace_back(
+            type, Object::BinaryCmd::create(Byte32(blob), recordedAt));
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_SE_NA_1, IEC60870_5_TypeID::C_SE_TA_1}) {
+      for (int const qualifier : {0, 127}) {
+        for (float const target : {-1.0f, -0.5f, -0.25f, -1.0f / 32768, 0.0f,
+                                   1.0f / 32768, 0.25f, 0.5f, 1.0f}) {
+          table.emplace_back(type, Object::NormalizedCmd::create(
+                                       NormalizedFloat(target),
+                                       LimitedUInt7(qualifier), recordedAt));
+        }
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_SE_NB_1, IEC60870_5_TypeID::C_SE_TB_1}) {
+      for (int const qualifier : {0, 127}) {
+        for (int const target : {-32768, -1, 0, 1, 32767}) {
+          table.emplace_back(type, Object::ScaledCmd::create(
+                                       LimitedInt16(target),
+                                       LimitedUInt7(qualifier), recordedAt));
+        }
+      }
+    }
+    for (auto const type :
+         {IEC60870_5_TypeID::C_SE_NC_1, IEC60870_5_TypeID::C_SE_TC_1}) {
+      for (int const qualifier : {0, 127}) {
+        for (float const target : {-1e10f, -12.5f, 0.0f, 1e-7f, 230.5f}) {
+          table.emplace_back(type,
+                             Object::ShortCmd::create(
+                                 target, LimitedUInt7(qualifier), recordedAt));
+        }
+      }
+    }
+  }
+  return table;
+}
+
+TEST_CASE("Patch command templates of all types", "[remote::message]") {
+  auto client = Client::create();
+  auto connection = client->addConnection("127.0.0.1");
+  auto station = connection->addStation(14);
+
+  std::map<IEC60870_5_TypeID,
+           std::pair<std::shared_ptr<Object::DataPoint>,
+                     std::shared_ptr<Remote::Message::CommandTemplate>>>
+      templates;
+  std::uint_fast32_t ioa = 11;
+
+  for (auto const &[type, info] : createCommandTable()) {
+    auto &[point, commandTemplate] = templates[type];
+    if (!point) {
+      point = station->addPoint(ioa++, type);
+      commandTemplate =
+          Remote::Message::CommandTemplate::create(point, &appLayerParameters);
+    }
+    INFO(TypeID_toString(type) << " " << info->toString());
+    REQUIRE(commandTemplate->isPatchable());
+    point->setInfo(info);
+
+    for (auto const select : {false, true}) {
+      INFO("select " << select);
+      CS101_ASDU patched = commandTemplate->prepare(
+          *point->getInfo(), CS101_COT_ACTIVATION, select);
+      REQUIRE(patched != nullptr);
+
+      auto command = Remote::Message::PointCommand::create(point, select);
+      CS101_ASDU expected = CS101_ASDU_create(
+          &appLayerParameters, false, CS101_COT_ACTIVATION,
+          appLayerParameters.originatorAddress, 14, false, false);
+      CS101_ASDU_addInformationObject(expected,
+                                      command->getInformationObject());
+
+      int const size = CS101_ASDU_getPayloadSize(expected);
+      REQUIRE(CS101_ASDU_getPayloadSize(patched) == size);
+      REQUIRE(std::vector<std::uint8_t>(CS101_ASDU_getPayload(patched),
+                                        CS101_ASDU_getPayload(patched) +
+                                            size) ==
+              std::vector<std::uint8_t>(CS101_ASDU_getPayload(expected),
+                                        CS101_ASDU_getPayload(expected) +
+                                            size));
+      CS101_ASDU_destroy(expected);
+    }
+  }
+  REQUIRE(templates.size() == 14);
+}
+
+TEST_CASE("Benchmark command encoding", "[.][benchmark][remote::message]") {
+  auto client = Client::create();
+  auto connection = client->addConnection("127.0.0.1");
+  auto station = connection->addStation(14);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SE_NC_1);
+  point->setInfo(Object::ShortCmd::create(230.5));
+
+  auto commandTemplate =
+      Remote::Message::CommandTemplate::create(point, &appLayerParameters);
+
+  BENCHMARK("encode from scratch") {
+    auto command = Remote::Message::PointCommand::create(point);
+    CS101_ASDU asdu = CS101_ASDU_create(
+        &appLayerParameters, false, CS101_COT_ACTIVATION,
+        appLayerParameters.originatorAddress, 14, false, false);
+    CS101_ASDU_addInformationObject(asdu, command->getInformationObject());
+    int const size = CS101_ASDU_getPayloadSize(asdu);
+    CS101_ASDU_destroy(asdu);
+    return size;
+  };
+
+  BENCHMARK("patch template") {
+    return commandTemplate->prepare(*point->getInfo(), CS101_COT_ACTIVATION,
+                                    false);
+  };
+}
+
+TEST_CASE("Reuse scratch ASDU buffers", "[remote::message]") {
+  {
+    Remote::Message::ScratchAsdu const warmup(
+        &appLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 14, false, false);
+  }
+  auto const allocated = Remote::Message::ScratchAsdu::getAllocatedCount();
+  auto const acquired = Remote::Message::ScratchAsdu::getAcquiredCount();
+
+  InformationObject io = (InformationObject)SinglePointInformation_create(
+      nullptr, 11, true, IEC60870_QUALITY_GOOD);
+  for (int i = 0; i < 100; i++) {
+    Remote::Message::ScratchAsdu const scratch(
+        &appLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 14, false, false);
+    REQUIRE(CS101_ASDU_addInformationObject(scratch.get(), io));
+    REQUIRE(CS101_ASDU_getNumberOfElements(scratch.get()) == 1);
+  }
+  InformationObject_destroy(io);
+
+  REQUIRE(Remote::Message::ScratchAsdu::getAllocatedCount() == allocated);
+  REQUIRE(Remote::Message::ScratchAsdu::getAcquiredCount() == acquired + 100);
+}
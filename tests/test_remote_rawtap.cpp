@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "remote/RawFrameTap.h"
+#include "types.h"
+
+TEST_CASE("Batch raw frames", "[remote::rawtap]") {
+  Remote::RawFrameTap tap;
+  tap.configure(2, 1000);
+
+  unsigned char const first[] = {0x68, 0x04, 0x07, 0x00, 0x00, 0x00};
+  unsigned char const second[] = {0x68, 0x04, 0x0b, 0x00, 0x00, 0x00};
+  REQUIRE_FALSE(tap.append(first, sizeof(first), true));
+  REQUIRE(tap.append(second, sizeof(second), false));
+  // delivery is already scheduled
+  REQUIRE_FALSE(tap.append(first, sizeof(first), true));
+
+  auto batches = tap.collect();
+  REQUIRE(batches.size() == 1);
+  REQUIRE(batches[0]->size() == 2);
+  REQUIRE(batches[0]->getFrame(1).cast<std::string>() ==
+          std::string(reinterpret_cast<const char *>(second), sizeof(second)));
+  REQUIRE_THROWS_AS(batches[0]->getFrame(2), std::out_of_range);
+
+  auto const offsets =
+      batches[0]->getBufferInfo(Remote::RawFrameBatch::OFFSETS);
+  REQUIRE(offsets.size == 3);
+  REQUIRE(static_cast<std::uint32_t *>(offsets.ptr)[2] == 12);
+
+  batches = tap.collect(true);
+  REQUIRE(batches.size() == 1);
+  REQUIRE(batches[0]->size() == 1);
+
+  auto const stats = tap.toDict();
+  REQUIRE(stats["frames"].cast<int>() == 3);
+  REQUIRE(stats["batches"].cast<int>() == 2);
+  REQUIRE(stats["dropped_frames"].cast<int>() == 0);
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "remote/RoundTripMonitor.h"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Collect round trip statistics", "[remote::roundtrip]") {
+  Remote::RoundTripMonitor monitor;
+
+  monitor.record(10ms);
+  monitor.record(100ms);
+  monitor.record(1ms);
+  monitor.record(6s);
+  monitor.recordLost();
+
+  auto stats = monitor.toDict();
+  REQUIRE(stats["count"].cast<std::uint64_t>() == 4);
+  REQUIRE(stats["lost"].cast<std::uint64_t>() == 1);
+  REQUIRE(stats["last_ms"].cast<double>() == 6000.0);
+  REQUIRE(stats["min_ms"].cast<double>() == 1.0);
+  REQUIRE(stats["max_ms"].cast<double>() == 6000.0);
+
+  // first sample initializes both averages, later ones are smoothed by 1/8
+  // and 1/64
+  double fast = 10.0;
+  double slow = 10.0;
+  for (double sample : {100.0, 1.0, 6000.0}) {
+    fast += (sample - fast) / 8;
+    slow += (sample - slow) / 64;
+  }
+  REQUIRE(stats["ema_fast_ms"].cast<double>() == fast);
+  REQUIRE(stats["ema_slow_ms"].cast<double>() == slow);
+  REQUIRE(monitor.getAverage_ms() == fast);
+
+  auto histogram = stats["histogram"].cast<py::list>();
+  REQUIRE(histogram.size() ==
+          Remote::ROUND_TRIP_HISTOGRAM_BOUNDS_MS.size() + 1);
+  REQUIRE(histogram[0].cast<int>() == 1);  // 1 ms
+  REQUIRE(histogram[3].cast<int>() == 1);  // 10 ms
+  REQUIRE(histogram[6].cast<int>() == 1);  // 100 ms
+  REQUIRE(histogram[12].cast<int>() == 1); // above 5000 ms
+
+  monitor.reset();
+  stats = monitor.toDict();
+  REQUIRE(stats["count"].cast<std::uint64_t>() == 0);
+  REQUIRE(stats["lost"].cast<std::uint64_t>() == 0);
+  REQUIRE(stats["max_ms"].cast<double>() == 0.0);
+  REQUIRE(monitor.getAverage_ms() == 0.0);
+}
+
+TEST_CASE("Detect round trip threshold crossing", "[remote::roundtrip]") {
+  Remote::RoundTripMonitor monitor;
+
+  SECTION("Disabled threshold never reports") {
+    REQUIRE_FALSE(monitor.record(1s));
+    REQUIRE_FALSE(monitor.isExceeded());
+  }
+
+  SECTION("Report each crossing once") {
+    monitor.setThreshold_ms(20);
+    REQUIRE(monitor.getThreshold_ms() == 20);
+
+    REQUIRE_FALSE(monitor.record(10ms));
+    REQUIRE_FALSE(monitor.record(10ms));
+    REQUIRE_FALSE(monitor.isExceeded());
+
+    // fast average: 10 + (100 - 10) / 8 = 21.25
+    REQUIRE(monitor.record(100ms));
+    REQUIRE(monitor.isExceeded());
+    REQUIRE_FALSE(monitor.record(100ms));
+    REQUIRE(monitor.isExceeded());
+
+    // decay below the threshold again
+    bool crossed = false;
+    int samples = 0;
+    while (!crossed && samples < 100) {
+      crossed = monitor.record(1ms);
+      samples++;
+    }
+    REQUIRE(crossed);
+    REQUIRE_FALSE(monitor.isExceeded());
+    REQUIRE(monitor.getAverage_ms() <= 20.0);
+    REQUIRE_FALSE(monitor.record(1ms));
+  }
+
+  SECTION("Disabling clears the exceeded state") {
+    monitor.setThreshold_ms(5);
+    REQUIRE(monitor.record(50ms));
+    REQUIRE(monitor.isExceeded());
+    monitor.setThreshold_ms(0);
+    REQUIRE_FALSE(monitor.isExceeded());
+  }
+}
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020-2024 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "remote/BandwidthShaper.h"
+#include "remote/message/ScratchAsdu.h"
+#include "types.h"
+
+static sCS101_AppLayerParameters appLayerParameters{.sizeOfTypeId = 1,
+                                                    .sizeOfVSQ = 0,
+                                                    .sizeOfCOT = 2,
+                                                    .originatorAddress = 99,
+                                                    .sizeOfCA = 2,
+                                                    .sizeOfIOA = 3,
+                                                    .maxSizeOfASDU = 249};
+
+TEST_CASE("Shape outgoing bandwidth", "[remote::shaper]") {
+  Remote::BandwidthShaper shaper("127.0.0.1");
+  shaper.configure(1000, 255);
+
+  REQUIRE(shaper.tryConsume(200, false));
+  REQUIRE_FALSE(shaper.tryConsume(200, true));
+
+  Remote::Message::ScratchAsdu const scratch(
+      &appLayerParameters, false, CS101_COT_PERIODIC, 0, 14, false, false);
+  shaper.hold(scratch.get(), 200, true);
+  // normal priority frames are not queued behind held low priority frames
+  REQUIRE_FALSE(shaper.hasHeldFrames());
+
+  REQUIRE(shaper.releaseNext() == nullptr);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(250));
+  CS101_ASDU const released = shaper.releaseNext();
+  REQUIRE(released != nullptr);
+  REQUIRE(CS101_ASDU_getCOT(released) == CS101_COT_PERIODIC);
+  CS101_ASDU_destroy(released);
+  REQUIRE(shaper.releaseNext() == nullptr);
+
+  auto const stats = shaper.toDict();
+  REQUIRE(stats["frames"].cast<int>() == 2);
+  REQUIRE(stats["delayed_frames"].cast<int>() == 1);
+  REQUIRE(stats["held_frames"].cast<int>() == 0);
+  REQUIRE(stats["max_held_ms"].cast<double>() >= 200);
+}
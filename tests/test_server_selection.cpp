@@ -0,0 +1,304 @@
+/**
+ * Copyright 2020-2023 Fraunhofer Institute for Applied Information Technology
+ * FIT
+ *
+ * This file is part of iec104-python.
+ * iec104-python is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * iec104-python is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with iec104-python. If not, see <https://www.gnu.org/licenses/>.
+ *
+ *  See LICENSE file for the complete license text.
+ *
+ * @authors Martin Unkel <martin.unkel@fit.fraunhofer.de>
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <pybind11/eval.h>
+
+#include <cstring>
+#include <thread>
+
+#include "Server.h"
+#include "object/DataPoint.h"
+#include "object/Station.h"
+#include "types.h"
+
+namespace {
+
+/// @brief frame sent by the server to an in-memory master connection
+struct SentFrame {
+  CS101_CauseOfTransmission cot;
+  bool negative;
+};
+
+/**
+ * @brief in-memory master connection that records all frames sent by the
+ * server, sending happens from the caller or the server thread
+ */
+struct FakeMaster {
+  sIMasterConnection connection{};
+  sCS101_AppLayerParameters parameters{.sizeOfTypeId = 1,
+                                       .sizeOfVSQ = 0,
+                                       .sizeOfCOT = 2,
+                                       .originatorAddress = 0,
+                                       .sizeOfCA = 2,
+                                       .sizeOfIOA = 3,
+                                       .maxSizeOfASDU = 249};
+  std::mutex mutex;
+  std::vector<SentFrame> frames;
+
+  FakeMaster() {
+    connection.isReady = [](IMasterConnection self) { return true; };
+    connection.sendASDU = [](IMasterConnection self, CS101_ASDU asdu) {
+      static_cast<FakeMaster *>(self->object)->record(asdu);
+      return true;
+    };
+    connection.sendACT_CON = [](IMasterConnection self, CS101_ASDU asdu,
+                                bool negative) {
+      CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+      CS101_ASDU_setNegative(asdu, negative);
+      static_cast<FakeMaster *>(self->object)->record(asdu);
+      return true;
+    };
+    connection.sendACT_TERM = [](IMasterConnection self, CS101_ASDU asdu) {
+      CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_TERMINATION);
+      static_cast<FakeMaster *>(self->object)->record(asdu);
+      return true;
+    };
+    connection.close = [](IMasterConnection self) {};
+    connection.getPeerAddress = [](IMasterConnection self, char *addrBuf,
+                                   int addrBufSize) {
+      std::strncpy(addrBuf, "127.0.0.1:2404", addrBufSize - 1);
+      addrBuf[addrBufSize - 1] = '\0';
+      return static_cast<int>(std::strlen(addrBuf));
+    };
+    connection.getApplicationLayerParameters = [](IMasterConnection self) {
+      return &static_cast<FakeMaster *>(self->object)->parameters;
+    };
+    connection.object = this;
+  }
+
+  void record(CS101_ASDU asdu) {
+    std::lock_guard<std::mutex> const lock(mutex);
+    frames.push_back({CS101_ASDU_getCOT(asdu), CS101_ASDU_isNegative(asdu)});
+  }
+
+  std::vector<SentFrame> takeFrames() {
+    std::lock_guard<std::mutex> const lock(mutex);
+    return std::exchange(frames, {});
+  }
+
+  /**
+   * @brief send a single command with the select flag set or cleared to the
+   * asdu handler of a server
+   */
+  void command(const std::shared_ptr<Server> &server, bool select,
+               std::uint_fast32_t ioa = 11) {
+    CS101_ASDU asdu = CS101_ASDU_create(&parameters, false,
+                                        CS101_COT_ACTIVATION, 0, 10, false,
+                                        false);
+    InformationObject io = (InformationObject)SingleCommand_create(
+        nullptr, ioa, true, select, 0);
+    CS101_ASDU_addInformationObject(asdu, io);
+    Server::asduHandler(server.get(), &connection, asdu);
+    InformationObject_destroy(io);
+    CS101_ASDU_destroy(asdu);
+  }
+};
+
+std::shared_ptr<Server> createServer(const std::uint_fast16_t port,
+                                     const std::uint_fast16_t timeout_ms) {
+  auto server = Server::create("127.0.0.1", port, 100, timeout_ms);
+  auto station = server->addStation(10);
+  auto point = station->addPoint(11, IEC60870_5_TypeID::C_SC_NA_1);
+  point->setCommandMode(SELECT_AND_EXECUTE_COMMAND);
+  return server;
+}
+
+} // namespace
+
+TEST_CASE("Select and execute command", "[server::selection]") {
+  auto server = createServer(24160, 10000);
+  FakeMaster master;
+  FakeMaster other;
+  Server::connectionEventHandler(server.get(), &master.connection,
+                                 CS104_CON_EVENT_ACTIVATED);
+  Server::connectionEventHandler(server.get(), &other.connection,
+                                 CS104_CON_EVENT_ACTIVATED);
+
+  SECTION("Execute terminates the selection") {
+    master.command(server, true);
+    auto frames = master.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].cot == CS101_COT_ACTIVATION_CON);
+    REQUIRE_FALSE(frames[0].negative);
+    REQUIRE(server->getSelector(10, 11) == 0);
+
+    // the point is selected by another connection
+    other.command(server, true);
+    frames = other.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].negative);
+    other.command(server, false);
+    frames = other.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].negative);
+
+    // confirmation first, then the termination of the selection
+    master.command(server, false);
+    frames = master.takeFrames();
+    REQUIRE(frames.size() == 2);
+    REQUIRE(frames[0].cot == CS101_COT_ACTIVATION_CON);
+    REQUIRE_FALSE(frames[0].negative);
+    REQUIRE(frames[1].cot == CS101_COT_ACTIVATION_TERMINATION);
+    REQUIRE_FALSE(server->getSelector(10, 11).has_value());
+
+    // a selection is executed only once
+    master.command(server, false);
+    frames = master.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].negative);
+  }
+
+  SECTION("Execute without selection fails") {
+    master.command(server, false);
+    auto frames = master.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0].cot == CS101_COT_ACTIVATION_CON);
+    REQUIRE(frames[0].negative);
+  }
+
+  SECTION("Closed connections drop their selections") {
+    master.command(server, true);
+    master.takeFrames();
+    Server::connectionEventHandler(server.get(), &master.connection,
+                                   CS104_CON_EVENT_CONNECTION_CLOSED);
+    REQUIRE_FALSE(server->getSelector(10, 11).has_value());
+    REQUIRE(master.takeFrames().empty());
+
+    other.command(server, true);
+    auto frames = other.takeFrames();
+    REQUIRE(frames.size() == 1);
+    REQUIRE_FALSE(frames[0].negative);
+  }
+
+  Server::connectionEventHandler(server.get(), &master.connection,
+                                 CS104_CON_EVENT_CONNECTION_CLOSED);
+  Server::connectionEventHandler(server.get(), &other.connection,
+                                 CS104_CON_EVENT_CONNECTION_CLOSED);
+}
+
+TEST_CASE("Terminate expired selection", "[server::selection]") {
+  auto server = createServer(24161, 100);
+  FakeMaster master;
+  server->start();
+  Server::connectionEventHandler(server.get(), &master.connection,
+                                 CS104_CON_EVENT_ACTIVATED);
+
+  master.command(server, true);
+  auto frames = master.takeFrames();
+  REQUIRE(frames.size() == 1);
+  REQUIRE_FALSE(frames[0].negative);
+
+  // the periodic cleanup of the server thread terminates the selection
+  bool terminated = false;
+  {
+    py::gil_scoped_release const release;
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!terminated && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      for (auto const &frame : master.takeFrames()) {
+        terminated |= frame.cot == CS101_COT_ACTIVATION_TERMINATION;
+      }
+    }
+  }
+  REQUIRE(terminated);
+  REQUIRE_FALSE(server->getSelector(10, 11).has_value());
+
+  // an expired selection cannot be executed
+  master.command(server, false);
+  frames = master.takeFrames();
+  REQUIRE(frames.size() == 1);
+  REQUIRE(frames[0].negative);
+
+  Server::connectionEventHandler(server.get(), &master.connection,
+                                 CS104_CON_EVENT_CONNECTION_CLOSED);
+  server->stop();
+}
+
+TEST_CASE("Drop queued commands of closed connection", "[server::selection]") {
+  auto server = createServer(24162, 10000);
+  auto point =
+      server->getStation(10)->addPoint(12, IEC60870_5_TypeID::C_SC_NA_1);
+  py::module_::import("_c104");
+  py::dict scope;
+  py::exec(R"(
+import time
+import _c104
+
+received = []
+
+def on_receive(point, previous_info, message):
+    received.append(message.is_select_command)
+    time.sleep(0.3)
+    return _c104.ResponseState.SUCCESS
+)",
+           scope);
+  py::object onReceive = scope["on_receive"];
+  point->setOnReceiveCallback(onReceive);
+
+  FakeMaster master;
+  server->enableCommandExecutor(1);
+  Server::connectionEventHandler(server.get(), &master.connection,
+                                 CS104_CON_EVENT_ACTIVATED);
+
+  std::vector<SentFrame> confirmed;
+  {
+    py::gil_scoped_release const release;
+
+    // the first command blocks the only worker
+    master.command(server, false, 12);
+    bool started = false;
+    auto const deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!started && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      py::gil_scoped_acquire const acquire;
+      started = !py::list(scope["received"]).empty();
+    }
+    REQUIRE(started);
+
+    // queued behind the running command
+    master.command(server, false, 12);
+    master.command(server, true, 11);
+
+    // closing waits for the running command
+    Server::connectionEventHandler(server.get(), &master.connection,
+                                   CS104_CON_EVENT_CONNECTION_CLOSED);
+    confirmed = master.takeFrames();
+
+    // queued commands of the closed connection are dropped
+    server->disableCommandExecutor();
+  }
+  REQUIRE_FALSE(confirmed.empty());
+  REQUIRE(confirmed[0].cot == CS101_COT_ACTIVATION_CON);
+  REQUIRE_FALSE(confirmed[0].negative);
+  REQUIRE(master.takeFrames().empty());
+  REQUIRE(py::list(scope["received"]).size() == 1);
+  REQUIRE_FALSE(server->getSelector(10, 11).has_value());
+
+  auto const stats = server->getCommandExecutorStatistics();
+  REQUIRE(stats["dispatched"].cast<std::uint_fast64_t>() == 3);
+  REQUIRE(stats["executed"].cast<std::uint_fast64_t>() == 3);
+}